@@ -22,6 +22,7 @@ EncoderArguments::EncoderArguments(size_t argc, const char** argv) :
     _normalMap(false),
     _parseError(false),
     _fontPreview(false),
+    _fontDistanceField(false),
     _textOutput(false),
     _daeOutput(false),
     _optimizeAnimations(false)
@@ -266,6 +267,8 @@ void EncoderArguments::printUsage() const
     LOG(1, "TTF file options:\n");
     LOG(1, "  -s <size>\tSize of the font.\n");
     LOG(1, "  -p\t\tOutput font preview.\n");
+    LOG(1, "  -sdf\t\tOutput a signed distance field of the glyphs, which can be drawn\n" \
+        "\t\tcrisply at any size, instead of a bitmap of the font size.\n");
     LOG(1, "\n");
     exit(8);
 }
@@ -275,6 +278,11 @@ bool EncoderArguments::fontPreviewEnabled() const
     return _fontPreview;
 }
 
+bool EncoderArguments::fontDistanceFieldEnabled() const
+{
+    return _fontDistanceField;
+}
+
 bool EncoderArguments::textOutputEnabled() const
 {
     return _textOutput;
@@ -513,7 +521,11 @@ void EncoderArguments::readOption(const std::vector<std::string>& options, size_
         _fontPreview = true;
         break;
     case 's':
-        if (_normalMap)
+        if (str.compare("-sdf") == 0)
+        {
+            _fontDistanceField = true;
+        }
+        else if (_normalMap)
         {
             (*index)++;
             if (*index >= options.size())
@@ -699,6 +711,14 @@ void unittestsEncoderArguments()
         assert(args.textOutputEnabled());
         //assert(equals(args.getDAEOutputPath(), concat(dir, "/collada.dae")));
     }
+    {
+        // Test parsing font arguments
+        const char* argv[] = {exe, "-s", "32", "-sdf", "input.ttf"};
+        EncoderArguments args(sizeof(argv) / sizeof(char*), (const char**)argv);
+        assert(args.getFontSize() == 32);
+        assert(args.fontDistanceFieldEnabled());
+        assert(equals(args.getOutputFilePath(), concat(dir, "/input.gpb")));
+    }
     {
         // Test output file with no file extension
         const char* argv[] = {exe, "input.dae", "output"};
@@ -137,6 +137,7 @@ public:
     void printUsage() const;
 
     bool fontPreviewEnabled() const;
+    bool fontDistanceFieldEnabled() const;
     bool textOutputEnabled() const;
     bool DAEOutputEnabled() const;
     bool optimizeAnimationsEnabled() const;
@@ -186,6 +187,7 @@ private:
 
     bool _parseError;
     bool _fontPreview;
+    bool _fontDistanceField;
     bool _textOutput;
     bool _daeOutput;
     bool _optimizeAnimations;
@@ -8,7 +8,8 @@ Font::Font(void) :
     style(0),
     size(0),
     texMapWidth(0),
-    texMapHeight(0)
+    texMapHeight(0),
+    format(0)
 {
 }
 
@@ -36,6 +37,7 @@ void Font::writeBinary(FILE* file)
     write(texMapWidth, file);
     write(texMapHeight, file);
     write(texMap, file);
+    write(format, file);
 }
 void Font::writeText(FILE* file)
 {
@@ -48,6 +50,7 @@ void Font::writeText(FILE* file)
     fprintfElement(file, "texMapWidth", texMapWidth);
     fprintfElement(file, "texMapHeight", texMapHeight);
     //fprintfElement(file, "texMap", texMap);
+    fprintfElement(file, "format", format);
     fprintElementEnd(file);
 }
 
@@ -34,6 +34,7 @@ public:
     unsigned int texMapWidth;
     unsigned int texMapHeight;
     std::list<unsigned char> texMap;
+    unsigned int format;
 
     enum FontStyle
     {
@@ -42,6 +43,12 @@ public:
         ITALIC = 2,
         BOLD_ITALIC = 4
     };
+
+    enum FontFormat
+    {
+        BITMAP = 0,
+        DISTANCE_FIELD = 1
+    };
 };
 
 }
@@ -6,6 +6,8 @@ namespace gameplay
 
 GPBDecoder::GPBDecoder(void) : _file(NULL), _outFile(NULL)
 {
+    _version[0] = 0;
+    _version[1] = 0;
 }
 
 
@@ -52,9 +54,7 @@ bool GPBDecoder::validateHeading()
         }
     }
     // read version
-    unsigned char version[2];
-    fread(version, sizeof(unsigned char), 2, _file);
-    // don't care about version
+    fread(_version, sizeof(unsigned char), 2, _file);
 
     return true;
 }
@@ -69,6 +69,16 @@ void GPBDecoder::readRefs()
     {
         readRef();
     }
+    // skip the ref table index that follows the refs since version 1.3
+    if (_version[0] > 1 || (_version[0] == 1 && _version[1] >= 3))
+    {
+        unsigned int bucketCount = 0;
+        if (read(&bucketCount))
+        {
+            fprintfElement(_outFile, "indexBucketCount", bucketCount);
+            fseek(_file, bucketCount * sizeof(unsigned int), SEEK_CUR);
+        }
+    }
     fprintf(_outFile, "</RefTable>\n");
 }
 
@@ -35,6 +35,7 @@ private:
 
     FILE* _file;
     FILE* _outFile;
+    unsigned char _version[2];
 };
 
 }
@@ -4,6 +4,20 @@
 namespace gameplay
 {
 
+/**
+ * Hashes a reference ID for the reference table index (32-bit FNV-1a, matching the gameplay Bundle loader).
+ */
+static unsigned int hashReferenceId(const std::string& id)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0, count = id.length(); i < count; ++i)
+    {
+        hash ^= (unsigned char)id[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 ReferenceTable::ReferenceTable(void)
 {
 }
@@ -35,6 +49,35 @@ void ReferenceTable::writeBinary(FILE* file)
     {
         i->second.writeBinary(file);
     }
+    writeIndexBinary(file);
+}
+
+void ReferenceTable::writeIndexBinary(FILE* file)
+{
+    // Use the smallest power of two at least twice the reference count, to keep the probe sequences short.
+    unsigned int refCount = (unsigned int)_table.size();
+    unsigned int bucketCount = 1;
+    while (bucketCount < refCount * 2)
+        bucketCount <<= 1;
+
+    // Each bucket holds the index of a reference in the table plus one, or zero when empty.
+    // Collisions are resolved by linear probing.
+    std::vector<unsigned int> buckets(bucketCount, 0);
+    unsigned int mask = bucketCount - 1;
+    unsigned int index = 0;
+    for (std::map<std::string, Reference>::iterator i = _table.begin(); i != _table.end(); ++i, ++index)
+    {
+        unsigned int bucket = hashReferenceId(i->first) & mask;
+        while (buckets[bucket] != 0)
+            bucket = (bucket + 1) & mask;
+        buckets[bucket] = index + 1;
+    }
+
+    write(bucketCount, file);
+    for (unsigned int i = 0; i < bucketCount; ++i)
+    {
+        write(buckets[i], file);
+    }
 }
 
 void ReferenceTable::writeText(FILE* file)
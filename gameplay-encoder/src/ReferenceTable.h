@@ -38,6 +38,18 @@ public:
     void writeBinary(FILE* file);
     void writeText(FILE* file);
 
+    /**
+     * Writes the hash index of the reference table, which follows the references in the GamePlay binary file.
+     *
+     * The index lets the runtime find a reference by ID without searching or indexing the table itself.
+     * It is an array of buckets whose count is a power of two greater than the number of references.
+     * Each bucket holds the index of a reference plus one, or zero when empty. A reference is stored in
+     * the first empty bucket found probing linearly from the 32-bit FNV-1a hash of its ID.
+     * 
+     * @param file The file pointer.
+     */
+    void writeIndexBinary(FILE* file);
+
     /**
      * Updates the file positon offsets of the Reference objects in the GamePlay binary file.
      * This needs to be called after all of the objects have been written.
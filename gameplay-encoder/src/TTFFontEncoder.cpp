@@ -19,6 +19,56 @@ static void drawBitmap(unsigned char* dstBitmap, int x, int y, int dstWidth, uns
     }
 }
 
+/**
+ * Computes a distance field from a glyph bitmap, downsampled by the given factor.
+ *
+ * Each value of the field is 128 on a glyph edge, and rises inside (or falls outside) a glyph
+ * to 255 (or 0) at the given distance from the edge, in pixels of the bitmap.
+ */
+static unsigned char* createDistanceField(const unsigned char* bitmap, int width, int height, int scale, int spread)
+{
+    int fieldWidth = width / scale;
+    int fieldHeight = height / scale;
+    unsigned char* field = (unsigned char*)malloc(fieldWidth * fieldHeight);
+
+    for (int fy = 0; fy < fieldHeight; ++fy)
+    {
+        for (int fx = 0; fx < fieldWidth; ++fx)
+        {
+            // Sample the bitmap at the center of the field pixel.
+            int x = fx * scale + scale / 2;
+            int y = fy * scale + scale / 2;
+            bool inside = bitmap[x + y * width] >= 128;
+
+            // Find the nearest bitmap pixel on the other side of an edge (pixels off the bitmap are outside).
+            int nearest = spread * spread;
+            for (int dy = -spread; dy <= spread; ++dy)
+            {
+                for (int dx = -spread; dx <= spread; ++dx)
+                {
+                    int distance = dx * dx + dy * dy;
+                    if (distance >= nearest)
+                        continue;
+
+                    int sx = x + dx;
+                    int sy = y + dy;
+                    bool sampleInside = sx >= 0 && sx < width && sy >= 0 && sy < height && bitmap[sx + sy * width] >= 128;
+                    if (sampleInside != inside)
+                        nearest = distance;
+                }
+            }
+
+            // The edge lies half way between the two pixels.
+            float distance = sqrt((float)nearest) - 0.5f;
+            float value = 0.5f + (inside ? distance : -distance) / (2.0f * spread);
+            value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+            field[fx + fy * fieldWidth] = (unsigned char)(value * 255.0f + 0.5f);
+        }
+    }
+
+    return field;
+}
+
 static void writeUint(FILE* fp, unsigned int i)
 {
     fwrite(&i, sizeof(unsigned int), 1, fp);
@@ -34,9 +84,13 @@ static void writeString(FILE* fp, const char* str)
     }
 }
 
-int writeFont(const char* inFilePath, const char* outFilePath, unsigned int fontSize, const char* id, bool fontpreview = false)
+int writeFont(const char* inFilePath, const char* outFilePath, unsigned int fontSize, const char* id, bool fontpreview = false, bool distanceField = false)
 {
     Glyph glyphArray[END_INDEX - START_INDEX];
+
+    // Distance fields are computed from glyphs rasterized at a larger size, and then downsampled.
+    int scale = distanceField ? DISTANCE_FIELD_SCALE : 1;
+    int padding = GLYPH_PADDING * scale;
     
     // Initialize freetype library.
     FT_Library library;
@@ -60,7 +114,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
     error = FT_Set_Char_Size(
             face,           // handle to face object.
             0,              // char_width in 1/64th of points.
-            fontSize * 64,   // char_height in 1/64th of points.
+            fontSize * scale * 64, // char_height in 1/64th of points.
             0,              // horizontal device resolution (defaults to 72 dpi if resolution (0, 0)).
             0 );            // vertical device resolution.
     
@@ -106,7 +160,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
     }
 
     // Include padding in the rowSize.
-    rowSize += GLYPH_PADDING;
+    rowSize += padding;
     
     // Initialize with padding.
     int penX = 0;
@@ -144,7 +198,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
             int glyphWidth = slot->bitmap.pitch;
             int glyphHeight = slot->bitmap.rows;
 
-            advance = glyphWidth + GLYPH_PADDING; //((int)slot->advance.x >> 6) + GLYPH_PADDING;
+            advance = glyphWidth + padding; //((int)slot->advance.x >> 6) + padding;
 
             // If we reach the end of the image wrap aroud to the next row.
             if ((penX + advance) > (int)imageWidth)
@@ -212,7 +266,7 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
         int glyphWidth = slot->bitmap.pitch;
         int glyphHeight = slot->bitmap.rows;
 
-        advance = glyphWidth + GLYPH_PADDING;//((int)slot->advance.x >> 6) + GLYPH_PADDING;
+        advance = glyphWidth + padding;//((int)slot->advance.x >> 6) + padding;
 
         // If we reach the end of the image wrap aroud to the next row.
         if ((penX + advance) > (int)imageWidth)
@@ -238,12 +292,12 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
         penY = row * rowSize;
 
         glyphArray[i].index = ascii;
-        glyphArray[i].width = advance - GLYPH_PADDING;
+        glyphArray[i].width = advance - padding;
         
         // Generate UV coords.
         glyphArray[i].uvCoords[0] = (float)penX / (float)imageWidth;
         glyphArray[i].uvCoords[1] = (float)penY / (float)imageHeight;
-        glyphArray[i].uvCoords[2] = (float)(penX + advance - GLYPH_PADDING) / (float)imageWidth;
+        glyphArray[i].uvCoords[2] = (float)(penX + advance - padding) / (float)imageWidth;
         glyphArray[i].uvCoords[3] = (float)(penY + rowSize) / (float)imageHeight;
 
         // Set the pen position for the next glyph
@@ -251,6 +305,22 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
         i++;
     }
 
+    if (distanceField)
+    {
+        // Replace the bitmap with its distance field at the requested font size.
+        // The uv coordinates are unchanged since they are relative to the image size.
+        unsigned char* fieldBuffer = createDistanceField(imageBuffer, imageWidth, imageHeight, scale, DISTANCE_FIELD_SPREAD * scale);
+        free(imageBuffer);
+        imageBuffer = fieldBuffer;
+        imageWidth /= scale;
+        imageHeight /= scale;
+        rowSize = (rowSize + scale / 2) / scale;
+        for (i = 0; i < END_INDEX - START_INDEX; ++i)
+        {
+            glyphArray[i].width = (glyphArray[i].width + scale / 2) / scale;
+        }
+    }
+
 
     FILE *gpbFp = fopen(outFilePath, "wb");
     
@@ -263,7 +333,8 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
     writeUint(gpbFp, 1);                // Ref[] count
     writeString(gpbFp, id);             // Ref id
     writeUint(gpbFp, 128);              // Ref type
-    writeUint(gpbFp, ftell(gpbFp) + 4); // Ref offset (current pos + 4 bytes)
+    writeUint(gpbFp, ftell(gpbFp) + 8); // Ref offset (current pos + 4 bytes + 4 bytes for the index)
+    writeUint(gpbFp, 0);                // Ref table index bucket count (no index)
     
     // Write Font object.
     
@@ -294,6 +365,9 @@ int writeFont(const char* inFilePath, const char* outFilePath, unsigned int font
     writeUint(gpbFp, imageHeight);
     writeUint(gpbFp, textureSize);
     fwrite(imageBuffer, sizeof(unsigned char), textureSize, gpbFp);
+
+    // Texture format.
+    writeUint(gpbFp, distanceField ? 1 : 0); // 0 == BITMAP, 1 == DISTANCE_FIELD
     
     // Close file.
     fclose(gpbFp);
@@ -5,6 +5,11 @@
 #define END_INDEX       127
 #define GLYPH_PADDING   4
 
+// Distance fields are computed from glyphs rasterized at this multiple of the font size.
+#define DISTANCE_FIELD_SCALE    4
+// The distance (in pixels of the font size) over which a distance field falls from a glyph edge to zero.
+#define DISTANCE_FIELD_SPREAD   4
+
 namespace gameplay
 {
 
@@ -25,9 +30,11 @@ public:
  * @param fontSize Size of the font.
  * @param id ID string of the font in the ref table.
  * @param fontpreview True if the pgm font preview file should be written. (For debugging)
+ * @param distanceField True to write a signed distance field of the glyphs instead of a bitmap,
+ *      which can be drawn crisply at any size.
  * 
  * @return 0 if successful, -1 if error.
  */
-int writeFont(const char* inFilePath, const char* outFilePath, unsigned int fontSize, const char* id, bool fontpreview);
+int writeFont(const char* inFilePath, const char* outFilePath, unsigned int fontSize, const char* id, bool fontpreview, bool distanceField);
 
 }
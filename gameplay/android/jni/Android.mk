@@ -47,6 +47,7 @@ LOCAL_SRC_FILES := \
     FileSystem.cpp \
     FlowLayout.cpp \
     Font.cpp \
+    FontAtlas.cpp \
     Form.cpp \
     FrameBuffer.cpp \
     Frustum.cpp \
@@ -54,6 +55,8 @@ LOCAL_SRC_FILES := \
     Gamepad.cpp \
     HeightField.cpp \
     Image.cpp \
+    InstanceBuffer.cpp \
+    JobSystem.cpp \
     Joint.cpp \
     Joystick.cpp \
     Label.cpp \
@@ -64,6 +67,7 @@ LOCAL_SRC_FILES := \
     MaterialParameter.cpp \
     MathUtil.cpp \
     Matrix.cpp \
+    MemoryTracker.cpp \
     Mesh.cpp \
     MeshBatch.cpp \
     MeshPart.cpp \
@@ -71,6 +75,7 @@ LOCAL_SRC_FILES := \
     Model.cpp \
     Node.cpp \
     ParticleEmitter.cpp \
+    ParticleSystem.cpp \
     Pass.cpp \
     PhysicsCharacter.cpp \
     PhysicsCollisionObject.cpp \
@@ -88,20 +93,25 @@ LOCAL_SRC_FILES := \
     PhysicsVehicleWheel.cpp \
     Plane.cpp \
     PlatformAndroid.cpp \
+    Profiler.cpp \
     Properties.cpp \
     Quaternion.cpp \
     RadioButton.cpp \
     Ray.cpp \
     Rectangle.cpp \
     Ref.cpp \
+    RenderQueue.cpp \
     RenderState.cpp \
     RenderTarget.cpp \
+    ResourceLoader.cpp \
+    ResourceRequest.cpp \
     Scene.cpp \
     SceneLoader.cpp \
     ScreenDisplayer.cpp \
     ScriptController.cpp \
     ScriptTarget.cpp \
     Slider.cpp \
+    SpatialIndex.cpp \
     SpriteBatch.cpp \
     Technique.cpp \
     Terrain.cpp \
@@ -110,6 +120,7 @@ LOCAL_SRC_FILES := \
     Texture.cpp \
     Theme.cpp \
     ThemeStyle.cpp \
+    Thread.cpp \
     Transform.cpp \
     Vector2.cpp \
     Vector3.cpp \
@@ -161,6 +172,7 @@ LOCAL_SRC_FILES := \
     lua/lua_FileSystem.cpp \
     lua/lua_FlowLayout.cpp \
     lua/lua_Font.cpp \
+    lua/lua_FontFormat.cpp \
     lua/lua_FontJustify.cpp \
     lua/lua_FontStyle.cpp \
     lua/lua_FontText.cpp \
@@ -179,6 +191,7 @@ LOCAL_SRC_FILES := \
     lua/lua_HeightField.cpp \
     lua/lua_Image.cpp \
     lua/lua_ImageFormat.cpp \
+    lua/lua_InstanceBuffer.cpp \
     lua/lua_Joint.cpp \
     lua/lua_Joystick.cpp \
     lua/lua_Keyboard.cpp \
@@ -209,6 +222,7 @@ LOCAL_SRC_FILES := \
     lua/lua_NodeType.cpp \
     lua/lua_ParticleEmitter.cpp \
     lua/lua_ParticleEmitterTextureBlending.cpp \
+    lua/lua_ParticleSystem.cpp \
     lua/lua_Pass.cpp \
     lua/lua_PhysicsCharacter.cpp \
     lua/lua_PhysicsCollisionObject.cpp \
@@ -237,6 +251,7 @@ LOCAL_SRC_FILES := \
     lua/lua_PhysicsVehicleWheel.cpp \
     lua/lua_Plane.cpp \
     lua/lua_Platform.cpp \
+    lua/lua_Profiler.cpp \
     lua/lua_Properties.cpp \
     lua/lua_PropertiesType.cpp \
     lua/lua_Quaternion.cpp \
@@ -244,12 +259,16 @@ LOCAL_SRC_FILES := \
     lua/lua_Ray.cpp \
     lua/lua_Rectangle.cpp \
     lua/lua_Ref.cpp \
+    lua/lua_RenderQueue.cpp \
     lua/lua_RenderState.cpp \
     lua/lua_RenderStateAutoBinding.cpp \
     lua/lua_RenderStateBlend.cpp \
     lua/lua_RenderStateDepthFunction.cpp \
     lua/lua_RenderStateStateBlock.cpp \
     lua/lua_RenderTarget.cpp \
+    lua/lua_ResourceLoader.cpp \
+    lua/lua_ResourceRequest.cpp \
+    lua/lua_ResourceRequestListener.cpp \
     lua/lua_Scene.cpp \
     lua/lua_SceneDebugFlags.cpp \
     lua/lua_ScreenDisplayer.cpp \
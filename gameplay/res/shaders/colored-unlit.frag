@@ -15,6 +15,9 @@ uniform float u_modulateAlpha;              // Modulation alpha
 #endif
 
 // Varyings
+#if defined(INSTANCED)
+varying vec4 v_instanceColor;				// Instance color
+#endif
 #if defined(VERTEX_COLOR)
 varying vec3 v_color;						// Input Vertex color ( r g b )
 #endif
@@ -35,6 +38,10 @@ void main()
 	vec4 lightColor = texture2D(u_lightmapTexture, v_texCoord);
 	gl_FragColor.rgb *= lightColor.rgb;
 	#endif
+	// Instance color
+	#if defined(INSTANCED)
+	gl_FragColor *= v_instanceColor;
+	#endif
 	// Global color modulation
 	#if defined(MODULATE_COLOR)
 	gl_FragColor *= u_modulateColor;
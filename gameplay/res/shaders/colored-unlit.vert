@@ -3,6 +3,10 @@ attribute vec4 a_position;									// Vertex Position							(x, y, z, w)
 #if defined(TEXTURE_LIGHTMAP)
 attribute vec2 a_texCoord;                                  // Texture Coordinate (for lightmapping)
 #endif
+#if defined(INSTANCED)
+attribute mat4 a_instanceMatrix;							// Instance world matrix
+attribute vec4 a_instanceColor;								// Instance color							(r, g, b, a)
+#endif
 #if defined(SKINNING)
 attribute vec4 a_blendWeights;								// Vertex blend weight, up to 4				(0, 1, 2, 3) 
 attribute vec4 a_blendIndices;								// Vertex blend index int u_matrixPalette	(0, 1, 2, 3)
@@ -12,12 +16,19 @@ attribute vec3 a_color;										// Vertex Color								(r, g, b)
 #endif
 
 // Uniforms
+#if defined(INSTANCED)
+uniform mat4 u_viewProjectionMatrix;						// Matrix to transform a world position to clip space.
+#else
 uniform mat4 u_worldViewProjectionMatrix;					// Matrix to transform a position to clip space.
+#endif
 #if defined(SKINNING)
 uniform vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 3];		// Array of 4x3 matrices as an array of floats
 #endif
 
 // Varyings
+#if defined(INSTANCED)
+varying vec4 v_instanceColor;								// Output Instance color					(r, g, b, a)
+#endif
 #if defined(TEXTURE_LIGHTMAP)
 varying vec2 v_texCoord;                                    // Output Texture Coordinate
 #endif
@@ -39,7 +50,12 @@ void main()
     vec4 position = getPosition();
     
     // Transform position to clip space.a
+    #if defined(INSTANCED)
+    gl_Position = u_viewProjectionMatrix * (a_instanceMatrix * position);
+    v_instanceColor = a_instanceColor;
+    #else
     gl_Position = u_worldViewProjectionMatrix *  position;
+    #endif
     
     // Pass lightmap tex coord to fragment shader
     #if defined(TEXTURE_LIGHTMAP)
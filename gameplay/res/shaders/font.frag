@@ -1,4 +1,7 @@
 #ifdef OPENGL_ES
+#ifdef DISTANCE_FIELD
+#extension GL_OES_standard_derivatives : enable
+#endif
 precision highp float;
 #endif
 
@@ -13,5 +16,13 @@ varying vec4 v_color;
 void main()
 {
     gl_FragColor = v_color;
+#ifdef DISTANCE_FIELD
+    // The texture holds the distance to the nearest glyph edge, which is at 0.5.
+    // Smooth the edge over about one screen pixel, whatever the size the text is drawn at.
+    float distance = texture2D(u_texture, v_texCoord).a;
+    float smoothing = max(0.5 * fwidth(distance), 0.001);
+    gl_FragColor.a = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance) * v_color.a;
+#else
     gl_FragColor.a = texture2D(u_texture, v_texCoord).a * v_color.a;
+#endif
 }
\ No newline at end of file
@@ -4,6 +4,9 @@ attribute vec4 a_position;									// Vertex Position							(x, y, z, w)
 attribute vec3 a_normal;									// Vertex Normal							(x, y, z)
 #endif
 attribute vec2 a_texCoord0;
+#ifdef LOD_MORPH
+attribute float a_texCoord1;								// Vertex height in the next coarser LOD
+#endif
 
 // Uniforms
 uniform mat4 u_worldViewProjectionMatrix;					// World view projection matrix
@@ -11,6 +14,11 @@ uniform mat4 u_worldViewProjectionMatrix;					// World view projection matrix
 uniform mat4 u_normalMatrix;					            // Matrix used for normal vector transformation
 #endif
 uniform vec3 u_lightDirection;								// Direction of light
+#ifdef LOD_MORPH
+uniform mat4 u_worldMatrix;									// World matrix
+uniform vec3 u_cameraPosition;								// Camera position in world space
+uniform vec2 u_morphRange;									// Scale and offset of the morph factor over the distance to the camera
+#endif
 
 // Varyings
 #ifndef NORMAL_MAP
@@ -29,8 +37,18 @@ varying vec2 v_texCoordLayer2;
 
 void main()
 {
+    vec4 position = a_position;
+
+#ifdef LOD_MORPH
+    // Morph the height towards the next coarser LOD as the vertex approaches the distance
+    // at which that LOD is used.
+    float distance = length((u_worldMatrix * a_position).xyz - u_cameraPosition);
+    float morph = clamp(distance * u_morphRange.x + u_morphRange.y, 0.0, 1.0);
+    position.y = mix(a_position.y, a_texCoord1, morph);
+#endif
+
     // Transform position to clip space.
-    gl_Position = u_worldViewProjectionMatrix * a_position;
+    gl_Position = u_worldViewProjectionMatrix * position;
 
 #ifndef NORMAL_MAP
     // Pass normal to fragment shader
@@ -15,6 +15,9 @@ uniform float u_modulateAlpha;              // Modulation alpha
 #endif
 
 // Varyings
+#if defined(INSTANCED)
+varying vec4 v_instanceColor;				// Instance color
+#endif
 varying vec2 v_texCoord0;                	// Texture coordinate(u, v)
 #if defined(TEXCOORD1)
 varying vec2 v_texCoord1;                   // Second tex coord for multi-texturing
@@ -37,6 +40,10 @@ void main()
     #endif
     gl_FragColor.rgb *= lightColor.rgb;
     #endif
+    // Instance color
+    #if defined(INSTANCED)
+    gl_FragColor *= v_instanceColor;
+    #endif
     // Global color modulation
     #if defined(MODULATE_COLOR)
     gl_FragColor *= u_modulateColor;
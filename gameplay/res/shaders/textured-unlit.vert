@@ -4,13 +4,21 @@ attribute vec2 a_texCoord0;									// Vertex Texture Coordinate				(u, v)
 #if defined(TEXCOORD1)
 attribute vec2 a_texCoord1;                                 // Second tex coord for multi-texturing
 #endif
+#if defined(INSTANCED)
+attribute mat4 a_instanceMatrix;							// Instance world matrix
+attribute vec4 a_instanceColor;								// Instance color							(r, g, b, a)
+#endif
 #if defined(SKINNING)
 attribute vec4 a_blendWeights;								// Vertex blend weight, up to 4				(0, 1, 2, 3) 
 attribute vec4 a_blendIndices;								// Vertex blend index int u_matrixPalette	(0, 1, 2, 3)
 #endif
 
 // Uniforms
+#if defined(INSTANCED)
+uniform mat4 u_viewProjectionMatrix;						// Matrix to transform a world position to clip space.
+#else
 uniform mat4 u_worldViewProjectionMatrix;					// Matrix to transform a position to clip space
+#endif
 #if defined(SKINNING)
 uniform vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 3];		// Array of 4x3 matrices
 #endif
@@ -22,6 +30,9 @@ uniform vec2 u_textureOffset;								// Texture offset
 #endif
 
 // Varyings
+#if defined(INSTANCED)
+varying vec4 v_instanceColor;								// Output Instance color					(r, g, b, a)
+#endif
 varying vec2 v_texCoord0;									// Texture Coordinate
 #if defined(TEXCOORD1)
 varying vec2 v_texCoord1;                                   // Second tex coord for multi-texturing
@@ -41,7 +52,12 @@ void main()
     vec4 position = getPosition();
 
     // Transform position to clip space.
+    #if defined(INSTANCED)
+    gl_Position = u_viewProjectionMatrix * (a_instanceMatrix * position);
+    v_instanceColor = a_instanceColor;
+    #else
     gl_Position = u_worldViewProjectionMatrix * position;
+    #endif
 
     // Texture transformation.
     v_texCoord0 = a_texCoord0;
@@ -1,5 +1,6 @@
 #include "Base.h"
 #include "AIController.h"
+#include "Profiler.h"
 #include "Game.h"
 
 namespace gameplay
@@ -95,6 +96,8 @@ void AIController::sendMessage(AIMessage* message, float delay)
 
 void AIController::update(float elapsedTime)
 {
+    GP_PROFILE_SCOPE("AIController::update");
+
     if (_paused)
         return;
 
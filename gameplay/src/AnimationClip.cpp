@@ -23,7 +23,10 @@ AnimationClip::AnimationClip(const char* id, Animation* animation, unsigned long
         GP_ASSERT(_animation->_channels[i]);
         GP_ASSERT(_animation->_channels[i]->getCurve());
         _values.push_back(new AnimationValue(_animation->_channels[i]->getCurve()->getComponentCount()));
+        _curves.push_back(_animation->_channels[i]->getCurve());
+        _curveValues.push_back(_values[i]->_value);
     }
+    _cursors.resize(_values.size(), 0);
 }
 
 AnimationClip::~AnimationClip()
@@ -498,25 +501,29 @@ bool AnimationClip::update(float elapsedTime)
         }
     }
     
-    // Evaluate this clip.
+    // Evaluate the curves of all channels in a single pass.
+    size_t channelCount = _animation->_channels.size();
+    GP_ASSERT(channelCount == _values.size());
+    if (channelCount > 0)
+        Curve::evaluateBatch(&_curves[0], (unsigned int)channelCount, percentComplete, &_curveValues[0], &_cursors[0]);
+
+    // Set the animation values on the target properties. Transform values are queued on the controller,
+    // which blends them into their transforms in one pass after all running clips have been updated.
+    GP_ASSERT(_animation->_controller);
     Animation::Channel* channel = NULL;
-    AnimationValue* value = NULL;
     AnimationTarget* target = NULL;
-    size_t channelCount = _animation->_channels.size();
     for (size_t i = 0; i < channelCount; i++)
     {
         channel = _animation->_channels[i];
         GP_ASSERT(channel);
         target = channel->_target;
         GP_ASSERT(target);
-        value = _values[i];
-        GP_ASSERT(value);
+        GP_ASSERT(_values[i]);
 
-        // Evaluate the point on Curve
-        GP_ASSERT(channel->getCurve());
-        channel->getCurve()->evaluate(percentComplete, value->_value);
-        // Set the animation value on the target property.
-        target->setAnimationPropertyValue(channel->_propertyId, value, _blendWeight);
+        if (target->_targetType == AnimationTarget::TRANSFORM)
+            _animation->_controller->queueTransformValue(static_cast<Transform*>(target), channel->_propertyId, _values[i]->_value, _blendWeight);
+        else
+            target->setAnimationPropertyValue(channel->_propertyId, _values[i], _blendWeight);
     }
 
     // When ended. Probably should move to it's own method so we can call it when the clip is ended early.
@@ -615,6 +622,11 @@ AnimationClip* AnimationClip::clone(Animation* animation) const
             *newClip->_values[i] = *_values[i];
         }
     }
+    for (size_t i = 0; i < size; ++i)
+    {
+        newClip->_curveValues[i] = newClip->_values[i]->_value;
+    }
+    newClip->_cursors.resize(size, 0);
     return newClip;
 }
 
@@ -401,6 +401,9 @@ private:
     unsigned long _crossFadeOutDuration;                // The duration of the cross fade.
     float _blendWeight;                                 // The clip's blendweight.
     std::vector<AnimationValue*> _values;               // AnimationValue holder.
+    std::vector<const Curve*> _curves;                  // The curve of each channel.
+    std::vector<float*> _curveValues;                   // The value each channel's curve is evaluated into.
+    std::vector<unsigned int> _cursors;                 // Keyframe cursor for each channel's curve.
     std::vector<Listener*>* _beginListeners;            // Collection of begin listeners on the clip.
     std::vector<Listener*>* _endListeners;              // Collection of end listeners on the clip.
     std::list<ListenerEvent*>* _listeners;              // Ordered collection of listeners on the clip.
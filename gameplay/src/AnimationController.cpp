@@ -1,5 +1,7 @@
 #include "Base.h"
 #include "AnimationController.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include "Game.h"
 #include "Curve.h"
 
@@ -7,7 +9,7 @@ namespace gameplay
 {
 
 AnimationController::AnimationController()
-    : _state(STOPPED)
+    : _state(STOPPED), _updating(false)
 {
 }
 
@@ -17,13 +19,11 @@ AnimationController::~AnimationController()
 
 void AnimationController::stopAllAnimations() 
 {
-    std::list<AnimationClip*>::iterator clipIter = _runningClips.begin();
-    while (clipIter != _runningClips.end())
+    for (size_t i = 0, count = _runningClips.size(); i < count; i++)
     {
-        AnimationClip* clip = *clipIter;
-        GP_ASSERT(clip);
-        clip->stop();
-        clipIter++;
+        AnimationClip* clip = _runningClips[i];
+        if (clip)
+            clip->stop();
     }
 }
 
@@ -39,11 +39,9 @@ void AnimationController::initialize()
 
 void AnimationController::finalize()
 {
-    std::list<AnimationClip*>::iterator itr = _runningClips.begin();
-    for ( ; itr != _runningClips.end(); itr++)
+    for (size_t i = 0, count = _runningClips.size(); i < count; i++)
     {
-        AnimationClip* clip = *itr;
-        SAFE_RELEASE(clip);
+        SAFE_RELEASE(_runningClips[i]);
     }
     _runningClips.clear();
     _state = STOPPED;
@@ -76,17 +74,21 @@ void AnimationController::schedule(AnimationClip* clip)
 
 void AnimationController::unschedule(AnimationClip* clip)
 {
-    std::list<AnimationClip*>::iterator clipItr = _runningClips.begin();
-    while (clipItr != _runningClips.end())
+    std::vector<AnimationClip*>::iterator clipItr = std::find(_runningClips.begin(), _runningClips.end(), clip);
+    if (clipItr != _runningClips.end())
     {
-        AnimationClip* rClip = (*clipItr);
-        if (rClip == clip)
+        // While updating, clear the slot instead so the indices of the clips being updated do not shift,
+        // and release the clip after the update since its values may already be queued.
+        if (_updating)
+        {
+            *clipItr = NULL;
+            _endedClips.push_back(clip);
+        }
+        else
         {
             _runningClips.erase(clipItr);
             SAFE_RELEASE(clip);
-            break;
         }
-        clipItr++;
     }
 
     if (_runningClips.empty())
@@ -95,35 +97,61 @@ void AnimationController::unschedule(AnimationClip* clip)
 
 void AnimationController::update(float elapsedTime)
 {
+    GP_PROFILE_SCOPE("AnimationController::update");
+    GP_MEMORY_SCOPE(CATEGORY_ANIMATION);
+
     if (_state != RUNNING)
         return;
     
     Transform::suspendTransformChanged();
 
-    // Loop through running clips and call update() on them.
-    std::list<AnimationClip*>::iterator clipIter = _runningClips.begin();
-    while (clipIter != _runningClips.end())
+    // Loop through running clips and call update() on them, compacting the array as clips are removed.
+    // Clips appended while updating (restarted here or scheduled by listeners) are updated in this same pass.
+    _updating = true;
+    size_t runningCount = 0;
+    for (size_t i = 0; i < _runningClips.size(); i++)
     {
-        AnimationClip* clip = (*clipIter);
-        GP_ASSERT(clip);
+        AnimationClip* clip = _runningClips[i];
+        _runningClips[i] = NULL;
+        if (clip == NULL)
+            continue;
+
         if (clip->isClipStateBitSet(AnimationClip::CLIP_IS_RESTARTED_BIT))
         {   // If the CLIP_IS_RESTARTED_BIT is set, we should end the clip and 
-            // move it from where it is in the running clips list to the back.
+            // move it from where it is in the running clips to the back.
             clip->onEnd();
             clip->setClipStateBit(AnimationClip::CLIP_IS_PLAYING_BIT);
             _runningClips.push_back(clip);
-            clipIter = _runningClips.erase(clipIter);
         }
         else if (clip->update(elapsedTime))
         {
-            SAFE_RELEASE(clip);
-            clipIter = _runningClips.erase(clipIter);
+            // The clip's values may still be queued, so release it once they have been applied.
+            _endedClips.push_back(clip);
         }
         else
         {
-            clipIter++;
+            _runningClips[runningCount++] = clip;
         }
     }
+    _runningClips.resize(runningCount);
+    _runningClips.erase(std::remove(_runningClips.begin(), _runningClips.end(), (AnimationClip*)NULL), _runningClips.end());
+    _updating = false;
+
+    // Blend the queued transform values in one pass.
+    if (!_blendTargets.empty())
+    {
+        Transform::applyAnimationValues(&_blendTargets[0], &_blendPropertyIds[0], &_blendValues[0], &_blendWeights[0], _blendTargets.size());
+        _blendTargets.clear();
+        _blendPropertyIds.clear();
+        _blendValues.clear();
+        _blendWeights.clear();
+    }
+
+    for (size_t i = 0, count = _endedClips.size(); i < count; i++)
+    {
+        SAFE_RELEASE(_endedClips[i]);
+    }
+    _endedClips.clear();
 
     Transform::resumeTransformChanged();
 
@@ -131,4 +159,15 @@ void AnimationController::update(float elapsedTime)
         _state = IDLE;
 }
 
+void AnimationController::queueTransformValue(Transform* target, int propertyId, const float* value, float blendWeight)
+{
+    GP_ASSERT(target);
+    GP_ASSERT(value);
+
+    _blendTargets.push_back(target);
+    _blendPropertyIds.push_back(propertyId);
+    _blendValues.push_back(value);
+    _blendWeights.push_back(blendWeight);
+}
+
 }
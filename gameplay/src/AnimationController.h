@@ -9,8 +9,15 @@
 namespace gameplay
 {
 
+class Transform;
+
 /**
  * Defines a class for controlling game animation.
+ *
+ * Running clips are kept in a contiguous array and updated in order. Channels that target a
+ * Transform are not applied as each clip is evaluated; their values are collected into a flat
+ * array and blended into the transforms in one pass once every clip has been updated, followed
+ * by a single pass that marks the animated transforms dirty.
  */
 class AnimationController
 {
@@ -95,9 +102,25 @@ private:
      * Callback for when the controller receives a frame update event.
      */
     void update(float elapsedTime);
+
+    /**
+     * Queues an evaluated channel value to be blended into a transform at the end of the update.
+     *
+     * @param target The transform to blend the value into.
+     * @param propertyId The animated property.
+     * @param value The evaluated value, which must remain valid until the end of the update.
+     * @param blendWeight The blend weight of the clip the value was evaluated for.
+     */
+    void queueTransformValue(Transform* target, int propertyId, const float* value, float blendWeight);
     
     State _state;                                 // The current state of the AnimationController.
-    std::list<AnimationClip*> _runningClips;      // A list of running AnimationClips.
+    std::vector<AnimationClip*> _runningClips;    // The running AnimationClips, in update order.
+    std::vector<AnimationClip*> _endedClips;      // Clips that ended during the update, released once their values are applied.
+    std::vector<Transform*> _blendTargets;        // The target of each queued transform value.
+    std::vector<int> _blendPropertyIds;           // The animated property of each queued transform value.
+    std::vector<const float*> _blendValues;       // The queued transform values.
+    std::vector<float> _blendWeights;             // The blend weight of each queued transform value.
+    bool _updating;                               // Whether the running clips are being updated.
 };
 
 }
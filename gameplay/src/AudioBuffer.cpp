@@ -63,16 +63,13 @@ AudioBuffer::~AudioBuffer()
     }
 }
 
-AudioBuffer* AudioBuffer::create(const char* path)
+AudioBuffer* AudioBuffer::findCached(const char* path)
 {
-    GP_ASSERT(path);
-
     // Search the cache for a stream from this file.
     unsigned int bufferCount = (unsigned int)__buffers.size();
-    AudioBuffer* buffer = NULL;
     for (unsigned int i = 0; i < bufferCount; i++)
     {
-        buffer = __buffers[i];
+        AudioBuffer* buffer = __buffers[i];
         GP_ASSERT(buffer);
         if (buffer->_filePath.compare(path) == 0)
         {
@@ -80,6 +77,32 @@ AudioBuffer* AudioBuffer::create(const char* path)
             return buffer;
         }
     }
+    return NULL;
+}
+
+AudioBuffer* AudioBuffer::create(const char* path)
+{
+    GP_ASSERT(path);
+
+    AudioBuffer* buffer = findCached(path);
+    if (buffer)
+        return buffer;
+
+    PCM pcm;
+    if (!decode(path, &pcm))
+        return NULL;
+
+    return create(path, pcm);
+}
+
+AudioBuffer* AudioBuffer::create(const char* path, const PCM& pcm)
+{
+    GP_ASSERT(path);
+    GP_ASSERT(pcm.data);
+
+    AudioBuffer* buffer = findCached(path);
+    if (buffer)
+        return buffer;
 
     ALuint alBuffer;
 
@@ -91,13 +114,28 @@ AudioBuffer* AudioBuffer::create(const char* path)
         AL_CHECK( alDeleteBuffers(1, &alBuffer) );
         return NULL;
     }
-    
+
+    AL_CHECK( alBufferData(alBuffer, pcm.format, pcm.data, pcm.size, pcm.frequency) );
+
+    buffer = new AudioBuffer(path, alBuffer);
+
+    // Add the buffer to the cache.
+    __buffers.push_back(buffer);
+
+    return buffer;
+}
+
+bool AudioBuffer::decode(const char* path, PCM* pcm)
+{
+    GP_ASSERT(path);
+    GP_ASSERT(pcm);
+
     // Load sound file.
     std::auto_ptr<Stream> stream(FileSystem::open(path));
     if (stream.get() == NULL || !stream->canRead())
     {
         GP_ERROR("Failed to load audio file %s.", path);
-        goto cleanup;
+        return false;
     }
     
     // Read the file header
@@ -105,48 +143,39 @@ AudioBuffer* AudioBuffer::create(const char* path)
     if (stream->read(header, 1, 12) != 12)
     {
         GP_ERROR("Invalid header for audio file %s.", path);
-        goto cleanup;
+        return false;
     }
     
     // Check the file format
     if (memcmp(header, "RIFF", 4) == 0)
     {
-        if (!AudioBuffer::loadWav(stream.get(), alBuffer))
+        if (!AudioBuffer::loadWav(stream.get(), pcm))
         {
             GP_ERROR("Invalid wave file: %s", path);
-            goto cleanup;
+            return false;
         }
     }
     else if (memcmp(header, "OggS", 4) == 0)
     {
-        if (!AudioBuffer::loadOgg(stream.get(), alBuffer))
+        if (!AudioBuffer::loadOgg(stream.get(), pcm))
         {
             GP_ERROR("Invalid ogg file: %s", path);
-            goto cleanup;
+            return false;
         }
     }
     else
     {
         GP_ERROR("Unsupported audio file: %s", path);
-        goto cleanup;
+        return false;
     }
 
-    buffer = new AudioBuffer(path, alBuffer);
-
-    // Add the buffer to the cache.
-    __buffers.push_back(buffer);
-
-    return buffer;
-    
-cleanup:
-    if (alBuffer)
-        AL_CHECK( alDeleteBuffers(1, &alBuffer) );
-    return NULL;
+    return true;
 }
 
-bool AudioBuffer::loadWav(Stream* stream, ALuint buffer)
+bool AudioBuffer::loadWav(Stream* stream, PCM* pcm)
 {
     GP_ASSERT(stream);
+    GP_ASSERT(pcm);
 
     unsigned char data[12];
     
@@ -283,8 +312,10 @@ bool AudioBuffer::loadWav(Stream* stream, ALuint buffer)
                 return false;
             }
 
-            AL_CHECK( alBufferData(buffer, format, data, dataSize, frequency) );
-            SAFE_DELETE_ARRAY(data);
+            pcm->format = format;
+            pcm->frequency = frequency;
+            pcm->data = data;
+            pcm->size = dataSize;
 
             // We've read the data, so return now.
             return true;
@@ -329,9 +360,10 @@ bool AudioBuffer::loadWav(Stream* stream, ALuint buffer)
     }
 }
 
-bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer)
+bool AudioBuffer::loadOgg(Stream* stream, PCM* pcm)
 {
     GP_ASSERT(stream);
+    GP_ASSERT(pcm);
 
     OggVorbis_File ogg_file;
     vorbis_info* info;
@@ -391,12 +423,24 @@ bool AudioBuffer::loadOgg(Stream* stream, ALuint buffer)
         return false;
     }
 
-    AL_CHECK( alBufferData(buffer, format, data, data_size, info->rate) );
+    pcm->format = format;
+    pcm->frequency = info->rate;
+    pcm->data = data;
+    pcm->size = data_size;
 
-    SAFE_DELETE_ARRAY(data);
     ov_clear(&ogg_file);
 
     return true;
 }
 
+AudioBuffer::PCM::PCM()
+    : format(0), frequency(0), data(NULL), size(0)
+{
+}
+
+AudioBuffer::PCM::~PCM()
+{
+    SAFE_DELETE_ARRAY(data);
+}
+
 }
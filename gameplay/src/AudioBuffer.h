@@ -17,8 +17,28 @@ class AudioSource;
 class AudioBuffer : public Ref
 {
     friend class AudioSource;
+    friend class ResourceRequest;
 
 private:
+
+    /**
+     * Decoded PCM audio data, ready to be copied into an OpenAL buffer.
+     */
+    struct PCM
+    {
+        PCM();
+        ~PCM();
+
+        ALenum format;
+        ALsizei frequency;
+        char* data;
+        ALsizei size;
+
+    private:
+
+        PCM(const PCM& copy);
+        PCM& operator=(const PCM&);
+    };
     
     /**
      * Constructor.
@@ -43,10 +63,41 @@ private:
      * @return The buffer from a file.
      */
     static AudioBuffer* create(const char* path);
+
+    /**
+     * Finds the cached audio buffer for a file.
+     *
+     * @param path The path to the audio file.
+     *
+     * @return The buffer with an added reference, or NULL if it is not cached.
+     */
+    static AudioBuffer* findCached(const char* path);
+
+    /**
+     * Creates an audio buffer from audio data that has already been decoded.
+     *
+     * If a buffer for the path is already cached it is returned instead and the data is not used.
+     *
+     * @param path The path of the audio file the data was decoded from.
+     * @param pcm The decoded audio data.
+     *
+     * @return The buffer.
+     */
+    static AudioBuffer* create(const char* path, const PCM& pcm);
+
+    /**
+     * Reads and decodes an audio file. This does not use OpenAL, so it can be called from any thread.
+     *
+     * @param path The path to the audio file.
+     * @param pcm The decoded audio data.
+     *
+     * @return true if the file was decoded successfully; false otherwise.
+     */
+    static bool decode(const char* path, PCM* pcm);
     
-    static bool loadWav(Stream* stream, ALuint buffer);
+    static bool loadWav(Stream* stream, PCM* pcm);
     
-    static bool loadOgg(Stream* stream, ALuint buffer);
+    static bool loadOgg(Stream* stream, PCM* pcm);
 
     std::string _filePath;
     ALuint _alBuffer;
@@ -1,5 +1,6 @@
 #include "Base.h"
 #include "AudioController.h"
+#include "Profiler.h"
 #include "AudioListener.h"
 #include "AudioBuffer.h"
 #include "AudioSource.h"
@@ -93,6 +94,8 @@ void AudioController::resume()
 
 void AudioController::update(float elapsedTime)
 {
+    GP_PROFILE_SCOPE("AudioController::update");
+
     AudioListener* listener = AudioListener::getInstance();
     if (listener)
     {
@@ -220,10 +220,12 @@ using std::va_list;
     #define GLEW_STATIC
     #include <GL/glew.h>
     #define USE_VAO
+    #define USE_INSTANCING
 #elif __linux__
         #define GLEW_STATIC
         #include <GL/glew.h>
         #define USE_VAO
+        #define USE_INSTANCING
 #elif __APPLE__
     #include "TargetConditionals.h"
     #if TARGET_OS_IPHONE || TARGET_IPHONE_SIMULATOR
@@ -233,10 +235,14 @@ using std::va_list;
         #define glDeleteVertexArrays glDeleteVertexArraysOES
         #define glGenVertexArrays glGenVertexArraysOES
         #define glIsVertexArray glIsVertexArrayOES
+        #define glDrawArraysInstanced glDrawArraysInstancedEXT
+        #define glDrawElementsInstanced glDrawElementsInstancedEXT
+        #define glVertexAttribDivisor glVertexAttribDivisorEXT
         #define GL_DEPTH24_STENCIL8 GL_DEPTH24_STENCIL8_OES
         #define glClearDepth glClearDepthf
         #define OPENGL_ES
         #define USE_VAO
+        #define USE_INSTANCING
         #ifdef __arm__
             #define USE_NEON
         #endif
@@ -247,12 +253,22 @@ using std::va_list;
         #define glDeleteVertexArrays glDeleteVertexArraysAPPLE
         #define glGenVertexArrays glGenVertexArraysAPPLE
         #define glIsVertexArray glIsVertexArrayAPPLE
+        #define glDrawArraysInstanced glDrawArraysInstancedARB
+        #define glDrawElementsInstanced glDrawElementsInstancedARB
+        #define glVertexAttribDivisor glVertexAttribDivisorARB
         #define USE_VAO
+        #define USE_INSTANCING
     #else
         #error "Unsupported Apple Device"
     #endif
 #endif
 
+// SIMD (SSE) on x86 targets. ARM targets select USE_NEON above.
+// The math kernels additionally use AVX when the compiler targets it (see GAMEPLAY_SIMD in CMakeLists.txt).
+#if !defined(USE_NEON) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define USE_SSE
+#endif
+
 // Graphics (GLSL)
 #define VERTEX_ATTRIBUTE_POSITION_NAME              "a_position"
 #define VERTEX_ATTRIBUTE_NORMAL_NAME                "a_normal"
@@ -262,6 +278,8 @@ using std::va_list;
 #define VERTEX_ATTRIBUTE_BLENDWEIGHTS_NAME          "a_blendWeights"
 #define VERTEX_ATTRIBUTE_BLENDINDICES_NAME          "a_blendIndices"
 #define VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME       "a_texCoord"
+#define VERTEX_ATTRIBUTE_INSTANCE_MATRIX_NAME       "a_instanceMatrix"
+#define VERTEX_ATTRIBUTE_INSTANCE_COLOR_NAME        "a_instanceColor"
 
 // Hardware buffer
 namespace gameplay
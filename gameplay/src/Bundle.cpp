@@ -1,12 +1,16 @@
 #include "Base.h"
 #include "Bundle.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include "FileSystem.h"
 #include "MeshPart.h"
 #include "Scene.h"
 #include "Joint.h"
 
-#define BUNDLE_VERSION_MAJOR            1
-#define BUNDLE_VERSION_MINOR            2
+#define BUNDLE_VERSION_MAJOR                1
+#define BUNDLE_VERSION_MINOR                4
+#define BUNDLE_VERSION_MINOR_NO_FONT_FORMAT 3
+#define BUNDLE_VERSION_MINOR_NO_INDEX       2
 
 #define BUNDLE_TYPE_SCENE               1
 #define BUNDLE_TYPE_NODE                2
@@ -26,19 +30,39 @@
 // For sanity checking string reads
 #define BUNDLE_MAX_STRING_LENGTH        5000
 
+// For sanity checking the size of the reference hash index, relative to the reference count
+#define BUNDLE_MAX_BUCKETS_PER_REFERENCE 8
+
 namespace gameplay
 {
 
 static std::vector<Bundle*> __bundleCache;
 
+/**
+ * Hashes a reference ID for the reference table index (32-bit FNV-1a, matching gameplay-encoder).
+ */
+static unsigned int hashReferenceId(const char* id)
+{
+    unsigned int hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)id; *c; ++c)
+    {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 Bundle::Bundle(const char* path) :
-    _path(path), _referenceCount(0), _references(NULL), _stream(NULL), _trackedNodes(NULL)
+    _path(path), _referenceCount(0), _references(NULL), _referenceBucketCount(0), _referenceBuckets(NULL), _stream(NULL), _trackedNodes(NULL)
 {
+    _version[0] = 0;
+    _version[1] = 0;
 }
 
 Bundle::~Bundle()
 {
     clearLoadSession();
+    clearPreloadedMeshes();
 
     // Remove this Bundle from the cache.
     std::vector<Bundle*>::iterator itr = std::find(__bundleCache.begin(), __bundleCache.end(), this);
@@ -48,6 +72,7 @@ Bundle::~Bundle()
     }
 
     SAFE_DELETE_ARRAY(_references);
+    SAFE_DELETE_ARRAY(_referenceBuckets);
 
     if (_stream)
     {
@@ -127,6 +152,44 @@ bool Bundle::readArray(unsigned int* length, std::vector<T>* values, unsigned in
     return true;
 }
 
+template <class T>
+bool Bundle::readArray(unsigned int* length, std::vector<T>* values, const T** ptr)
+{
+    GP_ASSERT(length);
+    GP_ASSERT(values);
+    GP_ASSERT(ptr);
+    GP_ASSERT(_stream);
+
+    *ptr = NULL;
+    if (!read(length))
+    {
+        GP_ERROR("Failed to read the length of an array of data (to be mapped).");
+        return false;
+    }
+    if (*length > 0)
+    {
+        const void* data = _stream->map(sizeof(T) * *length);
+        if (data && ((size_t)data % sizeof(T)) == 0)
+        {
+            *ptr = (const T*)data;
+            return true;
+        }
+
+        values->resize(*length);
+        if (data)
+        {
+            memcpy(&(*values)[0], data, sizeof(T) * *length);
+        }
+        else if (_stream->read(&(*values)[0], sizeof(T), *length) != *length)
+        {
+            GP_ERROR("Failed to read an array of data from bundle (to be mapped).");
+            return false;
+        }
+        *ptr = &(*values)[0];
+    }
+    return true;
+}
+
 static std::string readString(Stream* stream)
 {
     GP_ASSERT(stream);
@@ -156,9 +219,26 @@ static std::string readString(Stream* stream)
 
 Bundle* Bundle::create(const char* path)
 {
+    GP_PROFILE_SCOPE("Bundle::create");
+
     GP_ASSERT(path);
 
     // Search the cache for this bundle.
+    Bundle* bundle = findCached(path);
+    if (bundle)
+        return bundle;
+
+    bundle = open(path);
+    if (bundle)
+        __bundleCache.push_back(bundle);
+
+    return bundle;
+}
+
+Bundle* Bundle::findCached(const char* path)
+{
+    GP_ASSERT(path);
+
     for (size_t i = 0, count = __bundleCache.size(); i < count; ++i)
     {
         Bundle* p = __bundleCache[i];
@@ -170,9 +250,31 @@ Bundle* Bundle::create(const char* path)
             return p;
         }
     }
+    return NULL;
+}
+
+Bundle* Bundle::addToCache(Bundle* bundle)
+{
+    GP_ASSERT(bundle);
+
+    // Another bundle may have been opened from the same path in the meantime.
+    Bundle* cached = findCached(bundle->_path.c_str());
+    if (cached)
+    {
+        SAFE_RELEASE(bundle);
+        return cached;
+    }
+
+    __bundleCache.push_back(bundle);
+    return bundle;
+}
+
+Bundle* Bundle::open(const char* path)
+{
+    GP_ASSERT(path);
 
-    // Open the bundle.
-    Stream* stream = FileSystem::open(path);
+    // Open the bundle, memory mapped where supported so that mesh and animation data can be used in place.
+    Stream* stream = FileSystem::open(path, FileSystem::READ | FileSystem::MAPPED);
     if (!stream)
     {
         GP_ERROR("Failed to open file '%s'.", path);
@@ -196,7 +298,7 @@ Bundle* Bundle::create(const char* path)
         GP_ERROR("Failed to read GPB version for bundle '%s'.", path);
         return NULL;
     }
-    if (ver[0] != BUNDLE_VERSION_MAJOR || ver[1] != BUNDLE_VERSION_MINOR)
+    if (ver[0] != BUNDLE_VERSION_MAJOR || ver[1] < BUNDLE_VERSION_MINOR_NO_INDEX || ver[1] > BUNDLE_VERSION_MINOR)
     {
         SAFE_DELETE(stream);
         GP_ERROR("Unsupported version (%d.%d) for bundle '%s' (expected %d.%d).", (int)ver[0], (int)ver[1], path, BUNDLE_VERSION_MAJOR, BUNDLE_VERSION_MINOR);
@@ -227,27 +329,113 @@ Bundle* Bundle::create(const char* path)
         }
     }
 
-    // Keep file open for faster reading later.
     Bundle* bundle = new Bundle(path);
+    bundle->_version[0] = ver[0];
+    bundle->_version[1] = ver[1];
     bundle->_referenceCount = refCount;
     bundle->_references = refs;
+
+    // Read the ref table hash index, or build one if the bundle does not have it.
+    if (ver[1] > BUNDLE_VERSION_MINOR_NO_INDEX && !bundle->readReferenceIndex(stream))
+    {
+        SAFE_DELETE(stream);
+        GP_ERROR("Failed to read ref table index for bundle '%s'.", path);
+        SAFE_RELEASE(bundle);
+        return NULL;
+    }
+    if (bundle->_referenceBuckets == NULL)
+        bundle->buildReferenceIndex();
+
+    // Keep file open for faster reading later.
     bundle->_stream = stream;
 
     return bundle;
 }
 
+bool Bundle::readReferenceIndex(Stream* stream)
+{
+    GP_ASSERT(stream);
+
+    unsigned int bucketCount;
+    if (stream->read(&bucketCount, 4, 1) != 1)
+        return false;
+
+    // A bucket count of zero means the bundle was written without an index.
+    if (bucketCount == 0)
+        return true;
+
+    unsigned int* buckets = new unsigned int[bucketCount];
+    if (stream->read(buckets, 4, bucketCount) != bucketCount)
+    {
+        SAFE_DELETE_ARRAY(buckets);
+        return false;
+    }
+
+    // The bucket count must be a power of two with at least one empty bucket, and every
+    // bucket must be empty (zero) or hold a ref table index plus one. A corrupt index may
+    // repeat indices to fill every bucket, so the empty buckets are counted as well; find()
+    // relies on reaching an empty bucket to end its probe.
+    bool valid = (bucketCount & (bucketCount - 1)) == 0 && bucketCount > _referenceCount &&
+        bucketCount / BUNDLE_MAX_BUCKETS_PER_REFERENCE <= _referenceCount;
+    unsigned int emptyCount = 0;
+    for (unsigned int i = 0; valid && i < bucketCount; ++i)
+    {
+        if (buckets[i] > _referenceCount)
+            valid = false;
+        else if (buckets[i] == 0)
+            ++emptyCount;
+    }
+    if (emptyCount == 0)
+        valid = false;
+    if (!valid)
+    {
+        GP_WARN("Ignoring invalid ref table index in bundle '%s'.", _path.c_str());
+        SAFE_DELETE_ARRAY(buckets);
+        return true;
+    }
+
+    _referenceBucketCount = bucketCount;
+    _referenceBuckets = buckets;
+    return true;
+}
+
+void Bundle::buildReferenceIndex()
+{
+    // Use the smallest power of two at least twice the reference count, to keep the probe sequences short.
+    unsigned int bucketCount = 1;
+    while (bucketCount < _referenceCount * 2)
+        bucketCount <<= 1;
+
+    _referenceBucketCount = bucketCount;
+    _referenceBuckets = new unsigned int[bucketCount];
+    memset(_referenceBuckets, 0, sizeof(unsigned int) * bucketCount);
+
+    // Insert in ref table order with linear probing, so the first of any duplicate IDs is found first.
+    unsigned int mask = bucketCount - 1;
+    for (unsigned int i = 0; i < _referenceCount; ++i)
+    {
+        unsigned int bucket = hashReferenceId(_references[i].id.c_str()) & mask;
+        while (_referenceBuckets[bucket] != 0)
+            bucket = (bucket + 1) & mask;
+        _referenceBuckets[bucket] = i + 1;
+    }
+}
+
 Bundle::Reference* Bundle::find(const char* id) const
 {
     GP_ASSERT(id);
     GP_ASSERT(_references);
+    GP_ASSERT(_referenceBuckets);
 
-    // Search the ref table for the given id (case-sensitive).
-    for (unsigned int i = 0; i < _referenceCount; ++i)
+    // Probe the ref table index for the given id (case-sensitive). There is always an empty bucket to stop at.
+    unsigned int mask = _referenceBucketCount - 1;
+    for (unsigned int bucket = hashReferenceId(id) & mask; _referenceBuckets[bucket] != 0; bucket = (bucket + 1) & mask)
     {
-        if (_references[i].id == id)
+        Reference* ref = &_references[_referenceBuckets[bucket] - 1];
+        if (ref->id == id)
         {
             // Found a match
-            return &_references[i];
+            return ref;
         }
     }
 
@@ -356,6 +544,8 @@ bool Bundle::readMatrix(float* m)
 
 Scene* Bundle::loadScene(const char* id)
 {
+    GP_PROFILE_SCOPE("Bundle::loadScene");
+
     clearLoadSession();
 
     Reference* ref = NULL;
@@ -464,6 +654,8 @@ Node* Bundle::loadNode(const char* id)
 
 Node* Bundle::loadNode(const char* id, Scene* sceneContext)
 {
+    GP_PROFILE_SCOPE("Bundle::loadNode");
+
     GP_ASSERT(id);
     GP_ASSERT(_references);
     GP_ASSERT(_stream);
@@ -957,6 +1149,14 @@ Model* Bundle::readModel(const char* nodeId)
                 if (skin)
                 {
                     model->setSkin(skin);
+
+                    // Skins with more joints than the matrix palette uniform can hold are
+                    // applied on the CPU, to a copy of the vertices in the bind pose.
+                    if (skin->getJointCount() > MeshSkin::getMaxGpuJointCount())
+                    {
+                        GP_WARN("Mesh skin of mesh '%s' has more joints than the GPU supports (%d > %d); it will be skinned on the CPU.", xref.c_str() + 1, skin->getJointCount(), MeshSkin::getMaxGpuJointCount());
+                        readCpuSkinningData(xref.c_str() + 1, skin);
+                    }
                 }
             }
             // Read material.
@@ -1051,6 +1251,47 @@ MeshSkin* Bundle::readMeshSkin()
     return meshSkin;
 }
 
+bool Bundle::readCpuSkinningData(const char* meshId, MeshSkin* skin)
+{
+    GP_ASSERT(meshId);
+    GP_ASSERT(skin);
+
+    // Save the file position.
+    long position = _stream->position();
+    if (position == -1L)
+    {
+        GP_ERROR("Failed to save the current file position before reading the vertices of mesh '%s'.", meshId);
+        return false;
+    }
+
+    bool result = false;
+    if (seekTo(meshId, BUNDLE_TYPE_MESH))
+    {
+        // The vertices are copied, since the skin keeps them after the bundle is released.
+        MeshData* meshData = readMeshData(false);
+        if (meshData)
+        {
+            skin->setCpuSkinningData(meshData->vertexData);
+            meshData->vertexData = NULL;
+            SAFE_DELETE(meshData);
+            result = true;
+        }
+    }
+    if (!result)
+    {
+        GP_ERROR("Failed to read the vertices of mesh '%s' for skinning on the CPU.", meshId);
+    }
+
+    // Restore file pointer.
+    if (_stream->seek(position, SEEK_SET) == false)
+    {
+        GP_ERROR("Failed to restore file pointer after reading the vertices of mesh '%s'.", meshId);
+        return false;
+    }
+
+    return result;
+}
+
 void Bundle::resolveJointReferences(Scene* sceneContext, Node* nodeContext)
 {
     GP_ASSERT(_stream);
@@ -1166,6 +1407,8 @@ void Bundle::resolveJointReferences(Scene* sceneContext, Node* nodeContext)
 
 void Bundle::readAnimation(Scene* scene)
 {
+    GP_MEMORY_SCOPE(CATEGORY_ANIMATION);
+
     const std::string animationId = readString(_stream);
 
     // Read the number of animation channels in this animation.
@@ -1185,6 +1428,8 @@ void Bundle::readAnimation(Scene* scene)
 
 void Bundle::readAnimations(Scene* scene)
 {
+    GP_MEMORY_SCOPE(CATEGORY_ANIMATION);
+
     // Read the number of animations in this object.
     unsigned int animationCount;
     if (!read(&animationCount))
@@ -1245,6 +1490,12 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
     std::vector<float> tangentsOut;
     std::vector<unsigned int> interpolation;
 
+    // Pointers to the key times, values and tangents, either in the vectors or in the bundle's memory mapping.
+    const unsigned int* keyTimesData;
+    const float* valuesData;
+    const float* tangentsInData;
+    const float* tangentsOutData;
+
     // Length of the arrays.
     unsigned int keyTimesCount;
     unsigned int valuesCount;
@@ -1253,28 +1504,28 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
     unsigned int interpolationCount;
 
     // Read key times.
-    if (!readArray(&keyTimesCount, &keyTimes, sizeof(unsigned int)))
+    if (!readArray(&keyTimesCount, &keyTimes, &keyTimesData))
     {
         GP_ERROR("Failed to read key times for animation '%s'.", id);
         return NULL;
     }
 
     // Read key values.
-    if (!readArray(&valuesCount, &values))
+    if (!readArray(&valuesCount, &values, &valuesData))
     {
         GP_ERROR("Failed to read key values for animation '%s'.", id);
         return NULL;
     }
 
     // Read in-tangents.
-    if (!readArray(&tangentsInCount, &tangentsIn))
+    if (!readArray(&tangentsInCount, &tangentsIn, &tangentsInData))
     {
         GP_ERROR("Failed to read in tangents for animation '%s'.", id);
         return NULL;
     }
 
     // Read out-tangents.
-    if (!readArray(&tangentsOutCount, &tangentsOut))
+    if (!readArray(&tangentsOutCount, &tangentsOut, &tangentsOutData))
     {
         GP_ERROR("Failed to read out tangents for animation '%s'.", id);
         return NULL;
@@ -1290,15 +1541,19 @@ Animation* Bundle::readAnimationChannelData(Animation* animation, const char* id
     if (targetAttribute > 0)
     {
         GP_ASSERT(target);
-        GP_ASSERT(keyTimes.size() > 0 && values.size() > 0);
+        GP_ASSERT(keyTimesCount > 0 && valuesCount > 0);
+
+        // The key times and values are only read from (and copied into the animation curve).
+        unsigned int* keyTimesPtr = const_cast<unsigned int*>(keyTimesData);
+        float* valuesPtr = const_cast<float*>(valuesData);
         if (animation == NULL)
         {
             // TODO: This code currently assumes LINEAR only.
-            animation = target->createAnimation(id, targetAttribute, keyTimesCount, &keyTimes[0], &values[0], Curve::LINEAR);
+            animation = target->createAnimation(id, targetAttribute, keyTimesCount, keyTimesPtr, valuesPtr, Curve::LINEAR);
         }
         else
         {
-            animation->createChannel(target, targetAttribute, keyTimesCount, &keyTimes[0], &values[0], Curve::LINEAR);
+            animation->createChannel(target, targetAttribute, keyTimesCount, keyTimesPtr, valuesPtr, Curve::LINEAR);
         }
     }
 
@@ -1312,9 +1567,21 @@ Mesh* Bundle::loadMesh(const char* id)
 
 Mesh* Bundle::loadMesh(const char* id, const char* nodeId)
 {
+    GP_PROFILE_SCOPE("Bundle::loadMesh");
+    GP_MEMORY_SCOPE(CATEGORY_MESH);
+
     GP_ASSERT(_stream);
     GP_ASSERT(id);
 
+    // Use the mesh created from preloaded data, if there is one.
+    std::map<std::string, Mesh*>::iterator itr = _preloadedMeshes.find(id);
+    if (itr != _preloadedMeshes.end())
+    {
+        Mesh* mesh = itr->second;
+        _preloadedMeshes.erase(itr);
+        return mesh;
+    }
+
     // Save the file position.
     long position = _stream->position();
     if (position == -1L)
@@ -1331,20 +1598,40 @@ Mesh* Bundle::loadMesh(const char* id, const char* nodeId)
         return NULL;
     }
 
-    // Read mesh data.
-    MeshData* meshData = readMeshData();
+    // Read mesh data, referencing the vertex and index data in place since it is uploaded before the bundle is released.
+    MeshData* meshData = readMeshData(true);
     if (meshData == NULL)
     {
         GP_ERROR("Failed to load mesh data for mesh '%s'.", id);
         return NULL;
     }
 
+    Mesh* mesh = createMesh(id, meshData);
+    SAFE_DELETE(meshData);
+    if (mesh == NULL)
+        return NULL;
+
+    // Restore file pointer.
+    if (_stream->seek(position, SEEK_SET) == false)
+    {
+        GP_ERROR("Failed to restore file pointer after loading mesh '%s'.", id);
+        SAFE_RELEASE(mesh);
+        return NULL;
+    }
+
+    return mesh;
+}
+
+Mesh* Bundle::createMesh(const char* id, MeshData* meshData)
+{
+    GP_ASSERT(id);
+    GP_ASSERT(meshData);
+
     // Create mesh.
     Mesh* mesh = Mesh::createMesh(meshData->vertexFormat, meshData->vertexCount, false);
     if (mesh == NULL)
     {
         GP_ERROR("Failed to create mesh '%s'.", id);
-        SAFE_DELETE_ARRAY(meshData);
         return NULL;
     }
 
@@ -1367,25 +1654,76 @@ Mesh* Bundle::loadMesh(const char* id, const char* nodeId)
         if (part == NULL)
         {
             GP_ERROR("Failed to create mesh part (with index %d) for mesh '%s'.", i, id);
-            SAFE_DELETE(meshData);
+            SAFE_RELEASE(mesh);
             return NULL;
         }
         part->setIndexData(partData->indexData, 0, partData->indexCount);
     }
 
-    SAFE_DELETE(meshData);
+    return mesh;
+}
 
-    // Restore file pointer.
-    if (_stream->seek(position, SEEK_SET) == false)
+void Bundle::preloadMeshData()
+{
+    GP_ASSERT(_stream);
+
+    for (unsigned int i = 0; i < _referenceCount; ++i)
     {
-        GP_ERROR("Failed to restore file pointer after loading mesh '%s'.", id);
-        return NULL;
+        const Reference& ref = _references[i];
+        if (ref.type != BUNDLE_TYPE_MESH)
+            continue;
+
+        if (_stream->seek(ref.offset, SEEK_SET) == false)
+        {
+            GP_ERROR("Failed to seek to mesh '%s' in bundle '%s'.", ref.id.c_str(), _path.c_str());
+            return;
+        }
+
+        // Copy the data, since the meshes are created after this call.
+        MeshData* meshData = readMeshData(false);
+        if (meshData)
+            _preloadedMeshData.push_back(std::make_pair(ref.id, meshData));
     }
+}
 
-    return mesh;
+bool Bundle::createPreloadedMesh()
+{
+    GP_PROFILE_SCOPE("Bundle::createPreloadedMesh");
+    GP_MEMORY_SCOPE(CATEGORY_MESH);
+
+    if (_preloadedMeshData.empty())
+        return false;
+
+    std::pair<std::string, MeshData*> entry = _preloadedMeshData.back();
+    _preloadedMeshData.pop_back();
+
+    Mesh* mesh = createMesh(entry.first.c_str(), entry.second);
+    SAFE_DELETE(entry.second);
+    if (mesh)
+    {
+        Mesh*& preloaded = _preloadedMeshes[entry.first];
+        SAFE_RELEASE(preloaded);
+        preloaded = mesh;
+    }
+    return true;
 }
 
-Bundle::MeshData* Bundle::readMeshData()
+void Bundle::clearPreloadedMeshes()
+{
+    for (size_t i = 0, count = _preloadedMeshData.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_preloadedMeshData[i].second);
+    }
+    _preloadedMeshData.clear();
+
+    for (std::map<std::string, Mesh*>::iterator itr = _preloadedMeshes.begin(); itr != _preloadedMeshes.end(); ++itr)
+    {
+        SAFE_RELEASE(itr->second);
+    }
+    _preloadedMeshes.clear();
+}
+
+Bundle::MeshData* Bundle::readMeshData(bool mapped)
 {
     // Read vertex format/elements.
     unsigned int vertexElementCount;
@@ -1441,12 +1779,20 @@ Bundle::MeshData* Bundle::readMeshData()
 
     GP_ASSERT(meshData->vertexFormat.getVertexSize());
     meshData->vertexCount = vertexByteCount / meshData->vertexFormat.getVertexSize();
-    meshData->vertexData = new unsigned char[vertexByteCount];
-    if (_stream->read(meshData->vertexData, 1, vertexByteCount) != vertexByteCount)
+    if (mapped)
     {
-        GP_ERROR("Failed to load vertex data.");
-        SAFE_DELETE(meshData);
-        return NULL;
+        meshData->vertexData = (unsigned char*)_stream->map(vertexByteCount);
+        meshData->mapped = meshData->vertexData != NULL;
+    }
+    if (!meshData->mapped)
+    {
+        meshData->vertexData = new unsigned char[vertexByteCount];
+        if (_stream->read(meshData->vertexData, 1, vertexByteCount) != vertexByteCount)
+        {
+            GP_ERROR("Failed to load vertex data.");
+            SAFE_DELETE(meshData);
+            return NULL;
+        }
     }
 
     // Read mesh bounds (bounding box and bounding sphere).
@@ -1520,12 +1866,20 @@ Bundle::MeshData* Bundle::readMeshData()
         GP_ASSERT(indexSize);
         partData->indexCount = iByteCount / indexSize;
 
-        partData->indexData = new unsigned char[iByteCount];
-        if (_stream->read(partData->indexData, 1, iByteCount) != iByteCount)
+        if (mapped)
         {
-            GP_ERROR("Failed to read index data for mesh part with index %d.", i);
-            SAFE_DELETE(meshData);
-            return NULL;
+            partData->indexData = (unsigned char*)_stream->map(iByteCount);
+            partData->mapped = partData->indexData != NULL;
+        }
+        if (!partData->mapped)
+        {
+            partData->indexData = new unsigned char[iByteCount];
+            if (_stream->read(partData->indexData, 1, iByteCount) != iByteCount)
+            {
+                GP_ERROR("Failed to read index data for mesh part with index %d.", i);
+                SAFE_DELETE(meshData);
+                return NULL;
+            }
         }
     }
 
@@ -1581,6 +1935,8 @@ Bundle::MeshData* Bundle::readMeshData(const char* url)
 
 Font* Bundle::loadFont(const char* id)
 {
+    GP_PROFILE_SCOPE("Bundle::loadFont");
+
     GP_ASSERT(id);
     GP_ASSERT(_stream);
 
@@ -1674,6 +2030,23 @@ Font* Bundle::loadFont(const char* id)
         return NULL;
     }
 
+    // Read the texture format, which bundles older than version 1.4 do not have.
+    unsigned int format = Font::BITMAP;
+    if (_version[1] > BUNDLE_VERSION_MINOR_NO_FONT_FORMAT && _stream->read(&format, 4, 1) != 1)
+    {
+        GP_ERROR("Failed to read texture format for font '%s'.", id);
+        SAFE_DELETE_ARRAY(glyphs);
+        SAFE_DELETE_ARRAY(textureData);
+        return NULL;
+    }
+    if (format != Font::BITMAP && format != Font::DISTANCE_FIELD)
+    {
+        GP_ERROR("Invalid texture format (%u) for font '%s'.", format, id);
+        SAFE_DELETE_ARRAY(glyphs);
+        SAFE_DELETE_ARRAY(textureData);
+        return NULL;
+    }
+
     // Create the texture for the font.
     Texture* texture = Texture::create(Texture::ALPHA, width, height, textureData, true);
 
@@ -1688,7 +2061,7 @@ Font* Bundle::loadFont(const char* id)
     }
 
     // Create the font.
-    Font* font = Font::create(family.c_str(), Font::PLAIN, size, glyphs, glyphCount, texture);
+    Font* font = Font::create(family.c_str(), Font::PLAIN, size, glyphs, glyphCount, texture, (Font::Format)format);
 
     // Free the glyph array.
     SAFE_DELETE_ARRAY(glyphs);
@@ -1745,23 +2118,29 @@ Bundle::Reference::~Reference()
 }
 
 Bundle::MeshPartData::MeshPartData() :
-    indexCount(0), indexData(NULL)
+    indexCount(0), indexData(NULL), mapped(false)
 {
 }
 
 Bundle::MeshPartData::~MeshPartData()
 {
-    SAFE_DELETE_ARRAY(indexData);
+    if (!mapped)
+    {
+        SAFE_DELETE_ARRAY(indexData);
+    }
 }
 
 Bundle::MeshData::MeshData(const VertexFormat& vertexFormat)
-    : vertexFormat(vertexFormat), vertexCount(0), vertexData(NULL)
+    : vertexFormat(vertexFormat), vertexCount(0), vertexData(NULL), mapped(false)
 {
 }
 
 Bundle::MeshData::~MeshData()
 {
-    SAFE_DELETE_ARRAY(vertexData);
+    if (!mapped)
+    {
+        SAFE_DELETE_ARRAY(vertexData);
+    }
 
     for (unsigned int i = 0; i < parts.size(); ++i)
     {
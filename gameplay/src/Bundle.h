@@ -17,6 +17,7 @@ class Bundle : public Ref
 {
     friend class PhysicsController;
     friend class SceneLoader;
+    friend class ResourceRequest;
 
 public:
 
@@ -133,6 +134,7 @@ private:
         Mesh::IndexFormat indexFormat;
         unsigned int indexCount;
         unsigned char* indexData;
+        bool mapped;                // Whether indexData points into the bundle's memory mapping (and is not owned).
     };
 
     struct MeshData
@@ -143,6 +145,7 @@ private:
         VertexFormat vertexFormat;
         unsigned int vertexCount;
         unsigned char* vertexData;
+        bool mapped;                // Whether vertexData points into the bundle's memory mapping (and is not owned).
         BoundingBox boundingBox;
         BoundingSphere boundingSphere;
         Mesh::PrimitiveType primitiveType;
@@ -161,11 +164,57 @@ private:
      */
     Bundle& operator=(const Bundle&);
 
+    /**
+     * Opens a bundle file and reads its header and reference table, without using the bundle cache.
+     *
+     * This does not create any game objects, so it can be called from any thread.
+     *
+     * @param path The path to the bundle file.
+     *
+     * @return The new bundle, or NULL if there was an error.
+     */
+    static Bundle* open(const char* path);
+
+    /**
+     * Finds the cached bundle for a file.
+     *
+     * @param path The path to the bundle file.
+     *
+     * @return The bundle with an added reference, or NULL if it is not cached.
+     */
+    static Bundle* findCached(const char* path);
+
+    /**
+     * Adds a bundle created with open() to the bundle cache.
+     *
+     * If a bundle for the same path has been cached in the meantime, the given bundle
+     * is released and the cached one is returned instead.
+     *
+     * @param bundle The bundle to add.
+     *
+     * @return The cached bundle.
+     */
+    static Bundle* addToCache(Bundle* bundle);
+
     /**
      * Finds a reference by ID.
      */
     Reference* find(const char* id) const;
 
+    /**
+     * Builds the hash index of the reference table, for bundles that do not store one.
+     */
+    void buildReferenceIndex();
+
+    /**
+     * Reads the hash index of the reference table stored in the bundle, if there is one.
+     *
+     * @param stream The stream positioned at the start of the index.
+     *
+     * @return True if the index was read or the bundle has no index; false if the stream could not be read.
+     */
+    bool readReferenceIndex(Stream* stream);
+
     /**
      * Resets any load session specific state for the bundle.
      */
@@ -231,6 +280,36 @@ private:
      */
     Mesh* loadMesh(const char* id, const char* nodeId);
 
+    /**
+     * Creates a mesh from mesh data read from the bundle.
+     *
+     * @param id The ID of the mesh.
+     * @param meshData The mesh data.
+     *
+     * @return The new mesh, or NULL if the mesh could not be created.
+     */
+    Mesh* createMesh(const char* id, MeshData* meshData);
+
+    /**
+     * Reads the data of all meshes in the bundle into memory, for createPreloadedMesh().
+     *
+     * This does not create any game objects, so it can be called from any thread.
+     */
+    void preloadMeshData();
+
+    /**
+     * Creates one mesh from the data read by preloadMeshData(). The mesh is returned
+     * by the next loadMesh() call for its ID.
+     *
+     * @return true if a mesh was created; false if there was no mesh data left.
+     */
+    bool createPreloadedMesh();
+
+    /**
+     * Releases any preloaded mesh data and meshes that have not been loaded.
+     */
+    void clearPreloadedMeshes();
+
     /**
      * Reads an unsigned int from the current file position.
      *
@@ -291,6 +370,22 @@ private:
      */
     template <class T>
     bool readArray(unsigned int* length, std::vector<T>* values, unsigned int readSize);
+
+    /**
+     * Reads an array of values and the array length from the current file position, referencing
+     * the values in place when the bundle is memory mapped.
+     *
+     * The values are only copied into the vector when the stream cannot be mapped or the data is
+     * not suitably aligned for T. Mapped values remain valid until the bundle is destroyed.
+     *
+     * @param length A pointer to where the length of the array will be copied to.
+     * @param values A pointer to the vector to copy the values to when they cannot be referenced in place.
+     * @param ptr A pointer to where the address of the values will be copied to (NULL if the array is empty).
+     *
+     * @return True if successful, false if an error occurred.
+     */
+    template <class T>
+    bool readArray(unsigned int* length, std::vector<T>* values, const T** ptr);
     
     /**
      * Reads 16 floats from the current file position.
@@ -341,8 +436,11 @@ private:
 
     /**
      * Reads mesh data from the current file position.
+     *
+     * @param mapped Whether the vertex and index data may reference the bundle's memory mapping
+     *      instead of being copied. Such data is only valid until the bundle is destroyed.
      */
-    MeshData* readMeshData();
+    MeshData* readMeshData(bool mapped = false);
 
     /**
      * Reads mesh data for the specified URL.
@@ -364,6 +462,16 @@ private:
      */
     MeshSkin* readMeshSkin();
 
+    /**
+     * Reads the vertices of a mesh for a skin that is applied on the CPU.
+     *
+     * @param meshId The ID of the mesh.
+     * @param skin The skin of the mesh.
+     *
+     * @return true if the vertices were read, false if there was an error.
+     */
+    bool readCpuSkinningData(const char* meshId, MeshSkin* skin);
+
     /**
      * Reads an animation from the current file position.
      * 
@@ -427,12 +535,17 @@ private:
     bool skipNode();
 
     std::string _path;
+    unsigned char _version[2];
     unsigned int _referenceCount;
     Reference* _references;
+    unsigned int _referenceBucketCount;
+    unsigned int* _referenceBuckets;
     Stream* _stream;
 
     std::vector<MeshSkinData*> _meshSkins;
     std::map<std::string, Node*>* _trackedNodes;
+    std::vector<std::pair<std::string, MeshData*> > _preloadedMeshData;
+    std::map<std::string, Mesh*> _preloadedMeshes;
 };
 
 }
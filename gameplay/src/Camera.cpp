@@ -331,7 +331,36 @@ void Camera::project(const Rectangle& viewport, const Vector3& position, float*
     if (depth)
     {
         float ndcZ = clipPos.z / clipPos.w;
-        *depth = ndcZ + 1.0f / 2.0f;
+        *depth = (ndcZ + 1.0f) / 2.0f;
+    }
+}
+
+void Camera::project(const Rectangle& viewport, const Vector3* positions, unsigned int count, Vector3* dst) const
+{
+    GP_ASSERT(count == 0 || (positions && dst));
+
+    const Matrix& viewProjection = getViewProjectionMatrix();
+    float halfWidth = 0.5f * viewport.width;
+    float halfHeight = 0.5f * viewport.height;
+
+    // Transform the points to clip-space in batches.
+    const unsigned int BATCH_SIZE = 64;
+    Vector4 clipPos[BATCH_SIZE];
+    for (unsigned int start = 0; start < count; start += BATCH_SIZE)
+    {
+        unsigned int batchCount = std::min(count - start, BATCH_SIZE);
+        viewProjection.transformPoints(positions + start, batchCount, clipPos);
+        for (unsigned int i = 0; i < batchCount; ++i)
+        {
+            // Compute normalized device coordinates and apply our viewport transformation.
+            const Vector4& p = clipPos[i];
+            GP_ASSERT(p.w != 0.0f);
+            float invW = 1.0f / p.w;
+            Vector3& screen = dst[start + i];
+            screen.x = viewport.x + (p.x * invW + 1.0f) * halfWidth;
+            screen.y = viewport.y + (1.0f - p.y * invW) * halfHeight;
+            screen.z = (p.z * invW + 1.0f) * 0.5f;
+        }
     }
 }
 
@@ -223,6 +223,20 @@ public:
      */
     void project(const Rectangle& viewport, const Vector3& position, float* x, float* y, float* depth = NULL) const;
 
+    /**
+     * Projects an array of world positions into the viewport coordinates.
+     *
+     * This is equivalent to calling project() for each position, but the positions are
+     * transformed to clip space in batches using SIMD instructions where available.
+     *
+     * @param viewport The viewport rectangle to use.
+     * @param positions The array of world space positions.
+     * @param count The number of positions in the array.
+     * @param dst An array of count vectors that receives the viewport x and y coordinates
+     *      and the pixel depth of each position (may be positions).
+     */
+    void project(const Rectangle& viewport, const Vector3* positions, unsigned int count, Vector3* dst) const;
+
     /**
      * Converts a viewport-space coordinate to a world-space position for the given depth value.
      *
@@ -265,10 +265,11 @@ void Container::removeControl(unsigned int index)
     GP_ASSERT(index < _controls.size());
 
     std::vector<Control*>::iterator it = _controls.begin() + index;
-    _controls.erase(it);
     Control* control = *it;
+    _controls.erase(it);
     control->_parent = NULL;
     SAFE_RELEASE(control);
+    _dirty = true;
 }
 
 void Container::removeControl(const char* id)
@@ -283,6 +284,7 @@ void Container::removeControl(const char* id)
             c->_parent = NULL;
             SAFE_RELEASE(c);
             _controls.erase(it);
+            _dirty = true;
             return;
         }
     }
@@ -299,6 +301,7 @@ void Container::removeControl(Control* control)
             control->_parent = NULL;
             SAFE_RELEASE(control);
             _controls.erase(it);
+            _dirty = true;
             return;
         }
     }
@@ -447,40 +450,28 @@ void Container::update(const Control* container, const Vector2& offset)
     }
 }
 
-void Container::draw(SpriteBatch* spriteBatch, const Rectangle& clip, bool needsClear, bool cleared, float targetHeight)
+void Container::draw(SpriteBatch* spriteBatch, const Rectangle& clip, const Rectangle& region)
 {
-    if (needsClear)
-    {
-        GL_ASSERT( glEnable(GL_SCISSOR_TEST) );
-        float clearY = targetHeight - _clearBounds.y - _clearBounds.height;
-        GL_ASSERT( glScissor(_clearBounds.x, clearY, _clearBounds.width, _clearBounds.height) );
-        Game::getInstance()->clear(Game::CLEAR_COLOR, Vector4::zero(), 1.0f, 0);
-        GL_ASSERT( glDisable(GL_SCISSOR_TEST) );
-        needsClear = false;
-        cleared = true;
-    }
-    else if (!cleared)
-    {
-        needsClear = true;
-    }
-
     if (!_visible)
+    {
+        _dirty = false;
         return;
+    }
 
     spriteBatch->start();
     Control::drawBorder(spriteBatch, clip);
     spriteBatch->finish();
 
+    // Only the controls that overlap the region being redrawn need to be drawn again. Dirty
+    // controls are always drawn so that they are no longer dirty, even if they are empty.
     std::vector<Control*>::const_iterator it;
-    Rectangle boundsUnion = Rectangle::empty();
     for (it = _controls.begin(); it < _controls.end(); it++)
     {
         Control* control = *it;
         GP_ASSERT(control);
-        if (!needsClear || control->isDirty() || control->_clearBounds.intersects(boundsUnion))
+        if (control->isDirty() || control->_absoluteClipBounds.intersects(region))
         {
-            control->draw(spriteBatch, _viewportClipBounds, needsClear, cleared, targetHeight);
-            Rectangle::combine(control->_clearBounds, boundsUnion, &boundsUnion);
+            control->draw(spriteBatch, _viewportClipBounds, region);
         }
     }
 
@@ -572,7 +563,7 @@ bool Container::isDirty()
     {
         return true;
     }
-    else
+    else if (_visible)
     {
         std::vector<Control*>::const_iterator it;
         for (it = _controls.begin(); it < _controls.end(); it++)
@@ -588,6 +579,24 @@ bool Container::isDirty()
     return false;
 }
 
+void Container::addDirtyRegion(Rectangle* region)
+{
+    // When the container itself changed it is redrawn entirely, and nothing inside a hidden container is drawn.
+    if (_dirty)
+    {
+        Control::addDirtyRegion(region);
+    }
+    else if (_visible)
+    {
+        std::vector<Control*>::const_iterator it;
+        for (it = _controls.begin(); it < _controls.end(); it++)
+        {
+            GP_ASSERT(*it);
+            (*it)->addDirtyRegion(region);
+        }
+    }
+}
+
 bool Container::touchEvent(Touch::TouchEvent evt, int x, int y, unsigned int contactIndex)
 {
     return pointerEvent(false, evt, x, y, (int)contactIndex);
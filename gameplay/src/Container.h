@@ -309,6 +309,11 @@ protected:
      */
     virtual bool isDirty();
 
+    /**
+     * @see Control::addDirtyRegion
+     */
+    virtual void addDirtyRegion(Rectangle* region);
+
     /**
      * Adds controls nested within a properties object to this container,
      * searching for styles within the given theme.
@@ -319,15 +324,9 @@ protected:
     void addControls(Theme* theme, Properties* properties);
 
     /**
-     * Draws a sprite batch for the specified clipping rect.
-     *
-     * @param spriteBatch The sprite batch to use.
-     * @param clip The clipping rectangle.
-     * @param needsClear Whether it needs to be cleared.
-     * @param cleared Whether it was previously cleared
-     * @param targetHeight The targets height
+     * @see Control::draw
      */
-    virtual void draw(SpriteBatch* spriteBatch, const Rectangle& clip, bool needsClear, bool cleared, float targetHeight);
+    virtual void draw(SpriteBatch* spriteBatch, const Rectangle& clip, const Rectangle& region);
 
     /**
      * Update scroll position and velocity.
@@ -1033,16 +1033,9 @@ void Control::drawText(const Rectangle& position)
 {
 }
 
-void Control::draw(SpriteBatch* spriteBatch, const Rectangle& clip, bool needsClear, bool cleared, float targetHeight)
+void Control::draw(SpriteBatch* spriteBatch, const Rectangle& clip, const Rectangle& region)
 {
-    if (needsClear)
-    {
-        GL_ASSERT( glEnable(GL_SCISSOR_TEST) );
-        GL_ASSERT( glScissor(_clearBounds.x, targetHeight - _clearBounds.y - _clearBounds.height, _clearBounds.width, _clearBounds.height) );
-        Game::getInstance()->clear(Game::CLEAR_COLOR, Vector4::zero(), 1.0f, 0);
-        GL_ASSERT( glDisable(GL_SCISSOR_TEST) );
-    }
-
+    _dirty = false;
     if (!_visible)
         return;
 
@@ -1052,7 +1045,6 @@ void Control::draw(SpriteBatch* spriteBatch, const Rectangle& clip, bool needsCl
     spriteBatch->finish();
 
     drawText(clip);
-    _dirty = false;
 }
 
 bool Control::isDirty()
@@ -1060,6 +1052,27 @@ bool Control::isDirty()
     return _dirty;
 }
 
+void Control::addDirtyRegion(Rectangle* region)
+{
+    if (_dirty)
+    {
+        addRegion(_clearBounds, region);
+        addRegion(_absoluteClipBounds, region);
+    }
+}
+
+void Control::addRegion(const Rectangle& rect, Rectangle* region)
+{
+    GP_ASSERT(region);
+
+    if (rect.width <= 0 || rect.height <= 0)
+        return;
+    if (region->width <= 0 || region->height <= 0)
+        region->set(rect);
+    else
+        Rectangle::combine(rect, *region, region);
+}
+
 bool Control::isContainer() const
 {
     return false;
@@ -866,15 +866,16 @@ protected:
     virtual void drawText(const Rectangle& clip);
 
     /**
-     * Draws a sprite batch for the specified clipping rect.
+     * Draws this control into the region of the form's framebuffer that is being redrawn.
+     *
+     * The form clears the region and restricts drawing to it with a scissor before drawing
+     * its controls, so controls outside of the region do not need to be drawn.
      *
      * @param spriteBatch The sprite batch to use.
      * @param clip The clipping rectangle.
-     * @param needsClear Whether it needs to be cleared.
-     * @param cleared Whether it was previously cleared
-     * @param targetHeight The targets height
+     * @param region The region of the form that is being redrawn.
      */
-    virtual void draw(SpriteBatch* spriteBatch, const Rectangle& clip, bool needsClear, bool cleared, float targetHeight);
+    virtual void draw(SpriteBatch* spriteBatch, const Rectangle& clip, const Rectangle& region);
 
     /**
      * Initialize properties common to all Controls from a Properties object.
@@ -891,6 +892,24 @@ protected:
      */
     virtual bool isDirty();
 
+    /**
+     * Adds the area of the form that must be redrawn because this control changed to a region.
+     *
+     * The area of a dirty control covers both its previous and its current bounds, so that
+     * a control that moved or was hidden is also erased from where it was.
+     *
+     * @param region The region to extend.
+     */
+    virtual void addDirtyRegion(Rectangle* region);
+
+    /**
+     * Extends a region to include a rectangle, ignoring empty rectangles.
+     *
+     * @param rect The rectangle to include.
+     * @param region The region to extend.
+     */
+    static void addRegion(const Rectangle& rect, Rectangle* region);
+
     /**
      * Get a Control::State enum from a matching string.
      *
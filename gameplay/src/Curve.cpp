@@ -177,6 +177,22 @@ void Curve::setTangent(unsigned int index, InterpolationType type, float* inValu
 }
 
 void Curve::evaluate(float time, float* dst) const
+{
+    evaluate(time, dst, NULL);
+}
+
+void Curve::evaluateBatch(const Curve* const* curves, unsigned int count, float time, float* const* dst, unsigned int* cursors)
+{
+    assert(curves && dst);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        assert(curves[i]);
+        curves[i]->evaluate(time, dst[i], cursors ? cursors + i : NULL);
+    }
+}
+
+void Curve::evaluate(float time, float* dst, unsigned int* cursor) const
 {
     assert(dst && time >= 0 && time <= 1.0f);
 
@@ -193,8 +209,8 @@ void Curve::evaluate(float time, float* dst) const
         return;
     }
 
-    // Locate the points we are interpolating between using a binary search.
-    unsigned int index = determineIndex(time);
+    // Locate the points we are interpolating between, starting from the cursor when there is one.
+    unsigned int index = cursor ? determineIndex(time, cursor) : determineIndex(time);
     
     Point* from = _points + index;
     Point* to = _points + (index + 1);
@@ -1180,6 +1196,39 @@ int Curve::determineIndex(float time) const
     return -1;
 }
 
+int Curve::determineIndex(float time, unsigned int* cursor) const
+{
+    assert(cursor);
+
+    // Check the segment found last time, then the segments on either side of it.
+    unsigned int index = *cursor;
+    if (index < _pointCount - 1)
+    {
+        if (time >= _points[index].time)
+        {
+            if (time <= _points[index + 1].time)
+                return index;
+
+            if (index + 2 < _pointCount && time <= _points[index + 2].time)
+            {
+                *cursor = index + 1;
+                return index + 1;
+            }
+        }
+        else if (index > 0 && time >= _points[index - 1].time)
+        {
+            *cursor = index - 1;
+            return index - 1;
+        }
+    }
+
+    // Fall back to a binary search.
+    int result = determineIndex(time);
+    if (result >= 0)
+        *cursor = (unsigned int)result;
+    return result;
+}
+
 int Curve::getInterpolationType(const char* curveId)
 {
     if (strcmp(curveId, "BEZIER") == 0)
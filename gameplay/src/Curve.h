@@ -352,6 +352,33 @@ public:
      */
     void evaluate(float time, float* dst) const;
 
+    /**
+     * Evaluates the curve at the given position value (between 0.0 and 1.0 inclusive) using a keyframe cursor.
+     *
+     * The cursor holds the index of the segment found by the previous evaluation. Since playback
+     * moves through a curve almost monotonically, that segment and its neighbours are checked first
+     * and the binary search over all points is only done when they do not contain the time.
+     * Each independent playback of the curve must keep its own cursor, initialized to zero.
+     *
+     * @param time The position to evaluate the curve at.
+     * @param dst The evaluated value of the curve at the given time.
+     * @param cursor The keyframe cursor, updated to the segment containing the given time.
+     * @script{ignore}
+     */
+    void evaluate(float time, float* dst, unsigned int* cursor) const;
+
+    /**
+     * Evaluates several curves at the same position value (between 0.0 and 1.0 inclusive) in a single pass.
+     *
+     * @param curves The curves to evaluate.
+     * @param count The number of curves.
+     * @param time The position to evaluate the curves at.
+     * @param dst The destination of each curve's value, which must hold the curve's component count.
+     * @param cursors The keyframe cursor of each curve, or NULL to search every curve from scratch.
+     * @script{ignore}
+     */
+    static void evaluateBatch(const Curve* const* curves, unsigned int count, float time, float* const* dst, unsigned int* cursors);
+
     /**
      * Linear interpolation function.
      */
@@ -461,6 +488,11 @@ private:
      */ 
     int determineIndex(float time) const;
 
+    /**
+     * Determines the current keyframe to interpolate from, starting the search from a keyframe cursor.
+     */
+    int determineIndex(float time, unsigned int* cursor) const;
+
     /**
      * Sets the offset for the beginning of a Quaternion piece of data within the curve's value span at the specified
      * index. The next four components of data starting at the given index will be interpolated as a Quaternion.
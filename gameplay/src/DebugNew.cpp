@@ -20,6 +20,7 @@ struct MemoryAllocationRecord
     unsigned int size;              // size of the allocation request
     const char* file;               // source file of allocation request
     int line;                       // source line of the allocation request
+    unsigned char category;         // MemoryTracker category the allocation is counted against
     MemoryAllocationRecord* next;
     MemoryAllocationRecord* prev;
 #ifdef WIN32
@@ -94,6 +95,23 @@ void operator delete[] (void* p, const char* file, int line) throw()
 
 // Include Base.h (needed for logging macros) AFTER new operator impls
 #include "Base.h"
+#include "Thread.h"
+#include "MemoryTracker.h"
+
+// Guards the allocation list, which is modified by every thread that allocates.
+// A spin lock is used since a mutex would itself be allocated with new.
+static volatile int __memoryAllocationLock = 0;
+
+static void lockMemoryAllocations()
+{
+    while (!gameplay::atomicCompareAndSwap(&__memoryAllocationLock, 0, 1))
+        gameplay::Thread::yield();
+}
+
+static void unlockMemoryAllocations()
+{
+    gameplay::atomicCompareAndSwap(&__memoryAllocationLock, 1, 0);
+}
 
 void* debugAlloc(std::size_t size, const char* file, int line)
 {
@@ -109,7 +127,7 @@ void* debugAlloc(std::size_t size, const char* file, int line)
     rec->size = (unsigned int)size;
     rec->file = file;
     rec->line = line;
-    rec->next = __memoryAllocations;
+    rec->category = (unsigned char)gameplay::MemoryTracker::getCurrentCategory();
     rec->prev = 0;
 
     // Capture the stack frame (up to MAX_STACK_FRAMES) if we 
@@ -160,10 +178,15 @@ void* debugAlloc(std::size_t size, const char* file, int line)
     }
 #endif
 
+    gameplay::MemoryTracker::trackAllocation((gameplay::MemoryTracker::Category)rec->category, rec->size);
+
+    lockMemoryAllocations();
+    rec->next = __memoryAllocations;
     if (__memoryAllocations)
         __memoryAllocations->prev = rec;
     __memoryAllocations = rec;
     ++__memoryAllocationCount;
+    unlockMemoryAllocations();
 
     return mem;
 }
@@ -185,7 +208,10 @@ void debugFree(void* p)
         return;
     }
 
+    gameplay::MemoryTracker::trackFree((gameplay::MemoryTracker::Category)rec->category, rec->size);
+
     // Link this item out
+    lockMemoryAllocations();
     if (__memoryAllocations == rec)
         __memoryAllocations = rec->next;
     if (rec->prev)
@@ -193,6 +219,7 @@ void debugFree(void* p)
     if (rec->next)
         rec->next->prev = rec->prev;
     --__memoryAllocationCount;
+    unlockMemoryAllocations();
 
     // Free the address from the original alloc location (before mem allocation record)
     free(mem);
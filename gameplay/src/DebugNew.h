@@ -14,6 +14,10 @@
 // Prints all heap and reference leaks to stderr.
 extern void printMemoryLeaks();
 
+// Allocates and frees tracked memory.
+void* debugAlloc(std::size_t size, const char* file, int line);
+void debugFree(void* p);
+
 // global new/delete operator overloads
 #ifdef _MSC_VER
 #pragma warning( disable : 4290 ) // C++ exception specification ignored.
@@ -11,6 +11,31 @@ namespace gameplay
 static std::map<std::string, Effect*> __effectCache;
 static Effect* __currentEffect = NULL;
 
+// The texture bound to each texture unit while redundant texture binds are being skipped.
+#define TEXTURE_UNIT_CACHE_SIZE 32
+static bool __textureUnitCacheEnabled = false;
+static TextureHandle __textureUnitCache[TEXTURE_UNIT_CACHE_SIZE];
+
+/**
+ * Binds the sampler's texture to the given texture unit, unless the texture unit cache
+ * shows that it is already bound there.
+ */
+static void bindSampler(unsigned int unit, const Texture::Sampler* sampler)
+{
+    if (__textureUnitCacheEnabled && unit < TEXTURE_UNIT_CACHE_SIZE)
+    {
+        TextureHandle handle = sampler->getTexture()->getHandle();
+        if (__textureUnitCache[unit] == handle)
+            return;
+        __textureUnitCache[unit] = handle;
+    }
+
+    GL_ASSERT( glActiveTexture(GL_TEXTURE0 + unit) );
+
+    // Bind the sampler - this binds the texture and applies sampler state
+    const_cast<Texture::Sampler*>(sampler)->bind();
+}
+
 Effect::Effect() : _program(0)
 {
 }
@@ -561,10 +586,7 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler* sampler)
     GP_ASSERT(uniform->_type == GL_SAMPLER_2D);
     GP_ASSERT(sampler);
 
-    GL_ASSERT( glActiveTexture(GL_TEXTURE0 + uniform->_index) );
-
-    // Bind the sampler - this binds the texture and applies sampler state
-    const_cast<Texture::Sampler*>(sampler)->bind();
+    bindSampler(uniform->_index, sampler);
 
     GL_ASSERT( glUniform1i(uniform->_location, uniform->_index) );
 }
@@ -579,10 +601,7 @@ void Effect::setValue(Uniform* uniform, const Texture::Sampler** values, unsigne
     GLint units[32];
     for (unsigned int i = 0; i < count; ++i)
     {
-        GL_ASSERT( glActiveTexture(GL_TEXTURE0 + uniform->_index + i) );
-
-        // Bind the sampler - this binds the texture and applies sampler state
-        const_cast<Texture::Sampler*>(values[i])->bind();
+        bindSampler(uniform->_index + i, values[i]);
 
         units[i] = uniform->_index + i;
     }
@@ -603,6 +622,13 @@ Effect* Effect::getCurrentEffect()
     return __currentEffect;
 }
 
+void Effect::setTextureBindCacheEnabled(bool enabled)
+{
+    // The cache starts out empty, since the bindings are unknown.
+    __textureUnitCacheEnabled = enabled;
+    memset(__textureUnitCache, 0, sizeof(__textureUnitCache));
+}
+
 Uniform::Uniform() :
     _location(-1), _type(0), _index(0)
 {
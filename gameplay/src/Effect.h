@@ -25,6 +25,8 @@ class Uniform;
  */
 class Effect: public Ref
 {
+    friend class RenderQueue;
+
 public:
 
     /**
@@ -241,6 +243,15 @@ private:
 
     static Effect* createFromSource(const char* vshPath, const char* vshSource, const char* fshPath, const char* fshSource, const char* defines = NULL);
 
+    /**
+     * Enables or disables skipping texture binds for texture units that already have the
+     * texture bound. Only enabled by the RenderQueue while it draws, since textures that are
+     * bound outside of Effect (when they are created, for example) are not tracked.
+     *
+     * @param enabled true to skip redundant texture binds; false to always bind textures.
+     */
+    static void setTextureBindCacheEnabled(bool enabled);
+
     GLuint _program;
     std::string _id;
     std::map<std::string, VertexAttribute> _vertexAttributes;
@@ -254,6 +265,7 @@ private:
 class Uniform
 {
     friend class Effect;
+    friend class RenderQueue;
 
 public:
 
@@ -18,6 +18,13 @@
     #define gp_stat_struct struct stat
 #endif
 
+#if !defined(WIN32) && !defined(__ANDROID__)
+    #define GP_MAPPED_STREAM
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
 #ifdef __ANDROID__
 #include <android/asset_manager.h>
 extern AAssetManager* __assetManager;
@@ -120,6 +127,47 @@ private:
     bool _canWrite;
 };
 
+#ifdef GP_MAPPED_STREAM
+
+/**
+ * A read-only stream over a memory mapped file.
+ *
+ * @script{ignore}
+ */
+class MemoryMappedStream : public Stream
+{
+public:
+    friend class FileSystem;
+
+    ~MemoryMappedStream();
+    virtual bool canRead();
+    virtual bool canWrite();
+    virtual bool canSeek();
+    virtual void close();
+    virtual size_t read(void* ptr, size_t size, size_t count);
+    virtual char* readLine(char* str, int num);
+    virtual size_t write(const void* ptr, size_t size, size_t count);
+    virtual bool eof();
+    virtual size_t length();
+    virtual long int position();
+    virtual bool seek(long int offset, int origin);
+    virtual bool rewind();
+    virtual const void* map(size_t size);
+
+    static MemoryMappedStream* create(const char* filePath);
+
+private:
+    MemoryMappedStream(const unsigned char* data, size_t length);
+
+private:
+    const unsigned char* _data;
+    size_t _length;
+    size_t _position;
+    bool _open;
+};
+
+#endif
+
 #ifdef __ANDROID__
 
 /**
@@ -375,6 +423,14 @@ Stream* FileSystem::open(const char* path, size_t mode)
             }
         }
     }
+#endif
+#ifdef GP_MAPPED_STREAM
+    if ((mode & MAPPED) != 0 && (mode & WRITE) == 0)
+    {
+        MemoryMappedStream* mappedStream = MemoryMappedStream::create(fullPath.c_str());
+        if (mappedStream)
+            return mappedStream;
+    }
 #endif
     FileStream* stream = FileStream::create(fullPath.c_str(), modeStr);
     return stream;
@@ -658,6 +714,180 @@ bool FileStream::rewind()
 
 ////////////////////////////////
 
+#ifdef GP_MAPPED_STREAM
+
+MemoryMappedStream::MemoryMappedStream(const unsigned char* data, size_t length)
+    : _data(data), _length(length), _position(0), _open(true)
+{
+}
+
+MemoryMappedStream::~MemoryMappedStream()
+{
+    if (_open)
+    {
+        close();
+    }
+}
+
+MemoryMappedStream* MemoryMappedStream::create(const char* filePath)
+{
+    int fd = ::open(filePath, O_RDONLY);
+    if (fd == -1)
+        return NULL;
+
+    struct stat s;
+    if (fstat(fd, &s) != 0 || !S_ISREG(s.st_mode))
+    {
+        ::close(fd);
+        return NULL;
+    }
+
+    // Empty files cannot be mapped, but are still valid streams.
+    void* data = NULL;
+    if (s.st_size > 0)
+    {
+        data = mmap(NULL, (size_t)s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            ::close(fd);
+            return NULL;
+        }
+    }
+
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+
+    return new MemoryMappedStream((const unsigned char*)data, (size_t)s.st_size);
+}
+
+bool MemoryMappedStream::canRead()
+{
+    return _open;
+}
+
+bool MemoryMappedStream::canWrite()
+{
+    return false;
+}
+
+bool MemoryMappedStream::canSeek()
+{
+    return _open;
+}
+
+void MemoryMappedStream::close()
+{
+    if (_data)
+        munmap((void*)_data, _length);
+    _data = NULL;
+    _length = 0;
+    _position = 0;
+    _open = false;
+}
+
+size_t MemoryMappedStream::read(void* ptr, size_t size, size_t count)
+{
+    if (!_open || size == 0 || _position >= _length)
+        return 0;
+    size_t available = (_length - _position) / size;
+    if (count > available)
+        count = available;
+    memcpy(ptr, _data + _position, size * count);
+    _position += size * count;
+    return count;
+}
+
+char* MemoryMappedStream::readLine(char* str, int num)
+{
+    if (!_open || num <= 0 || _position >= _length)
+        return NULL;
+
+    // Matches fgets(): copies up to num - 1 characters, stopping after a newline.
+    size_t i = 0;
+    while (i < (size_t)(num - 1) && _position < _length)
+    {
+        char c = (char)_data[_position++];
+        str[i++] = c;
+        if (c == '\n')
+            break;
+    }
+    str[i] = '\0';
+    return str;
+}
+
+size_t MemoryMappedStream::write(const void*, size_t, size_t)
+{
+    return 0;
+}
+
+bool MemoryMappedStream::eof()
+{
+    return !_open || _position >= _length;
+}
+
+size_t MemoryMappedStream::length()
+{
+    return _length;
+}
+
+long int MemoryMappedStream::position()
+{
+    if (!_open)
+        return -1;
+    return (long int)_position;
+}
+
+bool MemoryMappedStream::seek(long int offset, int origin)
+{
+    if (!_open)
+        return false;
+
+    long int base;
+    switch (origin)
+    {
+    case SEEK_SET:
+        base = 0;
+        break;
+    case SEEK_CUR:
+        base = (long int)_position;
+        break;
+    case SEEK_END:
+        base = (long int)_length;
+        break;
+    default:
+        return false;
+    }
+    if (offset < -base)
+        return false;
+
+    // Like fseek(), seeking past the end is allowed; reads there simply return nothing.
+    _position = (size_t)(base + offset);
+    return true;
+}
+
+bool MemoryMappedStream::rewind()
+{
+    if (canSeek())
+    {
+        _position = 0;
+        return true;
+    }
+    return false;
+}
+
+const void* MemoryMappedStream::map(size_t size)
+{
+    if (!_open || _position > _length || size > _length - _position)
+        return NULL;
+    const void* ptr = _data + _position;
+    _position += size;
+    return ptr;
+}
+
+#endif
+
+////////////////////////////////
+
 #ifdef __ANDROID__
 
 FileStreamAndroid::FileStreamAndroid(AAsset* asset)
@@ -22,7 +22,9 @@ public:
     enum StreamMode
     {
         READ = 1,
-        WRITE = 2
+        WRITE = 2,
+        /** Read through a memory mapping of the file where supported (ignored when combined with WRITE). */
+        MAPPED = 4
     };
 
     /**
@@ -125,6 +127,10 @@ public:
      * If <code>path</code> is a file path, the file at the specified location is opened relative to the currently set
      * resource path.
      *
+     * When <code>mode</code> includes MAPPED and the platform supports it (currently POSIX platforms other than
+     * Android), the file is memory mapped instead of read through buffered file IO, and Stream::map() can
+     * be used to access its contents without copying. Otherwise a regular file stream is returned.
+     *
      * @param path The path to the resource to be opened, relative to the currently set resource path.
      * @param mode The mode used to open the file.
      * 
@@ -1,5 +1,7 @@
 #include "Base.h"
 #include "Font.h"
+#include "FontAtlas.h"
+#include "MemoryTracker.h"
 #include "Game.h"
 #include "FileSystem.h"
 #include "Bundle.h"
@@ -7,16 +9,78 @@
 // Default font shaders
 #define FONT_VSH "res/shaders/font.vert"
 #define FONT_FSH "res/shaders/font.frag"
+#define FONT_DISTANCE_FIELD_DEFINE "DISTANCE_FIELD"
+
+// Default number of text layouts cached by each font.
+#define FONT_LAYOUT_CACHE_CAPACITY 64
+
+// Size of the dynamic fonts created from TrueType font files by Font::create.
+#define FONT_DYNAMIC_SIZE 32
 
 namespace gameplay
 {
 
 static std::vector<Font*> __fontCache;
 
-static Effect* __fontEffect = NULL;
+// Decodes the UTF-8 character at the start of a string, returning its code point and byte length.
+// Bytes that do not start a valid sequence are decoded as single characters of the same value.
+static unsigned int decodeUTF8(const char* text, unsigned int* length)
+{
+    const unsigned char* s = (const unsigned char*)text;
+    unsigned int count = 0;
+    unsigned int code = s[0];
+    if (s[0] >= 0xF0 && s[0] < 0xF8)
+    {
+        count = 3;
+        code = s[0] & 0x07;
+    }
+    else if (s[0] >= 0xE0)
+    {
+        count = 2;
+        code = s[0] & 0x0F;
+    }
+    else if (s[0] >= 0xC0)
+    {
+        count = 1;
+        code = s[0] & 0x1F;
+    }
+
+    for (unsigned int i = 1; i <= count; ++i)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            *length = 1;
+            return s[0];
+        }
+        code = (code << 6) | (s[i] & 0x3F);
+    }
+
+    *length = count + 1;
+    return code;
+}
+
+// Decodes the character at an index of a token and moves the index to the next character in
+// the direction of iteration, returning the code point and byte length of the character.
+static unsigned int readCharacter(const char* token, int* index, int iteration, unsigned int* length)
+{
+    int i = *index;
+    if (iteration < 0)
+    {
+        // Step back from a continuation byte to the start of its character.
+        while (i > 0 && (token[i] & 0xC0) == 0x80)
+        {
+            --i;
+        }
+    }
+
+    unsigned int code = decodeUTF8(token + i, length);
+    *index = iteration < 0 ? i - 1 : i + *length;
+    return code;
+}
 
 Font::Font() :
-    _style(PLAIN), _size(0), _glyphs(NULL), _glyphCount(0), _texture(NULL), _batch(NULL)
+    _style(PLAIN), _size(0), _format(BITMAP), _glyphs(NULL), _glyphCount(0), _texture(NULL), _batch(NULL), _atlas(NULL),
+    _layoutCapacity(FONT_LAYOUT_CACHE_CAPACITY), _layoutHits(0), _layoutMisses(0)
 {
 }
 
@@ -29,6 +93,8 @@ Font::~Font()
         __fontCache.erase(itr);
     }
 
+    clearLayoutCache();
+    SAFE_DELETE(_atlas);
     SAFE_DELETE(_batch);
     SAFE_DELETE_ARRAY(_glyphs);
     SAFE_RELEASE(_texture);
@@ -36,8 +102,17 @@ Font::~Font()
 
 Font* Font::create(const char* path, const char* id)
 {
+    GP_MEMORY_SCOPE(CATEGORY_UI);
+
     GP_ASSERT(path);
 
+    // TrueType font files are loaded as dynamic fonts.
+    size_t pathLength = strlen(path);
+    if (pathLength > 4 && strcmp(path + pathLength - 4, ".ttf") == 0)
+    {
+        return createDynamic(path, FONT_DYNAMIC_SIZE);
+    }
+
     // Search the font cache for a font with the given path and ID.
     for (size_t i = 0, count = __fontCache.size(); i < count; ++i)
     {
@@ -90,33 +165,66 @@ Font* Font::create(const char* path, const char* id)
     return font;
 }
 
-Font* Font::create(const char* family, Style style, unsigned int size, Glyph* glyphs, int glyphCount, Texture* texture)
+Font* Font::createDynamic(const char* path, unsigned int size, unsigned int atlasSize)
 {
-    GP_ASSERT(family);
-    GP_ASSERT(glyphs);
-    GP_ASSERT(texture);
+    GP_MEMORY_SCOPE(CATEGORY_UI);
+
+    GP_ASSERT(path);
 
-    // Create the effect for the font's sprite batch.
-    if (__fontEffect == NULL)
+    // Search the font cache for a dynamic font with the given path and size.
+    for (size_t i = 0, count = __fontCache.size(); i < count; ++i)
     {
-        __fontEffect = Effect::createFromFile(FONT_VSH, FONT_FSH);
-        if (__fontEffect == NULL)
+        Font* f = __fontCache[i];
+        GP_ASSERT(f);
+        if (f->_atlas && f->_path == path && f->_size == size)
         {
-            GP_ERROR("Failed to create effect for font.");
-            SAFE_RELEASE(texture);
-            return NULL;
+            // Found a match.
+            f->addRef();
+            return f;
         }
     }
-    else
+
+    FontAtlas* atlas = FontAtlas::create(path, size, atlasSize);
+    if (atlas == NULL)
+    {
+        return NULL;
+    }
+
+    Font* font = create(atlas->_family.c_str(), PLAIN, size, NULL, 0, atlas->_texture);
+    if (font == NULL)
+    {
+        SAFE_DELETE(atlas);
+        return NULL;
+    }
+    font->_path = path;
+    font->_atlas = atlas;
+    atlas->_batch = font->_batch;
+
+    // Add this font to the cache.
+    __fontCache.push_back(font);
+
+    return font;
+}
+
+Font* Font::create(const char* family, Style style, unsigned int size, Glyph* glyphs, int glyphCount, Texture* texture, Format format)
+{
+    GP_ASSERT(family);
+    GP_ASSERT(glyphs || glyphCount == 0);
+    GP_ASSERT(texture);
+
+    // Create the effect for the font's sprite batch (the effect cache shares it between fonts of the same format).
+    Effect* effect = Effect::createFromFile(FONT_VSH, FONT_FSH, format == DISTANCE_FIELD ? FONT_DISTANCE_FIELD_DEFINE : NULL);
+    if (effect == NULL)
     {
-        __fontEffect->addRef();
+        GP_ERROR("Failed to create effect for font.");
+        return NULL;
     }
 
     // Create batch for the font.
-    SpriteBatch* batch = SpriteBatch::create(texture, __fontEffect, 128);
+    SpriteBatch* batch = SpriteBatch::create(texture, effect, 128);
     
-    // Release __fontEffect since the SpriteBatch keeps a reference to it
-    SAFE_RELEASE(__fontEffect);
+    // Release the effect since the SpriteBatch keeps a reference to it
+    SAFE_RELEASE(effect);
 
     if (batch == NULL)
     {
@@ -135,13 +243,17 @@ Font* Font::create(const char* family, Style style, unsigned int size, Glyph* gl
     font->_family = family;
     font->_style = style;
     font->_size = size;
+    font->_format = format;
     font->_texture = texture;
     font->_batch = batch;
 
     // Copy the glyphs array.
-    font->_glyphs = new Glyph[glyphCount];
-    memcpy(font->_glyphs, glyphs, sizeof(Glyph) * glyphCount);
-    font->_glyphCount = glyphCount;
+    if (glyphCount > 0)
+    {
+        font->_glyphs = new Glyph[glyphCount];
+        memcpy(font->_glyphs, glyphs, sizeof(Glyph) * glyphCount);
+        font->_glyphCount = glyphCount;
+    }
 
     return font;
 }
@@ -151,17 +263,46 @@ unsigned int Font::getSize()
     return _size;
 }
 
+Font::Format Font::getFormat() const
+{
+    return _format;
+}
+
 void Font::start()
 {
     GP_ASSERT(_batch);
     _batch->start();
+    if (_atlas)
+        _atlas->_started = true;
+}
+
+Font::Glyph* Font::getGlyph(unsigned int code)
+{
+    if (_atlas)
+        return _atlas->getGlyph(code);
+
+    // The glyphs of a bundled font are sorted by code, and usually start from the space with no gaps.
+    if (code - 32 < _glyphCount && _glyphs[code - 32].code == code)
+        return &_glyphs[code - 32];
+
+    unsigned int first = 0;
+    unsigned int last = _glyphCount;
+    while (first < last)
+    {
+        unsigned int middle = (first + last) / 2;
+        if (_glyphs[middle].code < code)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+    return first < _glyphCount && _glyphs[first].code == code ? &_glyphs[first] : NULL;
 }
 
 Font::Text* Font::createText(const char* text, const Rectangle& area, const Vector4& color, unsigned int size, Justify justify,
     bool wrap, bool rightToLeft, const Rectangle* clip)
 {
     GP_ASSERT(text);
-    GP_ASSERT(_glyphs);
+    GP_ASSERT(_glyphs || _atlas);
     GP_ASSERT(_batch);
 
     if (size == 0)
@@ -258,14 +399,13 @@ Font::Text* Font::createText(const char* text, const Rectangle& area, const Vect
             break;
         }
 
-        for (int i = startIndex; i < (int)tokenLength && i >= 0; i += iteration)
+        for (int i = startIndex; i < (int)tokenLength && i >= 0;)
         {
-            char c = token[i];
-            int glyphIndex = c - 32; // HACK for ASCII
-        
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            unsigned int length;
+            Glyph* glyph = getGlyph(readCharacter(token, &i, iteration, &length));
+            if (glyph)
             {
-                Glyph& g = _glyphs[glyphIndex];
+                Glyph& g = *glyph;
 
                 if (xPos + (int)(g.width*scale) > area.x + area.width)
                 {
@@ -463,19 +603,11 @@ void Font::drawText(const char* text, int x, int y, const Vector4& color, unsign
             iteration = 1;
         }
 
-        GP_ASSERT(_glyphs);
         GP_ASSERT(_batch);
-        for (size_t i = startIndex; i < length; i += (size_t)iteration)
+        for (int i = (int)startIndex; i < (int)length && i >= 0;)
         {
-            char c = 0;
-            if (rightToLeft)
-            {
-                c = cursor[i];
-            }
-            else
-            {
-                c = text[i];
-            }
+            unsigned int characterLength;
+            unsigned int c = readCharacter(rightToLeft ? cursor : text, &i, iteration, &characterLength);
 
             // Draw this character.
             switch (c)
@@ -492,10 +624,10 @@ void Font::drawText(const char* text, int x, int y, const Vector4& color, unsign
                 xPos += (size >> 1)*4;
                 break;
             default:
-                int index = c - 32; // HACK for ASCII
-                if (index >= 0 && index < (int)_glyphCount)
+                Glyph* glyph = getGlyph(c);
+                if (glyph)
                 {
-                    Glyph& g = _glyphs[index];
+                    Glyph& g = *glyph;
                     _batch->draw(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color);
                     xPos += floor(g.width * scale + (float)(size >> 3));
                     break;
@@ -523,19 +655,66 @@ void Font::drawText(const char* text, int x, int y, float red, float green, floa
 void Font::drawText(const char* text, const Rectangle& area, const Vector4& color, unsigned int size, Justify justify, bool wrap, bool rightToLeft, const Rectangle* clip)
 {
     GP_ASSERT(text);
+    GP_ASSERT(_batch);
 
     if (size == 0)
         size = _size;
+
+    // The layout is relative to the origin of the area, which is applied to the vertices.
+    Layout* layout = getLineLayout(text, area, size, justify, wrap, rightToLeft);
+    GP_ASSERT(layout);
+    if (!layout->hasQuads || (_atlas && layout->generation != _atlas->_generation))
+    {
+        // Glyphs move when a dynamic atlas grows or evicts glyphs, which can happen while laying
+        // out the text itself, so lay it out again if that happened.
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            layoutQuads(text, Rectangle(area.width, area.height), size, wrap, rightToLeft, layout);
+            if (!_atlas || layout->generation == _atlas->_generation)
+                break;
+        }
+
+        // If the glyphs still moved, they do not all fit in the atlas at once and some of the
+        // texture coordinates are stale, so do not draw the text.
+        if (_atlas && layout->generation != _atlas->_generation)
+        {
+            if (!layout->atlasOverflow)
+            {
+                GP_WARN("The glyphs of text '%s' do not fit in the atlas of font '%s' at size %u.", text, _path.c_str(), size);
+                layout->atlasOverflow = true;
+            }
+            return;
+        }
+    }
+
+    // Only rebuild the vertices if the origin, color or clip differs from the last time this layout was drawn.
+    if (!layout->hasVertices || layout->originX != area.x || layout->originY != area.y || layout->color != color ||
+        layout->clipped != (clip != NULL) || (clip && layout->clip != *clip))
+    {
+        layoutVertices(area.x, area.y, color, clip, layout);
+    }
+
+    if (!layout->indices.empty())
+    {
+        _batch->draw(&layout->vertices[0], (unsigned int)layout->vertices.size(), &layout->indices[0], (unsigned int)layout->indices.size());
+    }
+}
+
+void Font::layoutQuads(const char* text, const Rectangle& area, unsigned int size, bool wrap, bool rightToLeft, Layout* layout)
+{
+    GP_ASSERT(text);
+    GP_ASSERT(layout);
     GP_ASSERT(_size);
+
     float scale = (float)size / _size;
-    int yPos = area.y;
+    int yPos = layout->yPosition;
     const float areaHeight = area.height - size;
-    std::vector<int> xPositions;
-    std::vector<unsigned int> lineLengths;
+    const std::vector<int>& xPositions = layout->xPositions;
+    const std::vector<unsigned int>& lineLengths = layout->lineLengths;
+    std::vector<float>& quads = layout->quads;
+    quads.clear();
+    layout->generation = _atlas ? _atlas->_generation : 0;
 
-    getMeasurementInfo(text, area, size, justify, wrap, rightToLeft, &xPositions, &yPos, &lineLengths);
-
-    // Now we have the info we need in order to render.
     int xPos = area.x;
     std::vector<int>::const_iterator xPositionsIt = xPositions.begin();
     if (xPositionsIt != xPositions.end())
@@ -615,16 +794,13 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
             break;
         }
 
-        GP_ASSERT(_glyphs);
-        GP_ASSERT(_batch);
-        for (int i = startIndex; i < (int)tokenLength && i >= 0; i += iteration)
+        for (int i = startIndex; i < (int)tokenLength && i >= 0;)
         {
-            char c = token[i];
-            int glyphIndex = c - 32; // HACK for ASCII
-        
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            unsigned int length;
+            Glyph* glyph = getGlyph(readCharacter(token, &i, iteration, &length));
+            if (glyph)
             {
-                Glyph& g = _glyphs[glyphIndex];
+                Glyph& g = *glyph;
 
                 if (xPos + (int)(g.width*scale) > area.x + area.width)
                 {
@@ -634,17 +810,17 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
                 }
                 else if (xPos >= area.x)
                 {
-                    // Draw this character.
+                    // Add a quad for this character.
                     if (draw)
                     {
-                        if (clip)
-                        {
-                            _batch->draw(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color, *clip);
-                        }
-                        else
-                        {
-                            _batch->draw(xPos, yPos, g.width * scale, size, g.uvs[0], g.uvs[1], g.uvs[2], g.uvs[3], color);
-                        }
+                        quads.push_back(xPos);
+                        quads.push_back(yPos);
+                        quads.push_back(g.width * scale);
+                        quads.push_back(size);
+                        quads.push_back(g.uvs[0]);
+                        quads.push_back(g.uvs[1]);
+                        quads.push_back(g.uvs[2]);
+                        quads.push_back(g.uvs[3]);
                     }
                 }
                 xPos += (int)(g.width)*scale + (size >> 3);
@@ -713,12 +889,17 @@ void Font::drawText(const char* text, const Rectangle& area, const Vector4& colo
             }
         }
     }
+
+    layout->hasQuads = true;
+    layout->hasVertices = false;
 }
 
 void Font::finish()
 {
     GP_ASSERT(_batch);
     _batch->finish();
+    if (_atlas)
+        _atlas->_started = false;
 }
 
 void Font::measureText(const char* text, unsigned int size, unsigned int* width, unsigned int* height)
@@ -736,6 +917,16 @@ void Font::measureText(const char* text, unsigned int size, unsigned int* width,
         return;
     }
 
+    bool created;
+    Layout* layout = getLayout(LAYOUT_SIZE, text, Rectangle(), size, ALIGN_TOP_LEFT, false, false, &created);
+    GP_ASSERT(layout);
+    if (!created)
+    {
+        *width = (unsigned int)layout->bounds.width;
+        *height = (unsigned int)layout->bounds.height;
+        return;
+    }
+
     float scale = (float)size / _size;
     const char* token = text;
 
@@ -760,6 +951,8 @@ void Font::measureText(const char* text, unsigned int size, unsigned int* width,
 
         token += tokenLength;
     }
+
+    layout->bounds.set(0, 0, *width, *height);
 }
 
 void Font::measureText(const char* text, const Rectangle& clip, unsigned int size, Rectangle* out, Justify justify, bool wrap, bool ignoreClip)
@@ -774,6 +967,15 @@ void Font::measureText(const char* text, const Rectangle& clip, unsigned int siz
         return;
     }
 
+    bool created;
+    Layout* layout = getLayout(LAYOUT_BOUNDS, text, clip, size, justify, wrap, ignoreClip, &created);
+    GP_ASSERT(layout);
+    if (!created)
+    {
+        out->set(clip.x + layout->bounds.x, clip.y + layout->bounds.y, layout->bounds.width, layout->bounds.height);
+        return;
+    }
+
     float scale = (float)size / _size;
     Justify vAlign = static_cast<Justify>(justify & 0xF0);
     if (vAlign == 0)
@@ -1091,6 +1293,8 @@ void Font::measureText(const char* text, const Rectangle& clip, unsigned int siz
         out->width = width;
         out->height = height;
     }
+
+    layout->bounds.set(out->x - clip.x, out->y - clip.y, out->width, out->height);
 }
 
 void Font::getMeasurementInfo(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft,
@@ -1300,12 +1504,18 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
 
     // Essentially need to measure text until we reach inLocation.
     float scale = (float)size / _size;
-    int yPos = area.y;
     const float areaHeight = area.height - size;
-    std::vector<int> xPositions;
-    std::vector<unsigned int> lineLengths;
-
-    getMeasurementInfo(text, area, size, justify, wrap, rightToLeft, &xPositions, &yPos, &lineLengths);
+    Layout* layout = getLineLayout(text, area, size, justify, wrap, rightToLeft);
+    GP_ASSERT(layout);
+    const std::vector<unsigned int>& lineLengths = layout->lineLengths;
+
+    // The cached lines are relative to the origin of the area.
+    int yPos = layout->yPosition + (int)area.y;
+    std::vector<int> xPositions(layout->xPositions);
+    for (size_t i = 0, count = xPositions.size(); i < count; ++i)
+    {
+        xPositions[i] += (int)area.x;
+    }
 
     int xPos = area.x;
     std::vector<int>::const_iterator xPositionsIt = xPositions.begin();
@@ -1406,15 +1616,14 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
             break;
         }
 
-        GP_ASSERT(_glyphs);
-        for (int i = startIndex; i < (int)tokenLength && i >= 0; i += iteration)
+        for (int i = startIndex; i < (int)tokenLength && i >= 0;)
         {
-            char c = token[i];
-            int glyphIndex = c - 32; // HACK for ASCII
-        
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            // Character indices are byte offsets into the text.
+            unsigned int length;
+            Glyph* glyph = getGlyph(readCharacter(token, &i, iteration, &length));
+            if (glyph)
             {
-                Glyph& g = _glyphs[glyphIndex];
+                Glyph& g = *glyph;
 
                 if (xPos + (int)(g.width*scale) > area.x + area.width)
                 {
@@ -1435,8 +1644,8 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
                 }
 
                 xPos += floor(g.width*scale + (float)(size >> 3));
-                charIndex++;
             }
+            charIndex += length;
         }
 
         if (!truncated)
@@ -1522,13 +1731,14 @@ int Font::getIndexOrLocation(const char* text, const Rectangle& area, unsigned i
 unsigned int Font::getTokenWidth(const char* token, unsigned int length, unsigned int size, float scale)
 {
     GP_ASSERT(token);
-    GP_ASSERT(_glyphs);
 
     // Calculate width of word or line.
     unsigned int tokenWidth = 0;
-    for (unsigned int i = 0; i < length; ++i)
+    for (unsigned int i = 0; i < length;)
     {
-        char c = token[i];
+        unsigned int characterLength;
+        unsigned int c = decodeUTF8(token + i, &characterLength);
+        i += characterLength;
         switch (c)
         {
         case ' ':
@@ -1538,11 +1748,10 @@ unsigned int Font::getTokenWidth(const char* token, unsigned int length, unsigne
             tokenWidth += (size >> 1)*4;
             break;
         default:
-            int glyphIndex = c - 32;
-            if (glyphIndex >= 0 && glyphIndex < (int)_glyphCount)
+            Glyph* g = getGlyph(c);
+            if (g)
             {
-                Glyph& g = _glyphs[glyphIndex];
-                tokenWidth += floor(g.width * scale + (float)(size >> 3));
+                tokenWidth += floor(g->width * scale + (float)(size >> 3));
             }
             break;
         }
@@ -1680,6 +1889,172 @@ void Font::addLineInfo(const Rectangle& area, int lineWidth, int lineLength, Jus
     }
 }
 
+Font::Layout* Font::getLayout(LayoutType type, const char* text, const Rectangle& area, unsigned int size, Justify justify,
+                              bool wrap, bool flag, bool* created)
+{
+    GP_ASSERT(text);
+    GP_ASSERT(created);
+
+    LayoutKey key;
+    key.type = type;
+    key.text = text;
+    key.size = size;
+    key.width = area.width;
+    key.height = area.height;
+    key.justify = justify;
+    key.wrap = wrap;
+    key.flag = flag;
+
+    LayoutMap::iterator itr = _layouts.find(key);
+    if (itr != _layouts.end())
+    {
+        // Move the layout to the front of the least recently used list.
+        ++_layoutHits;
+        Layout* layout = itr->second;
+        _layoutLru.splice(_layoutLru.begin(), _layoutLru, layout->lru);
+        *created = false;
+        return layout;
+    }
+
+    ++_layoutMisses;
+    Layout* layout = new Layout();
+    layout->text = text;
+    layout->yPosition = 0;
+    layout->hasQuads = false;
+    layout->generation = 0;
+    layout->atlasOverflow = false;
+    layout->hasVertices = false;
+    layout->originX = 0;
+    layout->originY = 0;
+    layout->clipped = false;
+
+    // The key points to the layout's own copy of the string.
+    key.text = layout->text.c_str();
+    itr = _layouts.insert(std::make_pair(key, layout)).first;
+    _layoutLru.push_front(itr);
+    layout->lru = _layoutLru.begin();
+
+    // Evict the least recently used layouts, always keeping the one being returned.
+    while (_layoutLru.size() > _layoutCapacity && _layoutLru.size() > 1)
+    {
+        LayoutMap::iterator last = _layoutLru.back();
+        _layoutLru.pop_back();
+        SAFE_DELETE(last->second);
+        _layouts.erase(last);
+    }
+
+    *created = true;
+    return layout;
+}
+
+Font::Layout* Font::getLineLayout(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft)
+{
+    bool created;
+    Layout* layout = getLayout(LAYOUT_LINES, text, area, size, justify, wrap, rightToLeft, &created);
+    GP_ASSERT(layout);
+    if (created)
+    {
+        getMeasurementInfo(text, Rectangle(area.width, area.height), size, justify, wrap, rightToLeft,
+                           &layout->xPositions, &layout->yPosition, &layout->lineLengths);
+    }
+    return layout;
+}
+
+void Font::layoutVertices(float originX, float originY, const Vector4& color, const Rectangle* clip, Layout* layout)
+{
+    GP_ASSERT(_batch);
+    GP_ASSERT(layout);
+
+    const std::vector<float>& quads = layout->quads;
+    std::vector<SpriteBatch::SpriteVertex>& vertices = layout->vertices;
+    std::vector<unsigned short>& indices = layout->indices;
+    vertices.resize(quads.size() / 2);
+    indices.clear();
+
+    unsigned int vertexCount = 0;
+    for (size_t i = 0; i < quads.size(); i += 8)
+    {
+        float x = originX + quads[i];
+        float y = originY + quads[i + 1];
+        float width = quads[i + 2];
+        float height = quads[i + 3];
+        float u1 = quads[i + 4];
+        float v1 = quads[i + 5];
+        float u2 = quads[i + 6];
+        float v2 = quads[i + 7];
+
+        // Skip quads entirely outside of the clip.
+        if (clip && !_batch->clipSprite(*clip, x, y, width, height, u1, v1, u2, v2))
+            continue;
+
+        _batch->addSprite(x, y, width, height, u1, v1, u2, v2, color, &vertices[vertexCount]);
+
+        if (vertexCount > 0)
+        {
+            // Create a degenerate triangle to connect separate triangle strips
+            // by duplicating the previous and next vertices.
+            indices.push_back(indices.back());
+            indices.push_back(vertexCount);
+        }
+        for (unsigned int j = 0; j < 4; ++j)
+        {
+            indices.push_back(vertexCount + j);
+        }
+        vertexCount += 4;
+    }
+    vertices.resize(vertexCount);
+
+    layout->hasVertices = true;
+    layout->originX = originX;
+    layout->originY = originY;
+    layout->color.set(color);
+    layout->clipped = (clip != NULL);
+    if (clip)
+    {
+        layout->clip = *clip;
+    }
+}
+
+unsigned int Font::getLayoutCacheCapacity() const
+{
+    return _layoutCapacity;
+}
+
+void Font::setLayoutCacheCapacity(unsigned int capacity)
+{
+    _layoutCapacity = capacity;
+
+    while (_layoutLru.size() > _layoutCapacity)
+    {
+        LayoutMap::iterator last = _layoutLru.back();
+        _layoutLru.pop_back();
+        SAFE_DELETE(last->second);
+        _layouts.erase(last);
+    }
+}
+
+unsigned int Font::getLayoutCacheHits() const
+{
+    return _layoutHits;
+}
+
+unsigned int Font::getLayoutCacheMisses() const
+{
+    return _layoutMisses;
+}
+
+void Font::clearLayoutCache()
+{
+    for (LayoutMap::iterator itr = _layouts.begin(); itr != _layouts.end(); ++itr)
+    {
+        SAFE_DELETE(itr->second);
+    }
+    _layouts.clear();
+    _layoutLru.clear();
+    _layoutHits = 0;
+    _layoutMisses = 0;
+}
+
 SpriteBatch* Font::getSpriteBatch() const
 {
     return _batch;
@@ -1779,4 +2154,23 @@ const char* Font::Text::getText()
     return _text.c_str();
 }
 
+bool Font::LayoutKey::operator<(const LayoutKey& key) const
+{
+    if (type != key.type)
+        return type < key.type;
+    if (size != key.size)
+        return size < key.size;
+    if (width != key.width)
+        return width < key.width;
+    if (height != key.height)
+        return height < key.height;
+    if (justify != key.justify)
+        return justify < key.justify;
+    if (wrap != key.wrap)
+        return wrap < key.wrap;
+    if (flag != key.flag)
+        return flag < key.flag;
+    return strcmp(text, key.text) < 0;
+}
+
 }
@@ -6,13 +6,20 @@
 namespace gameplay
 {
 
+class FontAtlas;
+
 /**
  * Defines a font for text rendering.
+ *
+ * Text is encoded in UTF-8. Fonts loaded from a bundle contain the glyphs that were
+ * encoded into them, while fonts created with createDynamic() rasterize any glyph of
+ * their TrueType font on demand. Characters without a glyph are skipped.
  */
 class Font : public Ref
 {
     friend class Bundle;
     friend class TextBox;
+    friend class FontAtlas;
 
 public:
 
@@ -27,6 +34,23 @@ public:
         BOLD_ITALIC = 4
     };
 
+    /**
+     * Defines the formats of the glyph texture of a font.
+     */
+    enum Format
+    {
+        /**
+         * The texture holds the coverage of each glyph, rasterized at the size of the font.
+         */
+        BITMAP = 0,
+
+        /**
+         * The texture holds the distance to the nearest glyph edge, so that the glyphs stay
+         * crisp when the font is drawn at sizes other than its own.
+         */
+        DISTANCE_FIELD = 1
+    };
+
     /**
      * Defines the set of allowable alignments when drawing text.
      */
@@ -102,6 +126,9 @@ public:
      * If a font for the given path has already been loaded, the existing font will be
      * returned with its reference count increased.
      *
+     * If the path is a TrueType font file (.ttf), a dynamic font with a size of 32 pixels is
+     * created with createDynamic() instead, and 'id' is ignored.
+     *
      * @param path The path to a bundle file containing a font resource.
      * @param id An optional ID of the font resource within the bundle (NULL for the first/only resource).
      * 
@@ -110,11 +137,44 @@ public:
      */
     static Font* create(const char* path, const char* id = NULL);
 
+    /**
+     * Creates a dynamic font from a TrueType font file.
+     *
+     * The glyphs of a dynamic font are rasterized the first time they are drawn or measured,
+     * into a texture atlas that grows up to 'atlasSize' pixels square. Once the atlas is full,
+     * the glyphs that were used least recently are evicted to make room for new ones, so that
+     * the memory used by the font stays proportional to the glyphs in use rather than to the
+     * size of the character set.
+     *
+     * Text objects created from a dynamic font with createText() refer to the positions of
+     * their glyphs in the atlas, and must be created again after glyphs are evicted.
+     *
+     * Dynamic fonts require the engine to be built with USE_FREETYPE.
+     *
+     * If a dynamic font for the given path and size has already been created, the existing
+     * font will be returned with its reference count increased.
+     *
+     * @param path The path to a TrueType font file.
+     * @param size The font size (line height) in pixels.
+     * @param atlasSize The maximum width and height of the glyph atlas, in pixels.
+     *
+     * @return The new font, or NULL if the font could not be loaded.
+     * @script{create}
+     */
+    static Font* createDynamic(const char* path, unsigned int size, unsigned int atlasSize = 512);
+
     /**
      * Returns the font size (max height of glyphs) in pixels.
      */
     unsigned int getSize();
 
+    /**
+     * Returns the format of the glyph texture of this font.
+     *
+     * @return The format of the font.
+     */
+    Format getFormat() const;
+
     /**
      * Starts text drawing for this font.
      */
@@ -249,6 +309,46 @@ public:
      */
     static Justify getJustify(const char* justify);
 
+    /**
+     * Gets the maximum number of text layouts that this font caches.
+     *
+     * @return The capacity of the layout cache.
+     */
+    unsigned int getLayoutCacheCapacity() const;
+
+    /**
+     * Sets the maximum number of text layouts that this font caches.
+     *
+     * Drawing text within an area, measuring text or locating characters in text with the
+     * same string and parameters as a cached layout reuses the lines and glyph quads of the
+     * layout instead of measuring the string again, and drawing it again with the same color
+     * and clip only copies its vertices into the sprite batch. When the cache is full, the
+     * least recently used layout is discarded. With a capacity of zero, only the layout used
+     * last is kept.
+     *
+     * @param capacity The capacity of the layout cache.
+     */
+    void setLayoutCacheCapacity(unsigned int capacity);
+
+    /**
+     * Gets the number of times that a cached layout was reused.
+     *
+     * @return The number of layout cache hits.
+     */
+    unsigned int getLayoutCacheHits() const;
+
+    /**
+     * Gets the number of times that text had to be laid out because no cached layout matched.
+     *
+     * @return The number of layout cache misses.
+     */
+    unsigned int getLayoutCacheMisses() const;
+
+    /**
+     * Discards all of the cached layouts and resets the hit and miss counts.
+     */
+    void clearLayoutCache();
+
 private:
 
     /**
@@ -273,6 +373,95 @@ private:
         float uvs[4];
     };
 
+    /**
+     * Defines the kinds of results that are cached for a string.
+     */
+    enum LayoutType
+    {
+        LAYOUT_LINES,
+        LAYOUT_BOUNDS,
+        LAYOUT_SIZE
+    };
+
+    /**
+     * Identifies a cached layout by the string and the parameters that determine it.
+     * Layouts are relative to the origin of the area, so that moving text still finds them.
+     */
+    class LayoutKey
+    {
+    public:
+        /**
+         * Orders keys by their parameters, then by their string.
+         */
+        bool operator<(const LayoutKey& key) const;
+
+        LayoutType type;
+        const char* text;
+        unsigned int size;
+        float width;
+        float height;
+        int justify;
+        bool wrap;
+        bool flag;
+    };
+
+    class Layout;
+    typedef std::map<LayoutKey, Layout*> LayoutMap;
+
+    /**
+     * Defines the cached layout of a string.
+     */
+    class Layout
+    {
+    public:
+        /**
+         * The string, which the key of the layout points to.
+         */
+        std::string text;
+
+        /**
+         * Position of the layout in the least recently used list.
+         */
+        std::list<LayoutMap::iterator>::iterator lru;
+
+        /**
+         * The measured lines (LAYOUT_LINES), relative to the origin of the area.
+         */
+        std::vector<int> xPositions;
+        int yPosition;
+        std::vector<unsigned int> lineLengths;
+
+        /**
+         * The glyph quads, as x, y, width, height, u1, v1, u2, v2 relative to the origin of the area
+         * (LAYOUT_LINES, once drawn), and the generation of the dynamic atlas that they were laid out in.
+         */
+        bool hasQuads;
+        std::vector<float> quads;
+        unsigned int generation;
+
+        /**
+         * Whether the glyphs of the string were found not to fit in the dynamic atlas at once.
+         */
+        bool atlasOverflow;
+
+        /**
+         * The vertices and indices of the quads for the origin, color and clip they were last drawn with.
+         */
+        bool hasVertices;
+        float originX;
+        float originY;
+        Vector4 color;
+        bool clipped;
+        Rectangle clip;
+        std::vector<SpriteBatch::SpriteVertex> vertices;
+        std::vector<unsigned short> indices;
+
+        /**
+         * The measured bounds relative to the origin of the clip (LAYOUT_BOUNDS), or width and height (LAYOUT_SIZE).
+         */
+        Rectangle bounds;
+    };
+
     /**
      * Constructor.
      */
@@ -302,13 +491,25 @@ private:
      * @param family The font family name.
      * @param style The font style.
      * @param size The font size.
-     * @param glyphs An array of font glyphs, defining each character in the font within the texture map.
+     * @param glyphs An array of font glyphs sorted by code, defining each character in the font within the texture map.
      * @param glyphCount The number of items in the glyph array.
-     * @param texture A texture map containing rendered glyphs.
+     * @param texture A texture map containing rendered glyphs. The font adds its own reference to it,
+     *      so the caller keeps its reference whether or not the font is created.
+     * @param format The format of the texture map.
      * 
      * @return The new Font.
      */
-    static Font* create(const char* family, Style style, unsigned int size, Glyph* glyphs, int glyphCount, Texture* texture);
+    static Font* create(const char* family, Style style, unsigned int size, Glyph* glyphs, int glyphCount, Texture* texture,
+                        Format format = BITMAP);
+
+    /**
+     * Finds the glyph of a character, rasterizing it if the font is dynamic.
+     *
+     * @param code The Unicode code point of the character.
+     *
+     * @return The glyph, or NULL if the font has no glyph for the character.
+     */
+    Glyph* getGlyph(unsigned int code);
 
     void getMeasurementInfo(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft,
                             std::vector<int>* xPositions, int* yPosition, std::vector<unsigned int>* lineLengths);
@@ -327,16 +528,51 @@ private:
     void addLineInfo(const Rectangle& area, int lineWidth, int lineLength, Justify hAlign,
                      std::vector<int>* xPositions, std::vector<unsigned int>* lineLengths, bool rightToLeft);
 
+    /**
+     * Finds the cached layout of the given type for a string and parameters, or adds an empty one
+     * to the cache (evicting the least recently used layouts when it is full).
+     *
+     * @param created Set to true if the layout was added and must be filled in by the caller.
+     *
+     * @return The layout.
+     */
+    Layout* getLayout(LayoutType type, const char* text, const Rectangle& area, unsigned int size, Justify justify,
+                      bool wrap, bool flag, bool* created);
+
+    /**
+     * Finds or adds the cached lines of a string, measuring them if they were not cached.
+     * The lines are measured relative to the origin of the area.
+     */
+    Layout* getLineLayout(const char* text, const Rectangle& area, unsigned int size, Justify justify, bool wrap, bool rightToLeft);
+
+    /**
+     * Lays out the glyph quads of a string from its measured lines.
+     */
+    void layoutQuads(const char* text, const Rectangle& area, unsigned int size, bool wrap, bool rightToLeft, Layout* layout);
+
+    /**
+     * Builds the vertices and indices of the glyph quads of a layout, offset by the given origin,
+     * for the given color and clip.
+     */
+    void layoutVertices(float originX, float originY, const Vector4& color, const Rectangle* clip, Layout* layout);
+
     std::string _path;
     std::string _id;
     std::string _family;
     Style _style;
     unsigned int _size;
+    Format _format;
     Glyph* _glyphs;
     unsigned int _glyphCount;
     Texture* _texture;
     SpriteBatch* _batch;
+    FontAtlas* _atlas;
     Rectangle _viewport;
+    LayoutMap _layouts;
+    std::list<LayoutMap::iterator> _layoutLru;
+    unsigned int _layoutCapacity;
+    unsigned int _layoutHits;
+    unsigned int _layoutMisses;
 };
 
 }
@@ -0,0 +1,401 @@
+#include "Base.h"
+#include "FontAtlas.h"
+#include "FileSystem.h"
+
+#ifdef USE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+// The initial width and height of an atlas, in pixels.
+#define FONT_ATLAS_INITIAL_SIZE 128
+
+// The number of empty pixels right of and below each glyph, so that filtering does not pick up its neighbours.
+#define FONT_ATLAS_PADDING 1
+
+namespace gameplay
+{
+
+FontAtlas::FontAtlas()
+    : _library(NULL), _face(NULL), _fontData(NULL), _size(0), _ascender(0), _maxSize(0), _width(0), _height(0),
+      _pixels(NULL), _texture(NULL), _useCount(0), _generation(0), _batch(NULL), _started(false)
+{
+}
+
+FontAtlas::~FontAtlas()
+{
+#ifdef USE_FREETYPE
+    if (_face)
+        FT_Done_Face(_face);
+    if (_library)
+        FT_Done_FreeType(_library);
+#endif
+    SAFE_DELETE_ARRAY(_fontData);
+    SAFE_DELETE_ARRAY(_pixels);
+    SAFE_RELEASE(_texture);
+}
+
+FontAtlas* FontAtlas::create(const char* path, unsigned int size, unsigned int maxSize)
+{
+    GP_ASSERT(path);
+    GP_ASSERT(size > 0);
+    GP_ASSERT(maxSize > size);
+
+#ifdef USE_FREETYPE
+    int fileSize = 0;
+    char* data = FileSystem::readAll(path, &fileSize);
+    if (data == NULL)
+    {
+        GP_ERROR("Failed to read font file '%s'.", path);
+        return NULL;
+    }
+
+    // FreeType reads the face from the file data for as long as the face is open.
+    FontAtlas* atlas = new FontAtlas();
+    atlas->_fontData = data;
+    if (FT_Init_FreeType(&atlas->_library) || FT_New_Memory_Face(atlas->_library, (const FT_Byte*)data, fileSize, 0, &atlas->_face))
+    {
+        GP_ERROR("Failed to load font file '%s'.", path);
+        SAFE_DELETE(atlas);
+        return NULL;
+    }
+    FT_Face face = atlas->_face;
+
+    // Scale the face so that a line, from the ascender to the descender, is 'size' pixels high.
+    unsigned int pixelSize = size;
+    if (FT_IS_SCALABLE(face) && face->ascender > face->descender)
+    {
+        pixelSize = std::max(1u, (unsigned int)(size * face->units_per_EM / (face->ascender - face->descender)));
+    }
+    if (FT_Set_Pixel_Sizes(face, 0, pixelSize))
+    {
+        GP_ERROR("Failed to set the size of font '%s' to %u pixels.", path, size);
+        SAFE_DELETE(atlas);
+        return NULL;
+    }
+
+    atlas->_family = face->family_name ? face->family_name : "";
+    atlas->_size = size;
+    atlas->_ascender = (int)(face->size->metrics.ascender >> 6);
+    atlas->_maxSize = maxSize;
+    atlas->_width = std::min((unsigned int)FONT_ATLAS_INITIAL_SIZE, maxSize);
+    atlas->_height = atlas->_width;
+    atlas->_pixels = new unsigned char[atlas->_width * atlas->_height];
+    memset(atlas->_pixels, 0, atlas->_width * atlas->_height);
+    atlas->_texture = Texture::create(Texture::ALPHA, atlas->_width, atlas->_height, atlas->_pixels);
+
+    Segment segment = { 0, 0, atlas->_width };
+    atlas->_skyline.push_back(segment);
+
+    return atlas;
+#else
+    (void)size;
+    (void)maxSize;
+    GP_ERROR("Failed to load font '%s'; dynamic fonts require the engine to be built with USE_FREETYPE.", path);
+    return NULL;
+#endif
+}
+
+Font::Glyph* FontAtlas::getGlyph(unsigned int code)
+{
+    // Control characters have no glyph.
+    if (code < 32)
+        return NULL;
+
+    Entry* entry;
+    std::map<unsigned int, Entry>::iterator itr = _entries.find(code);
+    if (itr != _entries.end())
+    {
+        entry = &itr->second;
+    }
+    else if ((entry = addGlyph(code)) == NULL)
+    {
+        return NULL;
+    }
+
+    entry->lastUse = ++_useCount;
+    return &entry->glyph;
+}
+
+FontAtlas::Entry* FontAtlas::addGlyph(unsigned int code)
+{
+#ifdef USE_FREETYPE
+    // Characters that are not in the face are skipped rather than drawn as its missing glyph.
+    FT_UInt index = FT_Get_Char_Index(_face, code);
+    if (index == 0 || FT_Load_Glyph(_face, index, FT_LOAD_RENDER))
+        return NULL;
+
+    const FT_GlyphSlot slot = _face->glyph;
+    const FT_Bitmap& bitmap = slot->bitmap;
+    if (bitmap.pixel_mode != FT_PIXEL_MODE_GRAY && bitmap.width > 0)
+    {
+        GP_WARN("Unsupported pixel mode (%d) of glyph %u in font '%s'.", bitmap.pixel_mode, code, _family.c_str());
+        return NULL;
+    }
+
+    // Each glyph occupies a cell as wide as its bitmap and as high as a line, with the bitmap on the baseline.
+    const unsigned int width = (unsigned int)bitmap.width;
+    const unsigned int cellWidth = width + FONT_ATLAS_PADDING;
+    const unsigned int cellHeight = _size + FONT_ATLAS_PADDING;
+    unsigned int x, y;
+    if (!pack(cellWidth, cellHeight, &x, &y))
+    {
+        // Grow the atlas until the glyph fits, and once it is at its maximum size make room by evicting glyphs.
+        bool packed = false;
+        while (!packed && grow())
+        {
+            packed = pack(cellWidth, cellHeight, &x, &y);
+        }
+        if (!packed)
+        {
+            compact();
+            if (!pack(cellWidth, cellHeight, &x, &y))
+            {
+                GP_WARN("Glyph %u of font '%s' does not fit in its atlas.", code, _family.c_str());
+                return NULL;
+            }
+        }
+    }
+
+    if (width > 0)
+    {
+        std::vector<unsigned char> cell(width * _size, 0);
+        const int top = _ascender - slot->bitmap_top;
+        for (int row = 0; row < (int)bitmap.rows; ++row)
+        {
+            const int cellRow = top + row;
+            if (cellRow >= 0 && cellRow < (int)_size)
+            {
+                memcpy(&cell[cellRow * width], bitmap.buffer + row * bitmap.pitch, width);
+            }
+        }
+        for (unsigned int row = 0; row < _size; ++row)
+        {
+            memcpy(&_pixels[(y + row) * _width + x], &cell[row * width], width);
+        }
+        _texture->setData(x, y, width, _size, &cell[0]);
+    }
+
+    Entry& entry = _entries[code];
+    entry.glyph.code = code;
+    entry.glyph.width = width;
+    entry.x = x;
+    entry.y = y;
+    entry.lastUse = 0;
+    setTextureCoordinates(&entry);
+
+    return &entry;
+#else
+    (void)code;
+    return NULL;
+#endif
+}
+
+bool FontAtlas::pack(unsigned int width, unsigned int height, unsigned int* x, unsigned int* y)
+{
+    GP_ASSERT(x);
+    GP_ASSERT(y);
+
+    // Find the lowest position on the skyline that the cell fits at, preferring the narrowest segments on ties.
+    size_t best = _skyline.size();
+    unsigned int bestY = 0;
+    unsigned int bestWidth = 0;
+    for (size_t i = 0, count = _skyline.size(); i < count; ++i)
+    {
+        const Segment& segment = _skyline[i];
+        if (segment.x + width > _width)
+            break;
+
+        // The cell rests on the highest of the segments that it spans.
+        unsigned int top = 0;
+        unsigned int spanned = 0;
+        for (size_t j = i; j < count && spanned < width; ++j)
+        {
+            top = std::max(top, _skyline[j].y);
+            spanned += _skyline[j].width;
+        }
+        if (top + height > _height)
+            continue;
+
+        if (best == _skyline.size() || top < bestY || (top == bestY && segment.width < bestWidth))
+        {
+            best = i;
+            bestY = top;
+            bestWidth = segment.width;
+        }
+    }
+    if (best == _skyline.size())
+        return false;
+
+    *x = _skyline[best].x;
+    *y = bestY;
+
+    // Raise the skyline over the cell, trimming the segments that it covers.
+    Segment segment = { *x, bestY + height, width };
+    _skyline.insert(_skyline.begin() + best, segment);
+    for (size_t i = best + 1; i < _skyline.size();)
+    {
+        Segment& previous = _skyline[i - 1];
+        Segment& current = _skyline[i];
+        if (current.x >= previous.x + previous.width)
+            break;
+
+        unsigned int overlap = previous.x + previous.width - current.x;
+        if (current.width <= overlap)
+        {
+            _skyline.erase(_skyline.begin() + i);
+        }
+        else
+        {
+            current.x += overlap;
+            current.width -= overlap;
+            break;
+        }
+    }
+
+    // Merge neighbouring segments of the same height.
+    for (size_t i = 0; i + 1 < _skyline.size();)
+    {
+        if (_skyline[i].y == _skyline[i + 1].y)
+        {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+bool FontAtlas::grow()
+{
+    unsigned int width = _width;
+    unsigned int height = _height;
+    if (width < _maxSize && (width <= height || height >= _maxSize))
+    {
+        width = std::min(width * 2, _maxSize);
+    }
+    else if (height < _maxSize)
+    {
+        height = std::min(height * 2, _maxSize);
+    }
+    else
+    {
+        return false;
+    }
+
+    beginMove();
+
+    unsigned char* pixels = new unsigned char[width * height];
+    memset(pixels, 0, width * height);
+    for (unsigned int row = 0; row < _height; ++row)
+    {
+        memcpy(&pixels[row * width], &_pixels[row * _width], _width);
+    }
+
+    // The new columns are empty from the top.
+    if (width > _width)
+    {
+        if (_skyline.back().y == 0)
+        {
+            _skyline.back().width += width - _width;
+        }
+        else
+        {
+            Segment segment = { _width, 0, width - _width };
+            _skyline.push_back(segment);
+        }
+    }
+
+    SAFE_DELETE_ARRAY(_pixels);
+    _pixels = pixels;
+    _width = width;
+    _height = height;
+    _texture->setData(_width, _height, _pixels);
+
+    for (std::map<unsigned int, Entry>::iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+    {
+        setTextureCoordinates(&itr->second);
+    }
+
+    return true;
+}
+
+void FontAtlas::compact()
+{
+    beginMove();
+
+    // Order the glyphs from the least to the most recently used.
+    std::vector<std::pair<unsigned int, unsigned int> > order;
+    order.reserve(_entries.size());
+    for (std::map<unsigned int, Entry>::iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+    {
+        order.push_back(std::make_pair(itr->second.lastUse, itr->first));
+    }
+    std::sort(order.begin(), order.end());
+
+    unsigned char* pixels = new unsigned char[_width * _height];
+    memset(pixels, 0, _width * _height);
+    _skyline.clear();
+    Segment segment = { 0, 0, _width };
+    _skyline.push_back(segment);
+
+    // Keep the most recently used glyphs that fit in half of the atlas, so that there is room for new ones.
+    const unsigned int limit = _width * _height / 2;
+    unsigned int area = 0;
+    bool full = false;
+    for (size_t i = order.size(); i-- > 0;)
+    {
+        std::map<unsigned int, Entry>::iterator itr = _entries.find(order[i].second);
+        Entry& entry = itr->second;
+        const unsigned int cellWidth = entry.glyph.width + FONT_ATLAS_PADDING;
+        const unsigned int cellHeight = _size + FONT_ATLAS_PADDING;
+        unsigned int x, y;
+        full = full || area + cellWidth * cellHeight > limit || !pack(cellWidth, cellHeight, &x, &y);
+        if (full)
+        {
+            _entries.erase(itr);
+            continue;
+        }
+
+        for (unsigned int row = 0; row < _size; ++row)
+        {
+            memcpy(&pixels[(y + row) * _width + x], &_pixels[(entry.y + row) * _width + entry.x], entry.glyph.width);
+        }
+        entry.x = x;
+        entry.y = y;
+        setTextureCoordinates(&entry);
+        area += cellWidth * cellHeight;
+    }
+
+    SAFE_DELETE_ARRAY(_pixels);
+    _pixels = pixels;
+    _texture->setData(_width, _height, _pixels);
+}
+
+void FontAtlas::beginMove()
+{
+    // Draw the glyphs batched so far while they are still where the batch expects them.
+    if (_started)
+    {
+        GP_ASSERT(_batch);
+        _batch->finish();
+        _batch->start();
+    }
+    ++_generation;
+}
+
+void FontAtlas::setTextureCoordinates(Entry* entry)
+{
+    GP_ASSERT(entry);
+
+    entry->glyph.uvs[0] = (float)entry->x / _width;
+    entry->glyph.uvs[1] = (float)entry->y / _height;
+    entry->glyph.uvs[2] = (float)(entry->x + entry->glyph.width) / _width;
+    entry->glyph.uvs[3] = (float)(entry->y + _size) / _height;
+}
+
+}
@@ -0,0 +1,152 @@
+#ifndef FONTATLAS_H_
+#define FONTATLAS_H_
+
+#include "Font.h"
+
+struct FT_LibraryRec_;
+struct FT_FaceRec_;
+
+namespace gameplay
+{
+
+/**
+ * Defines the texture atlas of a dynamic font, into which the glyphs of a TrueType font
+ * are rasterized on demand (see Font::createDynamic).
+ *
+ * Glyphs are rasterized with FreeType the first time they are requested and packed into the
+ * atlas with a skyline packer. The atlas starts small and doubles in size up to its maximum
+ * size as glyphs are added. When a glyph does not fit in an atlas of the maximum size, the
+ * glyphs that were used least recently are evicted and the others are packed again.
+ *
+ * Growing or repacking the atlas moves glyphs, so the sprites already batched by the font
+ * are drawn first, and the generation of the atlas is incremented so that cached layouts
+ * of the font are laid out again.
+ *
+ * @script{ignore}
+ */
+class FontAtlas
+{
+    friend class Font;
+
+private:
+
+    /**
+     * A glyph and the cell it occupies in the atlas.
+     */
+    class Entry
+    {
+    public:
+        Font::Glyph glyph;
+        unsigned int x;
+        unsigned int y;
+        unsigned int lastUse;
+    };
+
+    /**
+     * A horizontal segment of the skyline, the top edge of the packed cells.
+     */
+    class Segment
+    {
+    public:
+        unsigned int x;
+        unsigned int y;
+        unsigned int width;
+    };
+
+    /**
+     * Constructor.
+     */
+    FontAtlas();
+
+    /**
+     * Destructor.
+     */
+    ~FontAtlas();
+
+    /**
+     * Hidden copy constructor.
+     */
+    FontAtlas(const FontAtlas& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    FontAtlas& operator=(const FontAtlas&);
+
+    /**
+     * Creates the atlas of a TrueType font.
+     *
+     * @param path The path to the TrueType font file.
+     * @param size The line height of the font in pixels.
+     * @param maxSize The maximum width and height of the atlas in pixels.
+     *
+     * @return The new atlas, or NULL if the font could not be loaded.
+     */
+    static FontAtlas* create(const char* path, unsigned int size, unsigned int maxSize);
+
+    /**
+     * Finds the glyph of a character, rasterizing it into the atlas if it is not there.
+     *
+     * @param code The Unicode code point of the character.
+     *
+     * @return The glyph, or NULL if it could not be rasterized or does not fit in the atlas.
+     */
+    Font::Glyph* getGlyph(unsigned int code);
+
+    /**
+     * Rasterizes a glyph into the atlas.
+     */
+    Entry* addGlyph(unsigned int code);
+
+    /**
+     * Finds room for a cell in the skyline and raises the skyline over it.
+     *
+     * @return true if the cell was placed, false if the atlas is full.
+     */
+    bool pack(unsigned int width, unsigned int height, unsigned int* x, unsigned int* y);
+
+    /**
+     * Doubles the width or height of the atlas, keeping the glyphs where they are.
+     *
+     * @return false if the atlas is already at its maximum size.
+     */
+    bool grow();
+
+    /**
+     * Packs the most recently used half of the glyphs again, evicting the others.
+     */
+    void compact();
+
+    /**
+     * Draws the sprites batched by the font before glyphs move, and invalidates the layouts
+     * that refer to them.
+     */
+    void beginMove();
+
+    /**
+     * Computes the texture coordinates of a glyph from its cell and the size of the atlas.
+     */
+    void setTextureCoordinates(Entry* entry);
+
+    FT_LibraryRec_* _library;
+    FT_FaceRec_* _face;
+    char* _fontData;
+    std::string _family;
+    unsigned int _size;
+    int _ascender;
+    unsigned int _maxSize;
+    unsigned int _width;
+    unsigned int _height;
+    unsigned char* _pixels;
+    Texture* _texture;
+    std::vector<Segment> _skyline;
+    std::map<unsigned int, Entry> _entries;
+    unsigned int _useCount;
+    unsigned int _generation;
+    SpriteBatch* _batch;
+    bool _started;
+};
+
+}
+
+#endif
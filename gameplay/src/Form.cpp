@@ -1,5 +1,7 @@
 #include "Base.h"
 #include "Form.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include "AbsoluteLayout.h"
 #include "FlowLayout.h"
 #include "VerticalLayout.h"
@@ -49,6 +51,8 @@ Form::~Form()
 
 Form* Form::create(const char* id, Theme::Style* style, Layout::Type layoutType)
 {
+    GP_MEMORY_SCOPE(CATEGORY_UI);
+
     GP_ASSERT(style);
 
     Layout* layout;
@@ -89,6 +93,8 @@ Form* Form::create(const char* id, Theme::Style* style, Layout::Type layoutType)
 
 Form* Form::create(const char* url)
 {
+    GP_MEMORY_SCOPE(CATEGORY_UI);
+
     // Load Form from .form file.
     Properties* properties = Properties::create(url);
     if (properties == NULL)
@@ -390,6 +396,9 @@ void Form::setNode(Node* node)
 
 void Form::update(float elapsedTime)
 {
+    GP_PROFILE_SCOPE("Form::update");
+    GP_MEMORY_SCOPE(CATEGORY_UI);
+
     updateBounds();
 }
 
@@ -526,6 +535,9 @@ void Form::updateBounds()
 
 void Form::draw()
 {
+    GP_PROFILE_SCOPE("Form::draw");
+    GP_MEMORY_SCOPE(CATEGORY_UI);
+
     // The first time a form is drawn, its contents are rendered into a framebuffer.
     // The framebuffer will only be drawn into again when the contents of the form change.
     // If this form has a node then it's a 3D form and the framebuffer will be used
@@ -535,6 +547,7 @@ void Form::draw()
     // to render the contents of the framebuffer directly to the display.
 
     // Check whether this form has changed since the last call to draw() and if so, render into the framebuffer.
+    // Only the region covered by the controls that changed is cleared and drawn again.
     if (isDirty())
     {
         GP_ASSERT(_frameBuffer);
@@ -544,11 +557,24 @@ void Form::draw()
         Rectangle prevViewport = game->getViewport();
         game->setViewport(Rectangle(0, 0, _bounds.width, _bounds.height));
 
+        // Expand the region to whole pixels and clip it to the framebuffer.
+        Rectangle region;
+        addDirtyRegion(&region);
+        float left = std::max(floorf(region.x), 0.0f);
+        float top = std::max(floorf(region.y), 0.0f);
+        float right = std::min(ceilf(region.x + region.width), _bounds.width);
+        float bottom = std::min(ceilf(region.y + region.height), _bounds.height);
+        region.set(left, top, std::max(right - left, 0.0f), std::max(bottom - top, 0.0f));
+
+        GL_ASSERT( glEnable(GL_SCISSOR_TEST) );
+        GL_ASSERT( glScissor((GLint)region.x, (GLint)(_bounds.height - region.y - region.height), (GLsizei)region.width, (GLsizei)region.height) );
+        game->clear(Game::CLEAR_COLOR, Vector4::zero(), 1.0f, 0);
+
         GP_ASSERT(_theme);
         _theme->setProjectionMatrix(_projectionMatrix);
-        Container::draw(_theme->getSpriteBatch(), Rectangle(0, 0, _bounds.width, _bounds.height),
-                        _skin != NULL, false, _bounds.height);
+        Container::draw(_theme->getSpriteBatch(), Rectangle(0, 0, _bounds.width, _bounds.height), region);
         _theme->setProjectionMatrix(_defaultProjectionMatrix);
+        GL_ASSERT( glDisable(GL_SCISSOR_TEST) );
 
         // restore the previous game viewport
         game->setViewport(prevViewport);
@@ -3,9 +3,112 @@
 #include "BoundingSphere.h"
 #include "BoundingBox.h"
 
+#ifdef USE_SSE
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace gameplay
 {
 
+/**
+ * The planes of a frustum in structure-of-arrays form, for testing arrays of bounding volumes.
+ *
+ * The six planes are padded to eight so that they fill two SIMD registers; the padding planes
+ * are placed far away so that no volume is ever behind them.
+ */
+struct GP_ALIGN(16) FrustumPlanes
+{
+    float nx[8];    // The x component of each plane's normal.
+    float ny[8];    // The y component of each plane's normal.
+    float nz[8];    // The z component of each plane's normal.
+    float ax[8];    // The absolute value of the x component of each plane's normal.
+    float ay[8];    // The absolute value of the y component of each plane's normal.
+    float az[8];    // The absolute value of the z component of each plane's normal.
+    float d[8];     // The distance of each plane.
+
+    FrustumPlanes(const Plane** planes)
+    {
+        for (unsigned int i = 0; i < 8; ++i)
+        {
+            if (i < 6)
+            {
+                const Vector3& normal = planes[i]->getNormal();
+                nx[i] = normal.x;
+                ny[i] = normal.y;
+                nz[i] = normal.z;
+                d[i] = planes[i]->getDistance();
+            }
+            else
+            {
+                nx[i] = ny[i] = nz[i] = 0.0f;
+                d[i] = FLT_MAX;
+            }
+            ax[i] = fabsf(nx[i]);
+            ay[i] = fabsf(ny[i]);
+            az[i] = fabsf(nz[i]);
+        }
+    }
+
+    /**
+     * Tests a box with the given center and (non-negative) extents, grown by the given
+     * radius, against the planes. Spheres are tested as boxes with zero extents.
+     *
+     * @return false if the volume is in the negative half-space of any plane; true otherwise.
+     */
+    bool intersects(float x, float y, float z, float ex, float ey, float ez, float radius) const
+    {
+        // The signed distance from each plane to the point of the volume that is furthest
+        // along the plane's normal; the volume is behind the plane if that is negative.
+#ifdef USE_SSE
+        __m128 px = _mm_set1_ps(x);
+        __m128 py = _mm_set1_ps(y);
+        __m128 pz = _mm_set1_ps(z);
+        __m128 pex = _mm_set1_ps(ex);
+        __m128 pey = _mm_set1_ps(ey);
+        __m128 pez = _mm_set1_ps(ez);
+        __m128 r = _mm_set1_ps(radius);
+        __m128 zero = _mm_setzero_ps();
+        for (unsigned int i = 0; i < 8; i += 4)
+        {
+            __m128 distance = _mm_add_ps(_mm_load_ps(&d[i]), r);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_load_ps(&nx[i]), px));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_load_ps(&ny[i]), py));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_load_ps(&nz[i]), pz));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_load_ps(&ax[i]), pex));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_load_ps(&ay[i]), pey));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_load_ps(&az[i]), pez));
+            if (_mm_movemask_ps(_mm_cmplt_ps(distance, zero)))
+                return false;
+        }
+#elif defined(USE_NEON)
+        float32x4_t zero = vdupq_n_f32(0.0f);
+        for (unsigned int i = 0; i < 8; i += 4)
+        {
+            float32x4_t distance = vaddq_f32(vld1q_f32(&d[i]), vdupq_n_f32(radius));
+            distance = vmlaq_n_f32(distance, vld1q_f32(&nx[i]), x);
+            distance = vmlaq_n_f32(distance, vld1q_f32(&ny[i]), y);
+            distance = vmlaq_n_f32(distance, vld1q_f32(&nz[i]), z);
+            distance = vmlaq_n_f32(distance, vld1q_f32(&ax[i]), ex);
+            distance = vmlaq_n_f32(distance, vld1q_f32(&ay[i]), ey);
+            distance = vmlaq_n_f32(distance, vld1q_f32(&az[i]), ez);
+            uint32x4_t behind = vcltq_f32(distance, zero);
+            uint32x2_t any = vorr_u32(vget_low_u32(behind), vget_high_u32(behind));
+            if (vget_lane_u32(vpmax_u32(any, any), 0))
+                return false;
+        }
+#else
+        for (unsigned int i = 0; i < 6; ++i)
+        {
+            if (nx[i] * x + ny[i] * y + nz[i] * z + d[i] + ax[i] * ex + ay[i] * ey + az[i] * ez + radius < 0.0f)
+                return false;
+        }
+#endif
+        return true;
+    }
+};
+
 Frustum::Frustum()
 {
     set(Matrix::identity());
@@ -108,6 +211,46 @@ bool Frustum::intersects(const BoundingBox& box) const
     return box.intersects(*this);
 }
 
+unsigned int Frustum::intersects(const BoundingSphere* spheres, unsigned int count, bool* results) const
+{
+    GP_ASSERT(spheres || count == 0);
+
+    const Plane* planes[6] = { &_near, &_far, &_left, &_right, &_bottom, &_top };
+    FrustumPlanes frustumPlanes(planes);
+    unsigned int intersecting = 0;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const BoundingSphere& sphere = spheres[i];
+        bool result = frustumPlanes.intersects(sphere.center.x, sphere.center.y, sphere.center.z, 0.0f, 0.0f, 0.0f, sphere.radius);
+        if (results)
+            results[i] = result;
+        if (result)
+            ++intersecting;
+    }
+    return intersecting;
+}
+
+unsigned int Frustum::intersects(const BoundingBox* boxes, unsigned int count, bool* results) const
+{
+    GP_ASSERT(boxes || count == 0);
+
+    const Plane* planes[6] = { &_near, &_far, &_left, &_right, &_bottom, &_top };
+    FrustumPlanes frustumPlanes(planes);
+    unsigned int intersecting = 0;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const Vector3& min = boxes[i].min;
+        const Vector3& max = boxes[i].max;
+        bool result = frustumPlanes.intersects((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f,
+                                               fabsf(max.x - min.x) * 0.5f, fabsf(max.y - min.y) * 0.5f, fabsf(max.z - min.z) * 0.5f, 0.0f);
+        if (results)
+            results[i] = result;
+        if (result)
+            ++intersecting;
+    }
+    return intersecting;
+}
+
 float Frustum::intersects(const Plane& plane) const
 {
     return plane.intersects(*this);
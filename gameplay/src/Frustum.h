@@ -151,6 +151,36 @@ public:
      */
     bool intersects(const BoundingBox& box) const;
 
+    /**
+     * Tests an array of bounding spheres for intersection with this frustum.
+     *
+     * This is equivalent to testing each sphere on its own, but the frustum planes
+     * are only set up once and the spheres are tested with SIMD instructions where available.
+     *
+     * @param spheres The array of bounding spheres to test.
+     * @param count The number of spheres in the array.
+     * @param results An array of count elements that receives whether each sphere intersects
+     *      this frustum, or NULL if only the number of intersecting spheres is needed.
+     *
+     * @return The number of spheres that intersect this frustum.
+     */
+    unsigned int intersects(const BoundingSphere* spheres, unsigned int count, bool* results) const;
+
+    /**
+     * Tests an array of bounding boxes for intersection with this frustum.
+     *
+     * This is equivalent to testing each box on its own, but the frustum planes
+     * are only set up once and the boxes are tested with SIMD instructions where available.
+     *
+     * @param boxes The array of bounding boxes to test.
+     * @param count The number of boxes in the array.
+     * @param results An array of count elements that receives whether each box intersects
+     *      this frustum, or NULL if only the number of intersecting boxes is needed.
+     *
+     * @return The number of boxes that intersect this frustum.
+     */
+    unsigned int intersects(const BoundingBox* boxes, unsigned int count, bool* results) const;
+
     /**
      * Tests whether this frustum intersects the specified plane.
      *
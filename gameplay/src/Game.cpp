@@ -5,6 +5,10 @@
 #include "FileSystem.h"
 #include "FrameBuffer.h"
 #include "SceneLoader.h"
+#include "MeshBatch.h"
+#include "MeshSkin.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
 
 /** @script{ignore} */
 GLenum __gl_error_code = GL_NO_ERROR;
@@ -24,7 +28,8 @@ Game::Game()
       _clearDepth(1.0f), _clearStencil(0), _properties(NULL),
       _animationController(NULL), _audioController(NULL),
       _physicsController(NULL), _aiController(NULL), _audioListener(NULL),
-      _timeEvents(NULL), _scriptController(NULL), _scriptListeners(NULL)
+      _timeEvents(NULL), _scriptController(NULL), _scriptListeners(NULL),
+      _jobSystem(NULL), _resourceLoader(NULL)
 {
     GP_ASSERT(__gameInstance == NULL);
     __gameInstance = this;
@@ -94,10 +99,56 @@ bool Game::startup()
     if (_state != UNINITIALIZED)
         return false;
 
+    // Objects released on other threads are destroyed on this one, which owns the graphics context.
+    Ref::setMainThread();
+
     setViewport(Rectangle(0.0f, 0.0f, (float)_width, (float)_height));
     RenderState::initialize();
     FrameBuffer::initialize();
 
+    // Start the job system, leaving one processor for the calling thread by default.
+    unsigned int workerCount = Thread::getProcessorCount() - 1;
+    Properties* jobs = _properties ? _properties->getNamespace("jobs", true) : NULL;
+    if (jobs && jobs->exists("workers"))
+        workerCount = (unsigned int)std::max(0, jobs->getInt("workers"));
+    _jobSystem = new JobSystem();
+    _jobSystem->initialize(workerCount);
+
+    // Configure the profiler.
+    Properties* profiler = _properties ? _properties->getNamespace("profiler", true) : NULL;
+    if (profiler)
+    {
+        if (profiler->exists("capacity"))
+            Profiler::setCapacity((unsigned int)std::max(1, profiler->getInt("capacity")));
+        Profiler::setEnabled(profiler->getBool("enabled", false));
+    }
+
+    // Set the memory budgets, which are given in kilobytes.
+    Properties* memory = _properties ? _properties->getNamespace("memory", true) : NULL;
+    if (memory)
+    {
+        for (unsigned int i = 0; i < MemoryTracker::CATEGORY_COUNT; ++i)
+        {
+            MemoryTracker::Category category = (MemoryTracker::Category)i;
+            const char* name = MemoryTracker::getCategoryName(category);
+            if (memory->exists(name))
+                MemoryTracker::setBudget(category, (size_t)std::max(0, memory->getInt(name)) * 1024);
+        }
+    }
+
+    // Start the resource loader threads.
+    unsigned int loaderThreadCount = 1;
+    _resourceLoader = new ResourceLoader();
+    Properties* loader = _properties ? _properties->getNamespace("loader", true) : NULL;
+    if (loader)
+    {
+        if (loader->exists("threads"))
+            loaderThreadCount = (unsigned int)std::max(0, loader->getInt("threads"));
+        if (loader->exists("uploadBudget"))
+            _resourceLoader->setUploadBudget(loader->getFloat("uploadBudget"));
+    }
+    _resourceLoader->initialize(loaderThreadCount);
+
     _animationController = new AnimationController();
     _animationController->initialize();
 
@@ -171,6 +222,10 @@ void Game::shutdown()
 		// Call user finalize
         finalize();
 
+        // Stop loading resources before the subsystems they are created with are released.
+        _resourceLoader->finalize();
+        SAFE_DELETE(_resourceLoader);
+
 		// Shutdown scripting system first so that any objects allocated in script are released before our subsystems are released
 		_scriptController->finalizeGame();
 		if (_scriptListeners)
@@ -201,6 +256,12 @@ void Game::shutdown()
         _aiController->finalize();
         SAFE_DELETE(_aiController);
 
+        _jobSystem->finalize();
+        SAFE_DELETE(_jobSystem);
+
+        // No other threads remain, so destroy the objects they released.
+        Ref::finishDeferredReleases();
+
         // Note: we do not clean up the script controller here
         // because users can call Game::exit() from a script.
 
@@ -300,21 +361,48 @@ void Game::frame()
         // Update AI.
         _aiController->update(elapsedTime);
 
+        // Destroy the objects that were released on other threads.
+        Ref::finishDeferredReleases();
+
+        // Finish the resources loaded in the background.
+        _resourceLoader->update();
+
         // Application Update.
-        update(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Game::update");
+            update(elapsedTime);
+        }
 
         // Run script update.
         _scriptController->update(elapsedTime);
 
+        // Resolve the world transforms that changed during the update.
+        Scene::updateAllTransforms();
+
+        // Update the matrix palettes of the skins whose joints moved.
+        MeshSkin::updateAllMatrixPalettes();
+
         // Audio Rendering.
         _audioController->update(elapsedTime);
 
         // Graphics Rendering.
-        render(elapsedTime);
+        {
+            GP_PROFILE_SCOPE("Game::render");
+            render(elapsedTime);
+        }
 
         // Run script render.
         _scriptController->render(elapsedTime);
 
+        // Start the vertex streaming statistics of the next frame.
+        MeshBatch::finishFrame();
+
+        // Summarize the profiler scopes of this frame.
+        Profiler::finishFrame();
+
+        // Check the memory budgets and start the allocation statistics of the next frame.
+        MemoryTracker::finishFrame();
+
         // Update FPS.
         ++_frameCount;
         if ((Game::getGameTime() - _frameLastFPS) >= 1000)
@@ -326,17 +414,44 @@ void Game::frame()
     }
 	else if (_state == Game::PAUSED)
     {
+        // Destroy the objects that were released on other threads.
+        Ref::finishDeferredReleases();
+
+        // Finish the resources loaded in the background.
+        _resourceLoader->update();
+
         // Application Update.
-        update(0);
+        {
+            GP_PROFILE_SCOPE("Game::update");
+            update(0);
+        }
 
         // Script update.
         _scriptController->update(0);
 
+        // Resolve the world transforms that changed during the update.
+        Scene::updateAllTransforms();
+
+        // Update the matrix palettes of the skins whose joints moved.
+        MeshSkin::updateAllMatrixPalettes();
+
         // Graphics Rendering.
-        render(0);
+        {
+            GP_PROFILE_SCOPE("Game::render");
+            render(0);
+        }
 
         // Script render.
         _scriptController->render(0);
+
+        // Start the vertex streaming statistics of the next frame.
+        MeshBatch::finishFrame();
+
+        // Summarize the profiler scopes of this frame.
+        Profiler::finishFrame();
+
+        // Check the memory budgets and start the allocation statistics of the next frame.
+        MemoryTracker::finishFrame();
     }
 }
 
@@ -14,6 +14,8 @@
 #include "Rectangle.h"
 #include "Vector4.h"
 #include "TimeListener.h"
+#include "JobSystem.h"
+#include "ResourceLoader.h"
 
 namespace gameplay
 {
@@ -258,6 +260,24 @@ public:
      */
     inline ScriptController* getScriptController() const;
 
+    /**
+     * Gets the job system for running work in parallel across worker threads.
+     *
+     * The number of worker threads defaults to one less than the number of processors
+     * and can be set with the 'workers' property of the 'jobs' namespace in game.config.
+     *
+     * @return The job system for this game.
+     * @script{ignore}
+     */
+    inline JobSystem* getJobSystem() const;
+
+    /**
+     * Gets the resource loader for loading resources in the background.
+     *
+     * @return The resource loader for this game.
+     */
+    inline ResourceLoader* getResourceLoader() const;
+
     /**
      * Gets the audio listener for 3D audio.
      * 
@@ -684,6 +704,8 @@ private:
     std::priority_queue<TimeEvent, std::vector<TimeEvent>, std::less<TimeEvent> >* _timeEvents;     // Contains the scheduled time events.
     ScriptController* _scriptController;            // Controls the scripting engine.
     std::vector<ScriptListener*>* _scriptListeners; // Lua script listeners.
+    JobSystem* _jobSystem;                      // Runs jobs across the worker threads.
+    ResourceLoader* _resourceLoader;            // Loads resources on background threads.
 
     // Note: Do not add STL object member variables on the stack; this will cause false memory leaks to be reported.
 
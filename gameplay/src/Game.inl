@@ -63,6 +63,16 @@ inline AIController* Game::getAIController() const
     return _aiController;
 }
 
+inline JobSystem* Game::getJobSystem() const
+{
+    return _jobSystem;
+}
+
+inline ResourceLoader* Game::getResourceLoader() const
+{
+    return _resourceLoader;
+}
+
 template <class T>
 void Game::renderOnce(T* instance, void (T::*method)(void*), void* cookie)
 {
@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "FileSystem.h"
 #include "Image.h"
+#include "MemoryTracker.h"
 
 namespace gameplay
 {
@@ -16,6 +17,8 @@ static void readStream(png_structp png, png_bytep data, png_size_t length)
 
 Image* Image::create(const char* path)
 {
+    GP_MEMORY_SCOPE(CATEGORY_TEXTURE);
+
     GP_ASSERT(path);
 
     // Open the file.
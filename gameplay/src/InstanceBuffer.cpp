@@ -0,0 +1,200 @@
+#include "Base.h"
+#include "InstanceBuffer.h"
+#include "Effect.h"
+
+// The number of floats of each instance: a 4x4 world matrix followed by a color.
+#define INSTANCE_FLOAT_COUNT 20
+#define INSTANCE_SIZE (INSTANCE_FLOAT_COUNT * sizeof(float))
+#define INSTANCE_COLOR_OFFSET (16 * sizeof(float))
+
+namespace gameplay
+{
+
+InstanceBuffer::InstanceBuffer(unsigned int capacity)
+    : _instanceCount(0), _handle(0), _bufferCapacity(0), _dirty(false), _matrixAttribute(-1), _colorAttribute(-1), _hardware(false)
+{
+    _data.reserve(capacity * INSTANCE_FLOAT_COUNT);
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+    if (_handle)
+    {
+        GL_ASSERT( glDeleteBuffers(1, &_handle) );
+        _handle = 0;
+    }
+}
+
+InstanceBuffer* InstanceBuffer::create(unsigned int capacity)
+{
+    return new InstanceBuffer(capacity);
+}
+
+bool InstanceBuffer::isHardwareInstancingSupported()
+{
+#ifdef USE_INSTANCING
+    static int supported = -1;
+    if (supported < 0)
+    {
+#ifdef GLEW_STATIC
+        supported = (glDrawArraysInstanced && glDrawElementsInstanced && glVertexAttribDivisor) ? 1 : 0;
+#else
+        const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+        supported = (extensions && strstr(extensions, "instanced_arrays")) ? 1 : 0;
+#endif
+    }
+    return supported != 0;
+#else
+    return false;
+#endif
+}
+
+unsigned int InstanceBuffer::getInstanceCount() const
+{
+    return _instanceCount;
+}
+
+unsigned int InstanceBuffer::getCapacity() const
+{
+    return (unsigned int)(_data.capacity() / INSTANCE_FLOAT_COUNT);
+}
+
+unsigned int InstanceBuffer::add(const Matrix& world, const Vector4& color)
+{
+    _data.resize(_data.size() + INSTANCE_FLOAT_COUNT);
+    set(_instanceCount, world, color);
+    return _instanceCount++;
+}
+
+void InstanceBuffer::set(unsigned int index, const Matrix& world, const Vector4& color)
+{
+    GP_ASSERT(index < _data.size() / INSTANCE_FLOAT_COUNT);
+
+    float* instance = &_data[index * INSTANCE_FLOAT_COUNT];
+    memcpy(instance, world.m, sizeof(world.m));
+    instance[16] = color.x;
+    instance[17] = color.y;
+    instance[18] = color.z;
+    instance[19] = color.w;
+    _dirty = true;
+}
+
+void InstanceBuffer::clear()
+{
+    _data.clear();
+    _instanceCount = 0;
+}
+
+bool InstanceBuffer::isInstanced(Effect* effect)
+{
+    GP_ASSERT(effect);
+    return effect->getVertexAttribute(VERTEX_ATTRIBUTE_INSTANCE_MATRIX_NAME) != -1;
+}
+
+bool InstanceBuffer::bind(Effect* effect, bool hardware)
+{
+    GP_ASSERT(effect);
+
+    _matrixAttribute = effect->getVertexAttribute(VERTEX_ATTRIBUTE_INSTANCE_MATRIX_NAME);
+    _colorAttribute = effect->getVertexAttribute(VERTEX_ATTRIBUTE_INSTANCE_COLOR_NAME);
+    if (_matrixAttribute == -1)
+    {
+        GP_WARN("Effect '%s' does not declare the per-instance attribute '%s'.", effect->getId(), VERTEX_ATTRIBUTE_INSTANCE_MATRIX_NAME);
+        return false;
+    }
+
+    _hardware = hardware && isHardwareInstancingSupported();
+    if (!_hardware)
+    {
+        // The attributes are set to the constant values of each instance by bindInstance().
+        GL_ASSERT( glDisableVertexAttribArray(_matrixAttribute) );
+        GL_ASSERT( glDisableVertexAttribArray(_matrixAttribute + 1) );
+        GL_ASSERT( glDisableVertexAttribArray(_matrixAttribute + 2) );
+        GL_ASSERT( glDisableVertexAttribArray(_matrixAttribute + 3) );
+        if (_colorAttribute != -1)
+        {
+            GL_ASSERT( glDisableVertexAttribArray(_colorAttribute) );
+        }
+        return true;
+    }
+
+#ifdef USE_INSTANCING
+    if (_handle == 0)
+    {
+        GL_ASSERT( glGenBuffers(1, &_handle) );
+    }
+    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, _handle) );
+
+    // Copy the instances to the vertex buffer, growing it when it is too small.
+    if (_instanceCount > _bufferCapacity)
+    {
+        _bufferCapacity = getCapacity();
+        GL_ASSERT( glBufferData(GL_ARRAY_BUFFER, _bufferCapacity * INSTANCE_SIZE, NULL, GL_DYNAMIC_DRAW) );
+        _dirty = true;
+    }
+    if (_dirty && _instanceCount > 0)
+    {
+        GL_ASSERT( glBufferSubData(GL_ARRAY_BUFFER, 0, _instanceCount * INSTANCE_SIZE, &_data[0]) );
+    }
+    _dirty = false;
+
+    // A mat4 attribute occupies four consecutive locations, one for each column.
+    for (GLuint i = 0; i < 4; ++i)
+    {
+        GL_ASSERT( glVertexAttribPointer(_matrixAttribute + i, 4, GL_FLOAT, GL_FALSE, INSTANCE_SIZE, (void*)(i * 4 * sizeof(float))) );
+        GL_ASSERT( glEnableVertexAttribArray(_matrixAttribute + i) );
+        GL_ASSERT( glVertexAttribDivisor(_matrixAttribute + i, 1) );
+    }
+    if (_colorAttribute != -1)
+    {
+        GL_ASSERT( glVertexAttribPointer(_colorAttribute, 4, GL_FLOAT, GL_FALSE, INSTANCE_SIZE, (void*)INSTANCE_COLOR_OFFSET) );
+        GL_ASSERT( glEnableVertexAttribArray(_colorAttribute) );
+        GL_ASSERT( glVertexAttribDivisor(_colorAttribute, 1) );
+    }
+    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, 0) );
+#endif
+
+    return true;
+}
+
+void InstanceBuffer::bindInstance(unsigned int index)
+{
+    GP_ASSERT(!_hardware);
+    GP_ASSERT(_matrixAttribute != -1);
+    GP_ASSERT(index < _instanceCount);
+
+    const float* instance = &_data[index * INSTANCE_FLOAT_COUNT];
+    GL_ASSERT( glVertexAttrib4fv(_matrixAttribute, instance) );
+    GL_ASSERT( glVertexAttrib4fv(_matrixAttribute + 1, instance + 4) );
+    GL_ASSERT( glVertexAttrib4fv(_matrixAttribute + 2, instance + 8) );
+    GL_ASSERT( glVertexAttrib4fv(_matrixAttribute + 3, instance + 12) );
+    if (_colorAttribute != -1)
+    {
+        GL_ASSERT( glVertexAttrib4fv(_colorAttribute, instance + 16) );
+    }
+}
+
+void InstanceBuffer::unbind()
+{
+#ifdef USE_INSTANCING
+    if (_hardware)
+    {
+        // Reset the attributes so that they do not affect later draws that use the same vertex array.
+        for (GLuint i = 0; i < 4; ++i)
+        {
+            GL_ASSERT( glVertexAttribDivisor(_matrixAttribute + i, 0) );
+            GL_ASSERT( glDisableVertexAttribArray(_matrixAttribute + i) );
+        }
+        if (_colorAttribute != -1)
+        {
+            GL_ASSERT( glVertexAttribDivisor(_colorAttribute, 0) );
+            GL_ASSERT( glDisableVertexAttribArray(_colorAttribute) );
+        }
+    }
+#endif
+    _matrixAttribute = -1;
+    _colorAttribute = -1;
+    _hardware = false;
+}
+
+}
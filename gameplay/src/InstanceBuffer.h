@@ -0,0 +1,156 @@
+#ifndef INSTANCEBUFFER_H_
+#define INSTANCEBUFFER_H_
+
+#include "Ref.h"
+#include "Matrix.h"
+#include "Vector4.h"
+
+namespace gameplay
+{
+
+class Effect;
+
+/**
+ * Defines a buffer of per-instance attributes, a world matrix and a color for each instance,
+ * used to draw many copies of a mesh with a single draw call.
+ *
+ * A model is drawn once for each instance in the buffer with Model::drawInstanced(). The effect
+ * of the model's material must declare the per-instance vertex attributes:
+ *
+ * @code
+ * attribute mat4 a_instanceMatrix;     // The world matrix of the instance.
+ * attribute vec4 a_instanceColor;      // The color of the instance (optional).
+ * @endcode
+ *
+ * and transform its vertices by a_instanceMatrix instead of the world matrix of the node (the
+ * built-in unlit shaders do so when INSTANCED is defined). Where hardware instancing is supported
+ * the instances are drawn with one draw call per mesh part and pass; otherwise the attributes are
+ * set for each instance in turn and the mesh is drawn once per instance, which still avoids
+ * binding the material again for each copy.
+ *
+ * The instances are kept in system memory and are copied to the GPU the next time the buffer is
+ * drawn after they change.
+ */
+class InstanceBuffer : public Ref
+{
+    friend class Model;
+    friend class RenderQueue;
+
+public:
+
+    /**
+     * Creates an empty instance buffer.
+     *
+     * @param capacity The number of instances to reserve space for.
+     *
+     * @return The new instance buffer.
+     * @script{create}
+     */
+    static InstanceBuffer* create(unsigned int capacity = 64);
+
+    /**
+     * Determines if the current device can draw instances with a single draw call.
+     *
+     * @return true if hardware instancing is supported, false otherwise.
+     */
+    static bool isHardwareInstancingSupported();
+
+    /**
+     * Gets the number of instances in the buffer.
+     *
+     * @return The number of instances.
+     */
+    unsigned int getInstanceCount() const;
+
+    /**
+     * Gets the number of instances that the buffer can hold before it must grow.
+     *
+     * @return The capacity of the buffer.
+     */
+    unsigned int getCapacity() const;
+
+    /**
+     * Adds an instance to the end of the buffer.
+     *
+     * @param world The world matrix of the instance.
+     * @param color The color of the instance.
+     *
+     * @return The index of the new instance.
+     */
+    unsigned int add(const Matrix& world, const Vector4& color = Vector4::one());
+
+    /**
+     * Sets the attributes of an instance in the buffer.
+     *
+     * @param index The index of the instance.
+     * @param world The world matrix of the instance.
+     * @param color The color of the instance.
+     */
+    void set(unsigned int index, const Matrix& world, const Vector4& color = Vector4::one());
+
+    /**
+     * Removes all of the instances from the buffer.
+     */
+    void clear();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    InstanceBuffer(unsigned int capacity);
+
+    /**
+     * Destructor.
+     */
+    ~InstanceBuffer();
+
+    /**
+     * Hidden copy constructor.
+     */
+    InstanceBuffer(const InstanceBuffer& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    InstanceBuffer& operator=(const InstanceBuffer&);
+
+    /**
+     * Determines if the effect declares the per-instance matrix attribute.
+     */
+    static bool isInstanced(Effect* effect);
+
+    /**
+     * Binds the per-instance attributes of the effect that is currently bound.
+     *
+     * @param effect The effect that is currently bound.
+     * @param hardware If true, bind the instances as vertex arrays that advance once per
+     *      instance; otherwise each instance is bound with bindInstance() before it is drawn.
+     *
+     * @return false if the effect does not declare the per-instance matrix attribute.
+     */
+    bool bind(Effect* effect, bool hardware);
+
+    /**
+     * Sets the per-instance attributes to the values of a single instance.
+     */
+    void bindInstance(unsigned int index);
+
+    /**
+     * Unbinds the per-instance attributes.
+     */
+    void unbind();
+
+    std::vector<float> _data;           // The world matrix and color of each instance.
+    unsigned int _instanceCount;        // The number of instances.
+    VertexBufferHandle _handle;         // The vertex buffer that the instances are copied to.
+    unsigned int _bufferCapacity;       // The number of instances the vertex buffer can hold.
+    bool _dirty;                        // Whether the vertex buffer is out of date.
+    VertexAttribute _matrixAttribute;   // The bound location of a_instanceMatrix, or -1.
+    VertexAttribute _colorAttribute;    // The bound location of a_instanceColor, or -1.
+    bool _hardware;                     // Whether the attributes are bound as instanced arrays.
+};
+
+}
+
+#endif
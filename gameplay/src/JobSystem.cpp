@@ -0,0 +1,353 @@
+#include "Base.h"
+#include "JobSystem.h"
+
+// The number of batches per thread a parallel-for is split into when no batch size is given.
+#define PARALLEL_FOR_BATCHES_PER_THREAD 4
+
+namespace gameplay
+{
+
+/**
+ * A single batch of a parallel-for.
+ */
+struct ParallelForBatch
+{
+    JobSystem::ParallelForFunction function;
+    void* arg;
+    unsigned int start;
+    unsigned int end;
+
+    static void run(void* arg)
+    {
+        ParallelForBatch* batch = (ParallelForBatch*)arg;
+        batch->function(batch->arg, batch->start, batch->end);
+    }
+};
+
+/**
+ * The startup data handed to each worker thread.
+ */
+struct WorkerStart
+{
+    JobSystem* jobSystem;
+    unsigned int index;
+};
+
+JobSystem::Job::Job(JobFunction function, void* arg)
+    : _function(function), _arg(arg), _parent(NULL), _unfinished(0), _pending(1), _finished(1)
+{
+}
+
+void JobSystem::Job::reset(JobFunction function, void* arg)
+{
+    GP_ASSERT(isFinished());
+
+    _function = function;
+    _arg = arg;
+    _parent = NULL;
+    _unfinished = 0;
+    _pending = 1;
+    _finished = 1;
+    _dependents.clear();
+}
+
+void JobSystem::Job::addDependency(Job* job)
+{
+    GP_ASSERT(job && job != this);
+
+    job->_dependents.push_back(this);
+    ++_pending;
+}
+
+bool JobSystem::Job::isFinished() const
+{
+    return atomicLoad(&_finished) != 0;
+}
+
+JobSystem::JobSystem()
+    : _running(0), _startedWorkers(0)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    finalize();
+}
+
+void JobSystem::initialize(unsigned int workerCount)
+{
+    GP_ASSERT(_queues.empty());
+
+    _running = 1;
+    _queues.resize(workerCount + 1);
+    _threadIds.resize(workerCount + 1);
+    for (unsigned int i = 0; i <= workerCount; ++i)
+    {
+        _queues[i] = new WorkQueue();
+    }
+    _threadIds[0] = Thread::getCurrentId();
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        WorkerStart* start = new WorkerStart();
+        start->jobSystem = this;
+        start->index = i + 1;
+        Thread* thread = Thread::create(workerMain, start);
+        if (thread == NULL)
+        {
+            SAFE_DELETE(start);
+            break;
+        }
+        _workers.push_back(thread);
+    }
+
+    // Wait for the workers to register their thread identifiers before any jobs are submitted.
+    while (atomicLoad(&_startedWorkers) < (int)_workers.size())
+    {
+        Thread::yield();
+    }
+
+    // Drop the queues of any workers that could not be started.
+    for (size_t i = _workers.size() + 1; i < _queues.size(); ++i)
+    {
+        SAFE_DELETE(_queues[i]);
+    }
+    _queues.resize(_workers.size() + 1);
+    _threadIds.resize(_workers.size() + 1);
+}
+
+void JobSystem::finalize()
+{
+    if (_queues.empty())
+        return;
+
+    atomicCompareAndSwap(&_running, 1, 0);
+    _wakeup.post(_workers.size());
+    for (size_t i = 0, count = _workers.size(); i < count; ++i)
+    {
+        _workers[i]->join();
+        SAFE_DELETE(_workers[i]);
+    }
+    _workers.clear();
+
+    for (size_t i = 0, count = _queues.size(); i < count; ++i)
+    {
+        GP_ASSERT(_queues[i]->jobs.empty());
+        SAFE_DELETE(_queues[i]);
+    }
+    _queues.clear();
+    _threadIds.clear();
+    _startedWorkers = 0;
+}
+
+unsigned int JobSystem::getWorkerCount() const
+{
+    return (unsigned int)_workers.size();
+}
+
+void JobSystem::submit(Job* job, Job* parent)
+{
+    GP_ASSERT(job);
+    GP_ASSERT(job->isFinished());
+    GP_ASSERT(!parent || !parent->isFinished());
+
+    job->_parent = parent;
+    job->_unfinished = 1;
+    job->_finished = 0;
+    if (parent)
+        atomicIncrement(&parent->_unfinished);
+
+    // Release the reference held until submission; the job is ready once no dependencies remain.
+    if (atomicDecrement(&job->_pending) == 0)
+        enqueue(&job, 1);
+}
+
+void JobSystem::wait(Job* job)
+{
+    GP_ASSERT(job);
+
+    unsigned int index = getQueueIndex();
+    while (!job->isFinished())
+    {
+        Job* next = _queues.empty() ? NULL : take(index);
+        if (next)
+            execute(next);
+        else
+            Thread::yield();
+    }
+}
+
+void JobSystem::parallelFor(unsigned int count, unsigned int batchSize, ParallelForFunction function, void* arg)
+{
+    GP_ASSERT(function);
+
+    if (count == 0)
+        return;
+
+    unsigned int threadCount = getWorkerCount() + 1;
+    if (batchSize == 0)
+        batchSize = (count + threadCount * PARALLEL_FOR_BATCHES_PER_THREAD - 1) / (threadCount * PARALLEL_FOR_BATCHES_PER_THREAD);
+    unsigned int batchCount = (count + batchSize - 1) / batchSize;
+
+    // Run small ranges inline rather than paying for the queueing.
+    if (threadCount == 1 || batchCount <= 1)
+    {
+        function(arg, 0, count);
+        return;
+    }
+
+    ParallelForBatch* batches = new ParallelForBatch[batchCount];
+    Job* jobs = new Job[batchCount];
+    Job** ready = new Job*[batchCount];
+
+    Job root;
+    root._unfinished = 1 + batchCount;
+    root._finished = 0;
+    for (unsigned int i = 0; i < batchCount; ++i)
+    {
+        ParallelForBatch& batch = batches[i];
+        batch.function = function;
+        batch.arg = arg;
+        batch.start = i * batchSize;
+        batch.end = std::min(count, batch.start + batchSize);
+
+        Job& job = jobs[i];
+        job._function = ParallelForBatch::run;
+        job._arg = &batch;
+        job._parent = &root;
+        job._unfinished = 1;
+        job._pending = 0;
+        job._finished = 0;
+        ready[i] = &job;
+    }
+    enqueue(ready, batchCount);
+
+    // Release the root's own unit of work and help out until every batch is done.
+    finish(&root);
+    wait(&root);
+
+    SAFE_DELETE_ARRAY(ready);
+    SAFE_DELETE_ARRAY(jobs);
+    SAFE_DELETE_ARRAY(batches);
+}
+
+unsigned int JobSystem::getQueueIndex() const
+{
+    unsigned int id = Thread::getCurrentId();
+    for (size_t i = 1, count = _threadIds.size(); i < count; ++i)
+    {
+        if (_threadIds[i] == id)
+            return (unsigned int)i;
+    }
+
+    // Any thread that is not a worker shares the owning thread's queue.
+    return 0;
+}
+
+void JobSystem::enqueue(Job** jobs, unsigned int count)
+{
+    if (_queues.empty())
+    {
+        // The job system is not running, so execute the jobs right away.
+        for (unsigned int i = 0; i < count; ++i)
+            execute(jobs[i]);
+        return;
+    }
+
+    WorkQueue* queue = _queues[getQueueIndex()];
+    queue->mutex.lock();
+    for (unsigned int i = 0; i < count; ++i)
+        queue->jobs.push_back(jobs[i]);
+    queue->mutex.unlock();
+
+    if (!_workers.empty())
+        _wakeup.post(std::min(count, (unsigned int)_workers.size()));
+}
+
+JobSystem::Job* JobSystem::take(unsigned int index)
+{
+    // Take the most recently pushed job from our own queue (it is most likely to be hot in cache).
+    WorkQueue* queue = _queues[index];
+    Job* job = NULL;
+    queue->mutex.lock();
+    if (!queue->jobs.empty())
+    {
+        job = queue->jobs.back();
+        queue->jobs.pop_back();
+    }
+    queue->mutex.unlock();
+    if (job)
+        return job;
+
+    // Steal the oldest job from another queue.
+    size_t count = _queues.size();
+    for (size_t i = 1; i < count; ++i)
+    {
+        WorkQueue* victim = _queues[(index + i) % count];
+        if (!victim->mutex.tryLock())
+            continue;
+        if (!victim->jobs.empty())
+        {
+            job = victim->jobs.front();
+            victim->jobs.pop_front();
+        }
+        victim->mutex.unlock();
+        if (job)
+            return job;
+    }
+
+    return NULL;
+}
+
+void JobSystem::execute(Job* job)
+{
+    GP_ASSERT(job);
+
+    if (job->_function)
+        job->_function(job->_arg);
+    finish(job);
+}
+
+void JobSystem::finish(Job* job)
+{
+    if (atomicDecrement(&job->_unfinished) > 0)
+        return;
+
+    // Release the jobs waiting on this one.
+    for (size_t i = 0, count = job->_dependents.size(); i < count; ++i)
+    {
+        Job* dependent = job->_dependents[i];
+        if (atomicDecrement(&dependent->_pending) == 0)
+            enqueue(&dependent, 1);
+    }
+
+    Job* parent = job->_parent;
+
+    // Mark the job finished last since a waiting thread may reuse it right away.
+    atomicCompareAndSwap(&job->_finished, 0, 1);
+
+    if (parent)
+        finish(parent);
+}
+
+void JobSystem::workerMain(void* arg)
+{
+    WorkerStart* start = (WorkerStart*)arg;
+    JobSystem* jobSystem = start->jobSystem;
+    unsigned int index = start->index;
+    SAFE_DELETE(start);
+
+    jobSystem->_threadIds[index] = Thread::getCurrentId();
+    atomicIncrement(&jobSystem->_startedWorkers);
+
+    while (atomicLoad(&jobSystem->_running))
+    {
+        Job* job = jobSystem->take(index);
+        if (job)
+            jobSystem->execute(job);
+        else
+            jobSystem->_wakeup.wait();
+    }
+}
+
+}
@@ -0,0 +1,228 @@
+#ifndef JOBSYSTEM_H_
+#define JOBSYSTEM_H_
+
+#include "Thread.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a work-stealing job system for running work across the available processor cores.
+ *
+ * The job system owns a pool of worker threads, each with its own queue of jobs. Threads
+ * take work from the back of their own queue and steal from the front of other queues when
+ * they run out. The thread that created the job system (normally the main game thread) also
+ * has a queue and executes jobs whenever it waits for a job to finish, so submitting work and
+ * then waiting on it never leaves the calling core idle.
+ *
+ * Jobs can be organized as a dependency graph by declaring dependencies between jobs before
+ * they are submitted, or grouped by submitting child jobs to a parent job. For data parallel
+ * work over arrays, use parallelFor().
+ *
+ * The job system is created and owned by the Game and is accessed through Game::getJobSystem().
+ *
+ * @script{ignore}
+ */
+class JobSystem
+{
+    friend class Game;
+
+public:
+
+    /**
+     * The function signature for a job entry point.
+     */
+    typedef void (*JobFunction)(void* arg);
+
+    /**
+     * The function signature for a parallel-for batch.
+     *
+     * The function is called with a range of indices [start, end) to process.
+     */
+    typedef void (*ParallelForFunction)(void* arg, unsigned int start, unsigned int end);
+
+    /**
+     * Defines a unit of work that can be run by the job system.
+     *
+     * Jobs are owned by the caller and must remain valid until they have finished. A job
+     * may be reused once it has finished by calling reset().
+     */
+    class Job
+    {
+        friend class JobSystem;
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param function The function to run, or NULL for a job that only groups other jobs.
+         * @param arg The argument passed to the function.
+         */
+        Job(JobFunction function = NULL, void* arg = NULL);
+
+        /**
+         * Resets the job so that it can be submitted again.
+         *
+         * This clears all dependencies declared on or by this job.
+         *
+         * @param function The function to run, or NULL for a job that only groups other jobs.
+         * @param arg The argument passed to the function.
+         */
+        void reset(JobFunction function, void* arg);
+
+        /**
+         * Declares that this job may not start until the specified job has finished.
+         *
+         * Dependencies must be declared before either job is submitted.
+         *
+         * @param job The job this job depends on.
+         */
+        void addDependency(Job* job);
+
+        /**
+         * Determines if the job has finished, including all of its child jobs.
+         *
+         * Jobs that have never been submitted are reported as finished.
+         *
+         * @return true if the job has finished; false otherwise.
+         */
+        bool isFinished() const;
+
+    private:
+
+        Job(const Job& copy);
+        Job& operator=(const Job&);
+
+        JobFunction _function;
+        void* _arg;
+        Job* _parent;
+        volatile int _unfinished;       // Outstanding work: the job itself plus each unfinished child.
+        volatile int _pending;          // Unfinished dependencies plus one that is released on submit.
+        volatile int _finished;         // Set once the job and all of its children have completed.
+        std::vector<Job*> _dependents;  // Jobs waiting for this job to finish.
+    };
+
+    /**
+     * Gets the number of worker threads (not including the thread that owns the job system).
+     *
+     * @return The number of worker threads.
+     */
+    unsigned int getWorkerCount() const;
+
+    /**
+     * Submits a job to be run.
+     *
+     * The job is queued once all of its dependencies have finished. If a parent is specified,
+     * the parent job is not considered finished until this job has finished. The parent must
+     * be running or submitted but not yet finished.
+     *
+     * @param job The job to submit.
+     * @param parent The parent job, or NULL.
+     */
+    void submit(Job* job, Job* parent = NULL);
+
+    /**
+     * Waits for a job to finish, running other queued jobs on the calling thread meanwhile.
+     *
+     * @param job The job to wait for.
+     */
+    void wait(Job* job);
+
+    /**
+     * Calls a function over the range [0, count) split into batches that run in parallel.
+     *
+     * This method blocks until every batch has finished. The calling thread runs batches
+     * as well, so it is safe to call from inside another job.
+     *
+     * @param count The number of elements to process.
+     * @param batchSize The minimum number of elements per batch, or 0 to pick one from the worker count.
+     * @param function The function to call for each batch.
+     * @param arg The argument passed to the function.
+     */
+    void parallelFor(unsigned int count, unsigned int batchSize, ParallelForFunction function, void* arg);
+
+private:
+
+    /**
+     * The per-thread queue of jobs.
+     */
+    struct WorkQueue
+    {
+        Mutex mutex;
+        std::deque<Job*> jobs;
+    };
+
+    /**
+     * Constructor.
+     */
+    JobSystem();
+
+    /**
+     * Hidden copy constructor.
+     */
+    JobSystem(const JobSystem& copy);
+
+    /**
+     * Destructor.
+     */
+    ~JobSystem();
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    JobSystem& operator=(const JobSystem&);
+
+    /**
+     * Starts the worker threads.
+     *
+     * @param workerCount The number of worker threads to start.
+     */
+    void initialize(unsigned int workerCount);
+
+    /**
+     * Stops and joins the worker threads.
+     */
+    void finalize();
+
+    /**
+     * Gets the index of the queue belonging to the calling thread.
+     */
+    unsigned int getQueueIndex() const;
+
+    /**
+     * Pushes jobs that are ready to run onto the calling thread's queue and wakes the workers.
+     */
+    void enqueue(Job** jobs, unsigned int count);
+
+    /**
+     * Takes the next job for the queue at the specified index, stealing from other queues when empty.
+     */
+    Job* take(unsigned int index);
+
+    /**
+     * Runs a job and signals its completion.
+     */
+    void execute(Job* job);
+
+    /**
+     * Releases one unit of outstanding work on the job, completing it when none remains.
+     */
+    void finish(Job* job);
+
+    /**
+     * Worker thread entry point.
+     */
+    static void workerMain(void* arg);
+
+    std::vector<WorkQueue*> _queues;        // Job queues; index 0 belongs to the owning thread.
+    std::vector<unsigned int> _threadIds;   // Thread identifiers matching each queue.
+    std::vector<Thread*> _workers;          // The worker threads.
+    Semaphore _wakeup;                      // Signaled when jobs are queued.
+    volatile int _running;                  // Whether the worker threads should keep running.
+    volatile int _startedWorkers;           // Number of workers that have registered their thread identifier.
+};
+
+}
+
+#endif
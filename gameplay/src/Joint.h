@@ -71,12 +71,14 @@ protected:
     void setInverseBindPose(const Matrix& m);
 
     /**
-     * Updates the joint matrix.
-     * 
-     * @param bindShape The bind shape matrix.
-     * @param matrixPalette The matrix palette to update.
+     * Gets a number that changes whenever the world matrix of the joint changes.
+     */
+    unsigned int getTransformVersion() const;
+
+    /**
+     * Gets a number that changes whenever the inverse bind pose of the joint changes.
      */
-    void updateJointMatrix(const Matrix& bindShape, Vector4* matrixPalette);
+    unsigned int getBindPoseVersion() const;
 
     /**
      * Called when this Joint's transform changes.
@@ -103,9 +105,15 @@ protected:
     Matrix _bindPose;
     
     /** 
-     * Flag used to mark if the Joint's matrix is dirty.
+     * Incremented whenever the Joint's world matrix changes, so that each MeshSkin can tell
+     * which of its palette matrices are out of date.
+     */
+    unsigned int _transformVersion;
+
+    /** 
+     * Incremented whenever the Joint's bind pose changes.
      */
-    bool _jointMatrixDirty;
+    unsigned int _bindPoseVersion;
     
     /** 
      * The number of MeshSkin's influencing the Joint.
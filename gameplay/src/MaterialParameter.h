@@ -37,6 +37,7 @@ namespace gameplay
 class MaterialParameter : public AnimationTarget, public Ref
 {
     friend class RenderState;
+    friend class RenderQueue;
 
 public:
 
@@ -10,6 +10,7 @@ class MathUtil
 {
     friend class Matrix;
     friend class Vector3;
+    friend class MeshSkin;
 
 public:
 
@@ -62,6 +63,12 @@ private:
 
     inline static void transformVector4(const float* m, const float* v, float* dst);
 
+    // Transforms count (x, y, z) triples extended with w, writing dstComponents (3 or 4) floats for each.
+    inline static void transformVector3Array(const float* m, const float* v, unsigned int count, float w, float* dst, unsigned int dstComponents);
+
+    // Multiplies two affine matrices and writes the first three rows of the product, one after the other (12 floats).
+    inline static void multiplyAffineMatrixRows(const float* m1, const float* m2, float* dst);
+
     inline static void crossVector3(const float* v1, const float* v2, float* dst);
 
     MathUtil();
@@ -73,6 +80,8 @@ private:
 
 #ifdef USE_NEON
 #include "MathUtilNeon.inl"
+#elif defined(USE_SSE)
+#include "MathUtilSSE.inl"
 #else
 #include "MathUtil.inl"
 #endif
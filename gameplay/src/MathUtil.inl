@@ -161,6 +161,37 @@ inline void MathUtil::transformVector4(const float* m, const float* v, float* ds
     dst[3] = w;
 }
 
+inline void MathUtil::transformVector3Array(const float* m, const float* v, unsigned int count, float w, float* dst, unsigned int dstComponents)
+{
+    for (unsigned int i = 0; i < count; ++i, v += 3, dst += dstComponents)
+    {
+        // Handle case where v == dst.
+        float x = v[0] * m[0] + v[1] * m[4] + v[2] * m[8] + w * m[12];
+        float y = v[0] * m[1] + v[1] * m[5] + v[2] * m[9] + w * m[13];
+        float z = v[0] * m[2] + v[1] * m[6] + v[2] * m[10] + w * m[14];
+        if (dstComponents == 4)
+            dst[3] = v[0] * m[3] + v[1] * m[7] + v[2] * m[11] + w * m[15];
+
+        dst[0] = x;
+        dst[1] = y;
+        dst[2] = z;
+    }
+}
+
+inline void MathUtil::multiplyAffineMatrixRows(const float* m1, const float* m2, float* dst)
+{
+    // The last rows of both matrices are (0, 0, 0, 1), so they are not read and the last row of
+    // the product is not computed.
+    for (int r = 0; r < 3; ++r, dst += 4)
+    {
+        float a0 = m1[r], a1 = m1[r + 4], a2 = m1[r + 8], a3 = m1[r + 12];
+        dst[0] = a0 * m2[0] + a1 * m2[1] + a2 * m2[2];
+        dst[1] = a0 * m2[4] + a1 * m2[5] + a2 * m2[6];
+        dst[2] = a0 * m2[8] + a1 * m2[9] + a2 * m2[10];
+        dst[3] = a0 * m2[12] + a1 * m2[13] + a2 * m2[14] + a3;
+    }
+}
+
 inline void MathUtil::crossVector3(const float* v1, const float* v2, float* dst)
 {
     float x = (v1[1] * v2[2]) - (v1[2] * v2[1]);
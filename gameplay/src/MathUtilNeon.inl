@@ -201,6 +201,36 @@ inline void MathUtil::transformVector4(const float* m, const float* v, float* ds
     );
 }
 
+inline void MathUtil::transformVector3Array(const float* m, const float* v, unsigned int count, float w, float* dst, unsigned int dstComponents)
+{
+    for (unsigned int i = 0; i < count; ++i, v += 3, dst += dstComponents)
+    {
+        if (dstComponents == 4)
+        {
+            float vector[4] = { v[0], v[1], v[2], w };
+            transformVector4(m, vector, dst);
+        }
+        else
+        {
+            transformVector4(m, v[0], v[1], v[2], w, dst);
+        }
+    }
+}
+
+inline void MathUtil::multiplyAffineMatrixRows(const float* m1, const float* m2, float* dst)
+{
+    // The full product is computed with the NEON multiply and its first three rows are gathered.
+    float product[16];
+    multiplyMatrix(m1, m2, product);
+    for (int r = 0; r < 3; ++r, dst += 4)
+    {
+        dst[0] = product[r];
+        dst[1] = product[r + 4];
+        dst[2] = product[r + 8];
+        dst[3] = product[r + 12];
+    }
+}
+
 inline void MathUtil::crossVector3(const float* v1, const float* v2, float* dst)
 {
     asm volatile(
@@ -0,0 +1,242 @@
+#include <emmintrin.h>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+// Matrices are stored in column-major order, so the columns are loaded as vectors. Unaligned
+// loads and stores are used throughout, since they are as fast as aligned ones on aligned data
+// and the matrices and vectors used by the engine are not guaranteed to be 16-byte aligned.
+
+namespace gameplay
+{
+
+inline void MathUtil::addMatrix(const float* m, float scalar, float* dst)
+{
+    __m128 s = _mm_set1_ps(scalar);
+    __m128 c0 = _mm_add_ps(_mm_loadu_ps(&m[0]), s);
+    __m128 c1 = _mm_add_ps(_mm_loadu_ps(&m[4]), s);
+    __m128 c2 = _mm_add_ps(_mm_loadu_ps(&m[8]), s);
+    __m128 c3 = _mm_add_ps(_mm_loadu_ps(&m[12]), s);
+    _mm_storeu_ps(&dst[0], c0);
+    _mm_storeu_ps(&dst[4], c1);
+    _mm_storeu_ps(&dst[8], c2);
+    _mm_storeu_ps(&dst[12], c3);
+}
+
+inline void MathUtil::addMatrix(const float* m1, const float* m2, float* dst)
+{
+    __m128 c0 = _mm_add_ps(_mm_loadu_ps(&m1[0]), _mm_loadu_ps(&m2[0]));
+    __m128 c1 = _mm_add_ps(_mm_loadu_ps(&m1[4]), _mm_loadu_ps(&m2[4]));
+    __m128 c2 = _mm_add_ps(_mm_loadu_ps(&m1[8]), _mm_loadu_ps(&m2[8]));
+    __m128 c3 = _mm_add_ps(_mm_loadu_ps(&m1[12]), _mm_loadu_ps(&m2[12]));
+    _mm_storeu_ps(&dst[0], c0);
+    _mm_storeu_ps(&dst[4], c1);
+    _mm_storeu_ps(&dst[8], c2);
+    _mm_storeu_ps(&dst[12], c3);
+}
+
+inline void MathUtil::subtractMatrix(const float* m1, const float* m2, float* dst)
+{
+    __m128 c0 = _mm_sub_ps(_mm_loadu_ps(&m1[0]), _mm_loadu_ps(&m2[0]));
+    __m128 c1 = _mm_sub_ps(_mm_loadu_ps(&m1[4]), _mm_loadu_ps(&m2[4]));
+    __m128 c2 = _mm_sub_ps(_mm_loadu_ps(&m1[8]), _mm_loadu_ps(&m2[8]));
+    __m128 c3 = _mm_sub_ps(_mm_loadu_ps(&m1[12]), _mm_loadu_ps(&m2[12]));
+    _mm_storeu_ps(&dst[0], c0);
+    _mm_storeu_ps(&dst[4], c1);
+    _mm_storeu_ps(&dst[8], c2);
+    _mm_storeu_ps(&dst[12], c3);
+}
+
+inline void MathUtil::multiplyMatrix(const float* m, float scalar, float* dst)
+{
+    __m128 s = _mm_set1_ps(scalar);
+    __m128 c0 = _mm_mul_ps(_mm_loadu_ps(&m[0]), s);
+    __m128 c1 = _mm_mul_ps(_mm_loadu_ps(&m[4]), s);
+    __m128 c2 = _mm_mul_ps(_mm_loadu_ps(&m[8]), s);
+    __m128 c3 = _mm_mul_ps(_mm_loadu_ps(&m[12]), s);
+    _mm_storeu_ps(&dst[0], c0);
+    _mm_storeu_ps(&dst[4], c1);
+    _mm_storeu_ps(&dst[8], c2);
+    _mm_storeu_ps(&dst[12], c3);
+}
+
+#ifdef __AVX__
+
+inline void MathUtil::multiplyMatrix(const float* m1, const float* m2, float* dst)
+{
+    // Each column of m1 is loaded into both halves of a register, so that two columns of the
+    // product are computed at once. All of the inputs are loaded before the product is stored,
+    // which supports the case where m1 or m2 is the same array as dst.
+    __m256 a0 = _mm256_broadcast_ps((const __m128*)&m1[0]);
+    __m256 a1 = _mm256_broadcast_ps((const __m128*)&m1[4]);
+    __m256 a2 = _mm256_broadcast_ps((const __m128*)&m1[8]);
+    __m256 a3 = _mm256_broadcast_ps((const __m128*)&m1[12]);
+    __m256 b01 = _mm256_loadu_ps(&m2[0]);
+    __m256 b23 = _mm256_loadu_ps(&m2[8]);
+
+    __m256 p01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+    p01 = _mm256_add_ps(p01, _mm256_mul_ps(a1, _mm256_permute_ps(b01, 0x55)));
+    p01 = _mm256_add_ps(p01, _mm256_mul_ps(a2, _mm256_permute_ps(b01, 0xAA)));
+    p01 = _mm256_add_ps(p01, _mm256_mul_ps(a3, _mm256_permute_ps(b01, 0xFF)));
+
+    __m256 p23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+    p23 = _mm256_add_ps(p23, _mm256_mul_ps(a1, _mm256_permute_ps(b23, 0x55)));
+    p23 = _mm256_add_ps(p23, _mm256_mul_ps(a2, _mm256_permute_ps(b23, 0xAA)));
+    p23 = _mm256_add_ps(p23, _mm256_mul_ps(a3, _mm256_permute_ps(b23, 0xFF)));
+
+    _mm256_storeu_ps(&dst[0], p01);
+    _mm256_storeu_ps(&dst[8], p23);
+}
+
+#else
+
+inline void MathUtil::multiplyMatrix(const float* m1, const float* m2, float* dst)
+{
+    // All of the inputs are loaded before the product is stored, which supports the case
+    // where m1 or m2 is the same array as dst.
+    __m128 a0 = _mm_loadu_ps(&m1[0]);
+    __m128 a1 = _mm_loadu_ps(&m1[4]);
+    __m128 a2 = _mm_loadu_ps(&m1[8]);
+    __m128 a3 = _mm_loadu_ps(&m1[12]);
+    __m128 b[4] = { _mm_loadu_ps(&m2[0]), _mm_loadu_ps(&m2[4]), _mm_loadu_ps(&m2[8]), _mm_loadu_ps(&m2[12]) };
+
+    __m128 product[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        __m128 p = _mm_mul_ps(a0, _mm_shuffle_ps(b[i], b[i], _MM_SHUFFLE(0, 0, 0, 0)));
+        p = _mm_add_ps(p, _mm_mul_ps(a1, _mm_shuffle_ps(b[i], b[i], _MM_SHUFFLE(1, 1, 1, 1))));
+        p = _mm_add_ps(p, _mm_mul_ps(a2, _mm_shuffle_ps(b[i], b[i], _MM_SHUFFLE(2, 2, 2, 2))));
+        p = _mm_add_ps(p, _mm_mul_ps(a3, _mm_shuffle_ps(b[i], b[i], _MM_SHUFFLE(3, 3, 3, 3))));
+        product[i] = p;
+    }
+
+    _mm_storeu_ps(&dst[0], product[0]);
+    _mm_storeu_ps(&dst[4], product[1]);
+    _mm_storeu_ps(&dst[8], product[2]);
+    _mm_storeu_ps(&dst[12], product[3]);
+}
+
+#endif
+
+inline void MathUtil::negateMatrix(const float* m, float* dst)
+{
+    // Flip the sign bits.
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 c0 = _mm_xor_ps(_mm_loadu_ps(&m[0]), sign);
+    __m128 c1 = _mm_xor_ps(_mm_loadu_ps(&m[4]), sign);
+    __m128 c2 = _mm_xor_ps(_mm_loadu_ps(&m[8]), sign);
+    __m128 c3 = _mm_xor_ps(_mm_loadu_ps(&m[12]), sign);
+    _mm_storeu_ps(&dst[0], c0);
+    _mm_storeu_ps(&dst[4], c1);
+    _mm_storeu_ps(&dst[8], c2);
+    _mm_storeu_ps(&dst[12], c3);
+}
+
+inline void MathUtil::transposeMatrix(const float* m, float* dst)
+{
+    __m128 c0 = _mm_loadu_ps(&m[0]);
+    __m128 c1 = _mm_loadu_ps(&m[4]);
+    __m128 c2 = _mm_loadu_ps(&m[8]);
+    __m128 c3 = _mm_loadu_ps(&m[12]);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(&dst[0], c0);
+    _mm_storeu_ps(&dst[4], c1);
+    _mm_storeu_ps(&dst[8], c2);
+    _mm_storeu_ps(&dst[12], c3);
+}
+
+inline void MathUtil::transformVector4(const float* m, float x, float y, float z, float w, float* dst)
+{
+    __m128 p = _mm_mul_ps(_mm_loadu_ps(&m[0]), _mm_set1_ps(x));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(&m[4]), _mm_set1_ps(y)));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(&m[8]), _mm_set1_ps(z)));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(&m[12]), _mm_set1_ps(w)));
+
+    // The destination only holds three components.
+    _mm_storel_pi((__m64*)&dst[0], p);
+    _mm_store_ss(&dst[2], _mm_movehl_ps(p, p));
+}
+
+inline void MathUtil::transformVector4(const float* m, const float* v, float* dst)
+{
+    // Load v before storing, to handle the case where v == dst.
+    __m128 vector = _mm_loadu_ps(v);
+    __m128 p = _mm_mul_ps(_mm_loadu_ps(&m[0]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(0, 0, 0, 0)));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(&m[4]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(1, 1, 1, 1))));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(&m[8]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(2, 2, 2, 2))));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_loadu_ps(&m[12]), _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3))));
+    _mm_storeu_ps(dst, p);
+}
+
+inline void MathUtil::transformVector3Array(const float* m, const float* v, unsigned int count, float w, float* dst, unsigned int dstComponents)
+{
+    // The columns stay in registers for the whole array, and the w column is scaled once.
+    __m128 c0 = _mm_loadu_ps(&m[0]);
+    __m128 c1 = _mm_loadu_ps(&m[4]);
+    __m128 c2 = _mm_loadu_ps(&m[8]);
+    __m128 c3 = _mm_mul_ps(_mm_loadu_ps(&m[12]), _mm_set1_ps(w));
+
+    // Each vector is loaded before its result is stored, to handle the case where v == dst.
+    if (dstComponents == 4)
+    {
+        for (unsigned int i = 0; i < count; ++i, v += 3, dst += 4)
+        {
+            __m128 p = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(v[0])));
+            p = _mm_add_ps(p, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+            p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+            _mm_storeu_ps(dst, p);
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < count; ++i, v += 3, dst += 3)
+        {
+            __m128 p = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(v[0])));
+            p = _mm_add_ps(p, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+            p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+            _mm_storel_pi((__m64*)&dst[0], p);
+            _mm_store_ss(&dst[2], _mm_movehl_ps(p, p));
+        }
+    }
+}
+
+inline void MathUtil::multiplyAffineMatrixRows(const float* m1, const float* m2, float* dst)
+{
+    // The last rows of both matrices are (0, 0, 0, 1), so each column of the product needs three
+    // multiplies, and the translation column of m1 is only added to the last one. The columns
+    // are then transposed into rows, of which the first three are stored.
+    __m128 a0 = _mm_loadu_ps(&m1[0]);
+    __m128 a1 = _mm_loadu_ps(&m1[4]);
+    __m128 a2 = _mm_loadu_ps(&m1[8]);
+    __m128 a3 = _mm_loadu_ps(&m1[12]);
+
+    __m128 p[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        const float* b = &m2[i * 4];
+        p[i] = _mm_mul_ps(a0, _mm_set1_ps(b[0]));
+        p[i] = _mm_add_ps(p[i], _mm_mul_ps(a1, _mm_set1_ps(b[1])));
+        p[i] = _mm_add_ps(p[i], _mm_mul_ps(a2, _mm_set1_ps(b[2])));
+    }
+    p[3] = _mm_add_ps(p[3], a3);
+
+    _MM_TRANSPOSE4_PS(p[0], p[1], p[2], p[3]);
+    _mm_storeu_ps(&dst[0], p[0]);
+    _mm_storeu_ps(&dst[4], p[1]);
+    _mm_storeu_ps(&dst[8], p[2]);
+}
+
+inline void MathUtil::crossVector3(const float* v1, const float* v2, float* dst)
+{
+    // Vector3 only holds three components, so a four-wide load could read past its end;
+    // the cross product stays scalar.
+    float x = (v1[1] * v2[2]) - (v1[2] * v2[1]);
+    float y = (v1[2] * v2[0]) - (v1[0] * v2[2]);
+    float z = (v1[0] * v2[1]) - (v1[1] * v2[0]);
+
+    dst[0] = x;
+    dst[1] = y;
+    dst[2] = z;
+}
+
+}
@@ -798,6 +798,41 @@ public:
      */
     void transformVector(const Vector4& vector, Vector4* dst) const;
 
+    /**
+     * Transforms an array of points by this matrix.
+     *
+     * This is equivalent to calling transformPoint() for each point, but avoids the
+     * per-call overhead and uses SIMD instructions where available.
+     *
+     * @param points The array of points to transform.
+     * @param count The number of points in the array.
+     * @param dst An array of count points to store the transformed points in (may be points).
+     */
+    void transformPoints(const Vector3* points, unsigned int count, Vector3* dst) const;
+
+    /**
+     * Transforms an array of points by this matrix, keeping the fourth (w) coordinate
+     * of the results, as needed for points transformed by a projection matrix.
+     *
+     * @param points The array of points to transform.
+     * @param count The number of points in the array.
+     * @param dst An array of count vectors to store the transformed points in.
+     */
+    void transformPoints(const Vector3* points, unsigned int count, Vector4* dst) const;
+
+    /**
+     * Transforms an array of vectors by this matrix by treating the fourth (w)
+     * coordinate as zero.
+     *
+     * This is equivalent to calling transformVector() for each vector, but avoids the
+     * per-call overhead and uses SIMD instructions where available.
+     *
+     * @param vectors The array of vectors to transform.
+     * @param count The number of vectors in the array.
+     * @param dst An array of count vectors to store the transformed vectors in (may be vectors).
+     */
+    void transformVectors(const Vector3* vectors, unsigned int count, Vector3* dst) const;
+
     /**
      * Post-multiplies this matrix by the matrix corresponding to the
      * specified translation.
@@ -0,0 +1,298 @@
+#include "Base.h"
+#include "MemoryTracker.h"
+#include "Thread.h"
+#include <new>
+
+// The number of threads whose current category can be set.
+#define MEMORY_TRACKER_MAX_THREADS 64
+
+// The size of the header in front of each allocation made with the global new operator, which
+// holds the size and category of the allocation (kept at 16 bytes so the allocation stays aligned).
+#define MEMORY_TRACKER_HEADER_SIZE 16
+
+namespace gameplay
+{
+
+static const char* __categoryNames[MemoryTracker::CATEGORY_COUNT] =
+{
+    "other",
+    "texture",
+    "mesh",
+    "animation",
+    "physics",
+    "ui",
+    "script"
+};
+
+// These are plain arrays so that they are initialized before any allocation is made.
+static unsigned char __threadCategories[MEMORY_TRACKER_MAX_THREADS];
+static volatile long long __liveBytes[MemoryTracker::CATEGORY_COUNT];
+static volatile long long __peakBytes[MemoryTracker::CATEGORY_COUNT];
+static volatile int __liveCounts[MemoryTracker::CATEGORY_COUNT];
+static volatile int __frameCounts[MemoryTracker::CATEGORY_COUNT];
+static volatile long long __frameBytes[MemoryTracker::CATEGORY_COUNT];
+static unsigned int __lastFrameCounts[MemoryTracker::CATEGORY_COUNT];
+static size_t __lastFrameBytes[MemoryTracker::CATEGORY_COUNT];
+static size_t __budgets[MemoryTracker::CATEGORY_COUNT];
+static bool __overBudget[MemoryTracker::CATEGORY_COUNT];
+
+/**
+ * Counts an allocation against a category.
+ */
+static void countAllocation(MemoryTracker::Category category, size_t size)
+{
+    long long live = atomicAdd(&__liveBytes[category], (long long)size) + (long long)size;
+    atomicIncrement(&__liveCounts[category]);
+    atomicIncrement(&__frameCounts[category]);
+    atomicAdd(&__frameBytes[category], (long long)size);
+
+    // Raise the peak, unless another thread raised it further in the meantime.
+    long long peak = atomicLoad(&__peakBytes[category]);
+    while (live > peak && !atomicCompareAndSwap(&__peakBytes[category], peak, live))
+    {
+        peak = atomicLoad(&__peakBytes[category]);
+    }
+}
+
+/**
+ * Counts the free of an allocation against the category it was allocated in.
+ */
+static void countFree(MemoryTracker::Category category, size_t size)
+{
+    atomicAdd(&__liveBytes[category], -(long long)size);
+    atomicDecrement(&__liveCounts[category]);
+}
+
+MemoryTracker::Scope::Scope(Category category)
+    : _previous(CATEGORY_OTHER)
+{
+    unsigned int thread = Thread::getCurrentId();
+    if (thread < MEMORY_TRACKER_MAX_THREADS)
+    {
+        _previous = (Category)__threadCategories[thread];
+        __threadCategories[thread] = (unsigned char)category;
+    }
+}
+
+MemoryTracker::Scope::~Scope()
+{
+    unsigned int thread = Thread::getCurrentId();
+    if (thread < MEMORY_TRACKER_MAX_THREADS)
+        __threadCategories[thread] = (unsigned char)_previous;
+}
+
+const char* MemoryTracker::getCategoryName(Category category)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    return __categoryNames[category];
+}
+
+MemoryTracker::Category MemoryTracker::getCurrentCategory()
+{
+    unsigned int thread = Thread::getCurrentId();
+    return thread < MEMORY_TRACKER_MAX_THREADS ? (Category)__threadCategories[thread] : CATEGORY_OTHER;
+}
+
+size_t MemoryTracker::getLiveBytes(Category category)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    return (size_t)atomicLoad(&__liveBytes[category]);
+}
+
+size_t MemoryTracker::getPeakBytes(Category category)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    return (size_t)atomicLoad(&__peakBytes[category]);
+}
+
+unsigned int MemoryTracker::getLiveAllocationCount(Category category)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    return (unsigned int)atomicLoad(&__liveCounts[category]);
+}
+
+unsigned int MemoryTracker::getFrameAllocationCount(Category category)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    return __lastFrameCounts[category];
+}
+
+size_t MemoryTracker::getFrameAllocationBytes(Category category)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    return __lastFrameBytes[category];
+}
+
+size_t MemoryTracker::getBudget(Category category)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    return __budgets[category];
+}
+
+void MemoryTracker::setBudget(Category category, size_t bytes)
+{
+    GP_ASSERT(category < CATEGORY_COUNT);
+    __budgets[category] = bytes;
+    __overBudget[category] = false;
+}
+
+void MemoryTracker::printStatistics()
+{
+    for (unsigned int i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        Category category = (Category)i;
+        print("[memory] %-10s live: %u KB in %u allocations, peak: %u KB, last frame: %u allocations of %u KB",
+            __categoryNames[i], (unsigned int)(getLiveBytes(category) / 1024), getLiveAllocationCount(category),
+            (unsigned int)(getPeakBytes(category) / 1024), __lastFrameCounts[i], (unsigned int)(__lastFrameBytes[i] / 1024));
+        if (__budgets[i])
+            print(", budget: %u KB", (unsigned int)(__budgets[i] / 1024));
+        print("\n");
+    }
+}
+
+void MemoryTracker::trackAllocation(Category category, size_t size)
+{
+    countAllocation(category, size);
+}
+
+void MemoryTracker::trackFree(Category category, size_t size)
+{
+    countFree(category, size);
+}
+
+void MemoryTracker::finishFrame()
+{
+    for (unsigned int i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        // Subtract what was read rather than clearing, so that allocations made meanwhile count towards the next frame.
+        int count = atomicLoad(&__frameCounts[i]);
+        atomicAdd(&__frameCounts[i], -count);
+        long long bytes = atomicLoad(&__frameBytes[i]);
+        atomicAdd(&__frameBytes[i], -bytes);
+        __lastFrameCounts[i] = (unsigned int)count;
+        __lastFrameBytes[i] = (size_t)bytes;
+
+        if (__budgets[i] == 0)
+            continue;
+        size_t live = getLiveBytes((Category)i);
+        if (live > __budgets[i])
+        {
+            if (!__overBudget[i])
+            {
+                GP_WARN("Memory budget of category '%s' exceeded: %u KB live, %u KB budget.", __categoryNames[i],
+                    (unsigned int)(live / 1024), (unsigned int)(__budgets[i] / 1024));
+                __overBudget[i] = true;
+            }
+        }
+        else
+        {
+            __overBudget[i] = false;
+        }
+    }
+}
+
+}
+
+#ifndef GAMEPLAY_MEM_LEAK_DETECTION
+
+// Replace the global new and delete operators with ones that count each allocation against the
+// current category of the allocating thread. The operators of DebugNew.h do this when leak
+// detection is enabled.
+
+#if __cplusplus >= 201103L
+#define MEMORY_TRACKER_THROW_BAD_ALLOC
+#define MEMORY_TRACKER_NO_THROW noexcept
+#else
+#define MEMORY_TRACKER_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define MEMORY_TRACKER_NO_THROW throw()
+#endif
+
+static void* trackedAlloc(std::size_t size)
+{
+    unsigned char* p = (unsigned char*)malloc(size + MEMORY_TRACKER_HEADER_SIZE);
+    if (!p)
+        return NULL;
+
+    gameplay::MemoryTracker::Category category = gameplay::MemoryTracker::getCurrentCategory();
+    *(size_t*)p = size;
+    p[sizeof(size_t)] = (unsigned char)category;
+    gameplay::countAllocation(category, size);
+    return p + MEMORY_TRACKER_HEADER_SIZE;
+}
+
+static void trackedFree(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    unsigned char* p = (unsigned char*)ptr - MEMORY_TRACKER_HEADER_SIZE;
+    gameplay::countFree((gameplay::MemoryTracker::Category)p[sizeof(size_t)], *(size_t*)p);
+    free(p);
+}
+
+#ifdef _MSC_VER
+#pragma warning( disable : 4290 )
+#endif
+
+void* operator new (std::size_t size) MEMORY_TRACKER_THROW_BAD_ALLOC
+{
+    void* p = trackedAlloc(size);
+#if defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+    if (!p)
+        throw std::bad_alloc();
+#endif
+    return p;
+}
+
+void* operator new[] (std::size_t size) MEMORY_TRACKER_THROW_BAD_ALLOC
+{
+    return operator new (size);
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) MEMORY_TRACKER_NO_THROW
+{
+    return trackedAlloc(size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) MEMORY_TRACKER_NO_THROW
+{
+    return trackedAlloc(size);
+}
+
+void operator delete (void* p) MEMORY_TRACKER_NO_THROW
+{
+    trackedFree(p);
+}
+
+void operator delete[] (void* p) MEMORY_TRACKER_NO_THROW
+{
+    trackedFree(p);
+}
+
+void operator delete (void* p, const std::nothrow_t&) MEMORY_TRACKER_NO_THROW
+{
+    trackedFree(p);
+}
+
+void operator delete[] (void* p, const std::nothrow_t&) MEMORY_TRACKER_NO_THROW
+{
+    trackedFree(p);
+}
+
+#if __cplusplus >= 201402L
+void operator delete (void* p, std::size_t) MEMORY_TRACKER_NO_THROW
+{
+    trackedFree(p);
+}
+
+void operator delete[] (void* p, std::size_t) MEMORY_TRACKER_NO_THROW
+{
+    trackedFree(p);
+}
+#endif
+
+#ifdef _MSC_VER
+#pragma warning( default : 4290 )
+#endif
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef MEMORYTRACKER_H_
+#define MEMORYTRACKER_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines the tracking of heap allocations by the subsystem that made them.
+ *
+ * Every allocation made through the global new operator is counted against the category of the
+ * innermost GP_MEMORY_SCOPE that is open on the allocating thread, or against CATEGORY_OTHER if
+ * there is none, and is counted back against the same category when it is freed. The tracker
+ * replaces the global new and delete operators with ones that keep the size and category of each
+ * allocation in a 16-byte header in front of it, so it costs a few atomic additions per allocation
+ * and is always available. When GAMEPLAY_MEM_LEAK_DETECTION is defined, the operators of DebugNew.h
+ * are used instead and count the allocations from their leak records. The allocations of the Lua state
+ * and of Bullet, which do not use the global new operator, are counted against CATEGORY_SCRIPT
+ * and CATEGORY_PHYSICS by the allocators that the ScriptController and PhysicsController
+ * install for them. For each category the tracker keeps
+ * the live and peak bytes, and the number of allocations made in the previous frame, which
+ * exposes the per-frame allocation churn of each subsystem.
+ *
+ * A budget of live bytes can be set for each category, either with setBudget() or in the
+ * game config (in kilobytes):
+ *
+ * @code
+ * memory
+ * {
+ *     texture = 65536
+ *     ui = 4096
+ * }
+ * @endcode
+ *
+ * A warning is logged at the end of the frame in which a category first exceeds its budget.
+ *
+ * @script{ignore}
+ */
+class MemoryTracker
+{
+    friend class Game;
+
+public:
+
+    /**
+     * The subsystems that allocations are counted against.
+     */
+    enum Category
+    {
+        CATEGORY_OTHER,
+        CATEGORY_TEXTURE,
+        CATEGORY_MESH,
+        CATEGORY_ANIMATION,
+        CATEGORY_PHYSICS,
+        CATEGORY_UI,
+        CATEGORY_SCRIPT,
+        CATEGORY_COUNT
+    };
+
+    /**
+     * Counts the allocations made on the calling thread against a category, for the
+     * lifetime of the scope.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Constructor. Makes the category the current category of the calling thread.
+         *
+         * @param category The category to count allocations against.
+         */
+        Scope(Category category);
+
+        /**
+         * Destructor. Restores the previous category of the calling thread.
+         */
+        ~Scope();
+
+    private:
+
+        Scope(const Scope& copy);
+        Scope& operator=(const Scope&);
+
+        Category _previous;
+    };
+
+    /**
+     * Gets the name of a category, as used in the game config.
+     *
+     * @param category The category.
+     *
+     * @return The name of the category.
+     */
+    static const char* getCategoryName(Category category);
+
+    /**
+     * Gets the category that allocations on the calling thread are currently counted against.
+     *
+     * @return The current category.
+     */
+    static Category getCurrentCategory();
+
+    /**
+     * Gets the number of bytes currently allocated in a category.
+     *
+     * @param category The category.
+     *
+     * @return The number of live bytes.
+     */
+    static size_t getLiveBytes(Category category);
+
+    /**
+     * Gets the largest number of bytes that have been allocated in a category at once.
+     *
+     * @param category The category.
+     *
+     * @return The peak number of live bytes.
+     */
+    static size_t getPeakBytes(Category category);
+
+    /**
+     * Gets the number of allocations currently live in a category.
+     *
+     * @param category The category.
+     *
+     * @return The number of live allocations.
+     */
+    static unsigned int getLiveAllocationCount(Category category);
+
+    /**
+     * Gets the number of allocations made in a category during the previous frame.
+     *
+     * @param category The category.
+     *
+     * @return The number of allocations.
+     */
+    static unsigned int getFrameAllocationCount(Category category);
+
+    /**
+     * Gets the number of bytes allocated in a category during the previous frame.
+     *
+     * @param category The category.
+     *
+     * @return The number of bytes allocated, not counting frees.
+     */
+    static size_t getFrameAllocationBytes(Category category);
+
+    /**
+     * Gets the budget of live bytes of a category.
+     *
+     * @param category The category.
+     *
+     * @return The budget in bytes, or zero if the category has no budget.
+     */
+    static size_t getBudget(Category category);
+
+    /**
+     * Sets the budget of live bytes of a category.
+     *
+     * @param category The category.
+     * @param bytes The budget in bytes, or zero for no budget.
+     */
+    static void setBudget(Category category, size_t bytes);
+
+    /**
+     * Prints the statistics of each category.
+     */
+    static void printStatistics();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    MemoryTracker();
+
+    /**
+     * Hidden copy constructor.
+     */
+    MemoryTracker(const MemoryTracker& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    MemoryTracker& operator=(const MemoryTracker&);
+
+    /**
+     * Counts an allocation against a category.
+     */
+    static void trackAllocation(Category category, size_t size);
+
+    /**
+     * Counts the free of an allocation against the category it was allocated in.
+     */
+    static void trackFree(Category category, size_t size);
+
+    /**
+     * Checks the budgets and starts the per-frame statistics of the next frame.
+     */
+    static void finishFrame();
+
+#ifdef GAMEPLAY_MEM_LEAK_DETECTION
+    friend void* ::debugAlloc(std::size_t size, const char* file, int line);
+    friend void ::debugFree(void* p);
+#endif
+    friend class PhysicsController;
+    friend class ScriptController;
+};
+
+}
+
+#define GP_MEMORY_CONCAT_(a, b) a##b
+#define GP_MEMORY_CONCAT(a, b) GP_MEMORY_CONCAT_(a, b)
+
+/**
+ * Counts the allocations made in the remainder of the enclosing block against a MemoryTracker category.
+ */
+#define GP_MEMORY_SCOPE(category) gameplay::MemoryTracker::Scope GP_MEMORY_CONCAT(__memoryScope, __LINE__)(gameplay::MemoryTracker::category)
+
+#endif
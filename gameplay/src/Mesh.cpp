@@ -1,5 +1,6 @@
 #include "Base.h"
 #include "Mesh.h"
+#include "MemoryTracker.h"
 #include "MeshPart.h"
 #include "Effect.h"
 #include "Model.h"
@@ -10,7 +11,7 @@ namespace gameplay
 
 Mesh::Mesh(const VertexFormat& vertexFormat) 
     : _vertexFormat(vertexFormat), _vertexCount(0), _vertexBuffer(0), _primitiveType(TRIANGLES), 
-      _partCount(0), _parts(NULL), _dynamic(false)
+      _partCount(0), _parts(NULL), _dynamic(false), _skinnedVertexSource(NULL)
 {
 }
 
@@ -34,6 +35,8 @@ Mesh::~Mesh()
 
 Mesh* Mesh::createMesh(const VertexFormat& vertexFormat, unsigned int vertexCount, bool dynamic)
 {
+    GP_MEMORY_SCOPE(CATEGORY_MESH);
+
     GLuint vbo;
     GL_ASSERT( glGenBuffers(1, &vbo) );
     GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, vbo) );
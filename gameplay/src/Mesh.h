@@ -22,6 +22,7 @@ class Mesh : public Ref
 {
     friend class Model;
     friend class Bundle;
+    friend class MeshSkin;
 
 public:
 
@@ -327,6 +328,7 @@ private:
     bool _dynamic;
     BoundingBox _boundingBox;
     BoundingSphere _boundingSphere;
+    const void* _skinnedVertexSource;   // The skin whose CPU skinned vertices are in the vertex buffer, if any.
 };
 
 }
@@ -1,12 +1,25 @@
 #include "Base.h"
 #include "MeshBatch.h"
 
+// The number of full batches that fit in the streaming buffers before they are orphaned.
+#define STREAM_BUFFER_BATCH_COUNT 4
+
 namespace gameplay
 {
 
+static MeshBatch::Statistics __statistics;
+static MeshBatch::Statistics __frameStatistics;
+
+MeshBatch::Statistics::Statistics()
+    : uploadCount(0), uploadBytes(0), orphanCount(0)
+{
+}
+
 MeshBatch::MeshBatch(const VertexFormat& vertexFormat, Mesh::PrimitiveType primitiveType, Material* material, bool indexed, unsigned int initialCapacity, unsigned int growSize)
     : _vertexFormat(vertexFormat), _primitiveType(primitiveType), _material(material), _indexed(indexed), _capacity(0), _growSize(growSize),
-      _vertexCapacity(0), _indexCapacity(0), _vertexCount(0), _indexCount(0), _vertices(NULL), _verticesPtr(NULL), _indices(NULL), _indicesPtr(NULL)
+      _vertexCapacity(0), _indexCapacity(0), _vertexCount(0), _indexCount(0), _vertices(NULL), _verticesPtr(NULL), _indices(NULL), _indicesPtr(NULL),
+      _streaming(true), _streamMesh(NULL), _streamIndexBuffer(0), _streamVertexCapacity(0), _streamIndexCapacity(0),
+      _streamVertexOffset(0), _streamIndexOffset(0)
 {
     resize(initialCapacity);
 }
@@ -16,6 +29,12 @@ MeshBatch::~MeshBatch()
     SAFE_RELEASE(_material);
     SAFE_DELETE_ARRAY(_vertices);
     SAFE_DELETE_ARRAY(_indices);
+    SAFE_RELEASE(_streamMesh);
+    if (_streamIndexBuffer)
+    {
+        GL_ASSERT( glDeleteBuffers(1, &_streamIndexBuffer) );
+        _streamIndexBuffer = 0;
+    }
 }
 
 MeshBatch* MeshBatch::create(const VertexFormat& vertexFormat, Mesh::PrimitiveType primitiveType, const char* materialPath, bool indexed, unsigned int initialCapacity, unsigned int growSize)
@@ -55,7 +74,7 @@ void MeshBatch::updateVertexAttributeBinding()
         {
             Pass* p = t->getPassByIndex(j);
             GP_ASSERT(p);
-            VertexAttributeBinding* b = VertexAttributeBinding::create(_vertexFormat, _vertices, p->getEffect());
+            VertexAttributeBinding* b = _streaming ? VertexAttributeBinding::create(_streamMesh, p->getEffect()) : VertexAttributeBinding::create(_vertexFormat, _vertices, p->getEffect());
             p->setVertexAttributeBinding(b);
             SAFE_RELEASE(b);
         }
@@ -72,6 +91,113 @@ void MeshBatch::setCapacity(unsigned int capacity)
     resize(capacity);
 }
 
+bool MeshBatch::isStreamingEnabled() const
+{
+    return _streaming;
+}
+
+void MeshBatch::setStreamingEnabled(bool enabled)
+{
+    if (enabled == _streaming)
+        return;
+
+    _streaming = enabled;
+    if (_streaming)
+        updateStreamBuffers();
+    updateVertexAttributeBinding();
+}
+
+const MeshBatch::Statistics& MeshBatch::getStatistics()
+{
+    return __frameStatistics;
+}
+
+void MeshBatch::finishFrame()
+{
+    __frameStatistics = __statistics;
+    __statistics = Statistics();
+}
+
+void MeshBatch::updateStreamBuffers()
+{
+    if (_streamMesh && _streamVertexCapacity >= _vertexCapacity && _streamIndexCapacity >= _indexCapacity)
+        return;
+
+    // Size the buffers to hold several full batches, so that a number of batches can be drawn
+    // before the buffers are orphaned. Indexed batches address their vertices with unsigned shorts.
+    unsigned int vertexCapacity = _vertexCapacity * STREAM_BUFFER_BATCH_COUNT;
+    if (_indexed)
+        vertexCapacity = std::max(std::min(vertexCapacity, (unsigned int)USHRT_MAX + 1), _vertexCapacity);
+
+    SAFE_RELEASE(_streamMesh);
+    _streamMesh = Mesh::createMesh(_vertexFormat, vertexCapacity, true);
+    GP_ASSERT(_streamMesh);
+    _streamVertexCapacity = vertexCapacity;
+    _streamVertexOffset = 0;
+
+    if (_indexed)
+    {
+        _streamIndexCapacity = _indexCapacity * STREAM_BUFFER_BATCH_COUNT;
+        if (_streamIndexBuffer == 0)
+        {
+            GL_ASSERT( glGenBuffers(1, &_streamIndexBuffer) );
+        }
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _streamIndexBuffer) );
+        GL_ASSERT( glBufferData(GL_ELEMENT_ARRAY_BUFFER, _streamIndexCapacity * sizeof(unsigned short), NULL, GL_DYNAMIC_DRAW) );
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+        _streamIndexOffset = 0;
+    }
+}
+
+void MeshBatch::upload()
+{
+    GP_ASSERT(_streamMesh);
+
+    unsigned int vertexSize = _vertexFormat.getVertexSize();
+    VertexBufferHandle vertexBuffer = _streamMesh->getVertexBuffer();
+    GL_ASSERT( glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer) );
+    if (_indexed)
+    {
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _streamIndexBuffer) );
+    }
+
+    // When the rest of the buffers cannot hold the batch, orphan them so the driver can allocate
+    // new storage while the GPU is still reading the old one, and start again at the beginning.
+    if (_streamVertexOffset + _vertexCount > _streamVertexCapacity ||
+        (_indexed && _streamIndexOffset + _indexCount > _streamIndexCapacity))
+    {
+        GL_ASSERT( glBufferData(GL_ARRAY_BUFFER, _streamVertexCapacity * vertexSize, NULL, GL_DYNAMIC_DRAW) );
+        if (_indexed)
+        {
+            GL_ASSERT( glBufferData(GL_ELEMENT_ARRAY_BUFFER, _streamIndexCapacity * sizeof(unsigned short), NULL, GL_DYNAMIC_DRAW) );
+        }
+        _streamVertexOffset = 0;
+        _streamIndexOffset = 0;
+        ++__statistics.orphanCount;
+    }
+
+    GL_ASSERT( glBufferSubData(GL_ARRAY_BUFFER, _streamVertexOffset * vertexSize, _vertexCount * vertexSize, _vertices) );
+    __statistics.uploadBytes += _vertexCount * vertexSize;
+    if (_indexed)
+    {
+        // The indices are relative to the start of the batch, so they are offset to the region
+        // of the vertex buffer that the batch was copied to.
+        const unsigned short* indices = _indices;
+        if (_streamVertexOffset > 0)
+        {
+            _streamIndices.resize(_indexCount);
+            for (unsigned int i = 0; i < _indexCount; ++i)
+            {
+                _streamIndices[i] = (unsigned short)(_indices[i] + _streamVertexOffset);
+            }
+            indices = &_streamIndices[0];
+        }
+        GL_ASSERT( glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, _streamIndexOffset * sizeof(unsigned short), _indexCount * sizeof(unsigned short), indices) );
+        __statistics.uploadBytes += _indexCount * sizeof(unsigned short);
+    }
+    ++__statistics.uploadCount;
+}
+
 bool MeshBatch::resize(unsigned int capacity)
 {
     if (capacity == 0)
@@ -137,12 +263,12 @@ bool MeshBatch::resize(unsigned int capacity)
         _indicesPtr = _indices + ioffset;
     }
 
-    // Copy old data back in
+    // Copy the part of the old data that is in use back in
     if (oldVertices)
-        memcpy(_vertices, oldVertices, std::min(_vertexCapacity, vertexCapacity) * _vertexFormat.getVertexSize());
+        memcpy(_vertices, oldVertices, _verticesPtr - _vertices);
     SAFE_DELETE_ARRAY(oldVertices);
     if (oldIndices)
-        memcpy(_indices, oldIndices, std::min(_indexCapacity, indexCapacity) * sizeof(unsigned short));
+        memcpy(_indices, oldIndices, (_indicesPtr - _indices) * sizeof(unsigned short));
     SAFE_DELETE_ARRAY(oldIndices);
 
     // Assign new capacities
@@ -150,7 +276,10 @@ bool MeshBatch::resize(unsigned int capacity)
     _vertexCapacity = vertexCapacity;
     _indexCapacity = indexCapacity;
 
-    // Update our vertex attribute bindings now that our client array pointers have changed
+    if (_streaming)
+        updateStreamBuffers();
+
+    // Update our vertex attribute bindings now that our client array pointers (or streaming buffers) have changed
     updateVertexAttributeBinding();
 
     return true;
@@ -173,14 +302,14 @@ void MeshBatch::draw()
     if (_vertexCount == 0 || (_indexed && _indexCount == 0))
         return; // nothing to draw
 
-    // Not using VBOs, so unbind the element array buffer.
-    // ARRAY_BUFFER will be unbound automatically during pass->bind().
-    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0 ) );
-
     GP_ASSERT(_material);
     if (_indexed)
         GP_ASSERT(_indices);
 
+    // Copy the primitives to the streaming buffers.
+    if (_streaming)
+        upload();
+
     // Bind the material.
     Technique* technique = _material->getTechnique();
     GP_ASSERT(technique);
@@ -191,17 +320,42 @@ void MeshBatch::draw()
         GP_ASSERT(pass);
         pass->bind();
 
-        if (_indexed)
+        if (_streaming)
         {
-            GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)_indices) );
+            // The element array buffer is bound after the pass, since it is part of the state of a VAO.
+            if (_indexed)
+            {
+                GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _streamIndexBuffer) );
+                GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)(_streamIndexOffset * sizeof(unsigned short))) );
+            }
+            else
+            {
+                GL_ASSERT( glDrawArrays(_primitiveType, _streamVertexOffset, _vertexCount) );
+            }
         }
         else
         {
-            GL_ASSERT( glDrawArrays(_primitiveType, 0, _vertexCount) );
+            // Not using VBOs, so unbind the element array buffer.
+            // ARRAY_BUFFER will be unbound automatically during pass->bind().
+            GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0 ) );
+            if (_indexed)
+            {
+                GL_ASSERT( glDrawElements(_primitiveType, _indexCount, GL_UNSIGNED_SHORT, (GLvoid*)_indices) );
+            }
+            else
+            {
+                GL_ASSERT( glDrawArrays(_primitiveType, 0, _vertexCount) );
+            }
         }
 
         pass->unbind();
     }
+
+    if (_streaming)
+    {
+        _streamVertexOffset += _vertexCount;
+        _streamIndexOffset += _indexCount;
+    }
 }
     
 
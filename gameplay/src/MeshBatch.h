@@ -9,11 +9,52 @@ namespace gameplay
 
 /**
  * Defines a class for rendering multiple mesh into a single draw call on the graphics device.
+ *
+ * By default the batch streams its primitives to the GPU through a pair of dynamic vertex and
+ * index buffers that are used as ring buffers: each draw() copies the primitives into the next
+ * free region of the buffers, and when the buffers are full they are orphaned (reallocated by the
+ * driver without waiting for the GPU to finish with the previous contents) and filling restarts
+ * at the beginning. Streaming can be disabled with setStreamingEnabled(), in which case the
+ * primitives are drawn from client-side arrays.
+ *
+ * The vertices of each mesh are copied into the batch when it is added. To draw many copies of
+ * the same mesh, use an InstanceBuffer with Model::drawInstanced() instead, which only copies a
+ * world matrix and a color for each copy.
  */
 class MeshBatch
 {
+    friend class Game;
+
 public:
 
+    /**
+     * Defines the amount of data streamed to the GPU by all mesh batches in a frame.
+     *
+     * @script{ignore}
+     */
+    struct Statistics
+    {
+        /**
+         * Constructor.
+         */
+        Statistics();
+
+        /**
+         * The number of batches that were uploaded.
+         */
+        unsigned int uploadCount;
+
+        /**
+         * The number of bytes of vertex and index data that were uploaded.
+         */
+        unsigned int uploadBytes;
+
+        /**
+         * The number of times the streaming buffers were full and had to be orphaned.
+         */
+        unsigned int orphanCount;
+    };
+
     /**
      * Creates a new mesh batch.
      *
@@ -70,6 +111,31 @@ public:
      */
     inline Material* getMaterial() const;
 
+    /**
+     * Determines if the batch streams its primitives through dynamic vertex buffers.
+     *
+     * @return true if streaming is enabled, false if the batch is drawn from client-side arrays.
+     */
+    bool isStreamingEnabled() const;
+
+    /**
+     * Sets whether the batch streams its primitives through dynamic vertex buffers.
+     *
+     * Streaming is enabled by default.
+     *
+     * @param enabled true to stream the primitives through dynamic vertex buffers, false
+     *      to draw them from client-side arrays.
+     */
+    void setStreamingEnabled(bool enabled);
+
+    /**
+     * Gets the amount of data streamed by all mesh batches during the previous frame.
+     *
+     * @return The statistics of the previous frame.
+     * @script{ignore}
+     */
+    static const Statistics& getStatistics();
+
     /**
      * Adds a group of primitives to the batch.
      *
@@ -135,6 +201,21 @@ private:
 
     bool resize(unsigned int capacity);
 
+    /**
+     * Creates the streaming buffers, or recreates them if they cannot hold a full batch.
+     */
+    void updateStreamBuffers();
+
+    /**
+     * Copies the primitives into the next free region of the streaming buffers.
+     */
+    void upload();
+
+    /**
+     * Starts the upload statistics of a new frame.
+     */
+    static void finishFrame();
+
     const VertexFormat _vertexFormat;
     Mesh::PrimitiveType _primitiveType;
     Material* _material;
@@ -149,6 +230,14 @@ private:
     unsigned char* _verticesPtr;
     unsigned short* _indices;
     unsigned short* _indicesPtr;
+    bool _streaming;
+    Mesh* _streamMesh;
+    IndexBufferHandle _streamIndexBuffer;
+    unsigned int _streamVertexCapacity;
+    unsigned int _streamIndexCapacity;
+    unsigned int _streamVertexOffset;
+    unsigned int _streamIndexOffset;
+    std::vector<unsigned short> _streamIndices;
 
 };
 
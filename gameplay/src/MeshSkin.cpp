@@ -1,23 +1,41 @@
 #include "Base.h"
 #include "MeshSkin.h"
+#include "Profiler.h"
 #include "Joint.h"
+#include "Game.h"
+#include "MathUtil.h"
 
 // The number of rows in each palette matrix.
 #define PALETTE_ROWS 3
 
+// The number of vertex shader uniform vectors left for the uniforms of a skinned effect other than the palette.
+#define RESERVED_UNIFORM_VECTORS 32
+
 namespace gameplay
 {
 
+static std::vector<MeshSkin*> __skinList;
+
 MeshSkin::MeshSkin()
-    : _rootJoint(NULL), _rootNode(NULL), _matrixPalette(NULL), _model(NULL)
+    : _rootJoint(NULL), _rootNode(NULL), _matrixPalette(NULL), _model(NULL),
+      _bindPoseVertices(NULL), _skinnedVertices(NULL), _skinnedVerticesDirty(false)
 {
+    __skinList.push_back(this);
 }
 
 MeshSkin::~MeshSkin()
 {
+    std::vector<MeshSkin*>::iterator itr = std::find(__skinList.begin(), __skinList.end(), this);
+    if (itr != __skinList.end())
+    {
+        __skinList.erase(itr);
+    }
+
     clearJoints();
 
     SAFE_DELETE_ARRAY(_matrixPalette);
+    SAFE_DELETE_ARRAY(_bindPoseVertices);
+    SAFE_DELETE_ARRAY(_skinnedVertices);
 }
 
 const Matrix& MeshSkin::getBindShape() const
@@ -28,6 +46,9 @@ const Matrix& MeshSkin::getBindShape() const
 void MeshSkin::setBindShape(const float* matrix)
 {
     _bindShape.set(matrix);
+
+    // The bind matrices of all joints include the bind shape.
+    std::fill(_bindPoseVersions.begin(), _bindPoseVersions.end(), 0);
 }
 
 unsigned int MeshSkin::getJointCount() const
@@ -105,6 +126,15 @@ MeshSkin* MeshSkin::clone(NodeCloneContext &context) const
             skin->setJoint(newJoint, i);
         }
     }
+    if (_bindPoseVertices && _model && _model->getMesh())
+    {
+        // The clone shares the mesh, so it is skinned on the CPU as well.
+        const Mesh* mesh = _model->getMesh();
+        unsigned int size = mesh->getVertexCount() * mesh->getVertexFormat().getVertexSize();
+        unsigned char* vertexData = new unsigned char[size];
+        memcpy(vertexData, _bindPoseVertices, size);
+        skin->setCpuSkinningData(vertexData);
+    }
     return skin;
 }
 
@@ -120,6 +150,11 @@ void MeshSkin::setJointCount(unsigned int jointCount)
         _joints[i] = NULL;
     }
 
+    // Versions of zero are never current, so every palette matrix is computed on the first update.
+    _bindMatrices.resize(jointCount);
+    _transformVersions.assign(jointCount, 0);
+    _bindPoseVersions.assign(jointCount, 0);
+
     // Rebuild the matrix palette. Each matrix is 3 rows of Vector4.
     SAFE_DELETE_ARRAY(_matrixPalette);
 
@@ -146,6 +181,7 @@ void MeshSkin::setJoint(Joint* joint, unsigned int index)
     }
 
     _joints[index] = joint;
+    _bindPoseVersions[index] = 0;
 
     if (joint)
     {
@@ -158,11 +194,7 @@ Vector4* MeshSkin::getMatrixPalette() const
 {
     GP_ASSERT(_matrixPalette);
 
-    for (size_t i = 0, count = _joints.size(); i < count; i++)
-    {
-        GP_ASSERT(_joints[i]);
-        _joints[i]->updateJointMatrix(getBindShape(), &_matrixPalette[i * PALETTE_ROWS]);
-    }
+    updateMatrixPalette();
     return _matrixPalette;
 }
 
@@ -171,6 +203,228 @@ unsigned int MeshSkin::getMatrixPaletteSize() const
     return (unsigned int)_joints.size() * PALETTE_ROWS;
 }
 
+unsigned int MeshSkin::getMaxGpuJointCount()
+{
+    static unsigned int maxJointCount = 0;
+    if (maxJointCount == 0)
+    {
+        GLint vectors = 0;
+#ifdef OPENGL_ES
+        GL_ASSERT( glGetIntegerv(GL_MAX_VERTEX_UNIFORM_VECTORS, &vectors) );
+#else
+        GLint components = 0;
+        GL_ASSERT( glGetIntegerv(GL_MAX_VERTEX_UNIFORM_COMPONENTS, &components) );
+        vectors = components / 4;
+#endif
+        maxJointCount = vectors > RESERVED_UNIFORM_VECTORS + PALETTE_ROWS ? (vectors - RESERVED_UNIFORM_VECTORS) / PALETTE_ROWS : 1;
+    }
+    return maxJointCount;
+}
+
+bool MeshSkin::isCpuSkinningEnabled() const
+{
+    return _bindPoseVertices != NULL;
+}
+
+void MeshSkin::updateMatrixPalette() const
+{
+    bool changed = false;
+    for (size_t i = 0, count = _joints.size(); i < count; ++i)
+    {
+        Joint* joint = _joints[i];
+        if (!joint)
+            continue;
+
+        // The bind matrix only changes with the bind pose or the bind shape.
+        bool bindPoseChanged = _bindPoseVersions[i] != joint->getBindPoseVersion();
+        if (bindPoseChanged)
+        {
+            _bindPoseVersions[i] = joint->getBindPoseVersion();
+            Matrix::multiply(joint->getInverseBindPose(), _bindShape, &_bindMatrices[i]);
+        }
+
+        if (bindPoseChanged || _transformVersions[i] != joint->getTransformVersion())
+        {
+            _transformVersions[i] = joint->getTransformVersion();
+            MathUtil::multiplyAffineMatrixRows(joint->getWorldMatrix().m, _bindMatrices[i].m, &_matrixPalette[i * PALETTE_ROWS].x);
+            changed = true;
+        }
+    }
+
+    if (changed && _bindPoseVertices)
+    {
+        skinVertices();
+    }
+}
+
+void MeshSkin::setCpuSkinningData(unsigned char* vertexData)
+{
+    SAFE_DELETE_ARRAY(_bindPoseVertices);
+    SAFE_DELETE_ARRAY(_skinnedVertices);
+    _bindPoseVertices = vertexData;
+
+    // Skin the vertices on the next update.
+    std::fill(_transformVersions.begin(), _transformVersions.end(), 0);
+}
+
+void MeshSkin::skinVertices() const
+{
+    GP_ASSERT(_bindPoseVertices);
+
+    const Mesh* mesh = _model ? _model->getMesh() : NULL;
+    if (!mesh || !_matrixPalette)
+        return;
+
+    // Find the elements that are skinned, as offsets in floats.
+    const VertexFormat& format = mesh->getVertexFormat();
+    int position = -1, normal = -1, tangent = -1, binormal = -1, weights = -1, indices = -1;
+    unsigned int positionSize = 0, weightCount = 0;
+    unsigned int offset = 0;
+    for (unsigned int i = 0, count = format.getElementCount(); i < count; ++i)
+    {
+        const VertexFormat::Element& e = format.getElement(i);
+        switch (e.usage)
+        {
+        case VertexFormat::POSITION:
+            position = offset;
+            positionSize = e.size;
+            break;
+        case VertexFormat::NORMAL:
+            normal = offset;
+            break;
+        case VertexFormat::TANGENT:
+            tangent = offset;
+            break;
+        case VertexFormat::BINORMAL:
+            binormal = offset;
+            break;
+        case VertexFormat::BLENDWEIGHTS:
+            weights = offset;
+            weightCount = e.size;
+            break;
+        case VertexFormat::BLENDINDICES:
+            indices = offset;
+            break;
+        default:
+            break;
+        }
+        offset += e.size;
+    }
+    if (position < 0 || weights < 0 || indices < 0)
+        return;
+
+    unsigned int vertexCount = mesh->getVertexCount();
+    unsigned int vertexSize = format.getVertexSize();
+    if (!_skinnedVertices)
+    {
+        // The elements that are not skinned are copied once.
+        _skinnedVertices = new unsigned char[vertexCount * vertexSize];
+        memcpy(_skinnedVertices, _bindPoseVertices, vertexCount * vertexSize);
+    }
+
+    unsigned int floatCount = vertexSize / sizeof(float);
+    unsigned int jointCount = (unsigned int)_joints.size();
+    const float* palette = &_matrixPalette[0].x;
+    const float* src = (const float*)_bindPoseVertices;
+    float* dst = (float*)_skinnedVertices;
+    for (unsigned int v = 0; v < vertexCount; ++v, src += floatCount, dst += floatCount)
+    {
+        // Blend the palette matrices of the vertex, which gives the same result as blending the
+        // vertex transformed by each of them.
+        float m[12] = { 0 };
+        for (unsigned int k = 0; k < weightCount; ++k)
+        {
+            float w = src[weights + k];
+            unsigned int joint = (unsigned int)src[indices + k];
+            if (w == 0.0f || joint >= jointCount)
+                continue;
+            const float* p = &palette[joint * PALETTE_ROWS * 4];
+            for (unsigned int j = 0; j < 12; ++j)
+            {
+                m[j] += w * p[j];
+            }
+        }
+
+        const float* s = &src[position];
+        float w = positionSize > 3 ? s[3] : 1.0f;
+        for (unsigned int r = 0; r < 3; ++r)
+        {
+            dst[position + r] = m[r * 4] * s[0] + m[r * 4 + 1] * s[1] + m[r * 4 + 2] * s[2] + m[r * 4 + 3] * w;
+        }
+
+        int vectors[3] = { normal, tangent, binormal };
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            if (vectors[i] < 0)
+                continue;
+            s = &src[vectors[i]];
+            for (unsigned int r = 0; r < 3; ++r)
+            {
+                dst[vectors[i] + r] = m[r * 4] * s[0] + m[r * 4 + 1] * s[1] + m[r * 4 + 2] * s[2];
+            }
+        }
+    }
+    _skinnedVerticesDirty = true;
+}
+
+void MeshSkin::uploadSkinnedVertices() const
+{
+    GP_ASSERT(_bindPoseVertices);
+
+    // The palette may not have been updated yet this frame.
+    updateMatrixPalette();
+
+    // Models that are clones of each other share a mesh, so the vertex buffer is also written
+    // when it holds the vertices of another skin.
+    Mesh* mesh = _model ? _model->getMesh() : NULL;
+    if (mesh && _skinnedVertices && (_skinnedVerticesDirty || mesh->_skinnedVertexSource != this))
+    {
+        mesh->setVertexData((const float*)_skinnedVertices, 0, mesh->getVertexCount());
+        mesh->_skinnedVertexSource = this;
+        _skinnedVerticesDirty = false;
+    }
+}
+
+void MeshSkin::updateAllMatrixPalettes()
+{
+    GP_PROFILE_SCOPE("MeshSkin::updateAllMatrixPalettes");
+
+    unsigned int count = (unsigned int)__skinList.size();
+    if (count == 0)
+        return;
+
+    // Node::getWorldMatrix() caches the world matrices of a node and its ancestors as they are
+    // resolved, which is not safe to do from several threads for joints that skins share, so the
+    // joints are resolved here first (joints in a scene already are, by the scene transform pass).
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const std::vector<Joint*>& joints = __skinList[i]->_joints;
+        for (size_t j = 0, jointCount = joints.size(); j < jointCount; ++j)
+        {
+            if (joints[j])
+                joints[j]->getWorldMatrix();
+        }
+    }
+
+    JobSystem* jobSystem = Game::getInstance()->getJobSystem();
+    if (jobSystem && jobSystem->getWorkerCount() > 0 && count > 1)
+    {
+        jobSystem->parallelFor(count, 1, updateMatrixPalettes, NULL);
+    }
+    else
+    {
+        updateMatrixPalettes(NULL, 0, count);
+    }
+}
+
+void MeshSkin::updateMatrixPalettes(void*, unsigned int start, unsigned int end)
+{
+    for (unsigned int i = start; i < end; ++i)
+    {
+        __skinList[i]->updateMatrixPalette();
+    }
+}
+
 Model* MeshSkin::getModel() const
 {
     return _model;
@@ -257,6 +511,7 @@ void MeshSkin::setRootNode(Node* node)
         {
             _rootNode->addRef();
         }
+        Node::setNodeIndexDirty();
     }
 }
 
@@ -14,13 +14,26 @@ class Node;
 
 /**
  * Represents the skin for a mesh.
+ *
+ * The matrix palette of each skin keeps track of which joints have changed since it was last
+ * updated, so only the palette matrices of joints that moved are recomputed (each skin that
+ * shares a joint tracks the joint separately, since the skins can have different bind shapes).
+ * The palettes of all skins are updated once a frame, after the scene transforms are resolved,
+ * across the worker threads of the game's job system.
+ *
+ * A skin with more joints than the matrix palette uniform of the GPU can hold (see
+ * getMaxGpuJointCount()) is skinned on the CPU instead when it is loaded from a bundle: the
+ * skinned vertices are written to the vertex buffer of the mesh before the model is drawn, so
+ * its material must use an effect without SKINNING defined.
  */
 class MeshSkin : public Transform::Listener
 {
+    friend class Game;
     friend class Bundle;
     friend class Model;
     friend class Joint;
     friend class Node;
+    friend class Scene;
 
 public:
 
@@ -100,6 +113,21 @@ public:
      */
     unsigned int getMatrixPaletteSize() const;
 
+    /**
+     * Gets the largest number of joints whose matrix palette fits in the vertex shader
+     * uniforms of the current device.
+     *
+     * @return The largest number of joints that can be skinned on the GPU.
+     */
+    static unsigned int getMaxGpuJointCount();
+
+    /**
+     * Determines if this skin is applied to the vertices of its mesh on the CPU.
+     *
+     * @return true if the skin is applied on the CPU, false if it is applied by the vertex shader.
+     */
+    bool isCpuSkinningEnabled() const;
+
     /**
      * Returns our parent Model.
      */
@@ -169,6 +197,39 @@ private:
      */
     void clearJoints();
 
+    /**
+     * Recomputes the palette matrices of the joints that changed since the last update, and
+     * skins the vertices on the CPU if enabled and any joint changed.
+     */
+    void updateMatrixPalette() const;
+
+    /**
+     * Enables skinning on the CPU.
+     *
+     * @param vertexData The vertices of the mesh in the bind pose. The skin takes ownership of the array.
+     */
+    void setCpuSkinningData(unsigned char* vertexData);
+
+    /**
+     * Applies the matrix palette to the bind pose vertices.
+     */
+    void skinVertices() const;
+
+    /**
+     * Writes the skinned vertices to the vertex buffer of the mesh, if they are not there already.
+     */
+    void uploadSkinnedVertices() const;
+
+    /**
+     * Updates the matrix palettes of all of the skins, in parallel when the job system has workers.
+     */
+    static void updateAllMatrixPalettes();
+
+    /**
+     * Updates the matrix palettes of a range of the skins (a parallel-for function).
+     */
+    static void updateMatrixPalettes(void* arg, unsigned int start, unsigned int end);
+
     Matrix _bindShape;
     std::vector<Joint*> _joints;
     Joint* _rootJoint;
@@ -184,6 +245,18 @@ private:
     // The number of Vector4's is (_joints.size() * 3).
     Vector4* _matrixPalette;
     Model* _model;
+
+    // The inverse bind pose of each joint multiplied by the bind shape.
+    mutable std::vector<Matrix> _bindMatrices;
+
+    // The transform and bind pose versions of each joint when its palette matrix was computed.
+    mutable std::vector<unsigned int> _transformVersions;
+    mutable std::vector<unsigned int> _bindPoseVersions;
+
+    // The vertices of the mesh in the bind pose and after skinning, when skinning on the CPU.
+    unsigned char* _bindPoseVertices;
+    mutable unsigned char* _skinnedVertices;
+    mutable bool _skinnedVerticesDirty;
 };
 
 }
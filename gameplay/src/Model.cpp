@@ -221,6 +221,9 @@ void Model::setSkin(MeshSkin* skin)
         _skin = skin;
         if (_skin)
             _skin->_model = this;
+
+        // The joint hierarchy of the skin is searched by Node::findNode().
+        Node::setNodeIndexDirty();
     }
 }
 
@@ -347,11 +350,7 @@ void Model::draw(bool wireframe)
                 Pass* pass = technique->getPassByIndex(i);
                 GP_ASSERT(pass);
                 pass->bind();
-                GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-                if (!wireframe || !drawWireframe(_mesh))
-                {
-                    GL_ASSERT( glDrawArrays(_mesh->getPrimitiveType(), 0, _mesh->getVertexCount()) );
-                }
+                drawPart(-1, wireframe);
                 pass->unbind();
             }
         }
@@ -360,9 +359,6 @@ void Model::draw(bool wireframe)
     {
         for (unsigned int i = 0; i < partCount; ++i)
         {
-            MeshPart* part = _mesh->getPart(i);
-            GP_ASSERT(part);
-
             // Get the material for this mesh part.
             Material* material = getMaterial(i);
             if (material)
@@ -375,11 +371,7 @@ void Model::draw(bool wireframe)
                     Pass* pass = technique->getPassByIndex(j);
                     GP_ASSERT(pass);
                     pass->bind();
-                    GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, part->_indexBuffer) );
-                    if (!wireframe || !drawWireframe(part))
-                    {
-                        GL_ASSERT( glDrawElements(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0) );
-                    }
+                    drawPart(i, wireframe);
                     pass->unbind();
                 }
             }
@@ -387,6 +379,104 @@ void Model::draw(bool wireframe)
     }
 }
 
+void Model::drawInstanced(InstanceBuffer* instances, bool wireframe)
+{
+    GP_ASSERT(_mesh);
+    GP_ASSERT(instances);
+
+    if (instances->getInstanceCount() == 0)
+        return;
+
+    unsigned int partCount = _mesh->getPartCount();
+    for (unsigned int i = 0; i < partCount || (partCount == 0 && i == 0); ++i)
+    {
+        // Get the material for this mesh part, or for the whole mesh if it has no parts.
+        Material* material = partCount == 0 ? _material : getMaterial(i);
+        if (material)
+        {
+            Technique* technique = material->getTechnique();
+            GP_ASSERT(technique);
+            unsigned int passCount = technique->getPassCount();
+            for (unsigned int j = 0; j < passCount; ++j)
+            {
+                Pass* pass = technique->getPassByIndex(j);
+                GP_ASSERT(pass);
+                pass->bind();
+                drawPartInstanced(partCount == 0 ? -1 : (int)i, wireframe, instances);
+                pass->unbind();
+            }
+        }
+    }
+}
+
+void Model::drawPart(int partIndex, bool wireframe)
+{
+    GP_ASSERT(_mesh);
+
+    if (_skin && _skin->isCpuSkinningEnabled())
+    {
+        _skin->uploadSkinnedVertices();
+    }
+
+    if (partIndex < 0)
+    {
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+        if (!wireframe || !drawWireframe(_mesh))
+        {
+            GL_ASSERT( glDrawArrays(_mesh->getPrimitiveType(), 0, _mesh->getVertexCount()) );
+        }
+    }
+    else
+    {
+        MeshPart* part = _mesh->getPart(partIndex);
+        GP_ASSERT(part);
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, part->_indexBuffer) );
+        if (!wireframe || !drawWireframe(part))
+        {
+            GL_ASSERT( glDrawElements(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0) );
+        }
+    }
+}
+
+void Model::drawPartInstanced(int partIndex, bool wireframe, InstanceBuffer* instances)
+{
+    GP_ASSERT(_mesh);
+    GP_ASSERT(instances);
+
+    // Wireframes are drawn with a draw call for each triangle, so they are drawn one instance at a time.
+    bool hardware = !wireframe;
+    if (!instances->bind(Effect::getCurrentEffect(), hardware))
+        return;
+
+    unsigned int instanceCount = instances->getInstanceCount();
+    if (instances->_hardware)
+    {
+#ifdef USE_INSTANCING
+        if (partIndex < 0)
+        {
+            GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+            GL_ASSERT( glDrawArraysInstanced(_mesh->getPrimitiveType(), 0, _mesh->getVertexCount(), instanceCount) );
+        }
+        else
+        {
+            MeshPart* part = _mesh->getPart(partIndex);
+            GP_ASSERT(part);
+            GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, part->_indexBuffer) );
+            GL_ASSERT( glDrawElementsInstanced(part->getPrimitiveType(), part->getIndexCount(), part->getIndexFormat(), 0, instanceCount) );
+        }
+#endif
+    }
+    else
+    {
+        for (unsigned int i = 0; i < instanceCount; ++i)
+        {
+            instances->bindInstance(i);
+            drawPart(partIndex, wireframe);
+        }
+    }
+    instances->unbind();
+}
+
 void Model::validatePartCount()
 {
     GP_ASSERT(_mesh);
@@ -4,6 +4,7 @@
 #include "Mesh.h"
 #include "MeshSkin.h"
 #include "Material.h"
+#include "InstanceBuffer.h"
 
 namespace gameplay
 {
@@ -22,6 +23,7 @@ class Model : public Ref
     friend class Node;
     friend class Mesh;
     friend class Bundle;
+    friend class RenderQueue;
 
 public:
 
@@ -156,6 +158,19 @@ public:
      */
     void draw(bool wireframe = false);
 
+    /**
+     * Draws a copy of this mesh for each instance in the instance buffer.
+     *
+     * The world matrix and color of each copy are taken from the instance buffer rather than
+     * from the node of this model, so the effect of each material must declare the per-instance
+     * vertex attributes (see InstanceBuffer). Mesh parts whose effect does not declare them are
+     * not drawn.
+     *
+     * @param instances The instances to draw.
+     * @param wireframe If true, draw the model in wireframe mode.
+     */
+    void drawInstanced(InstanceBuffer* instances, bool wireframe = false);
+
 private:
 
     /**
@@ -187,6 +202,24 @@ private:
 
     void validatePartCount();
 
+    /**
+     * Draws a mesh part, or the whole mesh if partIndex is -1, with the pass that is currently bound.
+     *
+     * @param partIndex The index of the mesh part to draw, or -1.
+     * @param wireframe If true, draw the part in wireframe mode.
+     */
+    void drawPart(int partIndex, bool wireframe);
+
+    /**
+     * Draws a copy of a mesh part, or of the whole mesh if partIndex is -1, for each instance
+     * in the instance buffer with the pass that is currently bound.
+     *
+     * @param partIndex The index of the mesh part to draw, or -1.
+     * @param wireframe If true, draw the part in wireframe mode.
+     * @param instances The instances to draw.
+     */
+    void drawPartInstanced(int partIndex, bool wireframe, InstanceBuffer* instances);
+
     /**
      * Clones the model and returns a new model.
      * 
@@ -10,19 +10,26 @@
 #include "PhysicsCharacter.h"
 #include "Game.h"
 #include "Terrain.h"
+#include "SpatialIndex.h"
 
 // Node dirty flags
 #define NODE_DIRTY_WORLD 1
 #define NODE_DIRTY_BOUNDS 2
 #define NODE_DIRTY_ALL (NODE_DIRTY_WORLD | NODE_DIRTY_BOUNDS)
+// Set while the node is queued for the transform pass of its scene
+#define NODE_TRANSFORM_QUEUED 4
 
 namespace gameplay
 {
 
+// The version of the node IDs and hierarchies that the scene ID indexes are built from.
+static unsigned int __nodeIndexVersion = 1;
+
 Node::Node(const char* id)
     : _scene(NULL), _firstChild(NULL), _nextSibling(NULL), _prevSibling(NULL), _parent(NULL), _childCount(0),
     _tags(NULL), _camera(NULL), _light(NULL), _model(NULL), _terrain(NULL), _form(NULL), _audioSource(NULL), _particleEmitter(NULL),
-    _collisionObject(NULL), _agent(NULL), _dirtyBits(NODE_DIRTY_ALL), _notifyHierarchyChanged(true), _userData(NULL)
+    _collisionObject(NULL), _agent(NULL), _dirtyBits(NODE_DIRTY_ALL), _notifyHierarchyChanged(true), _spatialIndex(NULL), _spatialProxy(-1), _spatialDirty(false),
+    _userData(NULL)
 {
     if (id)
     {
@@ -33,6 +40,13 @@ Node::Node(const char* id)
 Node::~Node()
 {
     removeAllChildren();
+    setNodeIndexDirty();
+
+    if (_dirtyBits & NODE_TRANSFORM_QUEUED)
+        Scene::removeQueuedTransform(this);
+
+    if (_spatialIndex)
+        _spatialIndex->removeNode(this);
 
     if (_model)
         _model->setNode(NULL);
@@ -80,6 +94,7 @@ void Node::setId(const char* id)
     if (id)
     {
         _id = id;
+        setNodeIndexDirty();
     }
 }
 
@@ -125,6 +140,7 @@ void Node::addChild(Node* child)
     child->_parent = this;
 
     ++_childCount;
+    setNodeIndexDirty();
 
     if (_notifyHierarchyChanged)
     {
@@ -161,6 +177,14 @@ void Node::removeAllChildren()
 
 void Node::remove()
 {
+    // Our subtree is leaving the scene (it is indexed again if it is added back).
+    if (SpatialIndex::isActive())
+    {
+        Scene* scene = getScene();
+        if (scene && scene->_spatialIndex)
+            scene->_spatialIndex->removeHierarchy(this);
+    }
+
     // Re-link our neighbours.
     if (_prevSibling)
     {
@@ -186,6 +210,7 @@ void Node::remove()
     _nextSibling = NULL;
     _prevSibling = NULL;
     _parent = NULL;
+    setNodeIndexDirty();
 
     if (parent && parent->_notifyHierarchyChanged)
     {
@@ -293,6 +318,36 @@ Node* Node::findNode(const char* id, bool recursive, bool exactMatch) const
 {
     GP_ASSERT(id);
 
+    // Use the ID index of our scene for recursive searches.
+    Scene* scene = recursive ? getScene() : NULL;
+    unsigned int begin, end;
+    if (scene && scene->getIndexedSearchRange(this, &begin, &end))
+    {
+        return scene->findIndexedNode(id, exactMatch, begin, end);
+    }
+
+    return searchNode(id, recursive, exactMatch);
+}
+
+unsigned int Node::findNodes(const char* id, std::vector<Node*>& nodes, bool recursive, bool exactMatch) const
+{
+    GP_ASSERT(id);
+
+    // Use the ID index of our scene for recursive searches.
+    Scene* scene = recursive ? getScene() : NULL;
+    unsigned int begin, end;
+    if (scene && scene->getIndexedSearchRange(this, &begin, &end))
+    {
+        return scene->findIndexedNodes(id, nodes, exactMatch, begin, end);
+    }
+
+    return searchNodes(id, nodes, recursive, exactMatch);
+}
+
+Node* Node::searchNode(const char* id, bool recursive, bool exactMatch) const
+{
+    GP_ASSERT(id);
+
     // If the node has a model with a mesh skin, search the skin's hierarchy as well.
     Node* rootNode = NULL;
     if (_model != NULL && _model->getSkin() != NULL && (rootNode = _model->getSkin()->_rootNode) != NULL)
@@ -300,7 +355,7 @@ Node* Node::findNode(const char* id, bool recursive, bool exactMatch) const
         if ((exactMatch && rootNode->_id == id) || (!exactMatch && rootNode->_id.find(id) == 0))
             return rootNode;
         
-        Node* match = rootNode->findNode(id, true, exactMatch);
+        Node* match = rootNode->searchNode(id, true, exactMatch);
         if (match)
         {
             return match;
@@ -322,7 +377,7 @@ Node* Node::findNode(const char* id, bool recursive, bool exactMatch) const
     {
         for (Node* child = getFirstChild(); child != NULL; child = child->getNextSibling())
         {
-            Node* match = child->findNode(id, true, exactMatch);
+            Node* match = child->searchNode(id, true, exactMatch);
             if (match)
             {
                 return match;
@@ -333,7 +388,7 @@ Node* Node::findNode(const char* id, bool recursive, bool exactMatch) const
     return NULL;
 }   
 
-unsigned int Node::findNodes(const char* id, std::vector<Node*>& nodes, bool recursive, bool exactMatch) const
+unsigned int Node::searchNodes(const char* id, std::vector<Node*>& nodes, bool recursive, bool exactMatch) const
 {
     GP_ASSERT(id);
     
@@ -348,7 +403,7 @@ unsigned int Node::findNodes(const char* id, std::vector<Node*>& nodes, bool rec
             nodes.push_back(rootNode);
             ++count;
         }
-        count += rootNode->findNodes(id, nodes, true, exactMatch);
+        count += rootNode->searchNodes(id, nodes, true, exactMatch);
     }
 
     // Search immediate children first.
@@ -367,7 +422,7 @@ unsigned int Node::findNodes(const char* id, std::vector<Node*>& nodes, bool rec
     {
         for (Node* child = getFirstChild(); child != NULL; child = child->getNextSibling())
         {
-            count += child->findNodes(id, nodes, true, exactMatch);
+            count += child->searchNodes(id, nodes, true, exactMatch);
         }
     }
 
@@ -625,8 +680,20 @@ void Node::hierarchyChanged()
 
 void Node::transformChanged()
 {
+    // Queue the root of each changed subtree for the transform pass of our scene.
+    if (!(_dirtyBits & NODE_TRANSFORM_QUEUED) && !(_parent && (_parent->_dirtyBits & NODE_DIRTY_WORLD)))
+    {
+        Scene* scene = getScene();
+        if (scene)
+        {
+            _dirtyBits |= NODE_TRANSFORM_QUEUED;
+            scene->_transformRoots.push_back(this);
+        }
+    }
+
     // Our local transform was changed, so mark our world matrices dirty.
     _dirtyBits |= NODE_DIRTY_WORLD | NODE_DIRTY_BOUNDS;
+    setSpatialIndexDirty();
 
     // Notify our children that their transform has also changed (since transforms are inherited).
     for (Node* n = getFirstChild(); n != NULL; n = n->getNextSibling())
@@ -651,12 +718,92 @@ void Node::transformChanged()
 
 void Node::setBoundsDirty()
 {
+    // Only our own content changed, so only we need to be refitted in the spatial index.
+    setSpatialIndexDirty();
+
     // Mark ourself and our parent nodes as dirty
-    _dirtyBits |= NODE_DIRTY_BOUNDS;
+    for (Node* n = this; n != NULL; n = n->_parent)
+    {
+        n->_dirtyBits |= NODE_DIRTY_BOUNDS;
+    }
+}
+
+void Node::clearTransformQueued()
+{
+    _dirtyBits &= ~NODE_TRANSFORM_QUEUED;
+}
+
+void Node::updateWorldMatrices(Scene* scene, std::vector<Node*>& roots, std::vector<Node*>& nodes)
+{
+    for (size_t i = 0, rootCount = roots.size(); i < rootCount; ++i)
+    {
+        Node* root = roots[i];
+        root->_dirtyBits &= ~NODE_TRANSFORM_QUEUED;
+
+        // Skip nodes that were resolved since they were queued, or that have left the scene.
+        if (!(root->_dirtyBits & NODE_DIRTY_WORLD) || root->getScene() != scene)
+            continue;
+
+        // Start from the highest changed ancestor, so that every parent is resolved before its children.
+        while (root->_parent && (root->_parent->_dirtyBits & NODE_DIRTY_WORLD))
+        {
+            root = root->_parent;
+        }
+
+        // Flatten the changed subtree, parents before children.
+        nodes.clear();
+        nodes.push_back(root);
+        for (size_t j = 0; j < nodes.size(); ++j)
+        {
+            for (Node* child = nodes[j]->_firstChild; child != NULL; child = child->_nextSibling)
+            {
+                if (child->_dirtyBits & NODE_DIRTY_WORLD)
+                    nodes.push_back(child);
+            }
+        }
+
+        // Compute the world matrices in one sweep; each parent's matrix is already resolved.
+        for (size_t j = 0, nodeCount = nodes.size(); j < nodeCount; ++j)
+        {
+            Node* node = nodes[j];
+            Node* parent = node->_parent;
+            if (parent && (!node->_collisionObject || node->_collisionObject->isKinematic()))
+            {
+                Matrix::multiply(parent->_world, node->getMatrix(), &node->_world);
+            }
+            else
+            {
+                node->_world = node->getMatrix();
+            }
+            node->_dirtyBits &= ~NODE_DIRTY_WORLD;
+        }
+    }
+    roots.clear();
+    nodes.clear();
+}
+
+void Node::setNodeIndexDirty()
+{
+    ++__nodeIndexVersion;
+}
+
+unsigned int Node::getNodeIndexVersion()
+{
+    return __nodeIndexVersion;
+}
 
-    // Mark our parent bounds as dirty as well
-    if (_parent)
-        _parent->setBoundsDirty();
+void Node::setSpatialIndexDirty()
+{
+    if (_spatialIndex)
+    {
+        _spatialIndex->setDirty(this);
+    }
+    else if (SpatialIndex::isActive())
+    {
+        Scene* scene = getScene();
+        if (scene && scene->_spatialIndex)
+            scene->_spatialIndex->setDirty(this);
+    }
 }
 
 Animation* Node::getAnimation(const char* id) const
@@ -791,6 +938,11 @@ void Node::setModel(Model* model)
             _model->addRef();
             _model->setNode(this);
         }
+
+        // The joint hierarchy of the model's skin is searched by findNode().
+        setNodeIndexDirty();
+
+        setBoundsDirty();
     }
 }
 
@@ -816,6 +968,8 @@ void Node::setTerrain(Terrain* terrain)
             _terrain->addRef();
             _terrain->setNode(this);
         }
+
+        setBoundsDirty();
     }
 }
 
@@ -844,71 +998,77 @@ void Node::setForm(Form* form)
     }
 }
 
-const BoundingSphere& Node::getBoundingSphere() const
+bool Node::getContentBounds(BoundingSphere* bounds) const
 {
-    if (_dirtyBits & NODE_DIRTY_BOUNDS)
-    {
-        _dirtyBits &= ~NODE_DIRTY_BOUNDS;
+    GP_ASSERT(bounds);
 
-        const Matrix& worldMatrix = getWorldMatrix();
-
-        // Start with our local bounding sphere
-        // TODO: Incorporate bounds from entities other than mesh (i.e. emitters, audiosource, etc)
-        bool empty = true;
-        if (_terrain)
+    // Start with our local bounding sphere
+    // TODO: Incorporate bounds from entities other than mesh (i.e. emitters, audiosource, etc)
+    bool empty = true;
+    if (_terrain)
+    {
+        bounds->set(_terrain->getBoundingBox());
+        empty = false;
+    }
+    if (_model && _model->getMesh())
+    {
+        if (empty)
         {
-            _bounds.set(_terrain->getBoundingBox());
+            bounds->set(_model->getMesh()->getBoundingSphere());
             empty = false;
         }
-        if (_model && _model->getMesh())
+        else
         {
-            if (empty)
-            {
-                _bounds.set(_model->getMesh()->getBoundingSphere());
-                empty = false;
-            }
-            else
-            {
-                _bounds.merge(_model->getMesh()->getBoundingSphere());
-            }
+            bounds->merge(_model->getMesh()->getBoundingSphere());
         }
-        else
+    }
+    if (empty)
+        return false;
+
+    // Transform the sphere into world space.
+    bool applyWorldTransform = true;
+    if (_model && _model->getSkin())
+    {
+        // Special case: If the root joint of our mesh skin is parented by any nodes, 
+        // multiply the world matrix of the root joint's parent by this node's
+        // world matrix. This computes a final world matrix used for transforming this
+        // node's bounding volume. This allows us to store a much smaller bounding
+        // volume approximation than would otherwise be possible for skinned meshes,
+        // since joint parent nodes that are not in the matrix palette do not need to
+        // be considered as directly transforming vertices on the GPU (they can instead
+        // be applied directly to the bounding volume transformation below).
+        GP_ASSERT(_model->getSkin()->getRootJoint());
+        Node* jointParent = _model->getSkin()->getRootJoint()->getParent();
+        if (jointParent)
         {
-            // Empty bounding sphere, set the world translation with zero radius
-            worldMatrix.getTranslation(&_bounds.center);
-            _bounds.radius = 0;
+            // TODO: Should we protect against the case where joints are nested directly
+            // in the node hierachy of the model (this is normally not the case)?
+            Matrix boundsMatrix;
+            Matrix::multiply(getWorldMatrix(), jointParent->getWorldMatrix(), &boundsMatrix);
+            bounds->transform(boundsMatrix);
+            applyWorldTransform = false;
         }
+    }
+    if (applyWorldTransform)
+    {
+        bounds->transform(getWorldMatrix());
+    }
 
-        // Transform the sphere (if not empty) into world space.
-        if (!empty)
+    return true;
+}
+
+const BoundingSphere& Node::getBoundingSphere() const
+{
+    if (_dirtyBits & NODE_DIRTY_BOUNDS)
+    {
+        _dirtyBits &= ~NODE_DIRTY_BOUNDS;
+
+        bool empty = !getContentBounds(&_bounds);
+        if (empty)
         {
-            bool applyWorldTransform = true;
-            if (_model && _model->getSkin())
-            {
-                // Special case: If the root joint of our mesh skin is parented by any nodes, 
-                // multiply the world matrix of the root joint's parent by this node's
-                // world matrix. This computes a final world matrix used for transforming this
-                // node's bounding volume. This allows us to store a much smaller bounding
-                // volume approximation than would otherwise be possible for skinned meshes,
-                // since joint parent nodes that are not in the matrix palette do not need to
-                // be considered as directly transforming vertices on the GPU (they can instead
-                // be applied directly to the bounding volume transformation below).
-                GP_ASSERT(_model->getSkin()->getRootJoint());
-                Node* jointParent = _model->getSkin()->getRootJoint()->getParent();
-                if (jointParent)
-                {
-                    // TODO: Should we protect against the case where joints are nested directly
-                    // in the node hierachy of the model (this is normally not the case)?
-                    Matrix boundsMatrix;
-                    Matrix::multiply(getWorldMatrix(), jointParent->getWorldMatrix(), &boundsMatrix);
-                    _bounds.transform(boundsMatrix);
-                    applyWorldTransform = false;
-                }
-            }
-            if (applyWorldTransform)
-            {
-                _bounds.transform(getWorldMatrix());
-            }
+            // Empty bounding sphere, set the world translation with zero radius
+            getWorldMatrix().getTranslation(&_bounds.center);
+            _bounds.radius = 0;
         }
 
         // Merge this world-space bounding sphere with our childrens' bounding volumes.
@@ -20,6 +20,7 @@ class Bundle;
 class Scene;
 class Form;
 class Terrain;
+class SpatialIndex;
 
 /**
  * Defines a basic hierarchical structure of transformation spaces.
@@ -29,6 +30,8 @@ class Node : public Transform, public Ref
     friend class Scene;
     friend class Bundle;
     friend class MeshSkin;
+    friend class Model;
+    friend class SpatialIndex;
 
 public:
 
@@ -696,6 +699,63 @@ protected:
      */
     void setBoundsDirty();
 
+    /**
+     * Notifies the spatial index of the node's scene, if it has one, that the bounds of the node have changed.
+     */
+    void setSpatialIndexDirty();
+
+    /**
+     * Computes the world space bounding sphere of the node's own content (its model and terrain),
+     * without the bounds of its children.
+     *
+     * @param bounds The bounding sphere to set.
+     *
+     * @return true if the node has content with bounds; false otherwise.
+     */
+    bool getContentBounds(BoundingSphere* bounds) const;
+
+    /**
+     * Clears the flag that marks the node as queued for the transform pass of its scene.
+     */
+    void clearTransformQueued();
+
+    /**
+     * Computes the world matrices of the changed subtrees under the given queued nodes, in one
+     * sweep over an array that holds each changed node after its parent.
+     *
+     * @param scene The scene the nodes were queued to.
+     * @param roots The queued nodes, which are removed from the queue.
+     * @param nodes Storage for the array of changed nodes.
+     */
+    static void updateWorldMatrices(Scene* scene, std::vector<Node*>& roots, std::vector<Node*>& nodes);
+
+    /**
+     * Searches this node's hierarchy for the first node that matches the given ID, without the ID index.
+     *
+     * @see findNode(const char*, bool, bool)
+     */
+    Node* searchNode(const char* id, bool recursive, bool exactMatch) const;
+
+    /**
+     * Searches this node's hierarchy for all nodes that match the given ID, without the ID index.
+     *
+     * @see findNodes(const char*, std::vector<Node*>&, bool, bool)
+     */
+    unsigned int searchNodes(const char* id, std::vector<Node*>& nodes, bool recursive, bool exactMatch) const;
+
+    /**
+     * Invalidates the ID indexes of the scenes. Called whenever a node ID changes or
+     * the nodes searched by findNode() change.
+     */
+    static void setNodeIndexDirty();
+
+    /**
+     * Gets the version of the node IDs and hierarchies, which is incremented by setNodeIndexDirty().
+     *
+     * @return The version of the node IDs and hierarchies.
+     */
+    static unsigned int getNodeIndexVersion();
+
 private:
 
     /**
@@ -836,6 +896,21 @@ protected:
      */
     mutable BoundingSphere _bounds;
 
+    /**
+     * The spatial index that the Node is in or is waiting to be refitted in, or NULL.
+     */
+    SpatialIndex* _spatialIndex;
+
+    /**
+     * The leaf of the Node in the spatial index, or -1 if the Node is not in the tree.
+     */
+    int _spatialProxy;
+
+    /**
+     * Whether the Node is waiting to be refitted in the spatial index.
+     */
+    bool _spatialDirty;
+
     /**
      * Pointer to custom UserData and cleanup call back that can be stored in a Node.
      */
@@ -6,6 +6,12 @@
 #include "Quaternion.h"
 #include "Properties.h"
 
+#ifdef USE_SSE
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 #define PARTICLE_COUNT_MAX                       100
 #define PARTICLE_EMISSION_RATE                   10
 #define PARTICLE_EMISSION_RATE_TIME_INTERVAL     1000.0f / (float)PARTICLE_EMISSION_RATE
@@ -14,7 +20,8 @@ namespace gameplay
 {
 
 ParticleEmitter::ParticleEmitter(SpriteBatch* batch, unsigned int particleCountMax) :
-    _particleCountMax(particleCountMax), _particleCount(0), _particles(NULL),
+    _particleCountMax(particleCountMax), _particleCount(0), _particleStride(0), _particleData(NULL),
+    _particleFrames(NULL), _particleVisible(NULL),
     _emissionRate(PARTICLE_EMISSION_RATE), _started(false), _ellipsoid(false),
     _sizeStartMin(1.0f), _sizeStartMax(1.0f), _sizeEndMin(1.0f), _sizeEndMax(1.0f),
     _energyMin(1000L), _energyMax(1000L),
@@ -31,7 +38,21 @@ ParticleEmitter::ParticleEmitter(SpriteBatch* batch, unsigned int particleCountM
     _timePerEmission(PARTICLE_EMISSION_RATE_TIME_INTERVAL), _timeRunning(0)
 {
     GP_ASSERT(particleCountMax);
-    _particles = new Particle[particleCountMax];
+
+    // Allocate every particle stream from a single block, padding each stream to a multiple
+    // of four particles and aligning it to 16 bytes for the SIMD update kernels.
+    _particleStride = (particleCountMax + 3) & ~3;
+    _particleData = new float[_particleStride * PARTICLE_STREAM_COUNT + 3];
+    memset(_particleData, 0, sizeof(float) * (_particleStride * PARTICLE_STREAM_COUNT + 3));
+    float* streams = (float*)(((size_t)_particleData + 15) & ~(size_t)15);
+    for (unsigned int i = 0; i < PARTICLE_STREAM_COUNT; ++i)
+    {
+        _particleStreams[i] = streams + i * _particleStride;
+    }
+    _particleFrames = new unsigned int[_particleStride];
+    memset(_particleFrames, 0, sizeof(unsigned int) * _particleStride);
+    _particleVisible = new unsigned char[_particleStride];
+    memset(_particleVisible, 0, _particleStride);
 
     GP_ASSERT(_spriteBatch);
     GP_ASSERT(_spriteBatch->getStateBlock());
@@ -42,7 +63,9 @@ ParticleEmitter::ParticleEmitter(SpriteBatch* batch, unsigned int particleCountM
 ParticleEmitter::~ParticleEmitter()
 {
     SAFE_DELETE(_spriteBatch);
-    SAFE_DELETE_ARRAY(_particles);
+    SAFE_DELETE_ARRAY(_particleData);
+    SAFE_DELETE_ARRAY(_particleFrames);
+    SAFE_DELETE_ARRAY(_particleVisible);
     SAFE_DELETE_ARRAY(_spriteTextureCoords);
 }
 
@@ -247,11 +270,11 @@ bool ParticleEmitter::isActive() const
     if (!_node)
         return false;
 
-    GP_ASSERT(_particles);
+    const float* energy = _particleStreams[ENERGY];
     bool active = false;
     for (unsigned int i = 0; i < _particleCount; i++)
     {
-        if (_particles[i]._energy > 0)
+        if (energy[i] > 0)
         {
             active = true;
             break;
@@ -264,7 +287,7 @@ bool ParticleEmitter::isActive() const
 void ParticleEmitter::emitOnce(unsigned int particleCount)
 {
     GP_ASSERT(_node);
-    GP_ASSERT(_particles);
+    GP_ASSERT(_particleData);
 
     // Limit particleCount so as not to go over _particleCountMax.
     if (particleCount + _particleCount > _particleCountMax)
@@ -281,65 +304,107 @@ void ParticleEmitter::emitOnce(unsigned int particleCount)
     world.m[13] = 0.0f;
     world.m[14] = 0.0f;
 
+    Vector4 colorStart;
+    Vector4 colorEnd;
+    Vector3 position;
+    Vector3 velocity;
+    Vector3 acceleration;
+    Vector3 rotationAxis;
+    float** s = _particleStreams;
+
     // Emit the new particles.
     for (unsigned int i = 0; i < particleCount; i++)
     {
-        Particle* p = &_particles[_particleCount];
-        p->_visible = true;
+        unsigned int index = _particleCount;
+        _particleVisible[index] = 1;
 
-        generateColor(_colorStart, _colorStartVar, &p->_colorStart);
-        generateColor(_colorEnd, _colorEndVar, &p->_colorEnd);
-        p->_color.set(p->_colorStart);
+        generateColor(_colorStart, _colorStartVar, &colorStart);
+        generateColor(_colorEnd, _colorEndVar, &colorEnd);
 
-        p->_energy = p->_energyStart = generateScalar(_energyMin, _energyMax);
-        p->_size = p->_sizeStart = generateScalar(_sizeStartMin, _sizeStartMax);
-        p->_sizeEnd = generateScalar(_sizeEndMin, _sizeEndMax);
-        p->_rotationPerParticleSpeed = generateScalar(_rotationPerParticleSpeedMin, _rotationPerParticleSpeedMax);
-        p->_angle = generateScalar(0.0f, p->_rotationPerParticleSpeed);
-        p->_rotationSpeed = generateScalar(_rotationSpeedMin, _rotationSpeedMax);
+        // Energy is counted in whole milliseconds.
+        float energy = (float)(long)generateScalar(_energyMin, _energyMax);
+        float sizeStart = generateScalar(_sizeStartMin, _sizeStartMax);
+        float sizeEnd = generateScalar(_sizeEndMin, _sizeEndMax);
+        float rotationPerParticleSpeed = generateScalar(_rotationPerParticleSpeedMin, _rotationPerParticleSpeedMax);
+        float angle = generateScalar(0.0f, rotationPerParticleSpeed);
+        float rotationSpeed = generateScalar(_rotationSpeedMin, _rotationSpeedMax);
 
         // Only initial position can be generated within an ellipsoidal domain.
-        generateVector(_position, _positionVar, &p->_position, _ellipsoid);
-        generateVector(_velocity, _velocityVar, &p->_velocity, false);
-        generateVector(_acceleration, _accelerationVar, &p->_acceleration, false);
-        generateVector(_rotationAxis, _rotationAxisVar, &p->_rotationAxis, false);
+        generateVector(_position, _positionVar, &position, _ellipsoid);
+        generateVector(_velocity, _velocityVar, &velocity, false);
+        generateVector(_acceleration, _accelerationVar, &acceleration, false);
+        generateVector(_rotationAxis, _rotationAxisVar, &rotationAxis, false);
 
         // Initial position, velocity and acceleration can all be relative to the emitter's transform.
         // Rotate specified properties by the node's rotation.
         if (_orbitPosition)
         {
-            world.transformPoint(p->_position, &p->_position);
+            world.transformPoint(position, &position);
         }
 
         if (_orbitVelocity)
         {
-            world.transformPoint(p->_velocity, &p->_velocity);
+            world.transformPoint(velocity, &velocity);
         }
 
         if (_orbitAcceleration)
         {
-            world.transformPoint(p->_acceleration, &p->_acceleration);
+            world.transformPoint(acceleration, &acceleration);
         }
 
         // The rotation axis always orbits the node.
-        if (p->_rotationSpeed != 0.0f && !p->_rotationAxis.isZero())
+        if (rotationSpeed != 0.0f && !rotationAxis.isZero())
         {
-            world.transformPoint(p->_rotationAxis, &p->_rotationAxis);
+            world.transformPoint(rotationAxis, &rotationAxis);
         }
 
         // Translate position relative to the node's world space.
-        p->_position.add(translation);
+        position.add(translation);
+
+        s[COLOR_START_R][index] = colorStart.x;
+        s[COLOR_START_G][index] = colorStart.y;
+        s[COLOR_START_B][index] = colorStart.z;
+        s[COLOR_START_A][index] = colorStart.w;
+        s[COLOR_END_R][index] = colorEnd.x;
+        s[COLOR_END_G][index] = colorEnd.y;
+        s[COLOR_END_B][index] = colorEnd.z;
+        s[COLOR_END_A][index] = colorEnd.w;
+        s[COLOR_R][index] = colorStart.x;
+        s[COLOR_G][index] = colorStart.y;
+        s[COLOR_B][index] = colorStart.z;
+        s[COLOR_A][index] = colorStart.w;
+        s[ENERGY_START][index] = energy;
+        s[ENERGY][index] = energy;
+        s[PERCENT][index] = 0.0f;
+        s[SIZE_START][index] = sizeStart;
+        s[SIZE_END][index] = sizeEnd;
+        s[SIZE][index] = sizeStart;
+        s[ROTATION_PER_PARTICLE_SPEED][index] = rotationPerParticleSpeed;
+        s[ANGLE][index] = angle;
+        s[ROTATION_SPEED][index] = rotationSpeed;
+        s[POSITION_X][index] = position.x;
+        s[POSITION_Y][index] = position.y;
+        s[POSITION_Z][index] = position.z;
+        s[VELOCITY_X][index] = velocity.x;
+        s[VELOCITY_Y][index] = velocity.y;
+        s[VELOCITY_Z][index] = velocity.z;
+        s[ACCELERATION_X][index] = acceleration.x;
+        s[ACCELERATION_Y][index] = acceleration.y;
+        s[ACCELERATION_Z][index] = acceleration.z;
+        s[ROTATION_AXIS_X][index] = rotationAxis.x;
+        s[ROTATION_AXIS_Y][index] = rotationAxis.y;
+        s[ROTATION_AXIS_Z][index] = rotationAxis.z;
 
         // Initial sprite frame.
         if (_spriteFrameRandomOffset > 0)
         {
-            p->_frame = rand() % _spriteFrameRandomOffset;
+            _particleFrames[index] = rand() % _spriteFrameRandomOffset;
         }
         else
         {
-            p->_frame = 0;
+            _particleFrames[index] = 0;
         }
-        p->_timeOnCurrentFrame = 0.0f;
+        s[TIME_ON_CURRENT_FRAME][index] = 0.0f;
 
         ++_particleCount;
     }
@@ -789,6 +854,182 @@ ParticleEmitter::TextureBlending ParticleEmitter::getTextureBlendingFromString(c
     }
 }
 
+void ParticleEmitter::copyParticle(unsigned int src, unsigned int dst)
+{
+    for (unsigned int i = 0; i < PARTICLE_STREAM_COUNT; ++i)
+    {
+        _particleStreams[i][dst] = _particleStreams[i][src];
+    }
+    _particleFrames[dst] = _particleFrames[src];
+    _particleVisible[dst] = _particleVisible[src];
+}
+
+// The SIMD kernels below operate on four particles at a time over streams padded to a multiple of four.
+
+/**
+ * Decrements each energy by the elapsed time, truncating towards zero as energy is counted in whole milliseconds.
+ */
+static void updateEnergy(float* energy, float elapsedTime, unsigned int count)
+{
+#ifdef USE_SSE
+    __m128 t = _mm_set1_ps(elapsedTime);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        __m128 e = _mm_sub_ps(_mm_load_ps(energy + i), t);
+        _mm_store_ps(energy + i, _mm_cvtepi32_ps(_mm_cvttps_epi32(e)));
+    }
+#elif defined(USE_NEON)
+    float32x4_t t = vdupq_n_f32(elapsedTime);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        float32x4_t e = vsubq_f32(vld1q_f32(energy + i), t);
+        vst1q_f32(energy + i, vcvtq_f32_s32(vcvtq_s32_f32(e)));
+    }
+#else
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        energy[i] = (float)(long)(energy[i] - elapsedTime);
+    }
+#endif
+}
+
+/**
+ * Adds each source value scaled by a constant to the destination (dst += src * scale).
+ */
+static void multiplyAdd(float* dst, const float* src, float scale, unsigned int count)
+{
+#ifdef USE_SSE
+    __m128 k = _mm_set1_ps(scale);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        _mm_store_ps(dst + i, _mm_add_ps(_mm_load_ps(dst + i), _mm_mul_ps(_mm_load_ps(src + i), k)));
+    }
+#elif defined(USE_NEON)
+    float32x4_t k = vdupq_n_f32(scale);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_f32(vld1q_f32(src + i), k)));
+    }
+#else
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        dst[i] += src[i] * scale;
+    }
+#endif
+}
+
+/**
+ * Computes the fraction of each particle's life that has been spent (1 - energy / energyStart).
+ */
+static void computePercent(float* percent, const float* energy, const float* energyStart, unsigned int count)
+{
+#ifdef USE_SSE
+    __m128 one = _mm_set1_ps(1.0f);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        _mm_store_ps(percent + i, _mm_sub_ps(one, _mm_div_ps(_mm_load_ps(energy + i), _mm_load_ps(energyStart + i))));
+    }
+#else
+    // Note: ARMv7 NEON has no exact divide, so this stays scalar to give identical results on every platform.
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        percent[i] = 1.0f - (energy[i] / energyStart[i]);
+    }
+#endif
+}
+
+/**
+ * Linearly interpolates between start and end values by the given percentages.
+ */
+static void interpolate(float* dst, const float* start, const float* end, const float* percent, unsigned int count)
+{
+#ifdef USE_SSE
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        __m128 s = _mm_load_ps(start + i);
+        _mm_store_ps(dst + i, _mm_add_ps(s, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(end + i), s), _mm_load_ps(percent + i))));
+    }
+#elif defined(USE_NEON)
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        float32x4_t s = vld1q_f32(start + i);
+        vst1q_f32(dst + i, vaddq_f32(s, vmulq_f32(vsubq_f32(vld1q_f32(end + i), s), vld1q_f32(percent + i))));
+    }
+#else
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        dst[i] = start[i] + (end[i] - start[i]) * percent[i];
+    }
+#endif
+}
+
+/**
+ * Hides the particles whose positions fall outside of the frustum.
+ */
+static void cullParticles(const Frustum& frustum, const float* x, const float* y, const float* z, unsigned char* visible, unsigned int count)
+{
+    const Plane* planes[6] = { &frustum.getNear(), &frustum.getFar(), &frustum.getLeft(), &frustum.getRight(), &frustum.getTop(), &frustum.getBottom() };
+    float p[6][4];
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        const Vector3& normal = planes[i]->getNormal();
+        p[i][0] = normal.x;
+        p[i][1] = normal.y;
+        p[i][2] = normal.z;
+        p[i][3] = planes[i]->getDistance();
+    }
+
+#if defined(USE_SSE) || defined(USE_NEON)
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+#ifdef USE_SSE
+        __m128 px = _mm_load_ps(x + i);
+        __m128 py = _mm_load_ps(y + i);
+        __m128 pz = _mm_load_ps(z + i);
+        __m128 zero = _mm_setzero_ps();
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (unsigned int j = 0; j < 6; ++j)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[j][0]), px), _mm_mul_ps(_mm_set1_ps(p[j][1]), py)),
+                                             _mm_mul_ps(_mm_set1_ps(p[j][2]), pz)), _mm_set1_ps(p[j][3]));
+            inside = _mm_and_ps(inside, _mm_cmpgt_ps(d, zero));
+        }
+        int mask = _mm_movemask_ps(inside);
+#else
+        float32x4_t px = vld1q_f32(x + i);
+        float32x4_t py = vld1q_f32(y + i);
+        float32x4_t pz = vld1q_f32(z + i);
+        float32x4_t zero = vdupq_n_f32(0.0f);
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+        for (unsigned int j = 0; j < 6; ++j)
+        {
+            float32x4_t d = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(px, p[j][0]), vmulq_n_f32(py, p[j][1])),
+                                               vmulq_n_f32(pz, p[j][2])), vdupq_n_f32(p[j][3]));
+            inside = vandq_u32(inside, vcgtq_f32(d, zero));
+        }
+        int mask = (vgetq_lane_u32(inside, 0) & 1) | (vgetq_lane_u32(inside, 1) & 2) |
+                   (vgetq_lane_u32(inside, 2) & 4) | (vgetq_lane_u32(inside, 3) & 8);
+#endif
+        visible[i] &= (mask & 1);
+        visible[i + 1] &= (mask >> 1) & 1;
+        visible[i + 2] &= (mask >> 2) & 1;
+        visible[i + 3] &= (mask >> 3) & 1;
+    }
+#else
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        for (unsigned int j = 0; j < 6; ++j)
+        {
+            if (p[j][0] * x[i] + p[j][1] * y[i] + p[j][2] * z[i] + p[j][3] <= 0)
+            {
+                visible[i] = 0;
+                break;
+            }
+        }
+    }
+#endif
+}
+
 void ParticleEmitter::update(float elapsedTime)
 {
     if (!isActive())
@@ -796,9 +1037,14 @@ void ParticleEmitter::update(float elapsedTime)
         return;
     }
 
-    // Calculate the time passed since last update.
-    float elapsedSecs = elapsedTime * 0.001f;
+    updateEmission(elapsedTime);
 
+    GP_ASSERT(_node && _node->getScene() && _node->getScene()->getActiveCamera());
+    updateParticles(elapsedTime, _node->getScene()->getActiveCamera()->getFrustum());
+}
+
+void ParticleEmitter::updateEmission(float elapsedTime)
+{
     if (_started && _emissionRate)
     {
         // Calculate how much time has passed since we last emitted particles.
@@ -817,98 +1063,125 @@ void ParticleEmitter::update(float elapsedTime)
             emitOnce(emitCount);
         }
     }
+}
 
-    GP_ASSERT(_node && _node->getScene() && _node->getScene()->getActiveCamera());
-    const Frustum& frustum = _node->getScene()->getActiveCamera()->getFrustum();
+void ParticleEmitter::updateParticles(float elapsedTime, const Frustum& frustum)
+{
+    // Calculate the time passed since last update.
+    float elapsedSecs = elapsedTime * 0.001f;
 
-    // Now update all currently living particles.
-    GP_ASSERT(_particles);
-    for (unsigned int particlesIndex = 0; particlesIndex < _particleCount; ++particlesIndex)
-    {
-        Particle* p = &_particles[particlesIndex];
-        p->_energy -= elapsedTime;
+    // Now update all currently living particles, four at a time.
+    GP_ASSERT(_particleData);
+    float** s = _particleStreams;
+    unsigned int count = (_particleCount + 3) & ~3;
+
+    updateEnergy(s[ENERGY], elapsedTime, count);
 
-        if (p->_energy > 0L)
+    // Rotate the velocity and acceleration of living particles that spin around an axis.
+    if (_rotationSpeedMin != 0.0f || _rotationSpeedMax != 0.0f)
+    {
+        Vector3 axis;
+        Vector3 v;
+        for (unsigned int i = 0; i < _particleCount; ++i)
         {
-            if (p->_rotationSpeed != 0.0f && !p->_rotationAxis.isZero())
+            float rotationSpeed = s[ROTATION_SPEED][i];
+            axis.set(s[ROTATION_AXIS_X][i], s[ROTATION_AXIS_Y][i], s[ROTATION_AXIS_Z][i]);
+            if (s[ENERGY][i] > 0 && rotationSpeed != 0.0f && !axis.isZero())
             {
-                Matrix::createRotation(p->_rotationAxis, p->_rotationSpeed * elapsedSecs, &_rotation);
-
-                _rotation.transformPoint(p->_velocity, &p->_velocity);
-                _rotation.transformPoint(p->_acceleration, &p->_acceleration);
+                Matrix::createRotation(axis, rotationSpeed * elapsedSecs, &_rotation);
+
+                v.set(s[VELOCITY_X][i], s[VELOCITY_Y][i], s[VELOCITY_Z][i]);
+                _rotation.transformPoint(v, &v);
+                s[VELOCITY_X][i] = v.x;
+                s[VELOCITY_Y][i] = v.y;
+                s[VELOCITY_Z][i] = v.z;
+
+                v.set(s[ACCELERATION_X][i], s[ACCELERATION_Y][i], s[ACCELERATION_Z][i]);
+                _rotation.transformPoint(v, &v);
+                s[ACCELERATION_X][i] = v.x;
+                s[ACCELERATION_Y][i] = v.y;
+                s[ACCELERATION_Z][i] = v.z;
             }
+        }
+    }
 
-            // Particle is still alive.
-            p->_velocity.x += p->_acceleration.x * elapsedSecs;
-            p->_velocity.y += p->_acceleration.y * elapsedSecs;
-            p->_velocity.z += p->_acceleration.z * elapsedSecs;
-
-            p->_position.x += p->_velocity.x * elapsedSecs;
-            p->_position.y += p->_velocity.y * elapsedSecs;
-            p->_position.z += p->_velocity.z * elapsedSecs;
-
-            if (!frustum.intersects(p->_position))
-            {
-                p->_visible = false;
+    // Integrate velocity and position.
+    multiplyAdd(s[VELOCITY_X], s[ACCELERATION_X], elapsedSecs, count);
+    multiplyAdd(s[VELOCITY_Y], s[ACCELERATION_Y], elapsedSecs, count);
+    multiplyAdd(s[VELOCITY_Z], s[ACCELERATION_Z], elapsedSecs, count);
+    multiplyAdd(s[POSITION_X], s[VELOCITY_X], elapsedSecs, count);
+    multiplyAdd(s[POSITION_Y], s[VELOCITY_Y], elapsedSecs, count);
+    multiplyAdd(s[POSITION_Z], s[VELOCITY_Z], elapsedSecs, count);
+
+    // Particles that leave the frustum are hidden for the rest of their life.
+    cullParticles(frustum, s[POSITION_X], s[POSITION_Y], s[POSITION_Z], _particleVisible, count);
+
+    multiplyAdd(s[ANGLE], s[ROTATION_PER_PARTICLE_SPEED], elapsedSecs, count);
+
+    // Simple linear interpolation of color and size.
+    computePercent(s[PERCENT], s[ENERGY], s[ENERGY_START], count);
+    interpolate(s[COLOR_R], s[COLOR_START_R], s[COLOR_END_R], s[PERCENT], count);
+    interpolate(s[COLOR_G], s[COLOR_START_G], s[COLOR_END_G], s[PERCENT], count);
+    interpolate(s[COLOR_B], s[COLOR_START_B], s[COLOR_END_B], s[PERCENT], count);
+    interpolate(s[COLOR_A], s[COLOR_START_A], s[COLOR_END_A], s[PERCENT], count);
+    interpolate(s[SIZE], s[SIZE_START], s[SIZE_END], s[PERCENT], count);
+
+    // Handle sprite animations.
+    if (_spriteAnimated)
+    {
+        for (unsigned int i = 0; i < _particleCount; ++i)
+        {
+            if (s[ENERGY][i] <= 0 || !_particleVisible[i])
                 continue;
-            }
-
-            p->_angle += p->_rotationPerParticleSpeed * elapsedSecs;
 
-            // Simple linear interpolation of color and size.
-            float percent = 1.0f - ((float)p->_energy / (float)p->_energyStart);
-
-            p->_color.x = p->_colorStart.x + (p->_colorEnd.x - p->_colorStart.x) * percent;
-            p->_color.y = p->_colorStart.y + (p->_colorEnd.y - p->_colorStart.y) * percent;
-            p->_color.z = p->_colorStart.z + (p->_colorEnd.z - p->_colorStart.z) * percent;
-            p->_color.w = p->_colorStart.w + (p->_colorEnd.w - p->_colorStart.w) * percent;
-
-            p->_size = p->_sizeStart + (p->_sizeEnd - p->_sizeStart) * percent;
-
-            // Handle sprite animations.
-            if (_spriteAnimated)
+            unsigned int& frame = _particleFrames[i];
+            float& timeOnCurrentFrame = s[TIME_ON_CURRENT_FRAME][i];
+            if (!_spriteLooped)
             {
-                if (!_spriteLooped)
+                // The last frame should finish exactly when the particle dies.
+                float percentSpent = 0.0f;
+                for (unsigned int j = 0; j < frame; j++)
                 {
-                    // The last frame should finish exactly when the particle dies.
-                    float percentSpent = 0.0f;
-                    for (unsigned int i = 0; i < p->_frame; i++)
-                    {
-                        percentSpent += _spritePercentPerFrame;
-                    }
-                    p->_timeOnCurrentFrame = percent - percentSpent;
-                    if (p->_frame < _spriteFrameCount - 1 &&
-                        p->_timeOnCurrentFrame >= _spritePercentPerFrame)
-                    {
-                        ++p->_frame;
-                    }
+                    percentSpent += _spritePercentPerFrame;
                 }
-                else
+                timeOnCurrentFrame = s[PERCENT][i] - percentSpent;
+                if (frame < _spriteFrameCount - 1 &&
+                    timeOnCurrentFrame >= _spritePercentPerFrame)
                 {
-                    // _spriteFrameDurationSecs is an absolute time measured in seconds,
-                    // and the animation repeats indefinitely.
-                    p->_timeOnCurrentFrame += elapsedSecs;
-                    if (p->_timeOnCurrentFrame >= _spriteFrameDurationSecs)
+                    ++frame;
+                }
+            }
+            else
+            {
+                // _spriteFrameDurationSecs is an absolute time measured in seconds,
+                // and the animation repeats indefinitely.
+                timeOnCurrentFrame += elapsedSecs;
+                if (timeOnCurrentFrame >= _spriteFrameDurationSecs)
+                {
+                    timeOnCurrentFrame -= _spriteFrameDurationSecs;
+                    ++frame;
+                    if (frame == _spriteFrameCount)
                     {
-                        p->_timeOnCurrentFrame -= _spriteFrameDurationSecs;
-                        ++p->_frame;
-                        if (p->_frame == _spriteFrameCount)
-                        {
-                            p->_frame = 0;
-                        }
+                        frame = 0;
                     }
                 }
             }
         }
-        else
+    }
+
+    // Remove dead particles by moving the particle furthest from the start of the array
+    // down to take its place, and re-use the slot at the end of the list of living particles.
+    for (unsigned int i = 0; i < _particleCount;)
+    {
+        if (s[ENERGY][i] > 0)
         {
-            // Particle is dead.  Move the particle furthest from the start of the array
-            // down to take its place, and re-use the slot at the end of the list of living particles.
-            if (particlesIndex != _particleCount - 1)
-            {
-                _particles[particlesIndex] = _particles[_particleCount - 1];
-            }
-            --_particleCount;
+            ++i;
+            continue;
+        }
+        --_particleCount;
+        if (i != _particleCount)
+        {
+            copyParticle(_particleCount, i);
         }
     }
 }
@@ -922,45 +1195,57 @@ void ParticleEmitter::draw()
 
     if (_particleCount > 0)
     {
-        GP_ASSERT(_spriteBatch);
-        GP_ASSERT(_particles);
-        GP_ASSERT(_spriteTextureCoords);
-
-        // Set our node's view projection matrix to this emitter's effect.
-        if (_node)
-        {
-            _spriteBatch->setProjectionMatrix(_node->getViewProjectionMatrix());
-        }
+        Vector3 right;
+        Vector3 up;
+        prepareDraw(&right, &up);
 
         // Begin sprite batch drawing
         _spriteBatch->start();
+        drawParticles(right, up);
 
-        // 2D Rotation.
-        static const Vector2 pivot(0.5f, 0.5f);
+        // Render.
+        _spriteBatch->finish();
+    }
+}
 
-        // 3D Rotation so that particles always face the camera.
-        GP_ASSERT(_node && _node->getScene() && _node->getScene()->getActiveCamera() && _node->getScene()->getActiveCamera()->getNode());
-        const Matrix& cameraWorldMatrix = _node->getScene()->getActiveCamera()->getNode()->getWorldMatrix();
+void ParticleEmitter::prepareDraw(Vector3* right, Vector3* up)
+{
+    GP_ASSERT(_spriteBatch);
+    GP_ASSERT(right && up);
 
-        Vector3 right;
-        cameraWorldMatrix.getRightVector(&right);
-        Vector3 up;
-        cameraWorldMatrix.getUpVector(&up);
+    // Set our node's view projection matrix to this emitter's effect.
+    if (_node)
+    {
+        _spriteBatch->setProjectionMatrix(_node->getViewProjectionMatrix());
+    }
 
-        for (unsigned int i = 0; i < _particleCount; i++)
-        {
-            Particle* p = &_particles[i];
+    // 3D Rotation so that particles always face the camera.
+    GP_ASSERT(_node && _node->getScene() && _node->getScene()->getActiveCamera() && _node->getScene()->getActiveCamera()->getNode());
+    const Matrix& cameraWorldMatrix = _node->getScene()->getActiveCamera()->getNode()->getWorldMatrix();
+    cameraWorldMatrix.getRightVector(right);
+    cameraWorldMatrix.getUpVector(up);
+}
 
-            if (p->_visible)
-            {
-                _spriteBatch->draw(p->_position, right, up, p->_size, p->_size,
-                                   _spriteTextureCoords[p->_frame * 4], _spriteTextureCoords[p->_frame * 4 + 1], _spriteTextureCoords[p->_frame * 4 + 2], _spriteTextureCoords[p->_frame * 4 + 3],
-                                   p->_color, pivot, p->_angle);
-            }
-        }
+void ParticleEmitter::drawParticles(const Vector3& right, const Vector3& up)
+{
+    GP_ASSERT(_spriteBatch);
+    GP_ASSERT(_particleData);
+    GP_ASSERT(_spriteTextureCoords);
 
-        // Render.
-        _spriteBatch->finish();
+    // 2D Rotation.
+    const Vector2 pivot(0.5f, 0.5f);
+
+    float** s = _particleStreams;
+    for (unsigned int i = 0; i < _particleCount; i++)
+    {
+        if (_particleVisible[i])
+        {
+            unsigned int frame = _particleFrames[i];
+            float size = s[SIZE][i];
+            _spriteBatch->draw(Vector3(s[POSITION_X][i], s[POSITION_Y][i], s[POSITION_Z][i]), right, up, size, size,
+                               _spriteTextureCoords[frame * 4], _spriteTextureCoords[frame * 4 + 1], _spriteTextureCoords[frame * 4 + 2], _spriteTextureCoords[frame * 4 + 3],
+                               Vector4(s[COLOR_R][i], s[COLOR_G][i], s[COLOR_B][i], s[COLOR_A][i]), pivot, s[ANGLE][i]);
+        }
     }
 }
 
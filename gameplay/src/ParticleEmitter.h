@@ -14,6 +14,7 @@ namespace gameplay
 {
 
 class Node;
+class Frustum;
 
 /**
  * Defines a particle emitter that can be made to simulate and render a particle system.
@@ -139,6 +140,7 @@ class Node;
 class ParticleEmitter : public Ref
 {
     friend class Node;
+    friend class ParticleSystem;
 
 public:
 
@@ -667,35 +669,99 @@ private:
     void generateColor(const Vector4& base, const Vector4& variance, Vector4* dst);
 
     /**
-     * Defines the data for a single particle in the system.
+     * Emits the particles due since the last update.
+     *
+     * This consumes random numbers and reads the node's world matrix, so it must be called
+     * from one thread at a time.
+     *
+     * @param elapsedTime The amount of time that has passed since the last update, in milliseconds.
      */
-    class Particle
-    {
+    void updateEmission(float elapsedTime);
+
+    /**
+     * Simulates the living particles and removes the ones that have died.
+     *
+     * This only touches the emitter's own particle data, so different emitters can be
+     * updated on different threads at the same time.
+     *
+     * @param elapsedTime The amount of time that has passed since the last update, in milliseconds.
+     * @param frustum The frustum particles are culled against.
+     */
+    void updateParticles(float elapsedTime, const Frustum& frustum);
+
+    /**
+     * Sets the sprite batch's projection and computes the camera facing billboard axes.
+     *
+     * @param right Populated with the camera's right vector.
+     * @param up Populated with the camera's up vector.
+     */
+    void prepareDraw(Vector3* right, Vector3* up);
 
-    public:
-        Vector3 _position;
-        Vector3 _velocity;
-        Vector3 _acceleration;
-        Vector4 _colorStart;
-        Vector4 _colorEnd;
-        Vector4 _color;
-        float _rotationPerParticleSpeed;
-        Vector3 _rotationAxis;
-        float _rotationSpeed;
-        float _angle;
-        long _energyStart;
-        long _energy;
-        float _sizeStart;
-        float _sizeEnd;
-        float _size;
-        unsigned int _frame;
-        float _timeOnCurrentFrame;
-        bool _visible;
+    /**
+     * Writes a sprite for each visible particle into the sprite batch, without rendering it.
+     *
+     * @param right The camera's right vector.
+     * @param up The camera's up vector.
+     */
+    void drawParticles(const Vector3& right, const Vector3& up);
+
+    /**
+     * The per-particle streams of the structure-of-arrays particle store.
+     *
+     * Each stream holds one float per particle so that the update kernels
+     * can process four particles at a time with SIMD instructions.
+     */
+    enum ParticleStream
+    {
+        POSITION_X,
+        POSITION_Y,
+        POSITION_Z,
+        VELOCITY_X,
+        VELOCITY_Y,
+        VELOCITY_Z,
+        ACCELERATION_X,
+        ACCELERATION_Y,
+        ACCELERATION_Z,
+        COLOR_START_R,
+        COLOR_START_G,
+        COLOR_START_B,
+        COLOR_START_A,
+        COLOR_END_R,
+        COLOR_END_G,
+        COLOR_END_B,
+        COLOR_END_A,
+        COLOR_R,
+        COLOR_G,
+        COLOR_B,
+        COLOR_A,
+        SIZE_START,
+        SIZE_END,
+        SIZE,
+        ENERGY_START,
+        ENERGY,
+        PERCENT,
+        ROTATION_PER_PARTICLE_SPEED,
+        ANGLE,
+        ROTATION_SPEED,
+        ROTATION_AXIS_X,
+        ROTATION_AXIS_Y,
+        ROTATION_AXIS_Z,
+        TIME_ON_CURRENT_FRAME,
+        PARTICLE_STREAM_COUNT
     };
 
+    /**
+     * Copies the particle at index src over the particle at index dst.
+     */
+    void copyParticle(unsigned int src, unsigned int dst);
+
     unsigned int _particleCountMax;
     unsigned int _particleCount;
-    Particle* _particles;
+    unsigned int _particleStride;                           // Floats per stream (the max particle count rounded up to a multiple of four).
+    float* _particleData;                                   // The single allocation backing every particle stream.
+    float* _particleStreams[PARTICLE_STREAM_COUNT];         // 16-byte aligned pointers to each stream within _particleData.
+    unsigned int* _particleFrames;                          // The current sprite frame of each particle.
+    unsigned char* _particleVisible;                        // Whether each particle is visible (particles leaving the frustum stay hidden).
     unsigned int _emissionRate;
     bool _started;
     bool _ellipsoid;
@@ -0,0 +1,144 @@
+#include "Base.h"
+#include "ParticleSystem.h"
+#include "Game.h"
+#include "Node.h"
+#include "Scene.h"
+
+namespace gameplay
+{
+
+ParticleSystem::ParticleSystem()
+    : _elapsedTime(0.0f)
+{
+}
+
+ParticleSystem::~ParticleSystem()
+{
+    removeAllEmitters();
+}
+
+ParticleSystem* ParticleSystem::create()
+{
+    return new ParticleSystem();
+}
+
+void ParticleSystem::addEmitter(ParticleEmitter* emitter)
+{
+    GP_ASSERT(emitter);
+
+    emitter->addRef();
+    _emitters.push_back(emitter);
+}
+
+void ParticleSystem::removeEmitter(ParticleEmitter* emitter)
+{
+    std::vector<ParticleEmitter*>::iterator itr = std::find(_emitters.begin(), _emitters.end(), emitter);
+    if (itr != _emitters.end())
+    {
+        _emitters.erase(itr);
+        SAFE_RELEASE(emitter);
+    }
+}
+
+void ParticleSystem::removeAllEmitters()
+{
+    for (size_t i = 0, count = _emitters.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_emitters[i]);
+    }
+    _emitters.clear();
+}
+
+unsigned int ParticleSystem::getEmitterCount() const
+{
+    return (unsigned int)_emitters.size();
+}
+
+ParticleEmitter* ParticleSystem::getEmitter(unsigned int index) const
+{
+    GP_ASSERT(index < _emitters.size());
+    return _emitters[index];
+}
+
+void ParticleSystem::update(float elapsedTime)
+{
+    _activeEmitters.clear();
+    _frustums.clear();
+
+    // Emission consumes random numbers and reads node transforms and camera frustums (which
+    // are computed lazily), so it runs serially in order to match a serial update exactly.
+    for (size_t i = 0, count = _emitters.size(); i < count; ++i)
+    {
+        ParticleEmitter* emitter = _emitters[i];
+        if (!emitter->isActive())
+            continue;
+
+        emitter->updateEmission(elapsedTime);
+
+        Node* node = emitter->getNode();
+        GP_ASSERT(node && node->getScene() && node->getScene()->getActiveCamera());
+        _activeEmitters.push_back(emitter);
+        _frustums.push_back(&node->getScene()->getActiveCamera()->getFrustum());
+    }
+
+    // Each emitter only touches its own particles, so the simulations run in parallel.
+    _elapsedTime = elapsedTime;
+    Game::getInstance()->getJobSystem()->parallelFor((unsigned int)_activeEmitters.size(), 1, updateEmitters, this);
+}
+
+void ParticleSystem::draw()
+{
+    _activeEmitters.clear();
+    _billboardAxes.clear();
+
+    // Projection and camera matrices are computed lazily, so fetch them serially. The sprite
+    // batches are also started and grown here, since growing recreates GL buffers and vertex
+    // attribute bindings, which must only happen on the rendering thread.
+    for (size_t i = 0, count = _emitters.size(); i < count; ++i)
+    {
+        ParticleEmitter* emitter = _emitters[i];
+        if (!emitter->isActive() || emitter->getParticlesCount() == 0)
+            continue;
+
+        Vector3 right;
+        Vector3 up;
+        emitter->prepareDraw(&right, &up);
+        emitter->_spriteBatch->start();
+        emitter->_spriteBatch->reserve(emitter->getParticlesCount());
+        _activeEmitters.push_back(emitter);
+        _billboardAxes.push_back(right);
+        _billboardAxes.push_back(up);
+    }
+
+    // Build the vertices of every sprite batch in parallel. This only writes into the batches'
+    // client-side arrays and makes no GL calls.
+    Game::getInstance()->getJobSystem()->parallelFor((unsigned int)_activeEmitters.size(), 1, drawEmitters, this);
+
+    // Upload the vertices and issue the draw calls on this thread, in the order the emitters
+    // were added.
+    for (size_t i = 0, count = _activeEmitters.size(); i < count; ++i)
+    {
+        _activeEmitters[i]->_spriteBatch->finish();
+    }
+}
+
+void ParticleSystem::updateEmitters(void* arg, unsigned int start, unsigned int end)
+{
+    ParticleSystem* system = (ParticleSystem*)arg;
+    for (unsigned int i = start; i < end; ++i)
+    {
+        system->_activeEmitters[i]->updateParticles(system->_elapsedTime, *system->_frustums[i]);
+    }
+}
+
+void ParticleSystem::drawEmitters(void* arg, unsigned int start, unsigned int end)
+{
+    ParticleSystem* system = (ParticleSystem*)arg;
+    for (unsigned int i = start; i < end; ++i)
+    {
+        ParticleEmitter* emitter = system->_activeEmitters[i];
+        emitter->drawParticles(system->_billboardAxes[i * 2], system->_billboardAxes[i * 2 + 1]);
+    }
+}
+
+}
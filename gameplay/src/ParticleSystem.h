@@ -0,0 +1,124 @@
+#ifndef PARTICLESYSTEM_H_
+#define PARTICLESYSTEM_H_
+
+#include "ParticleEmitter.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a collection of particle emitters that are updated and drawn together.
+ *
+ * Updating each emitter separately runs every particle simulation one after another on the
+ * calling thread. A ParticleSystem instead simulates all of its emitters in parallel on the
+ * game's JobSystem and builds their sprite batches in parallel as well, while the steps that
+ * must stay serial (emitting new particles, which consumes random numbers, and issuing the
+ * draw calls) run on the calling thread in the order the emitters were added. The results
+ * are therefore exactly the same as calling ParticleEmitter::update() and
+ * ParticleEmitter::draw() on each emitter in that order.
+ *
+ * Every emitter must be attached to a node in a scene with an active camera.
+ */
+class ParticleSystem : public Ref
+{
+public:
+
+    /**
+     * Creates a new, empty particle system.
+     *
+     * @return The new particle system.
+     * @script{create}
+     */
+    static ParticleSystem* create();
+
+    /**
+     * Adds an emitter to the particle system.
+     *
+     * The particle system holds a reference to the emitter until it is removed.
+     *
+     * @param emitter The emitter to add.
+     */
+    void addEmitter(ParticleEmitter* emitter);
+
+    /**
+     * Removes an emitter from the particle system.
+     *
+     * @param emitter The emitter to remove.
+     */
+    void removeEmitter(ParticleEmitter* emitter);
+
+    /**
+     * Removes all emitters from the particle system.
+     */
+    void removeAllEmitters();
+
+    /**
+     * Gets the number of emitters in the particle system.
+     *
+     * @return The number of emitters.
+     */
+    unsigned int getEmitterCount() const;
+
+    /**
+     * Gets the emitter at the specified index.
+     *
+     * @param index The index of the emitter.
+     *
+     * @return The emitter at the index.
+     */
+    ParticleEmitter* getEmitter(unsigned int index) const;
+
+    /**
+     * Updates the particles of every emitter.
+     *
+     * @param elapsedTime The amount of time that has passed since the last call to update(), in milliseconds.
+     */
+    void update(float elapsedTime);
+
+    /**
+     * Draws the particles of every emitter, in the order the emitters were added.
+     */
+    void draw();
+
+private:
+
+    /**
+     * Constructor.
+     */
+    ParticleSystem();
+
+    /**
+     * Destructor.
+     */
+    ~ParticleSystem();
+
+    /**
+     * Hidden copy constructor.
+     */
+    ParticleSystem(const ParticleSystem& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    ParticleSystem& operator=(const ParticleSystem&);
+
+    /**
+     * Parallel-for batch that simulates a range of the active emitters.
+     */
+    static void updateEmitters(void* arg, unsigned int start, unsigned int end);
+
+    /**
+     * Parallel-for batch that builds the sprite batches for a range of the active emitters.
+     */
+    static void drawEmitters(void* arg, unsigned int start, unsigned int end);
+
+    std::vector<ParticleEmitter*> _emitters;        // The emitters, in the order they were added.
+    std::vector<ParticleEmitter*> _activeEmitters;  // The emitters being updated or drawn this pass.
+    std::vector<const Frustum*> _frustums;          // The culling frustum for each active emitter.
+    std::vector<Vector3> _billboardAxes;            // The camera right and up vectors for each active emitter.
+    float _elapsedTime;                             // The elapsed time of the update in progress.
+};
+
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "Base.h"
 #include "PhysicsController.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include "PhysicsRigidBody.h"
 #include "PhysicsCharacter.h"
 #include "Game.h"
@@ -32,6 +34,15 @@ PhysicsController::PhysicsController()
     _debugDrawer(NULL), _status(PhysicsController::Listener::DEACTIVATED), _listeners(NULL),
     _gravity(btScalar(0.0), btScalar(-9.8), btScalar(0.0)), _collisionCallback(NULL)
 {
+    // Install the allocator before Bullet allocates anything, and keep it for the lifetime
+    // of the process since memory allocated with it must be freed with it.
+    static bool allocatorInstalled = false;
+    if (!allocatorInstalled)
+    {
+        btAlignedAllocSetCustom(allocate, deallocate);
+        allocatorInstalled = true;
+    }
+
     // Default gravity is 9.8 along the negative Y axis.
     _collisionCallback = new CollisionCallback(this);
 
@@ -46,6 +57,28 @@ PhysicsController::~PhysicsController()
     SAFE_DELETE(_listeners);
 }
 
+// The size of the header that stores the size of each Bullet allocation (kept at 16 bytes for alignment).
+#define PHYSICS_ALLOCATION_HEADER 16
+
+void* PhysicsController::allocate(size_t size)
+{
+    unsigned char* p = (unsigned char*)malloc(size + PHYSICS_ALLOCATION_HEADER);
+    if (!p)
+        return NULL;
+    *(size_t*)p = size;
+    MemoryTracker::trackAllocation(MemoryTracker::CATEGORY_PHYSICS, size);
+    return p + PHYSICS_ALLOCATION_HEADER;
+}
+
+void PhysicsController::deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+    unsigned char* p = (unsigned char*)ptr - PHYSICS_ALLOCATION_HEADER;
+    MemoryTracker::trackFree(MemoryTracker::CATEGORY_PHYSICS, *(size_t*)p);
+    free(p);
+}
+
 void PhysicsController::addStatusListener(Listener* listener)
 {
     GP_ASSERT(listener);
@@ -429,6 +462,8 @@ btScalar PhysicsController::CollisionCallback::addSingleResult(btManifoldPoint&
 
 void PhysicsController::initialize()
 {
+    GP_MEMORY_SCOPE(CATEGORY_PHYSICS);
+
     _collisionConfiguration = bullet_new<btDefaultCollisionConfiguration>();
     _dispatcher = bullet_new<btCollisionDispatcher>(_collisionConfiguration);
     _overlappingPairCache = bullet_new<btDbvtBroadphase>();
@@ -472,6 +507,9 @@ void PhysicsController::resume()
 
 void PhysicsController::update(float elapsedTime)
 {
+    GP_PROFILE_SCOPE("PhysicsController::update");
+    GP_MEMORY_SCOPE(CATEGORY_PHYSICS);
+
     GP_ASSERT(_world);
     _isUpdating = true;
 
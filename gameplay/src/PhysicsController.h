@@ -372,6 +372,17 @@ private:
      */
     PhysicsController();
 
+    /**
+     * Allocates memory for Bullet (see btAlignedAllocSetCustom), counting it against
+     * MemoryTracker::CATEGORY_PHYSICS since Bullet does not use the global new operator.
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * Frees memory allocated with allocate().
+     */
+    static void deallocate(void* ptr);
+
     /**
      * Destructor.
      */
@@ -1,5 +1,6 @@
 #include "Base.h"
 #include "PhysicsRigidBody.h"
+#include "MemoryTracker.h"
 #include "PhysicsController.h"
 #include "Game.h"
 #include "Image.h"
@@ -160,6 +161,8 @@ void PhysicsRigidBody::applyTorqueImpulse(const Vector3& torque)
 
 PhysicsRigidBody* PhysicsRigidBody::create(Node* node, Properties* properties, const char* nspace)
 {
+    GP_MEMORY_SCOPE(CATEGORY_PHYSICS);
+
     // Check if the properties is valid and has a valid namespace.
     if (!properties || !(strcmp(properties->getNamespace(), "collisionObject") == 0))
     {
@@ -0,0 +1,497 @@
+#include "Base.h"
+#include "Profiler.h"
+#include "Thread.h"
+#include "FileSystem.h"
+
+#ifdef WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+// The number of threads and the nesting depth of the scopes that can be recorded.
+#define PROFILER_MAX_THREADS 64
+#define PROFILER_MAX_DEPTH 32
+
+#define PROFILER_DEFAULT_CAPACITY 16384
+
+namespace gameplay
+{
+
+/**
+ * A scope recorded in the ring buffer.
+ */
+struct ProfilerEvent
+{
+    const char* name;
+    double start;
+    double end;
+    unsigned int thread;
+    unsigned int depth;
+    volatile int frame;     // The frame the scope was recorded in, or 0 while the event is being written.
+};
+
+/**
+ * The scopes that are open on a thread.
+ */
+struct ProfilerThread
+{
+    const char* names[PROFILER_MAX_DEPTH];
+    double starts[PROFILER_MAX_DEPTH];
+    unsigned int depth;     // The number of open scopes, including those deeper than PROFILER_MAX_DEPTH.
+    unsigned int begun[PROFILER_MAX_DEPTH];
+    unsigned int begunCount;    // The number of depths in begun, at which scopes were opened by beginScope().
+};
+
+/**
+ * An entry of the frame summary.
+ */
+struct ProfilerSummary
+{
+    const char* name;
+    unsigned int depth;
+    unsigned int thread;
+    unsigned int callCount;
+    double time;
+    int parent;
+};
+
+static bool __enabled = false;
+static std::vector<ProfilerEvent> __events(PROFILER_DEFAULT_CAPACITY);
+static volatile int __eventCount = 0;
+static volatile int __frame = 1;
+static unsigned int __frameFirstEvent = 0;
+static double __frameStart = 0.0;
+static float __frameTime = 0.0f;
+static unsigned int __mainThread = 0;
+static ProfilerThread __threads[PROFILER_MAX_THREADS];
+static std::vector<ProfilerSummary> __summary;
+
+static Mutex& getNameMutex()
+{
+    static Mutex mutex;
+    return mutex;
+}
+
+/**
+ * Gets a copy of the name that remains valid for the lifetime of the program.
+ */
+static const char* internName(const char* name)
+{
+    static std::set<std::string> names;
+    MutexLock lock(getNameMutex());
+    return names.insert(name ? name : "").first->c_str();
+}
+
+Profiler::Scope::Scope(const char* name, bool copyName)
+    : _active(false)
+{
+    if (__enabled)
+        _active = open(copyName ? internName(name) : name);
+}
+
+Profiler::Scope::~Scope()
+{
+    if (_active)
+        close();
+}
+
+bool Profiler::isEnabled()
+{
+    return __enabled;
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !__enabled)
+        __frameStart = getTime();
+    __enabled = enabled;
+}
+
+unsigned int Profiler::getCapacity()
+{
+    return (unsigned int)__events.size();
+}
+
+void Profiler::setCapacity(unsigned int capacity)
+{
+    // Events are indexed by masking their sequence number, which stays correct when it wraps.
+    unsigned int size = 1;
+    while (size < capacity)
+        size <<= 1;
+
+    __events.assign(size, ProfilerEvent());
+    for (unsigned int i = 0; i < size; ++i)
+        __events[i].frame = 0;
+    __eventCount = 0;
+    __frameFirstEvent = 0;
+}
+
+void Profiler::beginScope(const char* name)
+{
+    if (!__enabled)
+        return;
+
+    unsigned int thread = Thread::getCurrentId();
+    if (thread >= PROFILER_MAX_THREADS || __threads[thread].begunCount >= PROFILER_MAX_DEPTH)
+        return;
+
+    ProfilerThread& state = __threads[thread];
+    state.begun[state.begunCount++] = state.depth;
+    open(internName(name));
+}
+
+void Profiler::endScope()
+{
+    unsigned int thread = Thread::getCurrentId();
+    if (thread >= PROFILER_MAX_THREADS)
+        return;
+
+    // Forget the scopes opened by beginScope() that have already been closed by a Scope.
+    ProfilerThread& state = __threads[thread];
+    while (state.begunCount > 0 && state.begun[state.begunCount - 1] >= state.depth)
+        --state.begunCount;
+
+    // Only close the innermost scope if it was opened by beginScope(), never a Scope of the engine.
+    if (state.begunCount == 0 || state.begun[state.begunCount - 1] != state.depth - 1)
+    {
+        // Scopes are not opened while the profiler is disabled, so that is not an error.
+        if (__enabled)
+            GP_WARN("Profiler::endScope() called without a matching beginScope().");
+        return;
+    }
+    --state.begunCount;
+    close();
+}
+
+double Profiler::getTime()
+{
+#ifdef WIN32
+    static double ticksPerMillisecond = 0.0;
+    if (ticksPerMillisecond == 0.0)
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        ticksPerMillisecond = frequency.QuadPart / 1000.0;
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart / ticksPerMillisecond;
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+    if (timebase.denom == 0)
+        mach_timebase_info(&timebase);
+    return ((double)mach_absolute_time() * timebase.numer) / (1000000.0 * timebase.denom);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+#endif
+}
+
+bool Profiler::open(const char* name)
+{
+    unsigned int thread = Thread::getCurrentId();
+    if (thread >= PROFILER_MAX_THREADS)
+        return false;
+
+    ProfilerThread& state = __threads[thread];
+    if (state.depth < PROFILER_MAX_DEPTH)
+    {
+        state.names[state.depth] = name;
+        state.starts[state.depth] = getTime();
+    }
+    ++state.depth;
+    return true;
+}
+
+void Profiler::close()
+{
+    unsigned int thread = Thread::getCurrentId();
+    GP_ASSERT(thread < PROFILER_MAX_THREADS);
+    ProfilerThread& state = __threads[thread];
+    GP_ASSERT(state.depth > 0);
+
+    unsigned int depth = --state.depth;
+    if (depth >= PROFILER_MAX_DEPTH || __events.empty())
+        return;
+
+    // Claim the next slot of the ring buffer, and mark the event as complete once it is written.
+    unsigned int index = (unsigned int)atomicAdd(&__eventCount, 1) & (unsigned int)(__events.size() - 1);
+    ProfilerEvent& event = __events[index];
+    event.frame = 0;
+    event.name = state.names[depth];
+    event.start = state.starts[depth];
+    event.end = getTime();
+    event.thread = thread;
+    event.depth = depth;
+    event.frame = __frame;
+}
+
+/**
+ * Orders events by thread and then by the time they were opened, so that each
+ * event follows the scope it was nested in.
+ */
+static bool compareEvents(const ProfilerEvent* e1, const ProfilerEvent* e2)
+{
+    if (e1->thread != e2->thread)
+        return e1->thread < e2->thread;
+    if (e1->start != e2->start)
+        return e1->start < e2->start;
+    return e1->depth < e2->depth;
+}
+
+/**
+ * Appends the summary entry and the entries nested in it to the ordered summary.
+ */
+static void appendSummary(unsigned int index, const std::vector<std::vector<unsigned int> >& children, std::vector<ProfilerSummary>& ordered)
+{
+    ordered.push_back(__summary[index]);
+    for (size_t i = 0, count = children[index].size(); i < count; ++i)
+    {
+        appendSummary(children[index][i], children, ordered);
+    }
+}
+
+void Profiler::finishFrame()
+{
+    __mainThread = Thread::getCurrentId();
+    if (!__enabled)
+        return;
+
+    double now = getTime();
+    __frameTime = (float)(now - __frameStart);
+    __frameStart = now;
+
+    // Gather the events recorded since the start of the frame.
+    int frame = __frame;
+    unsigned int eventCount = (unsigned int)atomicLoad(&__eventCount);
+    unsigned int capacity = (unsigned int)__events.size();
+    unsigned int count = std::min(eventCount - __frameFirstEvent, capacity);
+    std::vector<const ProfilerEvent*> events;
+    events.reserve(count);
+    for (unsigned int i = eventCount - count; i != eventCount; ++i)
+    {
+        const ProfilerEvent& event = __events[i & (capacity - 1)];
+        if (event.frame == frame)
+            events.push_back(&event);
+    }
+    std::sort(events.begin(), events.end(), compareEvents);
+
+    // Merge the events with the same path of scope names on each thread.
+    __summary.clear();
+    std::map<std::pair<int, std::string>, unsigned int> entries;
+    std::vector<unsigned int> stack;
+    unsigned int thread = 0;
+    for (size_t i = 0, eventsCount = events.size(); i < eventsCount; ++i)
+    {
+        const ProfilerEvent* event = events[i];
+        if (i == 0 || event->thread != thread)
+        {
+            thread = event->thread;
+            stack.clear();
+        }
+        while (stack.size() > event->depth)
+            stack.pop_back();
+
+        // Top level scopes are keyed by the thread they were recorded on.
+        int parent = stack.empty() ? -1 - (int)thread : (int)stack.back();
+        std::pair<std::map<std::pair<int, std::string>, unsigned int>::iterator, bool> result =
+            entries.insert(std::make_pair(std::make_pair(parent, std::string(event->name)), (unsigned int)__summary.size()));
+        if (result.second)
+        {
+            ProfilerSummary entry;
+            entry.name = event->name;
+            entry.depth = (unsigned int)stack.size();
+            entry.thread = thread;
+            entry.callCount = 0;
+            entry.time = 0.0;
+            entry.parent = parent;
+            __summary.push_back(entry);
+        }
+        ProfilerSummary& entry = __summary[result.first->second];
+        ++entry.callCount;
+        entry.time += event->end - event->start;
+        stack.push_back(result.first->second);
+    }
+
+    // Order the entries depth first.
+    std::vector<std::vector<unsigned int> > children(__summary.size());
+    std::vector<unsigned int> roots;
+    for (unsigned int i = 0, summaryCount = (unsigned int)__summary.size(); i < summaryCount; ++i)
+    {
+        if (__summary[i].parent < 0)
+            roots.push_back(i);
+        else
+            children[__summary[i].parent].push_back(i);
+    }
+    std::vector<ProfilerSummary> ordered;
+    ordered.reserve(__summary.size());
+    for (size_t i = 0, rootCount = roots.size(); i < rootCount; ++i)
+    {
+        appendSummary(roots[i], children, ordered);
+    }
+    __summary.swap(ordered);
+
+    __frameFirstEvent = eventCount;
+    atomicIncrement(&__frame);
+}
+
+float Profiler::getFrameTime()
+{
+    return __frameTime;
+}
+
+unsigned int Profiler::getScopeCount()
+{
+    return (unsigned int)__summary.size();
+}
+
+const char* Profiler::getScopeName(unsigned int index)
+{
+    GP_ASSERT(index < __summary.size());
+    return __summary[index].name;
+}
+
+unsigned int Profiler::getScopeDepth(unsigned int index)
+{
+    GP_ASSERT(index < __summary.size());
+    return __summary[index].depth;
+}
+
+unsigned int Profiler::getScopeThread(unsigned int index)
+{
+    GP_ASSERT(index < __summary.size());
+    return __summary[index].thread;
+}
+
+unsigned int Profiler::getScopeCallCount(unsigned int index)
+{
+    GP_ASSERT(index < __summary.size());
+    return __summary[index].callCount;
+}
+
+float Profiler::getScopeTime(unsigned int index)
+{
+    GP_ASSERT(index < __summary.size());
+    return (float)__summary[index].time;
+}
+
+float Profiler::getScopeTime(const char* name)
+{
+    GP_ASSERT(name);
+
+    double time = 0.0;
+    for (size_t i = 0, count = __summary.size(); i < count; ++i)
+    {
+        if (strcmp(__summary[i].name, name) == 0)
+            time += __summary[i].time;
+    }
+    return (float)time;
+}
+
+void Profiler::printFrameSummary()
+{
+    print("[profiler] Frame time: %.3f ms\n", __frameTime);
+    for (size_t i = 0, count = __summary.size(); i < count; ++i)
+    {
+        const ProfilerSummary& entry = __summary[i];
+        print("[profiler] [thread %u] %*s%s: %.3f ms (%u calls)\n", entry.thread, entry.depth * 2, "", entry.name, entry.time, entry.callCount);
+    }
+}
+
+/**
+ * Writes a string to a stream as a JSON string literal.
+ */
+static void writeJsonString(Stream* stream, const char* str)
+{
+    std::string escaped = "\"";
+    for (; *str; ++str)
+    {
+        char c = *str;
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            char code[8];
+            sprintf(code, "\\u%04x", (unsigned int)c);
+            escaped += code;
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+    escaped += '"';
+    stream->write(escaped.c_str(), 1, escaped.size());
+}
+
+bool Profiler::writeChromeTrace(const char* path)
+{
+    GP_ASSERT(path);
+
+    Stream* stream = FileSystem::open(path, FileSystem::WRITE);
+    if (stream == NULL)
+    {
+        GP_WARN("Failed to open file '%s' for writing the profiler trace.", path);
+        return false;
+    }
+
+    const char* header = "{\"traceEvents\":[\n";
+    stream->write(header, 1, strlen(header));
+
+    // Name the threads that recorded scopes.
+    char buffer[256];
+    bool first = true;
+    for (unsigned int i = 0; i < PROFILER_MAX_THREADS; ++i)
+    {
+        bool recorded = false;
+        for (size_t j = 0, count = __events.size(); j < count && !recorded; ++j)
+        {
+            recorded = __events[j].frame != 0 && __events[j].thread == i;
+        }
+        if (!recorded)
+            continue;
+
+        if (i == __mainThread)
+            sprintf(buffer, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Main\"}}", first ? "" : ",\n", i);
+        else
+            sprintf(buffer, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}", first ? "" : ",\n", i, i);
+        stream->write(buffer, 1, strlen(buffer));
+        first = false;
+    }
+
+    // Write the events from the oldest to the newest as complete events, with times in microseconds.
+    unsigned int eventCount = (unsigned int)atomicLoad(&__eventCount);
+    unsigned int capacity = (unsigned int)__events.size();
+    unsigned int count = std::min(eventCount, capacity);
+    for (unsigned int i = eventCount - count; i != eventCount; ++i)
+    {
+        const ProfilerEvent& event = __events[i & (capacity - 1)];
+        if (event.frame == 0)
+            continue;
+
+        const char* separator = first ? "" : ",\n";
+        stream->write(separator, 1, strlen(separator));
+        const char* name = "{\"name\":";
+        stream->write(name, 1, strlen(name));
+        writeJsonString(stream, event.name);
+        sprintf(buffer, ",\"cat\":\"gameplay\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u,\"args\":{\"frame\":%d}}",
+            event.start * 1000.0, (event.end - event.start) * 1000.0, event.thread, event.frame);
+        stream->write(buffer, 1, strlen(buffer));
+        first = false;
+    }
+
+    const char* footer = "\n]}\n";
+    stream->write(footer, 1, strlen(footer));
+    stream->close();
+    SAFE_DELETE(stream);
+    return true;
+}
+
+}
@@ -0,0 +1,255 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+namespace gameplay
+{
+
+/**
+ * Defines a lightweight instrumenting profiler for measuring the CPU time spent in named scopes.
+ *
+ * Scopes are timed by placing a GP_PROFILE_SCOPE(name) at the start of a block of code, and may
+ * be nested and opened on any thread. Each completed scope is recorded into a fixed size ring
+ * buffer without locking, so the most recent events are always available for export to the
+ * Chrome trace event format with writeChromeTrace() (which can be viewed in chrome://tracing).
+ *
+ * At the end of each frame the scopes recorded during the frame are merged into a summary, with
+ * one entry for each distinct path of nested scope names on each thread, which can be printed
+ * with printFrameSummary() or queried (from C++ or Lua) with getScopeCount() and related methods.
+ *
+ * Profiling is disabled by default and may be enabled with setEnabled() or in the game config:
+ *
+ * @code
+ * profiler
+ * {
+ *     enabled = true
+ *     capacity = 65536
+ * }
+ * @endcode
+ *
+ * Defining GP_NO_PROFILER removes all of the GP_PROFILE_SCOPE instrumentation from the build.
+ */
+class Profiler
+{
+    friend class Game;
+
+public:
+
+    /**
+     * Times the scope in which it is declared, from construction to destruction.
+     *
+     * @script{ignore}
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Constructor. Opens a scope on the calling thread.
+         *
+         * @param name The name of the scope. Unless copyName is true, the name must remain valid
+         *      for as long as the profiler is used (a string literal).
+         * @param copyName true to keep a copy of the name.
+         */
+        Scope(const char* name, bool copyName = false);
+
+        /**
+         * Destructor. Closes the scope and records it.
+         */
+        ~Scope();
+
+    private:
+
+        Scope(const Scope& copy);
+        Scope& operator=(const Scope&);
+
+        bool _active;
+    };
+
+    /**
+     * Determines if profiling is enabled.
+     *
+     * @return true if scopes are being recorded, false otherwise.
+     */
+    static bool isEnabled();
+
+    /**
+     * Sets whether profiling is enabled.
+     *
+     * @param enabled true to record scopes, false to ignore them.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Gets the number of scopes that the ring buffer holds.
+     *
+     * @return The capacity of the ring buffer.
+     */
+    static unsigned int getCapacity();
+
+    /**
+     * Sets the number of scopes that the ring buffer holds, discarding the recorded scopes.
+     *
+     * The capacity is rounded up to a power of two. This must not be called while scopes
+     * are being recorded on other threads.
+     *
+     * @param capacity The number of scopes to hold.
+     */
+    static void setCapacity(unsigned int capacity);
+
+    /**
+     * Opens a scope on the calling thread, which must later be closed by endScope().
+     *
+     * This is primarily intended for scripts, which cannot declare a Scope. The name is copied.
+     *
+     * @param name The name of the scope.
+     */
+    static void beginScope(const char* name);
+
+    /**
+     * Closes the most recently opened scope of the calling thread and records it.
+     *
+     * The scope must have been opened by beginScope(); if the innermost scope is a Scope
+     * (such as one of the engine's own), a warning is logged and nothing is closed.
+     */
+    static void endScope();
+
+    /**
+     * Gets the time between the start and the end of the previous frame.
+     *
+     * @return The duration of the previous frame, in milliseconds.
+     */
+    static float getFrameTime();
+
+    /**
+     * Gets the number of entries in the summary of the previous frame.
+     *
+     * Entries are ordered depth first: each entry is followed by the entries of the scopes
+     * that were nested in it.
+     *
+     * @return The number of entries.
+     */
+    static unsigned int getScopeCount();
+
+    /**
+     * Gets the name of an entry in the summary of the previous frame.
+     *
+     * @param index The index of the entry.
+     *
+     * @return The name of the scope.
+     */
+    static const char* getScopeName(unsigned int index);
+
+    /**
+     * Gets the nesting depth of an entry in the summary of the previous frame.
+     *
+     * @param index The index of the entry.
+     *
+     * @return The number of scopes that the scope was nested in.
+     */
+    static unsigned int getScopeDepth(unsigned int index);
+
+    /**
+     * Gets the thread of an entry in the summary of the previous frame.
+     *
+     * @param index The index of the entry.
+     *
+     * @return The identifier of the thread, as returned by Thread::getCurrentId().
+     */
+    static unsigned int getScopeThread(unsigned int index);
+
+    /**
+     * Gets the number of times the scope of an entry was recorded in the previous frame.
+     *
+     * @param index The index of the entry.
+     *
+     * @return The number of calls.
+     */
+    static unsigned int getScopeCallCount(unsigned int index);
+
+    /**
+     * Gets the total time spent in the scope of an entry in the previous frame.
+     *
+     * @param index The index of the entry.
+     *
+     * @return The time spent, in milliseconds.
+     */
+    static float getScopeTime(unsigned int index);
+
+    /**
+     * Gets the total time spent in all of the scopes with the given name in the previous frame.
+     *
+     * Time spent in nested scopes with the same name is counted for each of them.
+     *
+     * @param name The name of the scope.
+     *
+     * @return The time spent, in milliseconds.
+     */
+    static float getScopeTime(const char* name);
+
+    /**
+     * Prints the summary of the previous frame.
+     */
+    static void printFrameSummary();
+
+    /**
+     * Writes the scopes in the ring buffer to a file in the Chrome trace event format.
+     *
+     * @param path The path of the file to write.
+     *
+     * @return true if the file was written, false otherwise.
+     */
+    static bool writeChromeTrace(const char* path);
+
+private:
+
+    /**
+     * Constructor.
+     */
+    Profiler();
+
+    /**
+     * Hidden copy constructor.
+     */
+    Profiler(const Profiler& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Profiler& operator=(const Profiler&);
+
+    /**
+     * Gets the current time of a monotonic, high resolution clock, in milliseconds.
+     */
+    static double getTime();
+
+    /**
+     * Opens a scope on the calling thread.
+     */
+    static bool open(const char* name);
+
+    /**
+     * Closes the most recently opened scope of the calling thread and records it.
+     */
+    static void close();
+
+    /**
+     * Builds the summary of the frame that is ending and starts the next frame.
+     */
+    static void finishFrame();
+};
+
+}
+
+#define GP_PROFILE_CONCAT_(a, b) a##b
+#define GP_PROFILE_CONCAT(a, b) GP_PROFILE_CONCAT_(a, b)
+
+#ifdef GP_NO_PROFILER
+#define GP_PROFILE_SCOPE(name)
+#else
+/**
+ * Times the remainder of the enclosing block as a profiler scope with the given name.
+ */
+#define GP_PROFILE_SCOPE(name) gameplay::Profiler::Scope GP_PROFILE_CONCAT(__profileScope, __LINE__)(name)
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "Ref.h"
 #include "Game.h"
+#include "Thread.h"
 
 namespace gameplay
 {
@@ -10,8 +11,21 @@ void* trackRef(Ref* ref);
 void untrackRef(Ref* ref, void* record);
 #endif
 
+// The thread on which objects are destroyed, and whether it has been set.
+static unsigned int __mainThreadId = 0;
+static bool __mainThreadSet = false;
+
+// The objects whose last reference was released on another thread.
+static std::vector<Ref*> __deferredReleases;
+
+static Mutex& getDeferredReleaseMutex()
+{
+    static Mutex mutex;
+    return mutex;
+}
+
 Ref::Ref() :
-    _refCount(1)
+    _refCount(1), _deferred(false)
 {
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
     __record = trackRef(this);
@@ -19,7 +33,7 @@ Ref::Ref() :
 }
 
 Ref::Ref(const Ref& copy) :
-    _refCount(1)
+    _refCount(1), _deferred(false)
 {
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
     __record = trackRef(this);
@@ -32,23 +46,77 @@ Ref::~Ref()
 
 void Ref::addRef()
 {
-    ++_refCount;
+    atomicIncrement(&_refCount);
 }
 
 void Ref::release()
 {
-    if ((--_refCount) <= 0)
+    if (atomicDecrement(&_refCount) <= 0)
     {
-#ifdef GAMEPLAY_MEM_LEAK_DETECTION
-        untrackRef(this, __record);
-#endif
-        delete this;
+        if (__mainThreadSet)
+        {
+            MutexLock lock(getDeferredReleaseMutex());
+            if (_deferred)
+            {
+                // The object was already queued, and may have been found in a cache and referenced
+                // again since then. It is destroyed (or kept) when the queue is finished.
+                return;
+            }
+            if (Thread::getCurrentId() != __mainThreadId)
+            {
+                // The object may own graphics resources, which can only be freed on the main thread.
+                _deferred = true;
+                __deferredReleases.push_back(this);
+                return;
+            }
+        }
+        destroy();
     }
 }
 
 unsigned int Ref::getRefCount() const
 {
-    return _refCount;
+    return (unsigned int)atomicLoad(&_refCount);
+}
+
+void Ref::destroy()
+{
+#ifdef GAMEPLAY_MEM_LEAK_DETECTION
+    untrackRef(this, __record);
+#endif
+    delete this;
+}
+
+void Ref::setMainThread()
+{
+    __mainThreadId = Thread::getCurrentId();
+    __mainThreadSet = true;
+}
+
+void Ref::finishDeferredReleases()
+{
+    GP_ASSERT(!__mainThreadSet || Thread::getCurrentId() == __mainThreadId);
+
+    std::vector<Ref*> refs;
+    {
+        MutexLock lock(getDeferredReleaseMutex());
+        refs.swap(__deferredReleases);
+    }
+
+    // Objects stay in resource caches (such as the Texture and Font caches) until they are destroyed,
+    // so a queued object may have been referenced again, in which case it is kept until it is released
+    // again. Destroying an object releases the objects it references; those that are still queued
+    // further down the list are left to this loop, and the others are destroyed immediately.
+    for (size_t i = 0, count = refs.size(); i < count; ++i)
+    {
+        Ref* ref = refs[i];
+        {
+            MutexLock lock(getDeferredReleaseMutex());
+            ref->_deferred = false;
+        }
+        if (ref->getRefCount() == 0)
+            ref->destroy();
+    }
 }
 
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
@@ -63,6 +131,13 @@ struct RefAllocationRecord
 RefAllocationRecord* __refAllocations = 0;
 int __refAllocationCount = 0;
 
+// Refs can be created on resource loader threads, so the allocation list is guarded.
+static Mutex& getRefAllocationMutex()
+{
+    static Mutex mutex;
+    return mutex;
+}
+
 void Ref::printLeaks()
 {
     // Dump Ref object memory leaks
@@ -87,6 +162,8 @@ void* trackRef(Ref* ref)
 {
     GP_ASSERT(ref);
 
+    MutexLock lock(getRefAllocationMutex());
+
     // Create memory allocation record.
     RefAllocationRecord* rec = (RefAllocationRecord*)malloc(sizeof(RefAllocationRecord));
     rec->ref = ref;
@@ -116,6 +193,8 @@ void untrackRef(Ref* ref, void* record)
         return;
     }
 
+    MutexLock lock(getRefAllocationMutex());
+
     // Link this item out.
     if (__refAllocations == rec)
         __refAllocations = rec->next;
@@ -13,9 +13,18 @@ namespace gameplay
  * reference counting eliminates the need for programmers to manually
  * keep track of object ownership and having to worry about when to
  * safely delete such objects.
+ *
+ * The reference count is updated atomically, so objects may be shared with
+ * resource loader and job system threads. Since many objects own graphics
+ * resources, an object whose last reference is released on a thread other
+ * than the main thread is not destroyed immediately; it is queued and
+ * destroyed on the main thread at the start of the next frame, unless it
+ * was referenced again in the meantime.
  */
 class Ref
 {
+    friend class Game;
+
 public:
 
     /**
@@ -33,6 +42,9 @@ public:
      * Calling addRef() will increment the reference and calling release()
      * will decrement the reference count. When an object reaches a
      * reference count of zero, the object is destroyed.
+     *
+     * If the reference count reaches zero on a thread other than the main
+     * thread, the object is destroyed on the main thread during the next frame.
      */
     void release();
 
@@ -64,11 +76,26 @@ protected:
 
 private:
 
-    unsigned int _refCount;
+    /**
+     * Deletes this object once its reference count has reached zero.
+     */
+    void destroy();
+
+    /**
+     * Sets the calling thread as the main thread, on which objects are destroyed.
+     */
+    static void setMainThread();
+
+    /**
+     * Destroys the objects whose last reference was released on another thread.
+     */
+    static void finishDeferredReleases();
+
+    volatile int _refCount;
+    bool _deferred;
 
     // Memory leak diagnostic data (only included when GAMEPLAY_MEM_LEAK_DETECTION is defined)
 #ifdef GAMEPLAY_MEM_LEAK_DETECTION
-    friend class Game;
     static void printLeaks();
     void* __record;
 #endif
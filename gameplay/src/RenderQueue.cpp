@@ -0,0 +1,519 @@
+#include "Base.h"
+#include "RenderQueue.h"
+#include "Model.h"
+#include "Node.h"
+#include "Scene.h"
+#include "Camera.h"
+#include "InstanceBuffer.h"
+
+// The number of texture units tracked when counting texture binds.
+#define TEXTURE_UNIT_COUNT 32
+
+namespace gameplay
+{
+
+RenderQueue::BindCounts::BindCounts()
+    : drawCalls(0), effectBinds(0), passBinds(0), stateBlockBinds(0), textureBinds(0)
+{
+}
+
+RenderQueue::Statistics::Statistics()
+    : itemCount(0)
+{
+}
+
+RenderQueue::RenderQueue()
+    : _sorted(true), _instances(NULL)
+{
+}
+
+RenderQueue::~RenderQueue()
+{
+    SAFE_RELEASE(_instances);
+}
+
+RenderQueue* RenderQueue::create()
+{
+    return new RenderQueue();
+}
+
+/**
+ * Gets the distance of the model's node in front of the active camera of its scene,
+ * as a fraction of the distance to the camera's far plane.
+ */
+static float getViewDepth(Model* model)
+{
+    Node* node = model->getNode();
+    Scene* scene = node ? node->getScene() : NULL;
+    Camera* camera = scene ? scene->getActiveCamera() : NULL;
+    if (!camera || camera->getFarPlane() <= 0.0f)
+        return 0.0f;
+
+    float depth = -node->getTranslationView().z / camera->getFarPlane();
+    return std::min(std::max(depth, 0.0f), 1.0f);
+}
+
+/**
+ * Gets the rank of the key in the order in which the keys were first seen.
+ */
+template <class T>
+static unsigned int getRank(std::map<T, unsigned int>& ranks, const T& key)
+{
+    return ranks.insert(std::make_pair(key, (unsigned int)ranks.size())).first->second;
+}
+
+void RenderQueue::add(Model* model, bool wireframe)
+{
+    GP_ASSERT(model);
+    GP_ASSERT(model->getMesh());
+
+    float depth = getViewDepth(model);
+    unsigned int partCount = model->getMesh()->getPartCount();
+    if (partCount == 0)
+    {
+        // No mesh parts (index buffers).
+        if (model->_material)
+            addItems(model, model->_material, -1, wireframe, depth);
+    }
+    else
+    {
+        for (unsigned int i = 0; i < partCount; ++i)
+        {
+            Material* material = model->getMaterial(i);
+            if (material)
+                addItems(model, material, i, wireframe, depth);
+        }
+    }
+}
+
+void RenderQueue::addItems(Model* model, Material* material, int partIndex, bool wireframe, float depth)
+{
+    Technique* technique = material->getTechnique();
+    GP_ASSERT(technique);
+
+    unsigned long long depthBits = (unsigned long long)(depth * 65535.0f);
+    unsigned long long materialRank = std::min(getRank<const void*>(_ranks, material), 0xFFFFu);
+    unsigned int passCount = technique->getPassCount();
+    for (unsigned int i = 0; i < passCount; ++i)
+    {
+        Pass* pass = technique->getPassByIndex(i);
+        GP_ASSERT(pass);
+        GP_ASSERT(pass->getEffect());
+        unsigned long long passRank = materialRank;
+
+        unsigned long long state = pass->getStateBlockSignature();
+        unsigned long long stateRank = std::min(getRank(_stateRanks, state), 0x7FFFu);
+        unsigned long long effectRank = std::min(getRank<const void*>(_ranks, pass->getEffect()), 0xFFFFu);
+        bool instanced = InstanceBuffer::isInstanced(pass->getEffect());
+
+        // Opaque items are grouped by effect, state and material, and drawn front to back.
+        // Opaque instanced items are grouped by parameter values and mesh part instead, so that copies
+        // are drawn together even when each has its own material.
+        // Blended items are drawn after the opaque items, back to front.
+        DrawItem item;
+        if (state & 1)
+        {
+            item.key = (1ULL << 63) | ((0xFFFF - depthBits) << 47) | (effectRank << 31) | (stateRank << 16) | passRank;
+        }
+        else
+        {
+            if (instanced && !wireframe)
+            {
+                Mesh* mesh = model->getMesh();
+                const void* part = partIndex < 0 ? (const void*)mesh : (const void*)mesh->getPart(partIndex);
+                depthBits = std::min(getRank(_ranks, part), 0xFFFFu);
+                passRank = std::min(getRank(_parameterRanks, getParameterSignature(pass)), 0xFFFFu);
+            }
+            item.key = (effectRank << 47) | (stateRank << 32) | (passRank << 16) | depthBits;
+        }
+        item.model = model;
+        item.pass = pass;
+        item.partIndex = partIndex;
+        item.wireframe = wireframe;
+        item.instanced = instanced;
+        _items.push_back(item);
+    }
+    _sorted = false;
+}
+
+unsigned int RenderQueue::getItemCount() const
+{
+    return (unsigned int)_items.size();
+}
+
+void RenderQueue::sort()
+{
+    if (_sorted)
+        return;
+
+    unsigned int count = (unsigned int)_items.size();
+    _keys.resize(count);
+    _order.resize(count);
+    _sortKeys.resize(count);
+    _sortOrder.resize(count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        _keys[i] = _items[i].key;
+        _order[i] = i;
+    }
+
+    // Least significant digit radix sort, one byte at a time. Bytes that are the same
+    // for all of the keys are skipped.
+    for (unsigned int shift = 0; shift < 64 && count > 0; shift += 8)
+    {
+        unsigned int offsets[256] = { 0 };
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            ++offsets[(_keys[i] >> shift) & 0xFF];
+        }
+        if (offsets[(_keys[0] >> shift) & 0xFF] == count)
+            continue;
+
+        unsigned int offset = 0;
+        for (unsigned int i = 0; i < 256; ++i)
+        {
+            unsigned int digitCount = offsets[i];
+            offsets[i] = offset;
+            offset += digitCount;
+        }
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            unsigned int j = offsets[(_keys[i] >> shift) & 0xFF]++;
+            _sortKeys[j] = _keys[i];
+            _sortOrder[j] = _order[i];
+        }
+        _keys.swap(_sortKeys);
+        _order.swap(_sortOrder);
+    }
+    _sorted = true;
+
+    _statistics.itemCount = count;
+    _statistics.submitted = BindCounts();
+    _statistics.sorted = BindCounts();
+    countBinds(NULL, &_statistics.submitted);
+    countBinds(count > 0 ? &_order[0] : NULL, &_statistics.sorted);
+}
+
+unsigned int RenderQueue::getInstanceRunLength(const unsigned int* order, size_t start) const
+{
+    // Only opaque, solid items are grouped by mesh part; others are drawn one at a time.
+    const DrawItem& first = _items[order ? order[start] : start];
+    if (!first.instanced || first.wireframe || (first.key >> 63))
+        return 1;
+
+    size_t end = start + 1;
+    for (size_t count = _items.size(); end < count; ++end)
+    {
+        const DrawItem& item = _items[order ? order[end] : end];
+        if (item.partIndex != first.partIndex || item.model->getMesh() != first.model->getMesh() ||
+            !hasEquivalentParameters(item.pass, first.pass))
+            break;
+    }
+    return (unsigned int)(end - start);
+}
+
+/**
+ * Adds the bytes of a value to a 64-bit FNV-1a hash.
+ */
+static void hashBytes(unsigned long long* hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        *hash = (*hash ^ bytes[i]) * 1099511628211ULL;
+    }
+}
+
+unsigned long long RenderQueue::getParameterSignature(Pass* pass)
+{
+    GP_ASSERT(pass);
+
+    unsigned long long hash = 14695981039346656037ULL;
+    RenderState* rs = NULL;
+    while ((rs = pass->getTopmost(rs)))
+    {
+        for (size_t i = 0, count = rs->_parameters.size(); i < count; ++i)
+        {
+            const MaterialParameter* parameter = rs->_parameters[i];
+            hashBytes(&hash, parameter->_name.c_str(), parameter->_name.size());
+            hashBytes(&hash, &parameter->_type, sizeof(parameter->_type));
+            switch (parameter->_type)
+            {
+            case MaterialParameter::FLOAT:
+            case MaterialParameter::INT:
+                hashBytes(&hash, &parameter->_value.intValue, sizeof(int));
+                break;
+            case MaterialParameter::SAMPLER:
+            case MaterialParameter::SAMPLER_ARRAY:
+                {
+                    // Each material creates its own samplers, so hash the textures they sample.
+                    bool isArray = parameter->_type == MaterialParameter::SAMPLER_ARRAY;
+                    unsigned int samplerCount = isArray ? parameter->_count : 1;
+                    const Texture::Sampler* const* samplers = isArray ? parameter->_value.samplerArrayValue : &parameter->_value.samplerValue;
+                    for (unsigned int j = 0; j < samplerCount; ++j)
+                    {
+                        const Texture* texture = samplers[j] ? samplers[j]->getTexture() : NULL;
+                        hashBytes(&hash, &texture, sizeof(texture));
+                    }
+                }
+                break;
+            case MaterialParameter::METHOD:
+                {
+                    std::map<std::string, std::string>::const_iterator itr = rs->_autoBindings.find(parameter->_name);
+                    if (itr != rs->_autoBindings.end())
+                        hashBytes(&hash, itr->second.c_str(), itr->second.size());
+                    else
+                        hashBytes(&hash, &parameter->_value.method, sizeof(parameter->_value.method));
+                }
+                break;
+            default:
+                hashBytes(&hash, parameter->_value.floatPtrValue, getValueSize(parameter));
+                break;
+            }
+        }
+    }
+    return hash;
+}
+
+bool RenderQueue::hasEquivalentParameters(Pass* a, Pass* b)
+{
+    GP_ASSERT(a);
+    GP_ASSERT(b);
+
+    if (a == b)
+        return true;
+    if (a->getEffect() != b->getEffect() || a->getStateBlockSignature() != b->getStateBlockSignature())
+        return false;
+
+    // Compare the parameters of each render state in the hierarchies, top-down, in the order
+    // in which they are bound.
+    RenderState* aState = NULL;
+    RenderState* bState = NULL;
+    while (true)
+    {
+        aState = a->getTopmost(aState);
+        bState = b->getTopmost(bState);
+        if (!aState || !bState)
+            return aState == bState;
+
+        size_t count = aState->_parameters.size();
+        if (bState->_parameters.size() != count)
+            return false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!isEquivalent(aState->_parameters[i], aState, bState->_parameters[i], bState))
+                return false;
+        }
+    }
+}
+
+bool RenderQueue::isEquivalent(const MaterialParameter* a, const RenderState* aOwner, const MaterialParameter* b, const RenderState* bOwner)
+{
+    GP_ASSERT(a);
+    GP_ASSERT(b);
+
+    if (a->_type != b->_type || a->_name != b->_name)
+        return false;
+
+    switch (a->_type)
+    {
+    case MaterialParameter::NONE:
+        return true;
+    case MaterialParameter::FLOAT:
+        return a->_value.floatValue == b->_value.floatValue;
+    case MaterialParameter::INT:
+        return a->_value.intValue == b->_value.intValue;
+    case MaterialParameter::SAMPLER:
+    case MaterialParameter::SAMPLER_ARRAY:
+        {
+            bool isArray = a->_type == MaterialParameter::SAMPLER_ARRAY;
+            if (isArray && a->_count != b->_count)
+                return false;
+
+            unsigned int samplerCount = isArray ? a->_count : 1;
+            const Texture::Sampler* const* aSamplers = isArray ? a->_value.samplerArrayValue : &a->_value.samplerValue;
+            const Texture::Sampler* const* bSamplers = isArray ? b->_value.samplerArrayValue : &b->_value.samplerValue;
+            for (unsigned int i = 0; i < samplerCount; ++i)
+            {
+                const Texture::Sampler* aSampler = aSamplers[i];
+                const Texture::Sampler* bSampler = bSamplers[i];
+                if (aSampler == bSampler)
+                    continue;
+                if (!aSampler || !bSampler || aSampler->_texture != bSampler->_texture ||
+                    aSampler->_wrapS != bSampler->_wrapS || aSampler->_wrapT != bSampler->_wrapT ||
+                    aSampler->_minFilter != bSampler->_minFilter || aSampler->_magFilter != bSampler->_magFilter)
+                    return false;
+            }
+            return true;
+        }
+    case MaterialParameter::METHOD:
+        {
+            // Parameters bound to the same property of each material's node (auto-bindings) are
+            // equivalent, since the instance attributes supply the values that differ per node.
+            std::map<std::string, std::string>::const_iterator aBinding = aOwner->_autoBindings.find(a->_name);
+            std::map<std::string, std::string>::const_iterator bBinding = bOwner->_autoBindings.find(b->_name);
+            if (aBinding != aOwner->_autoBindings.end() && bBinding != bOwner->_autoBindings.end())
+                return aBinding->second == bBinding->second;
+            return a->_value.method == b->_value.method;
+        }
+    default:
+        return a->_count == b->_count && memcmp(a->_value.floatPtrValue, b->_value.floatPtrValue, getValueSize(a)) == 0;
+    }
+}
+
+size_t RenderQueue::getValueSize(const MaterialParameter* parameter)
+{
+    GP_ASSERT(parameter);
+
+    switch (parameter->_type)
+    {
+    case MaterialParameter::FLOAT_ARRAY:
+        return sizeof(float) * parameter->_count;
+    case MaterialParameter::INT_ARRAY:
+        return sizeof(int) * parameter->_count;
+    case MaterialParameter::VECTOR2:
+        return sizeof(float) * 2 * parameter->_count;
+    case MaterialParameter::VECTOR3:
+        return sizeof(float) * 3 * parameter->_count;
+    case MaterialParameter::VECTOR4:
+        return sizeof(float) * 4 * parameter->_count;
+    case MaterialParameter::MATRIX:
+        return sizeof(float) * 16 * parameter->_count;
+    default:
+        return 0;
+    }
+}
+
+void RenderQueue::countBinds(const unsigned int* order, BindCounts* counts) const
+{
+    GP_ASSERT(counts);
+
+    Effect* effect = NULL;
+    Pass* pass = NULL;
+    unsigned long long state = 0;
+    const Texture* textures[TEXTURE_UNIT_COUNT] = { NULL };
+    for (size_t i = 0, count = _items.size(); i < count; i += getInstanceRunLength(order, i))
+    {
+        ++counts->drawCalls;
+
+        const DrawItem& item = _items[order ? order[i] : i];
+        if (item.pass == pass)
+            continue;
+        pass = item.pass;
+        ++counts->passBinds;
+
+        if (pass->getEffect() != effect)
+        {
+            effect = pass->getEffect();
+            ++counts->effectBinds;
+        }
+
+        unsigned long long passState = pass->getStateBlockSignature();
+        if (passState != state || counts->stateBlockBinds == 0)
+        {
+            state = passState;
+            ++counts->stateBlockBinds;
+        }
+
+        // Count the texture units whose texture changes.
+        RenderState* rs = NULL;
+        while ((rs = pass->getTopmost(rs)))
+        {
+            for (size_t j = 0, parameterCount = rs->_parameters.size(); j < parameterCount; ++j)
+            {
+                const MaterialParameter* parameter = rs->_parameters[j];
+                if (parameter->_type != MaterialParameter::SAMPLER && parameter->_type != MaterialParameter::SAMPLER_ARRAY)
+                    continue;
+                Uniform* uniform = effect->getUniform(parameter->_name.c_str());
+                if (!uniform)
+                    continue;
+
+                bool isArray = parameter->_type == MaterialParameter::SAMPLER_ARRAY;
+                unsigned int samplerCount = isArray ? parameter->_count : 1;
+                const Texture::Sampler* const* samplers = isArray ? parameter->_value.samplerArrayValue : &parameter->_value.samplerValue;
+                for (unsigned int k = 0; k < samplerCount; ++k)
+                {
+                    unsigned int unit = uniform->_index + k;
+                    if (unit < TEXTURE_UNIT_COUNT && samplers[k] && textures[unit] != samplers[k]->getTexture())
+                    {
+                        textures[unit] = samplers[k]->getTexture();
+                        ++counts->textureBinds;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void RenderQueue::draw()
+{
+    sort();
+
+    Effect::setTextureBindCacheEnabled(true);
+    Pass* boundPass = NULL;
+    for (size_t i = 0, count = _order.size(); i < count;)
+    {
+        const DrawItem& item = _items[_order[i]];
+        unsigned int runLength = getInstanceRunLength(&_order[0], i);
+
+        // Consecutive items with the same pass only need it to be bound once.
+        if (item.pass != boundPass)
+        {
+            if (boundPass)
+                boundPass->unbind();
+            boundPass = item.pass;
+
+            // The same as Pass::bind(), but the effect is only bound when it changes.
+            Effect* effect = boundPass->getEffect();
+            if (effect != Effect::getCurrentEffect())
+                effect->bind();
+            boundPass->RenderState::bind(boundPass);
+            if (boundPass->_vaBinding)
+                boundPass->_vaBinding->bind();
+        }
+
+        if (item.instanced)
+        {
+            // Draw the models that share this mesh part and parameters as instances, with the
+            // world matrix of each model's node as its instance matrix. The effect reads the
+            // instance attributes, so even a single blended or wireframe item is drawn this way.
+            if (!_instances)
+                _instances = InstanceBuffer::create(runLength);
+            _instances->clear();
+            for (unsigned int j = 0; j < runLength; ++j)
+            {
+                Node* node = _items[_order[i + j]].model->getNode();
+                _instances->add(node ? node->getWorldMatrix() : Matrix::identity());
+            }
+            item.model->drawPartInstanced(item.partIndex, item.wireframe, _instances);
+        }
+        else
+        {
+            item.model->drawPart(item.partIndex, item.wireframe);
+        }
+        i += runLength;
+    }
+    if (boundPass)
+        boundPass->unbind();
+    Effect::setTextureBindCacheEnabled(false);
+
+    clear();
+}
+
+void RenderQueue::clear()
+{
+    _items.clear();
+    _keys.clear();
+    _order.clear();
+    _ranks.clear();
+    _stateRanks.clear();
+    _parameterRanks.clear();
+    _sorted = true;
+}
+
+const RenderQueue::Statistics& RenderQueue::getStatistics() const
+{
+    return _statistics;
+}
+
+}
@@ -0,0 +1,253 @@
+#ifndef RENDERQUEUE_H_
+#define RENDERQUEUE_H_
+
+#include "Ref.h"
+
+namespace gameplay
+{
+
+class Model;
+class Material;
+class Pass;
+class RenderState;
+class MaterialParameter;
+class InstanceBuffer;
+
+/**
+ * Defines a queue of draw calls that are sorted to minimize render state changes.
+ *
+ * Instead of drawing each model as the scene is traversed, models are added to the queue,
+ * which records one draw item for each mesh part and pass. Each item is given a 64-bit sort
+ * key built from its effect, render state, material and depth, and draw() radix sorts the
+ * items by key before drawing them. Opaque items are grouped by effect, then by render state
+ * and material, and drawn front to back within a group; items that are blended are drawn
+ * after the opaque items, back to front.
+ *
+ * While drawing, the effect is only bound when it changes, the pass is only bound when it
+ * changes (consecutive parts of a model that share a material are drawn with a single bind),
+ * and textures that are already bound to their texture unit are not bound again.
+ *
+ * Items whose effect declares the per-instance vertex attributes of InstanceBuffer are drawn
+ * through an instance buffer, with the world matrix of each model's node as its instance matrix.
+ * Opaque ones that are not drawn in wireframe are grouped by mesh part instead of by depth, and by
+ * the values of their material parameters instead of by material. Consecutive items that share a
+ * mesh part and whose passes bind the same effect, render state and parameter values are drawn as
+ * instances of a single draw call, so models that share a mesh are drawn together even when each
+ * has its own copy of a material (as the scene loader and Node::clone create). Blended and
+ * wireframe ones are drawn as a single instance each.
+ *
+ * The number of binds required to draw the items in sorted order, and in the order in which
+ * they were added, are counted by sort() and can be read with getStatistics(). They are computed
+ * from the items themselves, so they do not need a GPU timer query to be inspected.
+ */
+class RenderQueue : public Ref
+{
+public:
+
+    /**
+     * Defines the number of binds needed to draw the items in the queue in a given order.
+     *
+     * @script{ignore}
+     */
+    struct BindCounts
+    {
+        /**
+         * Constructor.
+         */
+        BindCounts();
+
+        /**
+         * The number of draw calls, counting the instances that are drawn together as one.
+         */
+        unsigned int drawCalls;
+
+        /**
+         * The number of times the effect changes.
+         */
+        unsigned int effectBinds;
+
+        /**
+         * The number of times the pass changes, each of which binds the render state
+         * and material parameters of the pass.
+         */
+        unsigned int passBinds;
+
+        /**
+         * The number of times the fixed-function render state (blending, culling, depth test
+         * and depth write) changes.
+         */
+        unsigned int stateBlockBinds;
+
+        /**
+         * The number of times a texture unit is bound to a different texture.
+         */
+        unsigned int textureBinds;
+    };
+
+    /**
+     * Defines the statistics of the most recent sort of the queue.
+     *
+     * @script{ignore}
+     */
+    struct Statistics
+    {
+        /**
+         * Constructor.
+         */
+        Statistics();
+
+        /**
+         * The number of draw items that were sorted.
+         */
+        unsigned int itemCount;
+
+        /**
+         * The binds needed to draw the items in the order in which they were added.
+         */
+        BindCounts submitted;
+
+        /**
+         * The binds needed to draw the items in sorted order.
+         */
+        BindCounts sorted;
+    };
+
+    /**
+     * Creates an empty render queue.
+     *
+     * @return The new render queue.
+     * @script{create}
+     */
+    static RenderQueue* create();
+
+    /**
+     * Adds draw items for each pass of each mesh part of the model.
+     *
+     * The model must not be released until the queue is drawn or cleared.
+     *
+     * @param model The model to draw.
+     * @param wireframe If true, draw the model in wireframe mode.
+     */
+    void add(Model* model, bool wireframe = false);
+
+    /**
+     * Gets the number of draw items in the queue.
+     *
+     * @return The number of draw items.
+     */
+    unsigned int getItemCount() const;
+
+    /**
+     * Sorts the draw items by their sort keys and updates the statistics.
+     *
+     * This is called by draw(); it only needs to be called directly to inspect the
+     * statistics without drawing.
+     */
+    void sort();
+
+    /**
+     * Sorts the draw items, draws them and clears the queue.
+     */
+    void draw();
+
+    /**
+     * Removes all of the draw items from the queue without drawing them.
+     */
+    void clear();
+
+    /**
+     * Gets the statistics of the most recent sort of the queue.
+     *
+     * @return The statistics.
+     * @script{ignore}
+     */
+    const Statistics& getStatistics() const;
+
+private:
+
+    /**
+     * A single draw call: a mesh part (or a whole mesh) drawn with one pass.
+     */
+    struct DrawItem
+    {
+        unsigned long long key;
+        Model* model;
+        Pass* pass;
+        int partIndex;
+        bool wireframe;
+        bool instanced;
+    };
+
+    /**
+     * Constructor.
+     */
+    RenderQueue();
+
+    /**
+     * Destructor.
+     */
+    ~RenderQueue();
+
+    /**
+     * Hidden copy constructor.
+     */
+    RenderQueue(const RenderQueue& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    RenderQueue& operator=(const RenderQueue&);
+
+    /**
+     * Adds a draw item for each pass of the material.
+     */
+    void addItems(Model* model, Material* material, int partIndex, bool wireframe, float depth);
+
+    /**
+     * Gets the number of consecutive items, starting at the given position in the given order,
+     * that can be drawn as instances of a single draw call.
+     */
+    unsigned int getInstanceRunLength(const unsigned int* order, size_t start) const;
+
+    /**
+     * Gets a hash of the material parameters bound by the pass and the render states above it.
+     * Passes that bind equivalent parameters have the same hash.
+     */
+    static unsigned long long getParameterSignature(Pass* pass);
+
+    /**
+     * Determines if two passes bind the same effect, render state and material parameter values.
+     */
+    static bool hasEquivalentParameters(Pass* a, Pass* b);
+
+    /**
+     * Determines if two material parameters, owned by the given render states, bind the same value.
+     */
+    static bool isEquivalent(const MaterialParameter* a, const RenderState* aOwner, const MaterialParameter* b, const RenderState* bOwner);
+
+    /**
+     * Gets the size in bytes of the value of a parameter that is stored as an array of floats or ints.
+     */
+    static size_t getValueSize(const MaterialParameter* parameter);
+
+    /**
+     * Counts the binds needed to draw the items in the given order.
+     */
+    void countBinds(const unsigned int* order, BindCounts* counts) const;
+
+    std::vector<DrawItem> _items;                   // The draw items, in the order they were added.
+    std::vector<unsigned long long> _keys;          // The sort keys, in sorted order.
+    std::vector<unsigned int> _order;               // The indices of the items, in sorted order.
+    std::vector<unsigned long long> _sortKeys;      // Scratch space for the radix sort.
+    std::vector<unsigned int> _sortOrder;           // Scratch space for the radix sort.
+    std::map<const void*, unsigned int> _ranks;     // The rank of each effect and material, in order of first use.
+    std::map<unsigned long long, unsigned int> _stateRanks; // The rank of each combination of fixed-function states.
+    std::map<unsigned long long, unsigned int> _parameterRanks; // The rank of each material parameter signature.
+    bool _sorted;                                   // Whether _order is up to date.
+    InstanceBuffer* _instances;                     // The instances of the items that are drawn together.
+    Statistics _statistics;                         // The statistics of the most recent sort.
+};
+
+}
+
+#endif
@@ -355,6 +355,49 @@ RenderState* RenderState::getTopmost(RenderState* below)
     return NULL;
 }
 
+unsigned long long RenderState::getStateBlockSignature()
+{
+    // Resolve the state the same way bind() does: defaults, overridden top-down.
+    bool blendEnabled = false;
+    Blend blendSrc = BLEND_ONE;
+    Blend blendDst = BLEND_ZERO;
+    bool cullFaceEnabled = false;
+    bool depthTestEnabled = false;
+    bool depthWriteEnabled = true;
+    DepthFunction depthFunction = DEPTH_LESS;
+    RenderState* rs = NULL;
+    while ((rs = getTopmost(rs)))
+    {
+        StateBlock* state = rs->_state;
+        if (!state)
+            continue;
+        if (state->_bits & RS_BLEND)
+            blendEnabled = state->_blendEnabled;
+        if (state->_bits & RS_BLEND_FUNC)
+        {
+            blendSrc = state->_blendSrc;
+            blendDst = state->_blendDst;
+        }
+        if (state->_bits & RS_CULL_FACE)
+            cullFaceEnabled = state->_cullFaceEnabled;
+        if (state->_bits & RS_DEPTH_TEST)
+            depthTestEnabled = state->_depthTestEnabled;
+        if (state->_bits & RS_DEPTH_WRITE)
+            depthWriteEnabled = state->_depthWriteEnabled;
+        if (state->_bits & RS_DEPTH_FUNC)
+            depthFunction = state->_depthFunction;
+    }
+
+    // The blend, depth function and blend factors are GL enums that fit in 16 bits.
+    return (blendEnabled ? 1ULL : 0ULL) |
+           (cullFaceEnabled ? 2ULL : 0ULL) |
+           (depthTestEnabled ? 4ULL : 0ULL) |
+           (depthWriteEnabled ? 8ULL : 0ULL) |
+           ((unsigned long long)(depthFunction & 0xFFFF) << 16) |
+           ((unsigned long long)(blendSrc & 0xFFFF) << 32) |
+           ((unsigned long long)(blendDst & 0xFFFF) << 48);
+}
+
 void RenderState::cloneInto(RenderState* renderState, NodeCloneContext& context) const
 {
     GP_ASSERT(renderState);
@@ -21,6 +21,7 @@ class RenderState : public Ref
     friend class Technique;
     friend class Pass;
     friend class Model;
+    friend class RenderQueue;
 
 public:
 
@@ -174,6 +175,7 @@ public:
     class StateBlock : public Ref
     {
         friend class RenderState;
+        friend class RenderQueue;
         friend class Game;
 
     public:
@@ -441,6 +443,13 @@ protected:
      */
     RenderState* getTopmost(RenderState* below);
 
+    /**
+     * Returns a value that identifies the fixed-function state that bind() applies for this
+     * RenderState and its parents. Hierarchies that apply the same state return the same value,
+     * and the lowest bit of the value is set if the state enables blending.
+     */
+    unsigned long long getStateBlockSignature();
+
     /**
      * Copies the data from this RenderState into the given RenderState.
      * 
@@ -0,0 +1,212 @@
+#include "Base.h"
+#include "ResourceLoader.h"
+#include "Profiler.h"
+#include "Game.h"
+
+namespace gameplay
+{
+
+ResourceLoader::ResourceLoader()
+    : _running(0), _pendingCount(0), _uploadBudget(4.0f)
+{
+}
+
+ResourceLoader::~ResourceLoader()
+{
+    finalize();
+}
+
+void ResourceLoader::initialize(unsigned int threadCount)
+{
+    GP_ASSERT(_threads.empty());
+
+    _running = 1;
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        Thread* thread = Thread::create(loaderMain, this);
+        if (!thread)
+        {
+            GP_WARN("Failed to create resource loader thread %u.", i);
+            break;
+        }
+        _threads.push_back(thread);
+    }
+    if (_threads.empty())
+    {
+        GP_WARN("No resource loader threads; resources will be loaded on the main thread.");
+    }
+}
+
+void ResourceLoader::finalize()
+{
+    if (_running)
+    {
+        _running = 0;
+        _wakeup.post((unsigned int)_threads.size());
+    }
+    for (size_t i = 0, count = _threads.size(); i < count; ++i)
+    {
+        _threads[i]->join();
+        SAFE_DELETE(_threads[i]);
+    }
+    _threads.clear();
+
+    // Release the requests that did not finish, without notifying their listeners.
+    for (size_t i = 0, count = _queued.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_queued[i]);
+    }
+    _queued.clear();
+    for (size_t i = 0, count = _loaded.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_loaded[i]);
+    }
+    _loaded.clear();
+    _pendingCount = 0;
+}
+
+ResourceRequest* ResourceLoader::loadImage(const char* path)
+{
+    GP_ASSERT(path);
+    return submit(new ResourceRequest(ResourceRequest::IMAGE, path));
+}
+
+ResourceRequest* ResourceLoader::loadTexture(const char* path, bool generateMipmaps)
+{
+    GP_ASSERT(path);
+    ResourceRequest* request = new ResourceRequest(ResourceRequest::TEXTURE, path);
+    request->_generateMipmaps = generateMipmaps;
+    return submit(request);
+}
+
+ResourceRequest* ResourceLoader::loadAudioSource(const char* url)
+{
+    GP_ASSERT(url);
+    return submit(new ResourceRequest(ResourceRequest::AUDIO_SOURCE, url));
+}
+
+ResourceRequest* ResourceLoader::loadBundle(const char* path)
+{
+    GP_ASSERT(path);
+    return submit(new ResourceRequest(ResourceRequest::BUNDLE, path));
+}
+
+ResourceRequest* ResourceLoader::loadScene(const char* url)
+{
+    GP_ASSERT(url);
+    return submit(new ResourceRequest(ResourceRequest::SCENE, url));
+}
+
+unsigned int ResourceLoader::getPendingCount() const
+{
+    return _pendingCount;
+}
+
+float ResourceLoader::getUploadBudget() const
+{
+    return _uploadBudget;
+}
+
+void ResourceLoader::setUploadBudget(float milliseconds)
+{
+    _uploadBudget = milliseconds;
+}
+
+ResourceRequest* ResourceLoader::submit(ResourceRequest* request)
+{
+    GP_ASSERT(request);
+
+    // The loader holds its own reference until the request has finished.
+    request->addRef();
+    ++_pendingCount;
+
+    if (_threads.empty())
+    {
+        // Without loader threads, the loading is done during the next update instead.
+        _loaded.push_back(request);
+        return request;
+    }
+
+    {
+        MutexLock lock(_mutex);
+        _queued.push_back(request);
+    }
+    _wakeup.post();
+    return request;
+}
+
+void ResourceLoader::update()
+{
+    GP_PROFILE_SCOPE("ResourceLoader::update");
+
+    if (_pendingCount == 0)
+        return;
+
+    double startTime = Game::getAbsoluteTime();
+    bool single = _threads.empty();
+    while (true)
+    {
+        ResourceRequest* request = NULL;
+        {
+            MutexLock lock(_mutex);
+            if (!_loaded.empty())
+            {
+                request = _loaded.front();
+                _loaded.pop_front();
+            }
+        }
+        if (!request)
+            break;
+
+        if (single && !request->_uploading)
+            request->load();
+        if (request->upload())
+        {
+            request->finish();
+            SAFE_RELEASE(request);
+            --_pendingCount;
+        }
+        else
+        {
+            // Continue with the same request next, in this update or the next one.
+            MutexLock lock(_mutex);
+            _loaded.push_front(request);
+        }
+
+        // Always make at least one upload step so that large uploads still make progress.
+        if (Game::getAbsoluteTime() - startTime >= _uploadBudget)
+            break;
+    }
+}
+
+void ResourceLoader::loaderMain(void* arg)
+{
+    ResourceLoader* loader = (ResourceLoader*)arg;
+    GP_ASSERT(loader);
+
+    while (true)
+    {
+        loader->_wakeup.wait();
+        if (!atomicLoad(&loader->_running))
+            break;
+
+        ResourceRequest* request = NULL;
+        {
+            MutexLock lock(loader->_mutex);
+            if (!loader->_queued.empty())
+            {
+                request = loader->_queued.front();
+                loader->_queued.pop_front();
+            }
+        }
+        if (!request)
+            continue;
+
+        request->load();
+
+        MutexLock lock(loader->_mutex);
+        loader->_loaded.push_back(request);
+    }
+}
+
+}
@@ -0,0 +1,169 @@
+#ifndef RESOURCELOADER_H_
+#define RESOURCELOADER_H_
+
+#include "ResourceRequest.h"
+#include "Thread.h"
+
+namespace gameplay
+{
+
+/**
+ * Defines a service for loading resources in the background without stalling the game loop.
+ *
+ * Each load method returns a ResourceRequest immediately and queues the request to a pool of
+ * loader threads, which do the file IO, PNG and OGG decoding and bundle parsing. The step that
+ * must run on the main game thread (creating the GPU textures, OpenAL buffers or scene objects)
+ * is done by the game at the start of each frame, in small steps until the upload time budget
+ * for the frame has been used up. At least one step is always done per frame, so a single
+ * resource that takes longer than the budget to upload still completes.
+ *
+ * For scenes, the scene file and the property files it references are parsed on a loader thread,
+ * which also reads the vertex and index data of the meshes in the main bundle and decodes the PNG
+ * textures sampled by the materials. The textures and then the meshes are created on the main
+ * thread one per upload step. The nodes, materials and animations are built from the parsed files
+ * in the last step, since they create scene objects and compile shaders.
+ *
+ * The resource loader is created and owned by the Game and is accessed through Game::getResourceLoader().
+ * The number of loader threads and the upload budget can be set with the 'threads' and
+ * 'uploadBudget' properties of the 'loader' namespace in game.config.
+ */
+class ResourceLoader
+{
+    friend class Game;
+
+public:
+
+    /**
+     * Loads an image in the background.
+     *
+     * @param path The path to the image file.
+     *
+     * @return The request for the image.
+     * @script{create}
+     */
+    ResourceRequest* loadImage(const char* path);
+
+    /**
+     * Loads a texture in the background.
+     *
+     * @param path The path to the texture file.
+     * @param generateMipmaps true to generate a mipmap chain for the texture.
+     *
+     * @return The request for the texture.
+     * @script{create}
+     */
+    ResourceRequest* loadTexture(const char* path, bool generateMipmaps = false);
+
+    /**
+     * Loads an audio source in the background.
+     *
+     * @param url The path to an audio file or to a .audio properties file.
+     *
+     * @return The request for the audio source.
+     * @script{create}
+     */
+    ResourceRequest* loadAudioSource(const char* url);
+
+    /**
+     * Loads a bundle in the background.
+     *
+     * @param path The path to the bundle file.
+     *
+     * @return The request for the bundle.
+     * @script{create}
+     */
+    ResourceRequest* loadBundle(const char* path);
+
+    /**
+     * Loads a scene in the background.
+     *
+     * @param url The URL of the .scene file to load.
+     *
+     * @return The request for the scene.
+     * @script{create}
+     */
+    ResourceRequest* loadScene(const char* url);
+
+    /**
+     * Gets the number of requests that have not finished yet.
+     *
+     * @return The number of unfinished requests.
+     */
+    unsigned int getPendingCount() const;
+
+    /**
+     * Gets the time the main thread may spend finishing loaded requests each frame.
+     *
+     * @return The upload budget, in milliseconds.
+     */
+    float getUploadBudget() const;
+
+    /**
+     * Sets the time the main thread may spend finishing loaded requests each frame.
+     *
+     * @param milliseconds The upload budget, in milliseconds.
+     */
+    void setUploadBudget(float milliseconds);
+
+private:
+
+    /**
+     * Constructor.
+     */
+    ResourceLoader();
+
+    /**
+     * Hidden copy constructor.
+     */
+    ResourceLoader(const ResourceLoader& copy);
+
+    /**
+     * Destructor.
+     */
+    ~ResourceLoader();
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    ResourceLoader& operator=(const ResourceLoader&);
+
+    /**
+     * Starts the loader threads.
+     *
+     * @param threadCount The number of loader threads to start.
+     */
+    void initialize(unsigned int threadCount);
+
+    /**
+     * Stops the loader threads and releases any unfinished requests.
+     */
+    void finalize();
+
+    /**
+     * Finishes the requests that have been loaded, within the upload budget.
+     */
+    void update();
+
+    /**
+     * Queues a request to the loader threads.
+     */
+    ResourceRequest* submit(ResourceRequest* request);
+
+    /**
+     * Loader thread entry point.
+     */
+    static void loaderMain(void* arg);
+
+    std::vector<Thread*> _threads;              // The loader threads.
+    Mutex _mutex;                               // Guards the queues shared with the loader threads.
+    Semaphore _wakeup;                          // Signaled when requests are queued.
+    volatile int _running;                      // Whether the loader threads should keep running.
+    std::deque<ResourceRequest*> _queued;       // Requests waiting for a loader thread.
+    std::deque<ResourceRequest*> _loaded;       // Requests waiting to be finished on the main thread.
+    unsigned int _pendingCount;                 // Requests submitted but not finished yet.
+    float _uploadBudget;                        // The upload time budget per frame, in milliseconds.
+};
+
+}
+
+#endif
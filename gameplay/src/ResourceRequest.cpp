@@ -0,0 +1,317 @@
+#include "Base.h"
+#include "ResourceRequest.h"
+#include "AudioSource.h"
+#include "Bundle.h"
+#include "FileSystem.h"
+#include "Game.h"
+#include "Image.h"
+#include "Properties.h"
+#include "Scene.h"
+#include "SceneLoader.h"
+#include "Texture.h"
+
+namespace gameplay
+{
+
+static bool isPNG(const char* path)
+{
+    const char* ext = strrchr(FileSystem::resolvePath(path), '.');
+    return ext && strlen(ext) == 4 && tolower(ext[1]) == 'p' && tolower(ext[2]) == 'n' && tolower(ext[3]) == 'g';
+}
+
+ResourceRequest::ResourceRequest(Type type, const char* path)
+    : _type(type), _path(path), _generateMipmaps(false), _state(QUEUED), _decoded(false), _uploading(false),
+      _image(NULL), _texture(NULL), _audioSource(NULL), _bundle(NULL), _scene(NULL), _sceneLoader(NULL)
+{
+}
+
+ResourceRequest::~ResourceRequest()
+{
+    SAFE_RELEASE(_image);
+    SAFE_RELEASE(_texture);
+    SAFE_RELEASE(_audioSource);
+    SAFE_RELEASE(_bundle);
+    SAFE_RELEASE(_scene);
+    SAFE_DELETE(_sceneLoader);
+    for (size_t i = 0, count = _sceneImages.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_sceneImages[i].second);
+    }
+    for (size_t i = 0, count = _sceneTextures.size(); i < count; ++i)
+    {
+        SAFE_RELEASE(_sceneTextures[i]);
+    }
+}
+
+const char* ResourceRequest::getPath() const
+{
+    return _path.c_str();
+}
+
+bool ResourceRequest::isFinished() const
+{
+    return _state != QUEUED;
+}
+
+bool ResourceRequest::isLoaded() const
+{
+    return _state == LOADED;
+}
+
+Image* ResourceRequest::getImage() const
+{
+    return _type == IMAGE ? _image : NULL;
+}
+
+Texture* ResourceRequest::getTexture() const
+{
+    return _texture;
+}
+
+AudioSource* ResourceRequest::getAudioSource() const
+{
+    return _audioSource;
+}
+
+Bundle* ResourceRequest::getBundle() const
+{
+    return _type == BUNDLE ? _bundle : NULL;
+}
+
+Scene* ResourceRequest::getScene() const
+{
+    return _scene;
+}
+
+void ResourceRequest::addListener(Listener* listener)
+{
+    GP_ASSERT(listener);
+    _listeners.push_back(listener);
+}
+
+void ResourceRequest::removeListener(Listener* listener)
+{
+    std::vector<Listener*>::iterator itr = std::find(_listeners.begin(), _listeners.end(), listener);
+    if (itr != _listeners.end())
+        _listeners.erase(itr);
+}
+
+void ResourceRequest::addListener(const char* function)
+{
+    GP_ASSERT(function);
+    _scriptFunctions.push_back(Game::getInstance()->getScriptController()->loadUrl(function));
+}
+
+void ResourceRequest::load()
+{
+    const char* path = _path.c_str();
+    switch (_type)
+    {
+    case IMAGE:
+        _image = Image::create(path);
+        _decoded = _image != NULL;
+        break;
+
+    case TEXTURE:
+        // PNG files are decoded here; compressed textures are read when they are uploaded.
+        if (isPNG(path))
+        {
+            _image = Image::create(path);
+            _decoded = _image != NULL;
+        }
+        else
+        {
+            _decoded = true;
+        }
+        break;
+
+    case AUDIO_SOURCE:
+        if (_path.find(".audio") != std::string::npos)
+        {
+            Properties* properties = Properties::create(path);
+            if (properties)
+            {
+                Properties* audioProperties = (strlen(properties->getNamespace()) > 0) ? properties : properties->getNextNamespace();
+                const char* audioPath = audioProperties ? audioProperties->getString("path") : NULL;
+                if (audioPath)
+                    _audioPath = audioPath;
+                SAFE_DELETE(properties);
+            }
+        }
+        else
+        {
+            _audioPath = _path;
+        }
+        _decoded = !_audioPath.empty() && AudioBuffer::decode(_audioPath.c_str(), &_pcm);
+        break;
+
+    case BUNDLE:
+        _bundle = Bundle::open(path);
+        _decoded = _bundle != NULL;
+        break;
+
+    case SCENE:
+        {
+            // Parse the scene, read its mesh data and decode its textures here; only the GPU
+            // objects are created on the main thread.
+            _sceneLoader = new SceneLoader();
+            if (!_sceneLoader->loadProperties(path))
+            {
+                SAFE_DELETE(_sceneLoader);
+                break;
+            }
+
+            if (!_sceneLoader->_gpbPath.empty())
+            {
+                _bundle = Bundle::open(_sceneLoader->_gpbPath.c_str());
+                if (_bundle)
+                    _bundle->preloadMeshData();
+            }
+
+            std::vector<std::string> texturePaths;
+            _sceneLoader->getTexturePaths(&texturePaths);
+            for (size_t i = 0, count = texturePaths.size(); i < count; ++i)
+            {
+                if (!isPNG(texturePaths[i].c_str()))
+                    continue;
+                Image* image = Image::create(texturePaths[i].c_str());
+                if (image)
+                    _sceneImages.push_back(std::make_pair(texturePaths[i], image));
+            }
+            _decoded = true;
+        }
+        break;
+    }
+}
+
+bool ResourceRequest::upload()
+{
+    _uploading = true;
+    if (!_decoded || _type != SCENE)
+        return true;
+
+    // Create the scene's textures and then its meshes, one per call. The textures are cached
+    // under their paths so that the materials of the scene use them.
+    if (!_sceneImages.empty())
+    {
+        std::pair<std::string, Image*> entry = _sceneImages.back();
+        _sceneImages.pop_back();
+
+        Texture* texture = Texture::findCached(entry.first.c_str(), false);
+        if (!texture)
+        {
+            texture = Texture::create(entry.second, false);
+            if (texture)
+                Texture::addToCache(texture, entry.first.c_str());
+        }
+        if (texture)
+            _sceneTextures.push_back(texture);
+        SAFE_RELEASE(entry.second);
+        return false;
+    }
+    return !_bundle || !_bundle->createPreloadedMesh();
+}
+
+void ResourceRequest::finish()
+{
+    const char* path = _path.c_str();
+    if (_decoded)
+    {
+        switch (_type)
+        {
+        case IMAGE:
+            break;
+
+        case TEXTURE:
+            if (_image)
+            {
+                _texture = Texture::findCached(path, _generateMipmaps);
+                if (!_texture)
+                {
+                    _texture = Texture::create(_image, _generateMipmaps);
+                    if (_texture)
+                        Texture::addToCache(_texture, path);
+                }
+                SAFE_RELEASE(_image);
+            }
+            else
+            {
+                _texture = Texture::create(path, _generateMipmaps);
+            }
+            break;
+
+        case AUDIO_SOURCE:
+            {
+                // Cache the buffer so that the audio source picks it up instead of loading the file again.
+                AudioBuffer* buffer = AudioBuffer::create(_audioPath.c_str(), _pcm);
+                SAFE_DELETE_ARRAY(_pcm.data);
+                if (buffer)
+                {
+                    _audioSource = AudioSource::create(path);
+                    SAFE_RELEASE(buffer);
+                }
+            }
+            break;
+
+        case BUNDLE:
+            _bundle = Bundle::addToCache(_bundle);
+            break;
+
+        case SCENE:
+            // Cache the main bundle so that the scene loader uses it instead of opening the file again.
+            if (_bundle)
+                _bundle = Bundle::addToCache(_bundle);
+            _scene = _sceneLoader->createScene();
+            SAFE_DELETE(_sceneLoader);
+            if (_bundle)
+                _bundle->clearPreloadedMeshes();
+            SAFE_RELEASE(_bundle);
+
+            // The materials of the scene hold their own references to its textures.
+            for (size_t i = 0, count = _sceneTextures.size(); i < count; ++i)
+            {
+                SAFE_RELEASE(_sceneTextures[i]);
+            }
+            _sceneTextures.clear();
+            break;
+        }
+    }
+
+    bool loaded = false;
+    switch (_type)
+    {
+    case IMAGE:
+        loaded = _image != NULL;
+        break;
+    case TEXTURE:
+        loaded = _texture != NULL;
+        break;
+    case AUDIO_SOURCE:
+        loaded = _audioSource != NULL;
+        break;
+    case BUNDLE:
+        loaded = _bundle != NULL;
+        break;
+    case SCENE:
+        loaded = _scene != NULL;
+        break;
+    }
+    _state = loaded ? LOADED : FAILED;
+    if (!loaded)
+    {
+        GP_WARN("Failed to load resource '%s' in the background.", path);
+    }
+
+    // Listeners may remove themselves while being notified.
+    std::vector<Listener*> listeners(_listeners);
+    for (size_t i = 0, count = listeners.size(); i < count; ++i)
+    {
+        listeners[i]->resourceLoaded(this);
+    }
+    for (size_t i = 0, count = _scriptFunctions.size(); i < count; ++i)
+    {
+        Game::getInstance()->getScriptController()->executeFunction<void>(_scriptFunctions[i].c_str(), "<ResourceRequest>", this);
+    }
+}
+
+}
@@ -0,0 +1,225 @@
+#ifndef RESOURCEREQUEST_H_
+#define RESOURCEREQUEST_H_
+
+#include "Ref.h"
+#include "AudioBuffer.h"
+
+namespace gameplay
+{
+
+class Image;
+class Texture;
+class AudioSource;
+class Bundle;
+class Scene;
+class SceneLoader;
+
+/**
+ * Defines a handle to a resource that is being loaded in the background by the ResourceLoader.
+ *
+ * A request can be polled with isFinished() or listeners can be attached to be notified
+ * when it finishes. Listeners are always called on the main game thread, during the frame
+ * in which the resource becomes available. The request holds a reference to the loaded
+ * resource, so the resource must be retained with addRef() if it is to be kept after the
+ * request is released.
+ */
+class ResourceRequest : public Ref
+{
+    friend class ResourceLoader;
+
+public:
+
+    /**
+     * Defines a listener to be notified when a request finishes.
+     */
+    class Listener
+    {
+    public:
+
+        /**
+         * Destructor.
+         */
+        virtual ~Listener() { }
+
+        /**
+         * Called on the main game thread when a request has finished, whether or not it succeeded.
+         *
+         * @param request The request that finished.
+         */
+        virtual void resourceLoaded(ResourceRequest* request) = 0;
+    };
+
+    /**
+     * Gets the path or URL of the resource being loaded.
+     *
+     * @return The path of the resource.
+     */
+    const char* getPath() const;
+
+    /**
+     * Determines if the request has finished, whether or not the resource was loaded successfully.
+     *
+     * @return true if the request has finished; false if it is still in progress.
+     */
+    bool isFinished() const;
+
+    /**
+     * Determines if the request has finished and the resource was loaded successfully.
+     *
+     * @return true if the resource is loaded; false otherwise.
+     */
+    bool isLoaded() const;
+
+    /**
+     * Gets the loaded image, for requests made with ResourceLoader::loadImage().
+     *
+     * @return The image, or NULL if it is not (yet) loaded.
+     */
+    Image* getImage() const;
+
+    /**
+     * Gets the loaded texture, for requests made with ResourceLoader::loadTexture().
+     *
+     * @return The texture, or NULL if it is not (yet) loaded.
+     */
+    Texture* getTexture() const;
+
+    /**
+     * Gets the loaded audio source, for requests made with ResourceLoader::loadAudioSource().
+     *
+     * @return The audio source, or NULL if it is not (yet) loaded.
+     */
+    AudioSource* getAudioSource() const;
+
+    /**
+     * Gets the loaded bundle, for requests made with ResourceLoader::loadBundle().
+     *
+     * @return The bundle, or NULL if it is not (yet) loaded.
+     */
+    Bundle* getBundle() const;
+
+    /**
+     * Gets the loaded scene, for requests made with ResourceLoader::loadScene().
+     *
+     * @return The scene, or NULL if it is not (yet) loaded.
+     */
+    Scene* getScene() const;
+
+    /**
+     * Adds a listener to be notified when the request finishes.
+     *
+     * If the request has already finished the listener is not called.
+     *
+     * @param listener The listener to add.
+     * @script{ignore}
+     */
+    void addListener(Listener* listener);
+
+    /**
+     * Removes a listener from the request.
+     *
+     * @param listener The listener to remove.
+     * @script{ignore}
+     */
+    void removeListener(Listener* listener);
+
+    /**
+     * Adds a script function to be called when the request finishes.
+     *
+     * The function is passed the request as its only argument.
+     *
+     * @param function The Lua script function to call.
+     */
+    void addListener(const char* function);
+
+private:
+
+    /**
+     * The type of resource being loaded.
+     */
+    enum Type
+    {
+        IMAGE,
+        TEXTURE,
+        AUDIO_SOURCE,
+        BUNDLE,
+        SCENE
+    };
+
+    /**
+     * The state of the request.
+     */
+    enum State
+    {
+        QUEUED,
+        LOADED,
+        FAILED
+    };
+
+    /**
+     * Constructor.
+     */
+    ResourceRequest(Type type, const char* path);
+
+    /**
+     * Destructor.
+     */
+    ~ResourceRequest();
+
+    /**
+     * Hidden copy constructor.
+     */
+    ResourceRequest(const ResourceRequest& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    ResourceRequest& operator=(const ResourceRequest&);
+
+    /**
+     * Does the part of the loading that is safe to run off the main thread: file IO,
+     * decoding and parsing. Called on a loader thread.
+     *
+     * For scenes this parses the scene file and the files it references, reads the mesh
+     * data of the main bundle and decodes the PNG textures sampled by the materials.
+     */
+    void load();
+
+    /**
+     * Does one step of creating the GPU objects from the data produced by load(), such
+     * as one texture or mesh of a scene, so that large requests are spread over several frames.
+     * Called on the main game thread until it returns true, and then finish() is called.
+     *
+     * @return true if there is nothing left to upload; false if it should be called again.
+     */
+    bool upload();
+
+    /**
+     * Creates the resource from the data produced by load(), uploading it to the GPU or
+     * audio device, and then notifies the listeners. Called on the main game thread.
+     */
+    void finish();
+
+    Type _type;                                 // The type of resource being loaded.
+    std::string _path;                          // The path or URL of the resource.
+    bool _generateMipmaps;                      // Whether texture mipmaps are generated.
+    State _state;                               // The state of the request.
+    bool _decoded;                              // Whether load() produced the data for finish().
+    bool _uploading;                            // Whether upload() has been called.
+    std::string _audioPath;                     // The audio file path, for audio sources loaded from .audio files.
+    AudioBuffer::PCM _pcm;                      // The decoded audio data.
+    Image* _image;                              // The loaded image (also the decoded texture image).
+    Texture* _texture;                          // The loaded texture.
+    AudioSource* _audioSource;                  // The loaded audio source.
+    Bundle* _bundle;                            // The loaded bundle (also the main bundle of a scene).
+    Scene* _scene;                              // The loaded scene.
+    SceneLoader* _sceneLoader;                  // The parsed scene file, for scenes.
+    std::vector<std::pair<std::string, Image*> > _sceneImages; // The decoded textures of a scene, by path.
+    std::vector<Texture*> _sceneTextures;       // The textures of a scene, held until the scene is created.
+    std::vector<Listener*> _listeners;          // The listeners to notify.
+    std::vector<std::string> _scriptFunctions;  // The script functions to call.
+};
+
+}
+
+#endif
@@ -1,10 +1,12 @@
 #include "Base.h"
 #include "AudioListener.h"
 #include "Scene.h"
+#include "Profiler.h"
 #include "SceneLoader.h"
 #include "MeshSkin.h"
 #include "Joint.h"
 #include "Terrain.h"
+#include "SpatialIndex.h"
 
 namespace gameplay
 {
@@ -12,9 +14,33 @@ namespace gameplay
 // Global list of active scenes
 static std::vector<Scene*> __sceneList;
 
+/**
+ * Hashes a node ID for the ID index (32-bit FNV-1a).
+ */
+static unsigned int hashNodeId(const char* id)
+{
+    unsigned int hash = 2166136261u;
+    for (const char* c = id; *c; ++c)
+    {
+        hash ^= (unsigned char)*c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Orders the ID index by node ID, and then in search order.
+ */
+static bool compareIndexedIds(const std::pair<const char*, unsigned int>& a, const std::pair<const char*, unsigned int>& b)
+{
+    int result = strcmp(a.first, b.first);
+    return result < 0 || (result == 0 && a.second < b.second);
+}
+
 Scene::Scene(const char* id)
     : _id(id ? id : ""), _activeCamera(NULL), _firstNode(NULL), _lastNode(NULL), _nodeCount(0), 
-    _lightColor(1,1,1), _lightDirection(0,-1,0), _bindAudioListenerToCamera(true), _debugBatch(NULL)
+    _lightColor(1,1,1), _lightDirection(0,-1,0), _bindAudioListenerToCamera(true), _debugBatch(NULL),
+    _spatialIndex(NULL), _nodeIndexVersion(0), _nodeIndexSearchVersion(0)
 {
     __sceneList.push_back(this);
 }
@@ -33,7 +59,15 @@ Scene::~Scene()
         SAFE_RELEASE(_activeCamera);
     }
 
-    // Remove all nodes from the scene
+    // Release the queued nodes, which may be kept alive elsewhere.
+    for (size_t i = 0, count = _transformRoots.size(); i < count; ++i)
+    {
+        _transformRoots[i]->clearTransformQueued();
+    }
+    _transformRoots.clear();
+
+    // Remove all nodes from the scene (dropping the spatial index first, rather than updating it for each node)
+    SAFE_DELETE(_spatialIndex);
     removeAllNodes();
     SAFE_DELETE(_debugBatch);
 
@@ -81,6 +115,12 @@ Node* Scene::findNode(const char* id, bool recursive, bool exactMatch) const
 {
     GP_ASSERT(id);
 
+    // Use the ID index for recursive searches.
+    if (recursive && updateNodeIndex())
+    {
+        return findIndexedNode(id, exactMatch, 0, (unsigned int)_nodeIndex.size());
+    }
+
     // Search immediate children first.
     for (Node* child = getFirstNode(); child != NULL; child = child->getNextSibling())
     {
@@ -96,7 +136,7 @@ Node* Scene::findNode(const char* id, bool recursive, bool exactMatch) const
     {
         for (Node* child = getFirstNode(); child != NULL; child = child->getNextSibling())
         {
-            Node* match = child->findNode(id, true, exactMatch);
+            Node* match = child->searchNode(id, true, exactMatch);
             if (match)
             {
                 return match;
@@ -111,6 +151,12 @@ unsigned int Scene::findNodes(const char* id, std::vector<Node*>& nodes, bool re
 {
     GP_ASSERT(id);
 
+    // Use the ID index for recursive searches.
+    if (recursive && updateNodeIndex())
+    {
+        return findIndexedNodes(id, nodes, exactMatch, 0, (unsigned int)_nodeIndex.size());
+    }
+
     unsigned int count = 0;
 
     // Search immediate children first.
@@ -129,7 +175,7 @@ unsigned int Scene::findNodes(const char* id, std::vector<Node*>& nodes, bool re
     {
         for (Node* child = getFirstNode(); child != NULL; child = child->getNextSibling())
         {
-            count += child->findNodes(id, nodes, true, exactMatch);
+            count += child->searchNodes(id, nodes, true, exactMatch);
         }
     }
 
@@ -187,6 +233,12 @@ void Scene::addNode(Node* node)
     node->_scene = this;
 
     ++_nodeCount;
+    Node::setNodeIndexDirty();
+
+    if (_spatialIndex)
+    {
+        _spatialIndex->addHierarchy(node);
+    }
 
     // If we don't have an active camera set, then check for one and set it.
     if (_activeCamera == NULL)
@@ -321,6 +373,374 @@ void Scene::setLightDirection(const Vector3& direction)
     _lightDirection = direction;
 }
 
+void Scene::updateTransforms()
+{
+    if (!_transformRoots.empty())
+    {
+        Node::updateWorldMatrices(this, _transformRoots, _transformNodes);
+    }
+}
+
+void Scene::updateAllTransforms()
+{
+    GP_PROFILE_SCOPE("Scene::updateAllTransforms");
+
+    for (size_t i = 0, count = __sceneList.size(); i < count; ++i)
+    {
+        __sceneList[i]->updateTransforms();
+    }
+}
+
+void Scene::removeQueuedTransform(Node* node)
+{
+    for (size_t i = 0, count = __sceneList.size(); i < count; ++i)
+    {
+        std::vector<Node*>& roots = __sceneList[i]->_transformRoots;
+        std::vector<Node*>::iterator itr = std::find(roots.begin(), roots.end(), node);
+        if (itr != roots.end())
+        {
+            roots.erase(itr);
+            return;
+        }
+    }
+}
+
+void Scene::setSpatialIndexEnabled(bool enabled)
+{
+    if (enabled == (_spatialIndex != NULL))
+        return;
+
+    if (enabled)
+    {
+        _spatialIndex = new SpatialIndex(this);
+        for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+        {
+            _spatialIndex->addHierarchy(node);
+        }
+    }
+    else
+    {
+        SAFE_DELETE(_spatialIndex);
+    }
+}
+
+bool Scene::isSpatialIndexEnabled() const
+{
+    return _spatialIndex != NULL;
+}
+
+unsigned int Scene::queryNodes(const Frustum& frustum, std::vector<Node*>& nodes)
+{
+    if (_spatialIndex)
+        return _spatialIndex->query(frustum, nodes);
+
+    unsigned int count = 0;
+    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    {
+        count += queryHierarchy(node, frustum, nodes);
+    }
+    return count;
+}
+
+unsigned int Scene::queryNodes(const BoundingBox& box, std::vector<Node*>& nodes)
+{
+    if (_spatialIndex)
+        return _spatialIndex->query(box, nodes);
+
+    unsigned int count = 0;
+    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    {
+        count += queryHierarchy(node, box, nodes);
+    }
+    return count;
+}
+
+unsigned int Scene::queryNodes(const BoundingSphere& sphere, std::vector<Node*>& nodes)
+{
+    if (_spatialIndex)
+        return _spatialIndex->query(sphere, nodes);
+
+    unsigned int count = 0;
+    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    {
+        count += queryHierarchy(node, sphere, nodes);
+    }
+    return count;
+}
+
+Node* Scene::pickNode(const Ray& ray, float* distance)
+{
+    if (_spatialIndex)
+        return _spatialIndex->pick(ray, distance);
+
+    Node* closest = NULL;
+    float closestDistance = 0;
+    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    {
+        pickHierarchy(node, ray, &closest, &closestDistance);
+    }
+    if (closest && distance)
+        *distance = closestDistance;
+    return closest;
+}
+
+static bool intersects(const Frustum& frustum, const BoundingSphere& bounds)
+{
+    return frustum.intersects(bounds);
+}
+
+static bool intersects(const BoundingBox& box, const BoundingSphere& bounds)
+{
+    return bounds.intersects(box);
+}
+
+static bool intersects(const BoundingSphere& sphere, const BoundingSphere& bounds)
+{
+    return bounds.intersects(sphere);
+}
+
+template <class T>
+unsigned int Scene::queryHierarchy(Node* node, const T& volume, std::vector<Node*>& nodes)
+{
+    unsigned int count = 0;
+    BoundingSphere bounds;
+    if (node->getContentBounds(&bounds) && intersects(volume, bounds))
+    {
+        nodes.push_back(node);
+        ++count;
+    }
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        count += queryHierarchy(child, volume, nodes);
+    }
+    return count;
+}
+
+void Scene::pickHierarchy(Node* node, const Ray& ray, Node** closest, float* closestDistance)
+{
+    BoundingSphere bounds;
+    if (node->getContentBounds(&bounds))
+    {
+        float d = ray.intersects(bounds);
+        if (d != Ray::INTERSECTS_NONE && (*closest == NULL || d < *closestDistance))
+        {
+            *closest = node;
+            *closestDistance = d;
+        }
+    }
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        pickHierarchy(child, ray, closest, closestDistance);
+    }
+}
+
+bool Scene::updateNodeIndex() const
+{
+    unsigned int version = Node::getNodeIndexVersion();
+    if (_nodeIndexVersion == version)
+        return true;
+
+    // The first search after the nodes change walks the hierarchy instead, and the index is only
+    // rebuilt when a second search is made without any changes in between. This keeps loops that
+    // alternate between searching and adding nodes (such as loading a bundle) from rebuilding
+    // the index for every node.
+    if (_nodeIndexSearchVersion != version)
+    {
+        _nodeIndexSearchVersion = version;
+        return false;
+    }
+    _nodeIndexVersion = version;
+
+    // Lay out the nodes in the order that findNode() searches them, so that the first match in
+    // the index is the node that a search of the hierarchy would find, and so that the nodes
+    // searched by any one node are a contiguous range of the index.
+    _nodeIndex.clear();
+    IndexedNode indexed = { NULL, 0, 0, 0 };
+    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    {
+        indexed.node = node;
+        _nodeIndex.push_back(indexed);
+    }
+    unsigned int entry = 0;
+    for (Node* node = _firstNode; node != NULL; node = node->_nextSibling)
+    {
+        indexNodeSearch(node, entry++);
+    }
+    unsigned int count = (unsigned int)_nodeIndex.size();
+
+    // Hash the IDs, chaining the entries that share an ID in search order.
+    unsigned int bucketCount = 16;
+    while (bucketCount < count * 2)
+        bucketCount <<= 1;
+    unsigned int mask = bucketCount - 1;
+    _nodeIndexBuckets.assign(bucketCount, 0);
+    std::vector<unsigned int> tails(bucketCount, 0);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        const std::string& id = _nodeIndex[i].node->_id;
+        for (unsigned int bucket = hashNodeId(id.c_str()) & mask; ; bucket = (bucket + 1) & mask)
+        {
+            unsigned int head = _nodeIndexBuckets[bucket];
+            if (head == 0)
+            {
+                _nodeIndexBuckets[bucket] = i + 1;
+                tails[bucket] = i;
+                break;
+            }
+            if (_nodeIndex[head - 1].node->_id == id)
+            {
+                _nodeIndex[tails[bucket]].next = i + 1;
+                tails[bucket] = i;
+                break;
+            }
+        }
+    }
+
+    // The IDs are sorted for prefix searches when the first one is made.
+    _nodeIndexSorted.clear();
+    return true;
+}
+
+void Scene::sortNodeIndex() const
+{
+    if (_nodeIndexSorted.size() == _nodeIndex.size())
+        return;
+
+    unsigned int count = (unsigned int)_nodeIndex.size();
+    _nodeIndexSorted.resize(count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        _nodeIndexSorted[i] = std::make_pair(_nodeIndex[i].node->_id.c_str(), i);
+    }
+    std::sort(_nodeIndexSorted.begin(), _nodeIndexSorted.end(), compareIndexedIds);
+}
+
+void Scene::indexNodeSearch(Node* node, unsigned int entry) const
+{
+    _nodeIndex[entry].searchBegin = (unsigned int)_nodeIndex.size();
+    IndexedNode indexed = { NULL, 0, 0, 0 };
+
+    // The joint hierarchy of a mesh skin is searched first.
+    Node* rootNode = NULL;
+    if (node->_model != NULL && node->_model->getSkin() != NULL && (rootNode = node->_model->getSkin()->_rootNode) != NULL)
+    {
+        unsigned int rootEntry = (unsigned int)_nodeIndex.size();
+        indexed.node = rootNode;
+        _nodeIndex.push_back(indexed);
+        indexNodeSearch(rootNode, rootEntry);
+    }
+
+    // Then the immediate children, then the descendants of each child.
+    unsigned int childEntry = (unsigned int)_nodeIndex.size();
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        indexed.node = child;
+        _nodeIndex.push_back(indexed);
+    }
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        indexNodeSearch(child, childEntry++);
+    }
+
+    _nodeIndex[entry].searchEnd = (unsigned int)_nodeIndex.size();
+}
+
+unsigned int Scene::findIndexedId(const char* id) const
+{
+    unsigned int mask = (unsigned int)_nodeIndexBuckets.size() - 1;
+    for (unsigned int bucket = hashNodeId(id) & mask; _nodeIndexBuckets[bucket] != 0; bucket = (bucket + 1) & mask)
+    {
+        unsigned int head = _nodeIndexBuckets[bucket];
+        if (_nodeIndex[head - 1].node->_id == id)
+            return head;
+    }
+    return 0;
+}
+
+bool Scene::getIndexedSearchRange(const Node* node, unsigned int* begin, unsigned int* end) const
+{
+    GP_ASSERT(node);
+    GP_ASSERT(begin);
+    GP_ASSERT(end);
+
+    if (!updateNodeIndex())
+        return false;
+
+    for (unsigned int i = findIndexedId(node->_id.c_str()); i != 0; i = _nodeIndex[i - 1].next)
+    {
+        if (_nodeIndex[i - 1].node == node)
+        {
+            *begin = _nodeIndex[i - 1].searchBegin;
+            *end = _nodeIndex[i - 1].searchEnd;
+            return true;
+        }
+    }
+    return false;
+}
+
+Node* Scene::findIndexedNode(const char* id, bool exactMatch, unsigned int begin, unsigned int end) const
+{
+    if (exactMatch)
+    {
+        // The entries for an ID are chained in search order.
+        for (unsigned int i = findIndexedId(id); i != 0 && i - 1 < end; i = _nodeIndex[i - 1].next)
+        {
+            if (i - 1 >= begin)
+                return _nodeIndex[i - 1].node;
+        }
+        return NULL;
+    }
+
+    // Find the first entry in search order among the IDs that start with the given prefix.
+    sortNodeIndex();
+    size_t length = strlen(id);
+    unsigned int match = end;
+    std::vector<std::pair<const char*, unsigned int> >::const_iterator itr =
+        std::lower_bound(_nodeIndexSorted.begin(), _nodeIndexSorted.end(), std::make_pair(id, 0u), compareIndexedIds);
+    for (; itr != _nodeIndexSorted.end() && strncmp(itr->first, id, length) == 0; ++itr)
+    {
+        if (itr->second >= begin && itr->second < match)
+            match = itr->second;
+    }
+    return match < end ? _nodeIndex[match].node : NULL;
+}
+
+unsigned int Scene::findIndexedNodes(const char* id, std::vector<Node*>& nodes, bool exactMatch, unsigned int begin, unsigned int end) const
+{
+    unsigned int count = 0;
+    if (exactMatch)
+    {
+        for (unsigned int i = findIndexedId(id); i != 0 && i - 1 < end; i = _nodeIndex[i - 1].next)
+        {
+            if (i - 1 >= begin)
+            {
+                nodes.push_back(_nodeIndex[i - 1].node);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    // Gather the entries whose IDs start with the given prefix, and return them in search order.
+    sortNodeIndex();
+    size_t length = strlen(id);
+    std::vector<unsigned int> matches;
+    std::vector<std::pair<const char*, unsigned int> >::const_iterator itr =
+        std::lower_bound(_nodeIndexSorted.begin(), _nodeIndexSorted.end(), std::make_pair(id, 0u), compareIndexedIds);
+    for (; itr != _nodeIndexSorted.end() && strncmp(itr->first, id, length) == 0; ++itr)
+    {
+        if (itr->second >= begin && itr->second < end)
+            matches.push_back(itr->second);
+    }
+    std::sort(matches.begin(), matches.end());
+    for (size_t i = 0, matchCount = matches.size(); i < matchCount; ++i)
+    {
+        nodes.push_back(_nodeIndex[matches[i]].node);
+        ++count;
+    }
+    return count;
+}
+
 static Material* createDebugMaterial()
 {
     // Vertex shader for drawing colored lines.
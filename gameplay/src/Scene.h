@@ -3,6 +3,7 @@
 
 #include "Node.h"
 #include "MeshBatch.h"
+#include "Profiler.h"
 #include "ScriptController.h"
 #include "Light.h"
 
@@ -14,6 +15,9 @@ namespace gameplay
  */
 class Scene : public Ref
 {
+    friend class Node;
+    friend class Game;
+
 public:
 
     /**
@@ -296,8 +300,103 @@ public:
      */
     void drawDebug(unsigned int debugFlags);
 
+    /**
+     * Computes the world matrices of all the nodes whose transforms have changed.
+     *
+     * The nodes whose transforms change are queued with the scene, and this method resolves
+     * them in one pass: the changed subtrees are flattened into an array with each parent
+     * before its children, and the array is swept once to compute the world matrices, instead
+     * of each node resolving its parents recursively when its world matrix is first read.
+     * After the pass, Node::getWorldMatrix() only reads the stored matrix.
+     *
+     * The game calls this for every scene after its update and before it renders each frame;
+     * it can also be called after moving nodes outside of the update.
+     */
+    void updateTransforms();
+
+    /**
+     * Enables or disables the spatial index of the scene.
+     *
+     * The spatial index is a bounding volume hierarchy over the nodes of the scene that
+     * have a model or terrain. It is kept up to date as nodes are added, removed and moved,
+     * and speeds up the node queries and picking so that their cost grows logarithmically
+     * with the number of nodes rather than linearly. The index is disabled by default.
+     *
+     * @param enabled true to enable the spatial index; false to disable it.
+     */
+    void setSpatialIndexEnabled(bool enabled);
+
+    /**
+     * Determines if the spatial index of the scene is enabled.
+     *
+     * @return true if the spatial index is enabled; false otherwise.
+     */
+    bool isSpatialIndexEnabled() const;
+
+    /**
+     * Finds the nodes whose model or terrain bounds intersect the given frustum, such as
+     * the frustum of a camera when culling the scene before drawing it.
+     *
+     * Only nodes with a model or terrain are returned, since other nodes have nothing to
+     * bound. Without the spatial index every node of the scene is tested.
+     *
+     * @param frustum The frustum to test.
+     * @param nodes The vector to append the intersecting nodes to.
+     *
+     * @return The number of nodes appended.
+     * @script{ignore}
+     */
+    unsigned int queryNodes(const Frustum& frustum, std::vector<Node*>& nodes);
+
+    /**
+     * Finds the nodes whose model or terrain bounds intersect the given box.
+     *
+     * @param box The box to test, in world space.
+     * @param nodes The vector to append the intersecting nodes to.
+     *
+     * @return The number of nodes appended.
+     * @script{ignore}
+     */
+    unsigned int queryNodes(const BoundingBox& box, std::vector<Node*>& nodes);
+
+    /**
+     * Finds the nodes whose model or terrain bounds intersect the given sphere.
+     *
+     * @param sphere The sphere to test, in world space.
+     * @param nodes The vector to append the intersecting nodes to.
+     *
+     * @return The number of nodes appended.
+     * @script{ignore}
+     */
+    unsigned int queryNodes(const BoundingSphere& sphere, std::vector<Node*>& nodes);
+
+    /**
+     * Finds the node whose model or terrain bounds are hit first by the given ray.
+     *
+     * The test is made against the bounding spheres of the nodes, so it is suited to coarse
+     * picking or to selecting the candidates for an exact test.
+     *
+     * @param ray The ray to test, in world space.
+     * @param distance Set to the distance along the ray of the hit, if not NULL.
+     *
+     * @return The closest node that is hit, or NULL if the ray does not hit any node.
+     * @script{ignore}
+     */
+    Node* pickNode(const Ray& ray, float* distance = NULL);
+
 private:
 
+    /**
+     * An entry of the ID index.
+     */
+    struct IndexedNode
+    {
+        Node* node;
+        unsigned int next;          // The next entry with the same ID, plus one.
+        unsigned int searchBegin;   // The first entry searched by node->findNode().
+        unsigned int searchEnd;     // One past the last entry searched by node->findNode().
+    };
+
     /**
      * Constructor.
      */
@@ -335,6 +434,68 @@ private:
      */
     inline void visitNode(Node* node, const char* visitMethod);
 
+    /**
+     * Tests the given node and all of its children recursively against a query volume,
+     * for queries made without the spatial index.
+     */
+    template <class T>
+    unsigned int queryHierarchy(Node* node, const T& volume, std::vector<Node*>& nodes);
+
+    /**
+     * Tests the given node and all of its children recursively against a ray,
+     * for picks made without the spatial index.
+     */
+    void pickHierarchy(Node* node, const Ray& ray, Node** closest, float* closestDistance);
+
+    /**
+     * Calls updateTransforms() on all scenes.
+     */
+    static void updateAllTransforms();
+
+    /**
+     * Removes a node that is being destroyed from the transform queue of its scene.
+     */
+    static void removeQueuedTransform(Node* node);
+
+    /**
+     * Rebuilds the ID index if any node IDs or hierarchies have changed since it was built.
+     *
+     * @return true if the index is up to date; false if the hierarchy should be searched instead.
+     */
+    bool updateNodeIndex() const;
+
+    /**
+     * Sorts the ID index by ID for prefix searches, if it has not been sorted since it was built.
+     */
+    void sortNodeIndex() const;
+
+    /**
+     * Adds the nodes searched by node->findNode() to the ID index, in the order they are searched.
+     */
+    void indexNodeSearch(Node* node, unsigned int entry) const;
+
+    /**
+     * Gets the range of ID index entries that are searched by node->findNode().
+     *
+     * @return true if the node is in the index; false otherwise.
+     */
+    bool getIndexedSearchRange(const Node* node, unsigned int* begin, unsigned int* end) const;
+
+    /**
+     * Finds the first node in the given range of ID index entries that matches the ID.
+     */
+    Node* findIndexedNode(const char* id, bool exactMatch, unsigned int begin, unsigned int end) const;
+
+    /**
+     * Finds all of the nodes in the given range of ID index entries that match the ID.
+     */
+    unsigned int findIndexedNodes(const char* id, std::vector<Node*>& nodes, bool exactMatch, unsigned int begin, unsigned int end) const;
+
+    /**
+     * Gets the first ID index entry for the given ID, plus one, or zero if there is none.
+     */
+    unsigned int findIndexedId(const char* id) const;
+
     std::string _id;
     Camera* _activeCamera;
     Node* _firstNode;
@@ -345,11 +506,21 @@ private:
     Vector3 _lightDirection;
     bool _bindAudioListenerToCamera;
     MeshBatch* _debugBatch;
+    SpatialIndex* _spatialIndex;
+    std::vector<Node*> _transformRoots;
+    std::vector<Node*> _transformNodes;
+    mutable std::vector<IndexedNode> _nodeIndex;
+    mutable std::vector<unsigned int> _nodeIndexBuckets;
+    mutable std::vector<std::pair<const char*, unsigned int> > _nodeIndexSorted;
+    mutable unsigned int _nodeIndexVersion;
+    mutable unsigned int _nodeIndexSearchVersion;
 };
 
 template <class T>
 void Scene::visit(T* instance, bool (T::*visitMethod)(Node*))
 {
+    GP_PROFILE_SCOPE("Scene::visit");
+
     for (Node* node = getFirstNode(); node != NULL; node = node->getNextSibling())
     {
         visitNode(node, instance, visitMethod);
@@ -360,6 +531,8 @@ void Scene::visit(T* instance, bool (T::*visitMethod)(Node*))
 template <class T, class C>
 void Scene::visit(T* instance, bool (T::*visitMethod)(Node*,C), C cookie)
 {
+    GP_PROFILE_SCOPE("Scene::visit");
+
     for (Node* node = getFirstNode(); node != NULL; node = node->getNextSibling())
     {
         visitNode(node, instance, visitMethod, cookie);
@@ -368,6 +541,8 @@ void Scene::visit(T* instance, bool (T::*visitMethod)(Node*,C), C cookie)
 
 inline void Scene::visit(const char* visitMethod)
 {
+    GP_PROFILE_SCOPE("Scene::visit");
+
     for (Node* node = getFirstNode(); node != NULL; node = node->getNextSibling())
     {
         visitNode(node, visitMethod);
@@ -12,6 +12,24 @@ namespace gameplay
 extern void calculateNamespacePath(const std::string& urlString, std::string& fileString, std::vector<std::string>& namespacePath);
 extern Properties* getPropertiesFromNamespacePath(Properties* properties, const std::vector<std::string>& namespacePath);
 
+SceneLoader::SceneLoader()
+    : _sceneFile(NULL), _sceneProperties(NULL)
+{
+}
+
+SceneLoader::~SceneLoader()
+{
+    // Clean up all loaded properties objects.
+    std::map<std::string, Properties*>::iterator iter = _propertiesFromFile.begin();
+    for (; iter != _propertiesFromFile.end(); ++iter)
+    {
+        SAFE_DELETE(iter->second);
+    }
+
+    // Clean up the .scene file's properties object.
+    SAFE_DELETE(_sceneFile);
+}
+
 Scene* SceneLoader::load(const char* url)
 {
     SceneLoader loader;
@@ -19,6 +37,14 @@ Scene* SceneLoader::load(const char* url)
 }
 
 Scene* SceneLoader::loadInternal(const char* url)
+{
+    if (!loadProperties(url))
+        return NULL;
+
+    return createScene();
+}
+
+bool SceneLoader::loadProperties(const char* url)
 {
     // Get the file part of the url that we are loading the scene from.
     std::string urlStr = url ? url : "";
@@ -26,31 +52,74 @@ Scene* SceneLoader::loadInternal(const char* url)
     splitURL(urlStr, &_path, &id);
 
     // Load the scene properties from file.
-    Properties* properties = Properties::create(url);
-    if (properties == NULL)
+    _sceneFile = Properties::create(url);
+    if (_sceneFile == NULL)
     {
         GP_ERROR("Failed to load scene file '%s'.", url);
-        return NULL;
+        return false;
     }
 
     // Check if the properties object is valid and has a valid namespace.
-    Properties* sceneProperties = (strlen(properties->getNamespace()) > 0) ? properties : properties->getNextNamespace();
-    if (!sceneProperties || !(strcmp(sceneProperties->getNamespace(), "scene") == 0))
+    _sceneProperties = (strlen(_sceneFile->getNamespace()) > 0) ? _sceneFile : _sceneFile->getNextNamespace();
+    if (!_sceneProperties || !(strcmp(_sceneProperties->getNamespace(), "scene") == 0))
     {
         GP_ERROR("Failed to load scene from properties object: must be non-null object and have namespace equal to 'scene'.");
-        SAFE_DELETE(properties);
-        return NULL;
+        return false;
     }
 
     // Get the path to the main GPB.
-    const char* path = sceneProperties->getString("path");
+    const char* path = _sceneProperties->getString("path");
     if (path)
         _gpbPath = path;
 
     // Build the node URL/property and animation reference tables and load the referenced files/store the inline properties objects.
-    buildReferenceTables(sceneProperties);
+    buildReferenceTables(_sceneProperties);
     loadReferencedFiles();
 
+    return true;
+}
+
+/**
+ * Adds the paths of the textures sampled in the properties object and its namespaces.
+ */
+static void getTexturePaths(Properties* properties, std::vector<std::string>* paths)
+{
+    // Iterate all of the namespaces, which leaves the namespace iterator rewound.
+    properties->rewind();
+    Properties* ns;
+    while ((ns = properties->getNextNamespace()))
+    {
+        if (strcmp(ns->getNamespace(), "sampler") == 0)
+        {
+            const char* path = ns->getString("path");
+            if (path && strlen(path) > 0 && std::find(paths->begin(), paths->end(), path) == paths->end())
+                paths->push_back(path);
+        }
+        else
+        {
+            getTexturePaths(ns, paths);
+        }
+    }
+}
+
+void SceneLoader::getTexturePaths(std::vector<std::string>* paths) const
+{
+    GP_ASSERT(paths);
+
+    if (_sceneFile)
+        gameplay::getTexturePaths(_sceneFile, paths);
+    for (std::map<std::string, Properties*>::const_iterator iter = _propertiesFromFile.begin(); iter != _propertiesFromFile.end(); ++iter)
+    {
+        if (iter->second)
+            gameplay::getTexturePaths(iter->second, paths);
+    }
+}
+
+Scene* SceneLoader::createScene()
+{
+    GP_ASSERT(_sceneProperties);
+    Properties* sceneProperties = _sceneProperties;
+
     // Load the main scene data from GPB and apply the global scene properties.
     Scene* scene = NULL;
     if (!_gpbPath.empty())
@@ -60,7 +129,6 @@ Scene* SceneLoader::loadInternal(const char* url)
         if (!scene)
         {
             GP_ERROR("Failed to load main scene from bundle.");
-            SAFE_DELETE(properties);
             return NULL;
         }
     }
@@ -136,16 +204,6 @@ Scene* SceneLoader::loadInternal(const char* url)
     if (physics)
         loadPhysics(physics, scene);
 
-    // Clean up all loaded properties objects.
-    std::map<std::string, Properties*>::iterator iter = _propertiesFromFile.begin();
-    for (; iter != _propertiesFromFile.end(); ++iter)
-    {
-        SAFE_DELETE(iter->second);
-    }
-
-    // Clean up the .scene file's properties object.
-    SAFE_DELETE(properties);
-
     return scene;
 }
 
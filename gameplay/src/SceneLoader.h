@@ -17,9 +17,20 @@ namespace gameplay
 class SceneLoader
 {
     friend class Scene;
+    friend class ResourceRequest;
 
 private:
 
+    /**
+     * Constructor.
+     */
+    SceneLoader();
+
+    /**
+     * Destructor.
+     */
+    ~SceneLoader();
+
     /**
      * Loads a scene using the data from the Properties object defined at the specified URL, 
      * where the URL is of the format "<file-path>.<extension>#<namespace-id>/<namespace-id>/.../<namespace-id>"
@@ -78,6 +89,30 @@ private:
 
     Scene* loadInternal(const char* url);
 
+    /**
+     * Parses the scene file at the specified URL and the property files that it references.
+     * This does not create any game objects, so it can be called from any thread.
+     *
+     * @param url The URL pointing to the Properties object defining the scene.
+     *
+     * @return true if the scene file was parsed; false otherwise.
+     */
+    bool loadProperties(const char* url);
+
+    /**
+     * Creates the scene from the properties parsed by loadProperties().
+     *
+     * @return The new scene, or NULL if it could not be created.
+     */
+    Scene* createScene();
+
+    /**
+     * Gets the paths of the textures sampled by the materials parsed by loadProperties().
+     *
+     * @param paths The vector to add the paths to.
+     */
+    void getTexturePaths(std::vector<std::string>* paths) const;
+
     void addSceneAnimation(const char* animationID, const char* targetID, const char* url);
 
     void addSceneNodeProperty(SceneNode& sceneNode, SceneNodeProperty::Type type, const char* url = NULL, int index = 0);
@@ -108,6 +143,8 @@ private:
 
     PhysicsConstraint* loadSpringConstraint(const Properties* constraint, PhysicsRigidBody* rbA, PhysicsRigidBody* rbB);
 
+    Properties* _sceneFile;                                      // The properties object of the .scene file.
+    Properties* _sceneProperties;                                // The 'scene' namespace of the .scene file.
     std::map<std::string, Properties*> _propertiesFromFile;      // Holds the properties object for a given file.
     std::map<std::string, Properties*> _properties;              // Holds the properties object for a given URL.
     std::vector<SceneAnimation> _animations;                     // Holds the animations declared in the .scene file.
@@ -1,6 +1,8 @@
 #include "Base.h"
 #include "FileSystem.h"
 #include "ScriptController.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 
 #ifndef NO_LUA_BINDINGS
 #include "lua/lua_all_bindings.h"
@@ -313,6 +315,34 @@ ScriptUtil::LuaArray<double> ScriptUtil::getDoublePointer(int index)
     GENERATE_LUA_GET_POINTER(double, (double)luaL_checknumber);
 }
 
+unsigned int ScriptUtil::getArrayLength(int index)
+{
+    ScriptController* sc = Game::getInstance()->getScriptController();
+    switch (lua_type(sc->_lua, index))
+    {
+    case LUA_TTABLE:
+        return (unsigned int)lua_rawlen(sc->_lua, index);
+    case LUA_TNIL:
+        return 0;
+    default:
+        return 1;
+    }
+}
+
+void ScriptUtil::setBoolArray(int index, const LuaArray<bool>& values, unsigned int count)
+{
+    ScriptController* sc = Game::getInstance()->getScriptController();
+    if (!lua_istable(sc->_lua, index))
+        return;
+
+    const bool* data = values;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        lua_pushboolean(sc->_lua, data[i]);
+        lua_rawseti(sc->_lua, index, i + 1);
+    }
+}
+
 const char* ScriptUtil::getString(int index, bool isStdString)
 {
     if (lua_type(Game::getInstance()->getScriptController()->_lua, index) == LUA_TSTRING)
@@ -340,6 +370,9 @@ bool ScriptUtil::luaCheckBool(lua_State* state, int n)
 
 void ScriptController::loadScript(const char* path, bool forceReload)
 {
+    GP_PROFILE_SCOPE("ScriptController::loadScript");
+    GP_MEMORY_SCOPE(CATEGORY_SCRIPT);
+
     std::set<std::string>::iterator iter = _loadedScripts.find(path);
     if (iter == _loadedScripts.end() || forceReload)
     {
@@ -599,7 +632,9 @@ static const char* lua_dofile_function =
 
 void ScriptController::initialize()
 {
-    _lua = luaL_newstate();
+    _lua = lua_newstate(allocate, NULL);
+    if (_lua)
+        lua_atpanic(_lua, panic);
     if (!_lua)
         GP_ERROR("Failed to initialize Lua scripting engine.");
     luaL_openlibs(_lua);
@@ -621,6 +656,33 @@ void ScriptController::initialize()
 #endif
 }
 
+void* ScriptController::allocate(void*, void* ptr, size_t oldSize, size_t newSize)
+{
+    // Lua passes the size of the block in oldSize when ptr is not NULL.
+    if (newSize == 0)
+    {
+        if (ptr)
+            MemoryTracker::trackFree(MemoryTracker::CATEGORY_SCRIPT, oldSize);
+        free(ptr);
+        return NULL;
+    }
+
+    void* p = realloc(ptr, newSize);
+    if (p)
+    {
+        if (ptr)
+            MemoryTracker::trackFree(MemoryTracker::CATEGORY_SCRIPT, oldSize);
+        MemoryTracker::trackAllocation(MemoryTracker::CATEGORY_SCRIPT, newSize);
+    }
+    return p;
+}
+
+int ScriptController::panic(lua_State* state)
+{
+    GP_ERROR("Unprotected error in call to the Lua API (%s).", lua_tostring(state, -1));
+    return 0;
+}
+
 void ScriptController::initializeGame()
 {
     if (_callbacks[INITIALIZE])
@@ -665,6 +727,8 @@ void ScriptController::finalizeGame()
 
 void ScriptController::update(float elapsedTime)
 {
+    GP_PROFILE_SCOPE("ScriptController::update");
+
     if (_callbacks[UPDATE])
     {
         executeFunction<void>(_callbacks[UPDATE]->c_str(), "f", elapsedTime);
@@ -673,6 +737,8 @@ void ScriptController::update(float elapsedTime)
 
 void ScriptController::render(float elapsedTime)
 {
+    GP_PROFILE_SCOPE("ScriptController::render");
+
     if (_callbacks[RENDER])
     {
         executeFunction<void>(_callbacks[RENDER]->c_str(), "f", elapsedTime);
@@ -723,6 +789,10 @@ void ScriptController::executeFunctionHelper(int resultCount, const char* func,
         return;
     }
 
+    // Function names are usually built at runtime, so the profiler keeps a copy.
+    Profiler::Scope scope(func, true);
+    GP_MEMORY_SCOPE(CATEGORY_SCRIPT);
+
     const char* sig = args;
 
     int argumentCount = 0;
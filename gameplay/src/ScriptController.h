@@ -314,6 +314,45 @@ LuaArray<double> getDoublePointer(int index);
 template <typename T>
 LuaArray<T> getObjectPointer(int index, const char* type, bool nonNull, bool* success);
 
+/**
+ * Gets the number of elements of an array parameter for the given stack index: the length
+ * of a table, zero for nil and one for a single value.
+ * 
+ * @param index The stack index.
+ * 
+ * @return The number of elements.
+ * 
+ * @script{ignore}
+ */
+unsigned int getArrayLength(int index);
+
+/**
+ * Copies the objects of an array retrieved with getObjectPointer() back into the table at the
+ * given stack index, for array parameters that a function writes to. Does nothing if the
+ * parameter is not a table, since single objects are written to in place.
+ * 
+ * @param index The stack index.
+ * @param values The array.
+ * @param count The number of objects to copy.
+ * 
+ * @script{ignore}
+ */
+template <typename T>
+void setObjectArray(int index, const LuaArray<T>& values, unsigned int count);
+
+/**
+ * Copies the bools of an array retrieved with getBoolPointer() back into the table at the
+ * given stack index, for array parameters that a function writes to. Does nothing if the
+ * parameter is not a table.
+ * 
+ * @param index The stack index.
+ * @param values The array.
+ * @param count The number of bools to copy.
+ * 
+ * @script{ignore}
+ */
+void setBoolArray(int index, const LuaArray<bool>& values, unsigned int count);
+
 /**
  * Gets a string for the given stack index.
  * 
@@ -753,6 +792,17 @@ private:
      */
     ScriptController();
 
+    /**
+     * Allocates, reallocates and frees the memory of the Lua state (see lua_Alloc), counting it
+     * against MemoryTracker::CATEGORY_SCRIPT since Lua does not use the global new operator.
+     */
+    static void* allocate(void* userData, void* ptr, size_t oldSize, size_t newSize);
+
+    /**
+     * Reports an error raised outside of a protected Lua call, as the default panic function does.
+     */
+    static int panic(lua_State* state);
+
     /**
      * Copy constructor.
      */
@@ -905,6 +955,9 @@ private:
     friend ScriptUtil::LuaArray<float> ScriptUtil::getFloatPointer(int index);
     friend ScriptUtil::LuaArray<double> ScriptUtil::getDoublePointer(int index);
     template<typename T> friend ScriptUtil::LuaArray<T> ScriptUtil::getObjectPointer(int index, const char* type, bool nonNull, bool* success);
+    friend unsigned int ScriptUtil::getArrayLength(int index);
+    template<typename T> friend void ScriptUtil::setObjectArray(int index, const ScriptUtil::LuaArray<T>& values, unsigned int count);
+    friend void ScriptUtil::setBoolArray(int index, const ScriptUtil::LuaArray<bool>& values, unsigned int count);
     friend const char* ScriptUtil::getString(int index, bool isStdString);
 
     lua_State* _lua;
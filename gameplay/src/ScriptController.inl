@@ -269,6 +269,25 @@ ScriptUtil::LuaArray<T> ScriptUtil::getObjectPointer(int index, const char* type
     return LuaArray<T>((T*)NULL);
 }
 
+template<typename T>
+void ScriptUtil::setObjectArray(int index, const LuaArray<T>& values, unsigned int count)
+{
+    ScriptController* sc = Game::getInstance()->getScriptController();
+    if (!lua_istable(sc->_lua, index))
+        return;
+
+    // Copy the memory directly, like LuaArray::set() does when the array is retrieved.
+    const T* data = values;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        lua_rawgeti(sc->_lua, index, i + 1);
+        ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)lua_touserdata(sc->_lua, -1);
+        if (object && object->instance)
+            memcpy(object->instance, (const void*)&data[i], sizeof(T));
+        lua_pop(sc->_lua, 1);
+    }
+}
+
 template<typename T> T ScriptController::executeFunction(const char* func)
 {
     executeFunctionHelper(1, func, NULL, NULL);
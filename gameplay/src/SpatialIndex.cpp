@@ -0,0 +1,585 @@
+#include "Base.h"
+#include "SpatialIndex.h"
+#include "Node.h"
+#include "Scene.h"
+
+#define NULL_TREE_NODE -1
+
+// The fraction of a node's bounding radius that its leaf box is enlarged by on each side.
+#define LEAF_MARGIN 0.25f
+
+namespace gameplay
+{
+
+// The number of spatial indexes in existence.
+static unsigned int __spatialIndexCount = 0;
+
+static float surfaceArea(const BoundingBox& box)
+{
+    float x = box.max.x - box.min.x;
+    float y = box.max.y - box.min.y;
+    float z = box.max.z - box.min.z;
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+static BoundingBox combine(const BoundingBox& a, const BoundingBox& b)
+{
+    BoundingBox box(a);
+    box.merge(b);
+    return box;
+}
+
+static bool contains(const BoundingBox& outer, const BoundingBox& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+           outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+static BoundingBox sphereBox(const BoundingSphere& sphere, float margin)
+{
+    float r = sphere.radius + margin;
+    return BoundingBox(sphere.center.x - r, sphere.center.y - r, sphere.center.z - r,
+                       sphere.center.x + r, sphere.center.y + r, sphere.center.z + r);
+}
+
+SpatialIndex::SpatialIndex(Scene* scene)
+    : _scene(scene), _root(NULL_TREE_NODE), _freeList(NULL_TREE_NODE), _leafCount(0)
+{
+    ++__spatialIndexCount;
+}
+
+SpatialIndex::~SpatialIndex()
+{
+    // Detach the nodes that still refer to the index.
+    for (size_t i = 0, count = _tree.size(); i < count; ++i)
+    {
+        Node* node = _tree[i].node;
+        if (node)
+        {
+            node->_spatialIndex = NULL;
+            node->_spatialProxy = NULL_TREE_NODE;
+        }
+    }
+    for (size_t i = 0, count = _dirtyNodes.size(); i < count; ++i)
+    {
+        _dirtyNodes[i]->_spatialIndex = NULL;
+        _dirtyNodes[i]->_spatialDirty = false;
+    }
+
+    --__spatialIndexCount;
+}
+
+bool SpatialIndex::isActive()
+{
+    return __spatialIndexCount > 0;
+}
+
+unsigned int SpatialIndex::getNodeCount() const
+{
+    return _leafCount;
+}
+
+unsigned int SpatialIndex::getHeight() const
+{
+    return _root == NULL_TREE_NODE ? 0 : (unsigned int)_tree[_root].height + 1;
+}
+
+void SpatialIndex::setDirty(Node* node)
+{
+    GP_ASSERT(node);
+    GP_ASSERT(node->_spatialIndex == NULL || node->_spatialIndex == this);
+
+    if (!node->_spatialDirty)
+    {
+        node->_spatialIndex = this;
+        node->_spatialDirty = true;
+        _dirtyNodes.push_back(node);
+    }
+}
+
+void SpatialIndex::addHierarchy(Node* node)
+{
+    setDirty(node);
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        addHierarchy(child);
+    }
+}
+
+void SpatialIndex::removeHierarchy(Node* node)
+{
+    removeNode(node);
+    for (Node* child = node->getFirstChild(); child != NULL; child = child->getNextSibling())
+    {
+        removeHierarchy(child);
+    }
+}
+
+void SpatialIndex::removeNode(Node* node)
+{
+    GP_ASSERT(node);
+
+    if (node->_spatialIndex != this)
+        return;
+
+    if (node->_spatialProxy != NULL_TREE_NODE)
+    {
+        removeLeaf(node->_spatialProxy);
+        freeTreeNode(node->_spatialProxy);
+        node->_spatialProxy = NULL_TREE_NODE;
+        --_leafCount;
+    }
+    if (node->_spatialDirty)
+    {
+        std::vector<Node*>::iterator itr = std::find(_dirtyNodes.begin(), _dirtyNodes.end(), node);
+        GP_ASSERT(itr != _dirtyNodes.end());
+        _dirtyNodes.erase(itr);
+        node->_spatialDirty = false;
+    }
+    node->_spatialIndex = NULL;
+}
+
+void SpatialIndex::update()
+{
+    for (size_t i = 0, count = _dirtyNodes.size(); i < count; ++i)
+    {
+        Node* node = _dirtyNodes[i];
+        node->_spatialDirty = false;
+
+        BoundingSphere sphere;
+        if (node->getScene() != _scene || !node->getContentBounds(&sphere))
+        {
+            // The node has left the scene or has nothing to bound, so it is no longer indexed.
+            if (node->_spatialProxy != NULL_TREE_NODE)
+            {
+                removeLeaf(node->_spatialProxy);
+                freeTreeNode(node->_spatialProxy);
+                node->_spatialProxy = NULL_TREE_NODE;
+                --_leafCount;
+            }
+            node->_spatialIndex = NULL;
+            continue;
+        }
+
+        int leaf = node->_spatialProxy;
+        BoundingBox box = sphereBox(sphere, 0);
+        if (leaf == NULL_TREE_NODE)
+        {
+            leaf = allocateTreeNode();
+            _tree[leaf].node = node;
+            _tree[leaf].box.set(sphereBox(sphere, sphere.radius * LEAF_MARGIN));
+            insertLeaf(leaf);
+            node->_spatialProxy = leaf;
+            ++_leafCount;
+        }
+        else if (!contains(_tree[leaf].box, box))
+        {
+            // The node has moved out of its enlarged box, so reinsert it.
+            removeLeaf(leaf);
+            _tree[leaf].box.set(sphereBox(sphere, sphere.radius * LEAF_MARGIN));
+            insertLeaf(leaf);
+        }
+        _tree[leaf].sphere.set(sphere);
+    }
+    _dirtyNodes.clear();
+}
+
+unsigned int SpatialIndex::query(const Frustum& frustum, std::vector<Node*>& nodes)
+{
+    update();
+
+    unsigned int count = 0;
+    if (_root == NULL_TREE_NODE)
+        return count;
+
+    _stack.push_back(_root);
+    while (!_stack.empty())
+    {
+        const TreeNode& treeNode = _tree[_stack.back()];
+        _stack.pop_back();
+
+        if (!frustum.intersects(treeNode.box))
+            continue;
+
+        if (treeNode.node)
+        {
+            if (frustum.intersects(treeNode.sphere))
+            {
+                nodes.push_back(treeNode.node);
+                ++count;
+            }
+        }
+        else
+        {
+            _stack.push_back(treeNode.child1);
+            _stack.push_back(treeNode.child2);
+        }
+    }
+    return count;
+}
+
+unsigned int SpatialIndex::query(const BoundingBox& box, std::vector<Node*>& nodes)
+{
+    update();
+
+    unsigned int count = 0;
+    if (_root == NULL_TREE_NODE)
+        return count;
+
+    _stack.push_back(_root);
+    while (!_stack.empty())
+    {
+        const TreeNode& treeNode = _tree[_stack.back()];
+        _stack.pop_back();
+
+        if (!box.intersects(treeNode.box))
+            continue;
+
+        if (treeNode.node)
+        {
+            if (treeNode.sphere.intersects(box))
+            {
+                nodes.push_back(treeNode.node);
+                ++count;
+            }
+        }
+        else
+        {
+            _stack.push_back(treeNode.child1);
+            _stack.push_back(treeNode.child2);
+        }
+    }
+    return count;
+}
+
+unsigned int SpatialIndex::query(const BoundingSphere& sphere, std::vector<Node*>& nodes)
+{
+    update();
+
+    unsigned int count = 0;
+    if (_root == NULL_TREE_NODE)
+        return count;
+
+    _stack.push_back(_root);
+    while (!_stack.empty())
+    {
+        const TreeNode& treeNode = _tree[_stack.back()];
+        _stack.pop_back();
+
+        if (!sphere.intersects(treeNode.box))
+            continue;
+
+        if (treeNode.node)
+        {
+            if (sphere.intersects(treeNode.sphere))
+            {
+                nodes.push_back(treeNode.node);
+                ++count;
+            }
+        }
+        else
+        {
+            _stack.push_back(treeNode.child1);
+            _stack.push_back(treeNode.child2);
+        }
+    }
+    return count;
+}
+
+Node* SpatialIndex::pick(const Ray& ray, float* distance)
+{
+    update();
+
+    Node* closest = NULL;
+    float closestDistance = 0;
+    if (_root == NULL_TREE_NODE)
+        return closest;
+
+    _stack.push_back(_root);
+    while (!_stack.empty())
+    {
+        const TreeNode& treeNode = _tree[_stack.back()];
+        _stack.pop_back();
+
+        // Skip branches that are missed or that start beyond the closest hit so far.
+        float d = ray.intersects(treeNode.box);
+        if (d == Ray::INTERSECTS_NONE || (closest && d > closestDistance))
+            continue;
+
+        if (treeNode.node)
+        {
+            d = ray.intersects(treeNode.sphere);
+            if (d != Ray::INTERSECTS_NONE && (!closest || d < closestDistance))
+            {
+                closest = treeNode.node;
+                closestDistance = d;
+            }
+        }
+        else
+        {
+            _stack.push_back(treeNode.child1);
+            _stack.push_back(treeNode.child2);
+        }
+    }
+
+    if (closest && distance)
+        *distance = closestDistance;
+    return closest;
+}
+
+int SpatialIndex::allocateTreeNode()
+{
+    int index;
+    if (_freeList != NULL_TREE_NODE)
+    {
+        index = _freeList;
+        _freeList = _tree[index].parent;
+    }
+    else
+    {
+        index = (int)_tree.size();
+        _tree.push_back(TreeNode());
+    }
+
+    TreeNode& treeNode = _tree[index];
+    treeNode.node = NULL;
+    treeNode.parent = NULL_TREE_NODE;
+    treeNode.child1 = NULL_TREE_NODE;
+    treeNode.child2 = NULL_TREE_NODE;
+    treeNode.height = 0;
+    return index;
+}
+
+void SpatialIndex::freeTreeNode(int index)
+{
+    TreeNode& treeNode = _tree[index];
+    treeNode.node = NULL;
+    treeNode.parent = _freeList;
+    treeNode.height = -1;
+    _freeList = index;
+}
+
+void SpatialIndex::insertLeaf(int leaf)
+{
+    if (_root == NULL_TREE_NODE)
+    {
+        _root = leaf;
+        _tree[leaf].parent = NULL_TREE_NODE;
+        return;
+    }
+
+    // Descend to the sibling for which the total surface area of the tree grows the least.
+    BoundingBox leafBox = _tree[leaf].box;
+    int index = _root;
+    while (_tree[index].node == NULL)
+    {
+        const TreeNode& treeNode = _tree[index];
+        float area = surfaceArea(treeNode.box);
+        float combinedArea = surfaceArea(combine(treeNode.box, leafBox));
+
+        // The cost of creating a new parent for this tree node and the leaf, and the
+        // minimum cost of pushing the leaf further down the tree.
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float cost1 = surfaceArea(combine(_tree[treeNode.child1].box, leafBox)) + inheritanceCost;
+        if (_tree[treeNode.child1].node == NULL)
+            cost1 -= surfaceArea(_tree[treeNode.child1].box);
+        float cost2 = surfaceArea(combine(_tree[treeNode.child2].box, leafBox)) + inheritanceCost;
+        if (_tree[treeNode.child2].node == NULL)
+            cost2 -= surfaceArea(_tree[treeNode.child2].box);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? treeNode.child1 : treeNode.child2;
+    }
+    int sibling = index;
+
+    // Create a new parent for the sibling and the leaf.
+    int newParent = allocateTreeNode();
+    int oldParent = _tree[sibling].parent;
+    _tree[newParent].parent = oldParent;
+    _tree[newParent].box.set(combine(leafBox, _tree[sibling].box));
+    _tree[newParent].height = _tree[sibling].height + 1;
+    _tree[newParent].child1 = sibling;
+    _tree[newParent].child2 = leaf;
+    _tree[sibling].parent = newParent;
+    _tree[leaf].parent = newParent;
+
+    if (oldParent != NULL_TREE_NODE)
+    {
+        if (_tree[oldParent].child1 == sibling)
+            _tree[oldParent].child1 = newParent;
+        else
+            _tree[oldParent].child2 = newParent;
+    }
+    else
+    {
+        _root = newParent;
+    }
+
+    // Walk back up the tree, refitting and rebalancing the ancestors.
+    index = _tree[leaf].parent;
+    while (index != NULL_TREE_NODE)
+    {
+        index = balance(index);
+
+        TreeNode& treeNode = _tree[index];
+        treeNode.height = 1 + std::max(_tree[treeNode.child1].height, _tree[treeNode.child2].height);
+        treeNode.box.set(combine(_tree[treeNode.child1].box, _tree[treeNode.child2].box));
+
+        index = treeNode.parent;
+    }
+}
+
+void SpatialIndex::removeLeaf(int leaf)
+{
+    if (leaf == _root)
+    {
+        _root = NULL_TREE_NODE;
+        return;
+    }
+
+    int parent = _tree[leaf].parent;
+    int grandParent = _tree[parent].parent;
+    int sibling = _tree[parent].child1 == leaf ? _tree[parent].child2 : _tree[parent].child1;
+
+    if (grandParent != NULL_TREE_NODE)
+    {
+        // Replace the parent with the sibling and refit the ancestors.
+        if (_tree[grandParent].child1 == parent)
+            _tree[grandParent].child1 = sibling;
+        else
+            _tree[grandParent].child2 = sibling;
+        _tree[sibling].parent = grandParent;
+        freeTreeNode(parent);
+
+        int index = grandParent;
+        while (index != NULL_TREE_NODE)
+        {
+            index = balance(index);
+
+            TreeNode& treeNode = _tree[index];
+            treeNode.height = 1 + std::max(_tree[treeNode.child1].height, _tree[treeNode.child2].height);
+            treeNode.box.set(combine(_tree[treeNode.child1].box, _tree[treeNode.child2].box));
+
+            index = treeNode.parent;
+        }
+    }
+    else
+    {
+        _root = sibling;
+        _tree[sibling].parent = NULL_TREE_NODE;
+        freeTreeNode(parent);
+    }
+}
+
+int SpatialIndex::balance(int iA)
+{
+    TreeNode& a = _tree[iA];
+    if (a.node || a.height < 2)
+        return iA;
+
+    int iB = a.child1;
+    int iC = a.child2;
+    TreeNode& b = _tree[iB];
+    TreeNode& c = _tree[iC];
+    int balance = c.height - b.height;
+
+    if (balance > 1)
+    {
+        // Rotate C up.
+        int iF = c.child1;
+        int iG = c.child2;
+        TreeNode& f = _tree[iF];
+        TreeNode& g = _tree[iG];
+
+        c.child1 = iA;
+        c.parent = a.parent;
+        a.parent = iC;
+        if (c.parent != NULL_TREE_NODE)
+        {
+            if (_tree[c.parent].child1 == iA)
+                _tree[c.parent].child1 = iC;
+            else
+                _tree[c.parent].child2 = iC;
+        }
+        else
+        {
+            _root = iC;
+        }
+
+        if (f.height > g.height)
+        {
+            c.child2 = iF;
+            a.child2 = iG;
+            g.parent = iA;
+            a.box.set(combine(b.box, g.box));
+            c.box.set(combine(a.box, f.box));
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        }
+        else
+        {
+            c.child2 = iG;
+            a.child2 = iF;
+            f.parent = iA;
+            a.box.set(combine(b.box, f.box));
+            c.box.set(combine(a.box, g.box));
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return iC;
+    }
+
+    if (balance < -1)
+    {
+        // Rotate B up.
+        int iD = b.child1;
+        int iE = b.child2;
+        TreeNode& d = _tree[iD];
+        TreeNode& e = _tree[iE];
+
+        b.child1 = iA;
+        b.parent = a.parent;
+        a.parent = iB;
+        if (b.parent != NULL_TREE_NODE)
+        {
+            if (_tree[b.parent].child1 == iA)
+                _tree[b.parent].child1 = iB;
+            else
+                _tree[b.parent].child2 = iB;
+        }
+        else
+        {
+            _root = iB;
+        }
+
+        if (d.height > e.height)
+        {
+            b.child2 = iD;
+            a.child1 = iE;
+            e.parent = iA;
+            a.box.set(combine(c.box, e.box));
+            b.box.set(combine(a.box, d.box));
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        }
+        else
+        {
+            b.child2 = iE;
+            a.child1 = iD;
+            d.parent = iA;
+            a.box.set(combine(c.box, d.box));
+            b.box.set(combine(a.box, e.box));
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+}
@@ -0,0 +1,178 @@
+#ifndef SPATIALINDEX_H_
+#define SPATIALINDEX_H_
+
+#include "BoundingBox.h"
+#include "BoundingSphere.h"
+#include "Frustum.h"
+#include "Ray.h"
+
+namespace gameplay
+{
+
+class Node;
+class Scene;
+
+/**
+ * Defines a dynamic bounding volume hierarchy over the nodes of a scene.
+ *
+ * The hierarchy is a binary tree of axis-aligned boxes whose leaves are the nodes that have
+ * content with bounds (a model with a mesh or a terrain). Leaf boxes are enlarged by a margin,
+ * so a node that moves by a small amount does not have to be reinserted, and the tree is kept
+ * balanced with tree rotations as leaves are inserted and removed.
+ *
+ * Nodes notify the index when their transform or bounds change and are then only marked as
+ * dirty; the dirty nodes are refitted in one pass before the next query. Queries visit only the
+ * branches that overlap the query volume, so their cost grows logarithmically with the number
+ * of nodes in the scene rather than linearly.
+ *
+ * The index is created and owned by a Scene and is enabled with Scene::setSpatialIndexEnabled().
+ *
+ * @script{ignore}
+ */
+class SpatialIndex
+{
+    friend class Scene;
+    friend class Node;
+
+public:
+
+    /**
+     * Gets the number of nodes in the index.
+     *
+     * @return The number of nodes in the index.
+     */
+    unsigned int getNodeCount() const;
+
+    /**
+     * Gets the height of the tree, which is a measure of how well it is balanced.
+     *
+     * @return The height of the tree, or zero if it is empty.
+     */
+    unsigned int getHeight() const;
+
+private:
+
+    /**
+     * A node of the tree. Free tree nodes are linked through their parent index.
+     */
+    struct TreeNode
+    {
+        BoundingBox box;
+        BoundingSphere sphere;
+        Node* node;
+        int parent;
+        int child1;
+        int child2;
+        int height;
+    };
+
+    /**
+     * Constructor.
+     */
+    SpatialIndex(Scene* scene);
+
+    /**
+     * Hidden copy constructor.
+     */
+    SpatialIndex(const SpatialIndex& copy);
+
+    /**
+     * Destructor.
+     */
+    ~SpatialIndex();
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    SpatialIndex& operator=(const SpatialIndex&);
+
+    /**
+     * Determines if there are any spatial indexes in existence, so that nodes that are not
+     * in the index can skip looking up their scene when their transform changes.
+     */
+    static bool isActive();
+
+    /**
+     * Marks a node as needing its bounds to be refitted before the next query.
+     */
+    void setDirty(Node* node);
+
+    /**
+     * Marks a node and all of its descendants as dirty.
+     */
+    void addHierarchy(Node* node);
+
+    /**
+     * Removes a node and all of its descendants from the index.
+     */
+    void removeHierarchy(Node* node);
+
+    /**
+     * Removes a single node from the index.
+     */
+    void removeNode(Node* node);
+
+    /**
+     * Refits the dirty nodes.
+     */
+    void update();
+
+    /**
+     * Adds the nodes whose bounds intersect the frustum to the list.
+     */
+    unsigned int query(const Frustum& frustum, std::vector<Node*>& nodes);
+
+    /**
+     * Adds the nodes whose bounds intersect the box to the list.
+     */
+    unsigned int query(const BoundingBox& box, std::vector<Node*>& nodes);
+
+    /**
+     * Adds the nodes whose bounds intersect the sphere to the list.
+     */
+    unsigned int query(const BoundingSphere& sphere, std::vector<Node*>& nodes);
+
+    /**
+     * Finds the node whose bounds are hit first by the ray.
+     */
+    Node* pick(const Ray& ray, float* distance);
+
+    /**
+     * Takes a tree node from the free list, growing the tree storage if needed.
+     */
+    int allocateTreeNode();
+
+    /**
+     * Returns a tree node to the free list.
+     */
+    void freeTreeNode(int index);
+
+    /**
+     * Inserts a leaf into the tree next to the sibling that enlarges the tree the least.
+     */
+    void insertLeaf(int leaf);
+
+    /**
+     * Removes a leaf from the tree, without freeing it.
+     */
+    void removeLeaf(int leaf);
+
+    /**
+     * Rotates the subtree at the given tree node if it is imbalanced.
+     *
+     * @return The tree node that is now at the root of the subtree.
+     */
+    int balance(int index);
+
+    Scene* _scene;                      // The scene that owns the index.
+    std::vector<TreeNode> _tree;        // The storage of the tree nodes.
+    int _root;                          // The root tree node, or -1 when the tree is empty.
+    int _freeList;                      // The first free tree node, or -1.
+    unsigned int _leafCount;            // The number of leaves in the tree.
+    std::vector<Node*> _dirtyNodes;     // The nodes to refit before the next query.
+    std::vector<int> _stack;            // The traversal stack used by queries.
+};
+
+}
+
+#endif
@@ -143,6 +143,15 @@ void SpriteBatch::start()
     _batch->start();
 }
 
+void SpriteBatch::reserve(unsigned int spriteCount)
+{
+    // Each sprite adds four vertices to the triangle strip, and six indices including
+    // the degenerate triangle that connects it to the previous sprite.
+    unsigned int capacity = spriteCount * 6;
+    if (_batch->getCapacity() < capacity)
+        _batch->setCapacity(capacity);
+}
+
 void SpriteBatch::draw(const Rectangle& dst, const Rectangle& src, const Vector4& color)
 {
     // Calculate uvs.
@@ -214,15 +223,15 @@ void SpriteBatch::draw(float x, float y, float z, float width, float height, flo
     downRight.rotate(pivotPoint, rotationAngle);
 
     // Write sprite vertex data.
-    static SpriteVertex v[4];
+    SpriteVertex v[4];
     SPRITE_ADD_VERTEX(v[0], downLeft.x, downLeft.y, z, u1, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[1], upLeft.x, upLeft.y, z, u1, v2, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[2], downRight.x, downRight.y, z, u2, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[3], upRight.x, upRight.y, z, u2, v2, color.x, color.y, color.z, color.w);
     
-    static unsigned short indices[4] = { 0, 1, 2, 3 };
+    static const unsigned short indices[4] = { 0, 1, 2, 3 };
 
-    _batch->add(v, 4, indices, 4);
+    _batch->add(v, 4, const_cast<unsigned short*>(indices), 4);
 }
 
 void SpriteBatch::draw(const Vector3& position, const Vector3& right, const Vector3& forward, float width, float height,
@@ -258,9 +267,9 @@ void SpriteBatch::draw(const Vector3& position, const Vector3& right, const Vect
     rp += tForward;
 
     // Rotate all points the specified amount about the given point (about the up vector).
-    static Vector3 u;
+    Vector3 u;
     Vector3::cross(right, forward, &u);
-    static Matrix rotation;
+    Matrix rotation;
     Matrix::createRotation(u, rotationAngle, &rotation);
 
     p0 -= rp;
@@ -280,7 +289,7 @@ void SpriteBatch::draw(const Vector3& position, const Vector3& right, const Vect
     p3 += rp;
 
     // Add the sprite vertex data to the batch.
-    static SpriteVertex v[4];
+    SpriteVertex v[4];
     SPRITE_ADD_VERTEX(v[0], p0.x, p0.y, p0.z, u1, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[1], p1.x, p1.y, p1.z, u2, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[2], p2.x, p2.y, p2.z, u1, v2, color.x, color.y, color.z, color.w);
@@ -350,15 +359,15 @@ void SpriteBatch::draw(float x, float y, float z, float width, float height, flo
     // Write sprite vertex data.
     const float x2 = x + width;
     const float y2 = y + height;
-    static SpriteVertex v[4];
+    SpriteVertex v[4];
     SPRITE_ADD_VERTEX(v[0], x, y, z, u1, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[1], x, y2, z, u1, v2, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[2], x2, y, z, u2, v1, color.x, color.y, color.z, color.w);
     SPRITE_ADD_VERTEX(v[3], x2, y2, z, u2, v2, color.x, color.y, color.z, color.w);
 
-    static unsigned short indices[4] = { 0, 1, 2, 3 };
+    static const unsigned short indices[4] = { 0, 1, 2, 3 };
 
-    _batch->add(v, 4, indices, 4);
+    _batch->add(v, 4, const_cast<unsigned short*>(indices), 4);
 }
 
 void SpriteBatch::finish()
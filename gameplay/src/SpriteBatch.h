@@ -96,6 +96,20 @@ public:
      */
     void start();
 
+    /**
+     * Grows the batch so that it can hold the specified number of sprites without growing
+     * while they are drawn.
+     *
+     * Growing the batch recreates its buffers and vertex attribute bindings, which must
+     * happen on the rendering thread. Reserving room there first allows the sprites to be
+     * drawn into the batch from another thread, as long as finish() is then called on the
+     * rendering thread.
+     *
+     * @param spriteCount The number of sprites that will be drawn into the batch.
+     * @script{ignore}
+     */
+    void reserve(unsigned int spriteCount);
+
     /**
      * Draws a single sprite.
      * 
@@ -155,6 +155,21 @@ public:
      */
     virtual bool rewind() = 0;
 
+    /**
+     * Gets a pointer to the next <code>size</code> bytes of the stream and advances the file pointer past them.
+     *
+     * This is only supported by streams whose contents are directly addressable in memory, such as
+     * memory mapped files, and lets large blocks of data be used without copying them first.
+     * The returned data is read-only and remains valid until the stream is closed.
+     *
+     * @param size The number of bytes to map.
+     *
+     * @return A pointer to the data, or NULL if the stream cannot be mapped or fewer than
+     *         <code>size</code> bytes remain (in which case the file pointer is not moved).
+     * @script{ignore}
+     */
+    virtual const void* map(size_t) { return NULL; }
+
 protected:
     Stream() {};
 private:
@@ -2,6 +2,8 @@
 #include "Terrain.h"
 #include "TerrainPatch.h"
 #include "Node.h"
+#include "Scene.h"
+#include "Game.h"
 #include "FileSystem.h"
 
 namespace gameplay
@@ -25,11 +27,25 @@ namespace gameplay
 #define TERRAIN_DIRTY_INV_WORLD_MATRIX 2
 #define TERRAIN_DIRTY_NORMAL_MATRIX 4
 
+// The largest geometric error of a terrain LOD, in pixels on screen, for the LOD to be used.
+//
+#define TERRAIN_LOD_PIXEL_ERROR 2.0f
+
+// The fraction of the distance range of a terrain LOD over which its vertices morph into
+// the next coarser LOD.
+//
+#define TERRAIN_LOD_MORPH_RANGE 0.3f
+
 /**
  * @script{ignore}
  */
 float getDefaultHeight(unsigned int width, unsigned int height);
 
+/**
+ * @script{ignore}
+ */
+float getDistance(const BoundingBox& box, const Vector3& point);
+
 Terrain::Terrain() :
     _heightfield(NULL), _node(NULL), _normalMap(NULL), _flags(FRUSTUM_CULLING | LEVEL_OF_DETAIL),
     _dirtyFlags(TERRAIN_DIRTY_WORLD_MATRIX | TERRAIN_DIRTY_INV_WORLD_MATRIX | TERRAIN_DIRTY_NORMAL_MATRIX)
@@ -43,6 +59,11 @@ Terrain::~Terrain()
         SAFE_DELETE(_patches[i]);
     }
 
+    for (size_t i = 0, count = _indexSets.size(); i < count; ++i)
+    {
+        SAFE_DELETE(_indexSets[i]);
+    }
+
     if (_node)
         _node->removeListener(this);
 
@@ -269,6 +290,7 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale, unsigne
         z1 = z;
         z2 = std::min(z1 + patchSize, height-1);
 
+        column = 0;
         for (unsigned int x = 0; x < width-1; x = x2, ++column)
         {
             x1 = x;
@@ -283,6 +305,32 @@ Terrain* Terrain::create(HeightField* heightfield, const Vector3& scale, unsigne
         }
     }
 
+    // Link each patch to its neighbours, so that its edges can be stitched to coarser ones
+    unsigned int columnCount = column;
+    for (size_t i = 0, count = terrain->_patches.size(); i < count; ++i)
+    {
+        TerrainPatch* patch = terrain->_patches[i];
+        patch->_neighbors[0] = patch->_row > 0 ? terrain->_patches[i - columnCount] : NULL;
+        patch->_neighbors[1] = i + columnCount < count ? terrain->_patches[i + columnCount] : NULL;
+        patch->_neighbors[2] = patch->_column > 0 ? terrain->_patches[i - 1] : NULL;
+        patch->_neighbors[3] = patch->_column + 1 < columnCount ? terrain->_patches[i + 1] : NULL;
+    }
+
+    // Store the geometric error of each LOD level, the largest error of the level in any patch.
+    // A level is never considered more accurate than a finer one.
+    for (size_t i = 0, count = terrain->_patches.size(); i < count; ++i)
+    {
+        const std::vector<TerrainPatch::Level*>& levels = terrain->_patches[i]->_levels;
+        for (size_t j = 0, levelCount = levels.size(); j < levelCount; ++j)
+        {
+            if (j == terrain->_levelErrors.size())
+                terrain->_levelErrors.push_back(0.0f);
+            terrain->_levelErrors[j] = std::max(terrain->_levelErrors[j], levels[j]->error);
+        }
+    }
+    for (size_t i = 1, count = terrain->_levelErrors.size(); i < count; ++i)
+        terrain->_levelErrors[i] = std::max(terrain->_levelErrors[i], terrain->_levelErrors[i-1]);
+
     // Read additional layer information from properties (if specified)
     if (properties)
     {
@@ -459,6 +507,8 @@ unsigned int Terrain::getTriangleCount() const
 
 unsigned int Terrain::getVisibleTriangleCount() const
 {
+    updateLOD();
+
     unsigned int triangleCount = 0;
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
     {
@@ -501,6 +551,8 @@ float Terrain::getHeight(float x, float z) const
 
 void Terrain::draw(bool wireframe)
 {
+    updateLOD();
+
     for (size_t i = 0, count = _patches.size(); i < count; ++i)
     {
         _patches[i]->draw(wireframe);
@@ -583,10 +635,100 @@ const Matrix& Terrain::getWorldViewProjectionMatrix() const
     return worldViewProj;
 }
 
+const Vector3& Terrain::getCameraPosition() const
+{
+    return _cameraPosition;
+}
+
+void Terrain::updateLOD() const
+{
+    size_t levelCount = _levelErrors.size();
+    _morphRanges.assign(levelCount, Vector2::zero());
+
+    Scene* scene = _node ? _node->getScene() : NULL;
+    Camera* camera = scene ? scene->getActiveCamera() : NULL;
+    if (!camera || !isFlagSet(LEVEL_OF_DETAIL) || levelCount < 2)
+    {
+        // Use the base level everywhere, without morphing
+        for (size_t i = 0, count = _patches.size(); i < count; ++i)
+            _patches[i]->_lod = 0;
+        return;
+    }
+
+    Node* cameraNode = camera->getNode();
+    _cameraPosition = cameraNode ? cameraNode->getTranslationWorld() : Vector3::zero();
+
+    // Scale that converts a geometric error in local units into pixels on screen, at a distance of
+    // one world unit from a perspective camera, relative to the allowed error in pixels
+    Vector3 worldScale;
+    getWorldMatrix().getScale(&worldScale);
+    float errorScale = fabs(worldScale.y) * Game::getInstance()->getHeight() / TERRAIN_LOD_PIXEL_ERROR;
+
+    if (camera->getCameraType() == Camera::ORTHOGRAPHIC)
+    {
+        // The projected error does not depend on the distance, so every patch uses the same level
+        errorScale /= camera->getZoomY();
+        size_t lod = 0;
+        while (lod + 1 < levelCount && _levelErrors[lod + 1] * errorScale <= 1.0f)
+            ++lod;
+        for (size_t i = 0, count = _patches.size(); i < count; ++i)
+            _patches[i]->_lod = lod;
+        return;
+    }
+    errorScale /= 2.0f * tan(MATH_DEG_TO_RAD(camera->getFieldOfView()) * 0.5f);
+
+    // Find the distance of each patch from the camera, and the size of the largest patch
+    float diagonal = 0.0f;
+    for (size_t i = 0, count = _patches.size(); i < count; ++i)
+    {
+        TerrainPatch* patch = _patches[i];
+        BoundingBox bounds = patch->getBoundingBox(true);
+        patch->_cameraDistance = getDistance(bounds, _cameraPosition);
+        diagonal = std::max(diagonal, bounds.min.distance(bounds.max));
+    }
+
+    // Compute the distance from which each level is used. Consecutive distances are at least
+    // the size of a patch apart, beyond the range over which the finer level morphs. This keeps
+    // neighbouring patches within one level of each other, and a coarser patch unmorphed along
+    // the edges it shares with finer ones, where its vertices must match their stitched edges.
+    _lodDistances.resize(levelCount);
+    _lodDistances[0] = 0.0f;
+    for (size_t i = 1; i < levelCount; ++i)
+    {
+        _lodDistances[i] = std::max(_levelErrors[i] * errorScale, _lodDistances[i-1] + diagonal / (1.0f - TERRAIN_LOD_MORPH_RANGE));
+
+        // Vertices of the finer level morph completely into this level by the time it is used,
+        // stored as the scale and offset of a linear function of the distance
+        float end = _lodDistances[i];
+        float start = end - TERRAIN_LOD_MORPH_RANGE * (end - _lodDistances[i-1]);
+        if (end > start)
+            _morphRanges[i-1].set(1.0f / (end - start), -start / (end - start));
+    }
+
+    // Each patch uses the coarsest level whose distance it is beyond
+    for (size_t i = 0, count = _patches.size(); i < count; ++i)
+    {
+        TerrainPatch* patch = _patches[i];
+        size_t lod = std::min(levelCount, patch->_levels.size()) - 1;
+        while (lod > 0 && _lodDistances[lod] > patch->_cameraDistance)
+            --lod;
+        patch->_lod = lod;
+    }
+}
+
 float getDefaultHeight(unsigned int width, unsigned int height)
 {
     // When terrain height is not specified, we'll use a default height of ~ 0.3 of the image dimensions
     return ((width + height) * 0.5f) * DEFAULT_TERRAIN_HEIGHT_RATIO;
 }
 
+float getDistance(const BoundingBox& box, const Vector3& point)
+{
+    // Distance from the point to the closest point of the box
+    Vector3 d(std::max(std::max(box.min.x - point.x, point.x - box.max.x), 0.0f),
+              std::max(std::max(box.min.y - point.y, point.y - box.max.y), 0.0f),
+              std::max(std::max(box.min.z - point.z, point.z - box.max.z), 0.0f));
+    return d.length();
+}
+
 }
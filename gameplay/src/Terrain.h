@@ -59,23 +59,26 @@ class TerrainPatch;
  * flags.
  * 
  * Level of detail (LOD) is supported using a technique that is similar to texture mipmapping.
- * A distance-to-camera based test, using a simple screen-space error metric is used to decide
- * the appropriate LOD for a terrain patch. The number of LOD levels is 1 by default (which
- * means only the base level is used), but can be specified via the detailLevels property.
- * Using too large a number for detailLevels can result in excessive popping in the distance
- * for very hilly terrains, so a smaller number (2-3) often works best in these cases.
+ * The number of LOD levels is 1 by default (which means only the base level is used), but can
+ * be specified via the detailLevels property. The geometric error of each level, the largest
+ * height difference between the level and the heightfield, is computed when the terrain is
+ * created. Each frame, the distances from the camera at which the error of each level projects
+ * to less than a couple of pixels on screen are computed once, and each patch then uses the
+ * coarsest level allowed at the distance of its bounding box from the camera. These distances
+ * are also kept far enough apart that neighbouring patches never differ by more than one level.
  *
- * Finally, when LOD is enabled, cracks can begin to appear between terrain patches of
- * different LOD levels. If the cracks are only minor (depends on your terrain topology
- * and tetures used), an acceptable appraoch might be to simply use a background clear 
- * color that closely matches your terrain to make the cracks much less visible. However,
- * often that is not acceptable, so the Terrain class also supports a simple solution called
- * "vertical skirts". When enabled (via the skirtScale parameter in the terrain file), a vertical
- * edge will extend down along the sides of all terrain patches, which fills in the crack.
- * This is a very fast approach as it adds only a small number of triangles per patch and requires
- * zero extra CPU time or draw calls, which are often needed for more complex stitching 
- * approaches. In practice, the skirts are often not noticable at all unless the LOD variation
- * is very large and the terrain is excessively hilly on the edge of a LOD transition.
+ * To avoid popping when a patch changes level, its vertices morph towards the surface of the
+ * next coarser level as their distance from the camera approaches the distance at which that
+ * level is used, so the switch happens when the two levels look the same. Only heights are
+ * morphed; vertex normals still change with the level, so a normal map is recommended for
+ * terrains that use level of detail.
+ *
+ * The edges of a patch that border a coarser patch are stitched to it, using index buffers that
+ * leave out the vertices the coarser patch does not have, so no cracks appear between patches
+ * of different LOD levels. Vertical skirts can still be enabled (via the skirtScale parameter in
+ * the terrain file), in which case a vertical edge extends down along the sides of all terrain
+ * patches. Skirts are only needed to hide small gaps caused by precision, or when the terrain is
+ * drawn with custom geometry.
  */
 class Terrain : public Ref, public Transform::Listener
 {
@@ -363,6 +366,17 @@ private:
      */
     const Matrix& getWorldViewProjectionMatrix() const;
 
+    /**
+     * Returns the world-space position of the camera the current LOD was computed for.
+     */
+    const Vector3& getCameraPosition() const;
+
+    /**
+     * Computes the LOD of every patch, and the range over which each level morphs into the
+     * next, from the viewpoint of the scene's active camera.
+     */
+    void updateLOD() const;
+
     HeightField* _heightfield;
     Node* _node;
     std::vector<TerrainPatch*> _patches;
@@ -374,6 +388,11 @@ private:
     mutable Matrix _normalMatrix;
     mutable unsigned int _dirtyFlags;
     BoundingBox _boundingBox;
+    std::vector<TerrainPatch::IndexSet*> _indexSets;
+    std::vector<float> _levelErrors;
+    mutable std::vector<float> _lodDistances;
+    mutable std::vector<Vector2> _morphRanges;
+    mutable Vector3 _cameraPosition;
 };
 
 }
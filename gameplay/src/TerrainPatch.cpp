@@ -1,9 +1,7 @@
 #include "Base.h"
 #include "TerrainPatch.h"
 #include "Terrain.h"
-#include "MeshPart.h"
 #include "Scene.h"
-#include "Game.h"
 
 // Default terrain shaders
 #define TERRAIN_VSH "res/shaders/terrain.vert"
@@ -17,14 +15,22 @@ namespace gameplay
  */
 float calculateHeight(float* heights, unsigned int width, unsigned int height, unsigned int x, unsigned int z);
 
+/**
+ * @script{ignore}
+ */
+float interpolateHeight(float* heights, unsigned int width, unsigned int height,
+                        unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                        unsigned int step, unsigned int x, unsigned int z);
+
 /**
  * @script{ignore}
  */
 template <class T> T clamp(T value, T min, T max) { return value < min ? min : (value > max ? max : value); }
 
 TerrainPatch::TerrainPatch() :
-    _terrain(NULL), _row(0), _column(0), _materialDirty(true)
+    _terrain(NULL), _row(0), _column(0), _materialDirty(true), _lod(0), _cameraDistance(0.0f)
 {
+    memset(_neighbors, 0, sizeof(_neighbors));
 }
 
 TerrainPatch::~TerrainPatch()
@@ -56,10 +62,12 @@ TerrainPatch* TerrainPatch::create(Terrain* terrain,
     patch->_row = row;
     patch->_column = column;
 
-    // Add patch lods
+    // Add patch lods. When there is more than one, each level also stores the heights of its
+    // vertices in the next coarser level, which it morphs towards.
     for (unsigned int step = 1; step <= maxStep; step *= 2)
     {
-        patch->addLOD(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, step, verticalSkirtSize);
+        unsigned int morphStep = maxStep > 1 ? std::min(step * 2, maxStep) : 0;
+        patch->addLOD(heights, width, height, x1, z1, x2, z2, xOffset, zOffset, step, morphStep, verticalSkirtSize);
     }
 
     // Set our bounding box using the base LOD mesh
@@ -80,7 +88,7 @@ TerrainPatch* TerrainPatch::create(Terrain* terrain,
 void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int height,
     unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
     float xOffset, float zOffset,
-    unsigned int step, float verticalSkirtSize)
+    unsigned int step, unsigned int morphStep, float verticalSkirtSize)
 {
     // Allocate vertex data for this patch
     unsigned int patchWidth;
@@ -106,7 +114,7 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
     }
 
     unsigned int vertexCount = patchHeight * patchWidth;
-    unsigned int vertexElements = _terrain->_normalMap ? 5 : 8; //<x,y,z>[i,j,k]<u,v>
+    unsigned int vertexElements = (_terrain->_normalMap ? 5 : 8) + (morphStep ? 1 : 0); //<x,y,z>[i,j,k]<u,v>[h]
     float* vertices = new float[vertexCount * vertexElements];
     unsigned int index = 0;
     Vector3 min(FLT_MAX, FLT_MAX, FLT_MAX);
@@ -181,6 +189,15 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
                 float offset = verticalSkirtSize / height;
                 v[1] = z == z1 ? v[1]-offset : v[1]+offset;
             }
+            v += 2;
+
+            // Compute the height in the next coarser level
+            if (morphStep)
+            {
+                v[0] = interpolateHeight(heights, width, height, x1, z1, x2, z2, morphStep, x, z);
+                if (xskirt || zskirt)
+                    v[0] -= verticalSkirtSize;
+            }
 
             if (x == x2)
             {
@@ -219,99 +236,137 @@ void TerrainPatch::addLOD(float* heights, unsigned int width, unsigned int heigh
 
     Vector3 center(min + ((max - min) * 0.5f));
 
-    // Create mesh
-    VertexFormat::Element elements[3];
-    elements[0] = VertexFormat::Element(VertexFormat::POSITION, 3);
-    if (_terrain->_normalMap)
-    {
-        elements[1] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
-    }
-    else
+    // Compute the geometric error of this level, the largest difference between the height of
+    // a sample and the height of the level's surface above it
+    float error = 0.0f;
+    if (step > 1)
     {
-        elements[1] = VertexFormat::Element(VertexFormat::NORMAL, 3);
-        elements[2] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
+        for (unsigned int z = z1; z <= z2; ++z)
+        {
+            for (unsigned int x = x1; x <= x2; ++x)
+            {
+                float e = fabs(calculateHeight(heights, width, height, x, z) - interpolateHeight(heights, width, height, x1, z1, x2, z2, step, x, z));
+                if (e > error)
+                    error = e;
+            }
+        }
     }
-    VertexFormat format(elements, _terrain->_normalMap ? 2 : 3);
+
+    // Create mesh
+    VertexFormat::Element elements[4];
+    unsigned int elementCount = 0;
+    elements[elementCount++] = VertexFormat::Element(VertexFormat::POSITION, 3);
+    if (!_terrain->_normalMap)
+        elements[elementCount++] = VertexFormat::Element(VertexFormat::NORMAL, 3);
+    elements[elementCount++] = VertexFormat::Element(VertexFormat::TEXCOORD0, 2);
+    if (morphStep)
+        elements[elementCount++] = VertexFormat::Element(VertexFormat::TEXCOORD1, 1);
+    VertexFormat format(elements, elementCount);
     Mesh* mesh = Mesh::createMesh(format, vertexCount);
     mesh->setVertexData(vertices);
     mesh->setBoundingBox(BoundingBox(min, max));
     mesh->setBoundingSphere(BoundingSphere(center, center.distance(max)));
 
-    // Add mesh part for indices
-    unsigned int indexCount =
-        (patchWidth * 2) *      // # indices per row of tris
-        (patchHeight - 1) +     // # rows of tris
-        (patchHeight-2) * 2;    // # degenerate tris
+    // Support a maximum number of vertices of USHRT_MAX + 1, since the index buffers use 16-bit indices.
+    // Any more vertices we will require breaking up the terrain into smaller patches.
+    if (vertexCount > USHRT_MAX + 1)
+    {
+        GP_WARN("Vertex count of %d for terrain patch exceeds the limit of 65536. Please specifiy a smaller patch size.", vertexCount);
+        GP_ASSERT(vertexCount <= USHRT_MAX + 1);
+    }
+
+    SAFE_DELETE_ARRAY(vertices);
+
+    // Create model. The mesh has no parts, since the triangles are drawn from the index set
+    // that matches the edges stitched to coarser neighbours.
+    Model* model = Model::create(mesh);
+    mesh->release();
 
-    // Support a maximum number of indices of USHRT_MAX. Any more indices we will require breaking up the
-    // terrain into smaller patches.
-    if (indexCount > USHRT_MAX)
+    // Add this level
+    Level* level = new Level();
+    level->model = model;
+    level->indices = getIndexSet(patchWidth, patchHeight, verticalSkirtSize > 0);
+    level->error = error;
+    _levels.push_back(level);
+}
+
+TerrainPatch::IndexSet* TerrainPatch::getIndexSet(unsigned int width, unsigned int height, bool skirts)
+{
+    std::vector<IndexSet*>& indexSets = _terrain->_indexSets;
+    for (size_t i = 0, count = indexSets.size(); i < count; ++i)
     {
-        GP_WARN("Index count of %d for terrain patch exceeds the limit of 65535. Please specifiy a smaller patch size.", indexCount);
-        GP_ASSERT(indexCount <= USHRT_MAX);
+        IndexSet* indexSet = indexSets[i];
+        if (indexSet->width == width && indexSet->height == height && indexSet->skirts == skirts)
+            return indexSet;
     }
 
-    MeshPart* part = mesh->addPart(Mesh::TRIANGLE_STRIP, Mesh::INDEX16, indexCount);
-    unsigned short* indices = new unsigned short[indexCount];
-    index = 0;
-    for (unsigned int z = 0; z < patchHeight-1; ++z)
+    IndexSet* indexSet = new IndexSet();
+    indexSet->width = width;
+    indexSet->height = height;
+    indexSet->skirts = skirts;
+    indexSets.push_back(indexSet);
+
+    // Build a triangle list for each combination of stitched edges. Each cell of the grid is split
+    // into two triangles along the same diagonal as the heights are interpolated on. Triangles
+    // that collapse when vertices are moved onto the coarser grid are left out.
+    unsigned short* indices = new unsigned short[(width - 1) * (height - 1) * 6];
+    for (unsigned int edges = 0; edges < 16; ++edges)
     {
-        unsigned int i1 = z * patchWidth;
-        unsigned int i2 = (z+1) * patchWidth;
-
-        // Move left to right for even rows and right to left for odd rows.
-        // Note that this results in two degenerate triangles between rows
-        // for stitching purposes, but actually does not require any extra
-        // indices to achieve this.
-        if (z % 2 == 0)
+        unsigned int index = 0;
+        for (unsigned int z = 0; z < height - 1; ++z)
         {
-            if (z > 0)
-            {
-                // Add degenerate indices to connect strips
-                indices[index] = indices[index-1];
-                ++index;
-                indices[index++] = i1;
-            }
-
-            // Add row strip
-            for (unsigned int x = 0; x < patchWidth; ++x)
+            for (unsigned int x = 0; x < width - 1; ++x)
             {
-                indices[index++] = i1 + x;
-                indices[index++] = i2 + x;
+                unsigned short a = getStitchedIndex(width, height, skirts, edges, x, z);
+                unsigned short b = getStitchedIndex(width, height, skirts, edges, x, z + 1);
+                unsigned short c = getStitchedIndex(width, height, skirts, edges, x + 1, z);
+                unsigned short d = getStitchedIndex(width, height, skirts, edges, x + 1, z + 1);
+
+                if (a != b && a != c && b != c)
+                {
+                    indices[index++] = a;
+                    indices[index++] = b;
+                    indices[index++] = c;
+                }
+                if (c != b && c != d && b != d)
+                {
+                    indices[index++] = c;
+                    indices[index++] = b;
+                    indices[index++] = d;
+                }
             }
         }
-        else
-        {
-            // Add degenerate indices to connect strips
-            if (z > 0)
-            {
-                indices[index] = indices[index-1];
-                ++index;
-                indices[index++] = i2 + ((int)patchWidth-1);
-            }
 
-            // Add row strip
-            for (int x = (int)patchWidth-1; x >= 0; --x)
-            {
-                indices[index++] = i2 + x;
-                indices[index++] = i1 + x;
-            }
-        }
+        GL_ASSERT( glGenBuffers(1, &indexSet->buffers[edges]) );
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexSet->buffers[edges]) );
+        GL_ASSERT( glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * index, indices, GL_STATIC_DRAW) );
+        indexSet->counts[edges] = index;
     }
-    GP_ASSERT(index == indexCount);
-    part->setIndexData(indices, 0, indexCount);
-
-    SAFE_DELETE_ARRAY(vertices);
     SAFE_DELETE_ARRAY(indices);
 
-    // Create model
-    Model* model = Model::create(mesh);
-    mesh->release();
+    return indexSet;
+}
 
-    // Add this level
-    Level* level = new Level();
-    level->model = model;
-    _levels.push_back(level);
+unsigned short TerrainPatch::getStitchedIndex(unsigned int width, unsigned int height, bool skirts, unsigned int edges,
+    unsigned int column, unsigned int row)
+{
+    // The coarser grid has every other vertex of the edge, plus the last one. The other vertices,
+    // and the skirt vertices below them, are moved back onto the previous vertex of the edge.
+    unsigned int border = skirts ? 1 : 0;
+    unsigned int x = column;
+    unsigned int z = row;
+    if (((edges & EDGE_NORTH) && row <= border) || ((edges & EDGE_SOUTH) && row >= height - 1 - border))
+    {
+        if (column > border && column < width - 1 - border && (column - border) % 2 == 1)
+            --x;
+    }
+    if (((edges & EDGE_WEST) && column <= border) || ((edges & EDGE_EAST) && column >= width - 1 - border))
+    {
+        if (row > border && row < height - 1 - border && (row - border) % 2 == 1)
+            --z;
+    }
+
+    return (unsigned short)(z * width + x);
 }
 
 void TerrainPatch::deleteLayer(Layer* layer)
@@ -451,6 +506,8 @@ bool TerrainPatch::updateMaterial()
             defines << ";DEBUG_PATCHES";
         if (_terrain->_normalMap)
             defines << ";NORMAL_MAP";
+        if (_levels.size() > 1)
+            defines << ";LOD_MORPH";
 
         // Append texture and blend index constants to preprocessor definition.
         // We need to do this since older versions of GLSL only allow sampler arrays
@@ -491,6 +548,12 @@ bool TerrainPatch::updateMaterial()
         material->getParameter("u_lightDirection")->bindValue(this, &TerrainPatch::getLightDirection);
         if (_layers.size() > 0)
             material->getParameter("u_samplers")->setValue((const Texture::Sampler**)&_samplers[0], (unsigned int)_samplers.size());
+        if (_levels.size() > 1)
+        {
+            material->getParameter("u_worldMatrix")->bindValue(_terrain, &Terrain::getWorldMatrix);
+            material->getParameter("u_cameraPosition")->bindValue(_terrain, &Terrain::getCameraPosition);
+            material->getParameter("u_morphRange")->bindValue(this, &TerrainPatch::getMorphRange);
+        }
 
         if (_terrain->isFlagSet(Terrain::DEBUG_PATCHES))
         {
@@ -524,11 +587,38 @@ void TerrainPatch::draw(bool wireframe)
     if (!updateMaterial())
         return;
 
-    // Compute the LOD level from the camera's perspective
-    size_t lod = computeLOD(camera, bounds);
+    // Draw the current LOD with the index set that stitches the edges shared with coarser
+    // neighbours (the LOD is computed for all patches by Terrain::updateLOD).
+    Level* level = _levels[_lod];
+    Material* material = level->model->getMaterial();
+    if (!material)
+        return;
 
-    // Draw the model for the current LOD
-    _levels[lod]->model->draw(wireframe);
+    unsigned int edges = getStitchedEdges();
+    IndexBufferHandle buffer = level->indices->buffers[edges];
+    unsigned int indexCount = level->indices->counts[edges];
+    Technique* technique = material->getTechnique();
+    GP_ASSERT(technique);
+    unsigned int passCount = technique->getPassCount();
+    for (unsigned int i = 0; i < passCount; ++i)
+    {
+        Pass* pass = technique->getPassByIndex(i);
+        GP_ASSERT(pass);
+        pass->bind();
+        GL_ASSERT( glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer) );
+        if (wireframe)
+        {
+            for (unsigned int j = 0; j < indexCount; j += 3)
+            {
+                GL_ASSERT( glDrawElements(GL_LINE_LOOP, 3, GL_UNSIGNED_SHORT, ((const GLvoid*)(j*sizeof(unsigned short)))) );
+            }
+        }
+        else
+        {
+            GL_ASSERT( glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, 0) );
+        }
+        pass->unbind();
+    }
 }
 
 bool TerrainPatch::isVisible() const
@@ -548,8 +638,8 @@ bool TerrainPatch::isVisible() const
 
 unsigned int TerrainPatch::getTriangleCount() const
 {
-    // Patches are made up of a single mesh part using triangle strips
-    return _levels[0]->model->getMesh()->getPart(0)->getIndexCount() - 2;
+    // Patches are drawn as triangle lists
+    return _levels[0]->indices->counts[0] / 3;
 }
 
 unsigned int TerrainPatch::getVisibleTriangleCount() const
@@ -567,9 +657,25 @@ unsigned int TerrainPatch::getVisibleTriangleCount() const
             return 0;
     }
 
-    // Return the triangle count of the LOD level depending on the camera
-    size_t lod = computeLOD(camera, bounds);
-    return _levels[lod]->model->getMesh()->getPart(0)->getIndexCount() - 2;
+    // Return the triangle count of the current LOD, with its stitched edges
+    return _levels[_lod]->indices->counts[getStitchedEdges()] / 3;
+}
+
+unsigned int TerrainPatch::getStitchedEdges() const
+{
+    unsigned int edges = 0;
+    for (unsigned int i = 0; i < EDGE_COUNT; ++i)
+    {
+        if (_neighbors[i] && _neighbors[i]->_lod > _lod)
+            edges |= 1 << i;
+    }
+    return edges;
+}
+
+Vector2 TerrainPatch::getMorphRange() const
+{
+    const std::vector<Vector2>& morphRanges = _terrain->_morphRanges;
+    return _lod < morphRanges.size() ? morphRanges[_lod] : Vector2::zero();
 }
 
 BoundingBox TerrainPatch::getBoundingBox(bool worldSpace) const
@@ -614,48 +720,39 @@ const Vector3& TerrainPatch::getLightDirection() const
     return scene->getLightDirection();
 }
 
-size_t TerrainPatch::computeLOD(Camera* camera, const BoundingBox& worldBounds) const
+float calculateHeight(float* heights, unsigned int width, unsigned int height, unsigned int x, unsigned int z)
 {
-    if (!_terrain->isFlagSet(Terrain::LEVEL_OF_DETAIL) || _levels.size() == 0)
-        return 0; // base level
-
-    // Compute LOD to use based on very simple distance metric.
-    // TODO: Optimize this.
-    Game* game = Game::getInstance();
-    Rectangle vp(0, 0, game->getWidth(), game->getHeight());
-    Vector3 corners[8];
-    Vector2 min(FLT_MAX, FLT_MAX);
-    Vector2 max(-FLT_MAX, -FLT_MAX);
-    worldBounds.getCorners(corners);
-    for (unsigned int i = 0; i < 8; ++i)
-    {
-        const Vector3& corner = corners[i];
-        float x, y;
-        camera->project(vp, corners[i], &x, &y);
-        if (x < min.x)
-            min.x = x;
-        if (y < min.y)
-            min.y = y;
-        if (x > max.x)
-            max.x = x;
-        if (y > max.y)
-            max.y = y;
-    }
-    float area = (max.x - min.x) * (max.y - min.y);
-    float screenArea = game->getWidth() * game->getHeight() / 10.0f;
-    float error = screenArea / area;
-
-    // Level LOD based on distance from camera
-    size_t maxLod = _levels.size()-1;
-    size_t lod = (size_t)error;
-    lod = std::max(lod, (size_t)0);
-    lod = std::min(lod, maxLod);
-    return lod;
+    return heights[z * width + x];
 }
 
-float calculateHeight(float* heights, unsigned int width, unsigned int height, unsigned int x, unsigned int z)
+float interpolateHeight(float* heights, unsigned int width, unsigned int height,
+                        unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
+                        unsigned int step, unsigned int x, unsigned int z)
 {
-    return heights[z * width + x];
+    // Find the cell of the level's grid that contains the sample. The grid has a line every
+    // step samples and a last line on the edge of the patch.
+    unsigned int cx1 = x1 + (x - x1) / step * step;
+    if (cx1 == x2 && x2 > x1)
+        cx1 = x1 + (x2 - x1 - 1) / step * step;
+    unsigned int cx2 = std::min(cx1 + step, x2);
+    unsigned int cz1 = z1 + (z - z1) / step * step;
+    if (cz1 == z2 && z2 > z1)
+        cz1 = z1 + (z2 - z1 - 1) / step * step;
+    unsigned int cz2 = std::min(cz1 + step, z2);
+
+    float u = cx2 > cx1 ? (float)(x - cx1) / (cx2 - cx1) : 0.0f;
+    float v = cz2 > cz1 ? (float)(z - cz1) / (cz2 - cz1) : 0.0f;
+    float h10 = calculateHeight(heights, width, height, cx2, cz1);
+    float h01 = calculateHeight(heights, width, height, cx1, cz2);
+
+    // Interpolate on the triangle of the cell that contains the sample
+    if (u + v <= 1.0f)
+    {
+        float h00 = calculateHeight(heights, width, height, cx1, cz1);
+        return h00 + u * (h10 - h00) + v * (h01 - h00);
+    }
+    float h11 = calculateHeight(heights, width, height, cx2, cz2);
+    return h11 + (1.0f - u) * (h01 - h11) + (1.0f - v) * (h10 - h11);
 }
 
 TerrainPatch::Layer::Layer() :
@@ -667,8 +764,25 @@ TerrainPatch::Layer::~Layer()
 {
 }
 
-TerrainPatch::Level::Level() : model(NULL)
+TerrainPatch::Level::Level() : model(NULL), indices(NULL), error(0.0f)
+{
+}
+
+TerrainPatch::IndexSet::IndexSet() : width(0), height(0), skirts(false)
 {
+    memset(buffers, 0, sizeof(buffers));
+    memset(counts, 0, sizeof(counts));
+}
+
+TerrainPatch::IndexSet::~IndexSet()
+{
+    for (unsigned int i = 0; i < 16; ++i)
+    {
+        if (buffers[i])
+        {
+            GL_ASSERT( glDeleteBuffers(1, &buffers[i]) );
+        }
+    }
 }
 
 bool TerrainPatch::LayerCompare::operator() (const Layer* lhs, const Layer* rhs) const
@@ -38,9 +38,41 @@ private:
         int blendChannel;
     };
 
+    /**
+     * Edges of a patch, as bits of the mask of edges that are stitched to coarser neighbours.
+     */
+    enum Edge
+    {
+        EDGE_NORTH = 1,
+        EDGE_SOUTH = 2,
+        EDGE_WEST = 4,
+        EDGE_EAST = 8,
+        EDGE_COUNT = 4
+    };
+
+    /**
+     * Triangle list index buffers for a grid of vertices, one for each mask of stitched edges.
+     *
+     * Index sets are owned by the terrain and shared by all of the levels that have the same
+     * number of vertices.
+     */
+    struct IndexSet
+    {
+        unsigned int width;
+        unsigned int height;
+        bool skirts;
+        IndexBufferHandle buffers[16];
+        unsigned int counts[16];
+
+        IndexSet();
+        ~IndexSet();
+    };
+
     struct Level
     {
         Model* model;
+        IndexSet* indices;
+        float error;
 
         Level();
     };
@@ -84,7 +116,19 @@ private:
      */
     void addLOD(float* heights, unsigned int width, unsigned int height,
                 unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2,
-                float xOffset, float zOffset, unsigned int step, float verticalSkirtSize);
+                float xOffset, float zOffset, unsigned int step, unsigned int morphStep, float verticalSkirtSize);
+
+    /**
+     * Finds the terrain's index set for a grid of vertices, creating it if there is none.
+     */
+    IndexSet* getIndexSet(unsigned int width, unsigned int height, bool skirts);
+
+    /**
+     * Returns the index of a vertex of a grid, moved along the stitched edges onto the grid of
+     * the next coarser LOD.
+     */
+    static unsigned short getStitchedIndex(unsigned int width, unsigned int height, bool skirts, unsigned int edges,
+                                           unsigned int column, unsigned int row);
 
     /**
      * Sets details for a layer of this patch.
@@ -127,9 +171,15 @@ private:
     bool updateMaterial();
 
     /**
-     * Computes the current LOD for this patch, from the viewpoint of the specified camera.
+     * Returns the mask of the edges of this patch whose neighbours use a coarser LOD.
+     */
+    unsigned int getStitchedEdges() const;
+
+    /**
+     * Returns the scale and offset that map the distance of a vertex from the camera to the
+     * factor by which it morphs towards the next coarser LOD.
      */
-    size_t computeLOD(Camera* camera, const BoundingBox& worldBounds) const;
+    Vector2 getMorphRange() const;
 
     /**
      * Returns the local bounding box for this patch, at the base LOD level.
@@ -150,6 +200,9 @@ private:
     std::vector<Texture::Sampler*> _samplers;
     bool _materialDirty;
     BoundingBox _boundingBox;
+    TerrainPatch* _neighbors[EDGE_COUNT];
+    size_t _lod;
+    float _cameraDistance;
 
 };
 
@@ -1,6 +1,7 @@
 #include "Base.h"
 #include "Image.h"
 #include "Texture.h"
+#include "MemoryTracker.h"
 #include "FileSystem.h"
 
 // PVRTC (GL_IMG_texture_compression_pvrtc) : Imagination based gpus
@@ -70,30 +71,14 @@ Texture::~Texture()
 
 Texture* Texture::create(const char* path, bool generateMipmaps)
 {
+    GP_MEMORY_SCOPE(CATEGORY_TEXTURE);
+
     GP_ASSERT(path);
 
     // Search texture cache first.
-    for (size_t i = 0, count = __textureCache.size(); i < count; ++i)
-    {
-        Texture* t = __textureCache[i];
-        GP_ASSERT(t);
-        if (t->_path == path)
-        {
-            // If 'generateMipmaps' is true, call Texture::generateMipamps() to force the 
-            // texture to generate its mipmap chain if it hasn't already done so.
-            if (generateMipmaps)
-            {
-                t->generateMipmaps();
-            }
-
-            // Found a match.
-            t->addRef();
-
-            return t;
-        }
-    }
-
-    Texture* texture = NULL;
+    Texture* texture = findCached(path, generateMipmaps);
+    if (texture)
+        return texture;
 
     // Filter loading based on file extension.
     const char* ext = strrchr(FileSystem::resolvePath(path), '.');
@@ -125,12 +110,7 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
 
     if (texture)
     {
-        texture->_path = path;
-        texture->_cached = true;
-
-        // Add to texture cache.
-        __textureCache.push_back(texture);
-
+        addToCache(texture, path);
         return texture;
     }
 
@@ -138,6 +118,44 @@ Texture* Texture::create(const char* path, bool generateMipmaps)
     return NULL;
 }
 
+Texture* Texture::findCached(const char* path, bool generateMipmaps)
+{
+    GP_ASSERT(path);
+
+    for (size_t i = 0, count = __textureCache.size(); i < count; ++i)
+    {
+        Texture* t = __textureCache[i];
+        GP_ASSERT(t);
+        if (t->_path == path)
+        {
+            // If 'generateMipmaps' is true, call Texture::generateMipamps() to force the 
+            // texture to generate its mipmap chain if it hasn't already done so.
+            if (generateMipmaps)
+            {
+                t->generateMipmaps();
+            }
+
+            // Found a match.
+            t->addRef();
+
+            return t;
+        }
+    }
+    return NULL;
+}
+
+void Texture::addToCache(Texture* texture, const char* path)
+{
+    GP_ASSERT(texture);
+    GP_ASSERT(path);
+
+    texture->_path = path;
+    texture->_cached = true;
+
+    // Add to texture cache.
+    __textureCache.push_back(texture);
+}
+
 Texture* Texture::create(Image* image, bool generateMipmaps)
 {
     GP_ASSERT(image);
@@ -156,6 +174,8 @@ Texture* Texture::create(Image* image, bool generateMipmaps)
 
 Texture* Texture::create(Format format, unsigned int width, unsigned int height, unsigned char* data, bool generateMipmaps)
 {
+    GP_MEMORY_SCOPE(CATEGORY_TEXTURE);
+
     // Create and load the texture.
     GLuint textureId;
     GL_ASSERT( glGenTextures(1, &textureId) );
@@ -838,6 +858,44 @@ void Texture::setFilterMode(Filter minificationFilter, Filter magnificationFilte
     GL_ASSERT( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLenum)magnificationFilter) );
 }
 
+void Texture::setData(unsigned int width, unsigned int height, const unsigned char* data)
+{
+    GP_ASSERT(_handle);
+    GP_ASSERT(!_compressed);
+
+    GL_ASSERT( glBindTexture(GL_TEXTURE_2D, _handle) );
+    GL_ASSERT( glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+    GL_ASSERT( glTexImage2D(GL_TEXTURE_2D, 0, (GLenum)_format, width, height, 0, (GLenum)_format, GL_UNSIGNED_BYTE, data) );
+    if (_mipmapped)
+    {
+        GL_ASSERT( glGenerateMipmap(GL_TEXTURE_2D) );
+    }
+    _width = width;
+    _height = height;
+
+    // Restore the texture id
+    GL_ASSERT( glBindTexture(GL_TEXTURE_2D, __currentTextureId) );
+}
+
+void Texture::setData(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const unsigned char* data)
+{
+    GP_ASSERT(_handle);
+    GP_ASSERT(!_compressed);
+    GP_ASSERT(data);
+    GP_ASSERT(x + width <= _width && y + height <= _height);
+
+    GL_ASSERT( glBindTexture(GL_TEXTURE_2D, _handle) );
+    GL_ASSERT( glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+    GL_ASSERT( glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, (GLenum)_format, GL_UNSIGNED_BYTE, data) );
+    if (_mipmapped)
+    {
+        GL_ASSERT( glGenerateMipmap(GL_TEXTURE_2D) );
+    }
+
+    // Restore the texture id
+    GL_ASSERT( glBindTexture(GL_TEXTURE_2D, __currentTextureId) );
+}
+
 void Texture::generateMipmaps()
 {
     if (!_mipmapped)
@@ -15,6 +15,7 @@ class Image;
 class Texture : public Ref
 {
     friend class Sampler;
+    friend class ResourceRequest;
 
 public:
 
@@ -62,6 +63,7 @@ public:
     class Sampler : public Ref
     {
         friend class Texture;
+        friend class RenderQueue;
 
     public:
 
@@ -243,6 +245,34 @@ public:
      */
     void setFilterMode(Filter minificationFilter, Filter magnificationFilter);
 
+    /**
+     * Replaces the whole image of this texture, which may change its size.
+     *
+     * The data is expected to be in the format of the texture and tightly packed. If the
+     * texture is mipmapped, its mipmap chain is regenerated.
+     *
+     * @param width The new width of the texture.
+     * @param height The new height of the texture.
+     * @param data Raw texture data, or NULL to leave the contents undefined.
+     * @script{ignore}
+     */
+    void setData(unsigned int width, unsigned int height, const unsigned char* data);
+
+    /**
+     * Replaces a rectangular region of the image of this texture.
+     *
+     * The data is expected to be in the format of the texture and tightly packed. If the
+     * texture is mipmapped, its mipmap chain is regenerated.
+     *
+     * @param x The x-coordinate of the region, in pixels.
+     * @param y The y-coordinate of the region, in pixels.
+     * @param width The width of the region.
+     * @param height The height of the region.
+     * @param data Raw texture data for the region.
+     * @script{ignore}
+     */
+    void setData(unsigned int x, unsigned int y, unsigned int width, unsigned int height, const unsigned char* data);
+
     /**
      * Generates a full mipmap chain for this texture if it isn't already mipmapped.
      */
@@ -289,6 +319,24 @@ private:
      */
     Texture& operator=(const Texture&);
 
+    /**
+     * Finds the cached texture for a file.
+     *
+     * @param path The path to the texture file.
+     * @param generateMipmaps true to generate a mipmap chain for the cached texture if it does not have one yet.
+     *
+     * @return The texture with an added reference, or NULL if it is not cached.
+     */
+    static Texture* findCached(const char* path, bool generateMipmaps);
+
+    /**
+     * Adds a texture loaded from a file to the texture cache.
+     *
+     * @param texture The texture to add.
+     * @param path The path to the texture file.
+     */
+    static void addToCache(Texture* texture, const char* path);
+
     static Texture* createCompressedPVRTC(const char* path);
 
     static Texture* createCompressedDDS(const char* path);
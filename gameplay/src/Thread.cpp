@@ -0,0 +1,287 @@
+#include "Base.h"
+#include "Thread.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace gameplay
+{
+
+static volatile int __threadIdCounter = 0;
+
+#ifdef WIN32
+
+Mutex::Mutex()
+{
+    CRITICAL_SECTION* cs = new CRITICAL_SECTION();
+    InitializeCriticalSection(cs);
+    _handle = cs;
+}
+
+Mutex::~Mutex()
+{
+    CRITICAL_SECTION* cs = (CRITICAL_SECTION*)_handle;
+    DeleteCriticalSection(cs);
+    delete cs;
+}
+
+void Mutex::lock()
+{
+    EnterCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+bool Mutex::tryLock()
+{
+    return TryEnterCriticalSection((CRITICAL_SECTION*)_handle) != 0;
+}
+
+void Mutex::unlock()
+{
+    LeaveCriticalSection((CRITICAL_SECTION*)_handle);
+}
+
+Semaphore::Semaphore(unsigned int count)
+{
+    _handle = CreateSemaphore(NULL, (LONG)count, LONG_MAX, NULL);
+    GP_ASSERT(_handle);
+}
+
+Semaphore::~Semaphore()
+{
+    CloseHandle((HANDLE)_handle);
+}
+
+void Semaphore::post(unsigned int count)
+{
+    ReleaseSemaphore((HANDLE)_handle, (LONG)count, NULL);
+}
+
+void Semaphore::wait()
+{
+    WaitForSingleObject((HANDLE)_handle, INFINITE);
+}
+
+struct ThreadEntry
+{
+    static DWORD WINAPI run(LPVOID arg)
+    {
+        Thread* thread = (Thread*)arg;
+        thread->_function(thread->_arg);
+        return 0;
+    }
+};
+
+Thread* Thread::create(ThreadFunction function, void* arg)
+{
+    GP_ASSERT(function);
+
+    Thread* thread = new Thread();
+    thread->_function = function;
+    thread->_arg = arg;
+    thread->_handle = CreateThread(NULL, 0, ThreadEntry::run, thread, 0, NULL);
+    if (thread->_handle == NULL)
+    {
+        GP_WARN("Failed to create thread.");
+        thread->_joined = true;
+        SAFE_DELETE(thread);
+    }
+    return thread;
+}
+
+void Thread::join()
+{
+    if (!_joined)
+    {
+        WaitForSingleObject((HANDLE)_handle, INFINITE);
+        CloseHandle((HANDLE)_handle);
+        _joined = true;
+    }
+}
+
+unsigned int Thread::getCurrentId()
+{
+    static __declspec(thread) unsigned int id = 0;
+    if (id == 0)
+        id = (unsigned int)atomicIncrement(&__threadIdCounter);
+    return id - 1;
+}
+
+void Thread::yield()
+{
+    SwitchToThread();
+}
+
+unsigned int Thread::getProcessorCount()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+// Note: pthread based semaphores are used rather than sem_t since unnamed POSIX semaphores are not supported on Apple platforms.
+struct SemaphoreHandle
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    unsigned int count;
+};
+
+static pthread_key_t __threadIdKey;
+static pthread_once_t __threadIdKeyOnce = PTHREAD_ONCE_INIT;
+
+static void createThreadIdKey()
+{
+    pthread_key_create(&__threadIdKey, NULL);
+}
+
+Mutex::Mutex()
+{
+    pthread_mutex_t* mutex = new pthread_mutex_t;
+    pthread_mutex_init(mutex, NULL);
+    _handle = mutex;
+}
+
+Mutex::~Mutex()
+{
+    pthread_mutex_t* mutex = (pthread_mutex_t*)_handle;
+    pthread_mutex_destroy(mutex);
+    delete mutex;
+}
+
+void Mutex::lock()
+{
+    pthread_mutex_lock((pthread_mutex_t*)_handle);
+}
+
+bool Mutex::tryLock()
+{
+    return pthread_mutex_trylock((pthread_mutex_t*)_handle) == 0;
+}
+
+void Mutex::unlock()
+{
+    pthread_mutex_unlock((pthread_mutex_t*)_handle);
+}
+
+Semaphore::Semaphore(unsigned int count)
+{
+    SemaphoreHandle* handle = new SemaphoreHandle();
+    pthread_mutex_init(&handle->mutex, NULL);
+    pthread_cond_init(&handle->condition, NULL);
+    handle->count = count;
+    _handle = handle;
+}
+
+Semaphore::~Semaphore()
+{
+    SemaphoreHandle* handle = (SemaphoreHandle*)_handle;
+    pthread_cond_destroy(&handle->condition);
+    pthread_mutex_destroy(&handle->mutex);
+    delete handle;
+}
+
+void Semaphore::post(unsigned int count)
+{
+    SemaphoreHandle* handle = (SemaphoreHandle*)_handle;
+    pthread_mutex_lock(&handle->mutex);
+    handle->count += count;
+    if (count == 1)
+        pthread_cond_signal(&handle->condition);
+    else
+        pthread_cond_broadcast(&handle->condition);
+    pthread_mutex_unlock(&handle->mutex);
+}
+
+void Semaphore::wait()
+{
+    SemaphoreHandle* handle = (SemaphoreHandle*)_handle;
+    pthread_mutex_lock(&handle->mutex);
+    while (handle->count == 0)
+        pthread_cond_wait(&handle->condition, &handle->mutex);
+    --handle->count;
+    pthread_mutex_unlock(&handle->mutex);
+}
+
+struct ThreadEntry
+{
+    static void* run(void* arg)
+    {
+        Thread* thread = (Thread*)arg;
+        thread->_function(thread->_arg);
+        return NULL;
+    }
+};
+
+Thread* Thread::create(ThreadFunction function, void* arg)
+{
+    GP_ASSERT(function);
+
+    Thread* thread = new Thread();
+    thread->_function = function;
+    thread->_arg = arg;
+    pthread_t* handle = new pthread_t;
+    thread->_handle = handle;
+    if (pthread_create(handle, NULL, ThreadEntry::run, thread) != 0)
+    {
+        GP_WARN("Failed to create thread.");
+        thread->_joined = true;
+        SAFE_DELETE(thread);
+    }
+    return thread;
+}
+
+void Thread::join()
+{
+    if (!_joined)
+    {
+        pthread_join(*(pthread_t*)_handle, NULL);
+        _joined = true;
+    }
+}
+
+unsigned int Thread::getCurrentId()
+{
+    pthread_once(&__threadIdKeyOnce, createThreadIdKey);
+    size_t id = (size_t)pthread_getspecific(__threadIdKey);
+    if (id == 0)
+    {
+        id = (size_t)atomicIncrement(&__threadIdCounter);
+        pthread_setspecific(__threadIdKey, (void*)id);
+    }
+    return (unsigned int)(id - 1);
+}
+
+void Thread::yield()
+{
+    sched_yield();
+}
+
+unsigned int Thread::getProcessorCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned int)count : 1;
+}
+
+#endif
+
+Thread::Thread()
+    : _handle(NULL), _function(NULL), _arg(NULL), _joined(false)
+{
+}
+
+Thread::~Thread()
+{
+    GP_ASSERT(_joined);
+#ifndef WIN32
+    delete (pthread_t*)_handle;
+#endif
+}
+
+}
@@ -0,0 +1,343 @@
+#ifndef THREAD_H_
+#define THREAD_H_
+
+#ifdef WIN32
+#include <intrin.h>
+#endif
+
+namespace gameplay
+{
+
+/**
+ * Defines a mutual exclusion lock for serializing access to data shared between threads.
+ *
+ * @script{ignore}
+ */
+class Mutex
+{
+public:
+
+    /**
+     * Constructor.
+     */
+    Mutex();
+
+    /**
+     * Destructor.
+     */
+    ~Mutex();
+
+    /**
+     * Acquires the lock, blocking the calling thread until it is available.
+     */
+    void lock();
+
+    /**
+     * Attempts to acquire the lock without blocking.
+     *
+     * @return true if the lock was acquired; false if it is held by another thread.
+     */
+    bool tryLock();
+
+    /**
+     * Releases the lock.
+     */
+    void unlock();
+
+private:
+
+    /**
+     * Hidden copy constructor.
+     */
+    Mutex(const Mutex& copy);
+
+    /**
+     * Hidden copy assignment operator.
+     */
+    Mutex& operator=(const Mutex&);
+
+    void* _handle;
+};
+
+/**
+ * Acquires a Mutex for the lifetime of the lock object.
+ *
+ * @script{ignore}
+ */
+class MutexLock
+{
+public:
+
+    /**
+     * Constructor. Locks the specified mutex.
+     *
+     * @param mutex The mutex to lock.
+     */
+    explicit MutexLock(Mutex& mutex) : _mutex(mutex) { _mutex.lock(); }
+
+    /**
+     * Destructor. Unlocks the mutex.
+     */
+    ~MutexLock() { _mutex.unlock(); }
+
+private:
+
+    MutexLock(const MutexLock& copy);
+    MutexLock& operator=(const MutexLock&);
+
+    Mutex& _mutex;
+};
+
+/**
+ * Defines a counting semaphore used to put threads to sleep until work is available.
+ *
+ * @script{ignore}
+ */
+class Semaphore
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param count The initial count of the semaphore.
+     */
+    Semaphore(unsigned int count = 0);
+
+    /**
+     * Destructor.
+     */
+    ~Semaphore();
+
+    /**
+     * Increments the semaphore count, waking up to count waiting threads.
+     *
+     * @param count The amount to increment by.
+     */
+    void post(unsigned int count = 1);
+
+    /**
+     * Blocks the calling thread until the semaphore count is non-zero and then decrements it.
+     */
+    void wait();
+
+private:
+
+    Semaphore(const Semaphore& copy);
+    Semaphore& operator=(const Semaphore&);
+
+    void* _handle;
+};
+
+/**
+ * Defines a native thread of execution.
+ *
+ * @script{ignore}
+ */
+class Thread
+{
+public:
+
+    /**
+     * The function signature for a thread entry point.
+     */
+    typedef void (*ThreadFunction)(void* arg);
+
+    /**
+     * Creates and starts a new thread.
+     *
+     * @param function The function to run on the new thread.
+     * @param arg The argument passed to the function.
+     *
+     * @return The new thread or NULL if the thread could not be created.
+     */
+    static Thread* create(ThreadFunction function, void* arg);
+
+    /**
+     * Destructor. The thread must have been joined before it is destroyed.
+     */
+    ~Thread();
+
+    /**
+     * Blocks the calling thread until this thread has finished running.
+     */
+    void join();
+
+    /**
+     * Gets a small, process unique identifier for the calling thread.
+     *
+     * Identifiers are assigned in the order threads first call this method.
+     *
+     * @return The identifier of the calling thread.
+     */
+    static unsigned int getCurrentId();
+
+    /**
+     * Yields the remainder of the calling thread's time slice.
+     */
+    static void yield();
+
+    /**
+     * Gets the number of logical processors available to the process.
+     *
+     * @return The number of logical processors (at least one).
+     */
+    static unsigned int getProcessorCount();
+
+private:
+
+    Thread();
+    Thread(const Thread& copy);
+    Thread& operator=(const Thread&);
+
+    void* _handle;
+    ThreadFunction _function;
+    void* _arg;
+    bool _joined;
+
+    friend struct ThreadEntry;
+};
+
+/**
+ * Atomically increments the specified value.
+ *
+ * @param value The value to increment.
+ * @return The incremented value.
+ * @script{ignore}
+ */
+inline int atomicIncrement(volatile int* value)
+{
+#ifdef WIN32
+    return (int)_InterlockedIncrement((volatile long*)value);
+#else
+    return __sync_add_and_fetch(value, 1);
+#endif
+}
+
+/**
+ * Atomically decrements the specified value.
+ *
+ * @param value The value to decrement.
+ * @return The decremented value.
+ * @script{ignore}
+ */
+inline int atomicDecrement(volatile int* value)
+{
+#ifdef WIN32
+    return (int)_InterlockedDecrement((volatile long*)value);
+#else
+    return __sync_sub_and_fetch(value, 1);
+#endif
+}
+
+/**
+ * Atomically adds the specified amount to a value.
+ *
+ * @param value The value to add to.
+ * @param amount The amount to add.
+ * @return The value before the addition.
+ * @script{ignore}
+ */
+inline int atomicAdd(volatile int* value, int amount)
+{
+#ifdef WIN32
+    return (int)_InterlockedExchangeAdd((volatile long*)value, (long)amount);
+#else
+    return __sync_fetch_and_add(value, amount);
+#endif
+}
+
+/**
+ * Atomically replaces a value if it currently holds an expected value.
+ *
+ * @param value The value to update.
+ * @param expected The value expected to be currently held.
+ * @param desired The value to store if the current value matches.
+ * @return true if the value was replaced; false otherwise.
+ * @script{ignore}
+ */
+inline bool atomicCompareAndSwap(volatile int* value, int expected, int desired)
+{
+#ifdef WIN32
+    return _InterlockedCompareExchange((volatile long*)value, (long)desired, (long)expected) == (long)expected;
+#else
+    return __sync_bool_compare_and_swap(value, expected, desired);
+#endif
+}
+
+/**
+ * Atomically reads a value shared between threads.
+ *
+ * @param value The value to read.
+ * @return The current value.
+ * @script{ignore}
+ */
+inline int atomicLoad(const volatile int* value)
+{
+#ifdef WIN32
+    return (int)_InterlockedCompareExchange((volatile long*)value, 0, 0);
+#else
+    return __sync_fetch_and_add(const_cast<volatile int*>(value), 0);
+#endif
+}
+
+/**
+ * Atomically replaces a 64-bit value if it currently holds an expected value.
+ *
+ * @param value The value to update.
+ * @param expected The value expected to be currently held.
+ * @param desired The value to store if the current value matches.
+ * @return true if the value was replaced; false otherwise.
+ * @script{ignore}
+ */
+inline bool atomicCompareAndSwap(volatile long long* value, long long expected, long long desired)
+{
+#ifdef WIN32
+    return _InterlockedCompareExchange64(value, desired, expected) == expected;
+#else
+    return __sync_bool_compare_and_swap(value, expected, desired);
+#endif
+}
+
+/**
+ * Atomically adds the specified amount to a 64-bit value.
+ *
+ * @param value The value to add to.
+ * @param amount The amount to add.
+ * @return The value before the addition.
+ * @script{ignore}
+ */
+inline long long atomicAdd(volatile long long* value, long long amount)
+{
+#ifdef WIN32
+    // There is no 64-bit exchange-add intrinsic on 32-bit x86, so compare and swap until it succeeds.
+    long long previous;
+    do
+    {
+        previous = *value;
+    } while (_InterlockedCompareExchange64(value, previous + amount, previous) != previous);
+    return previous;
+#else
+    return __sync_fetch_and_add(value, amount);
+#endif
+}
+
+/**
+ * Atomically reads a 64-bit value shared between threads.
+ *
+ * @param value The value to read.
+ * @return The current value.
+ * @script{ignore}
+ */
+inline long long atomicLoad(const volatile long long* value)
+{
+#ifdef WIN32
+    return _InterlockedCompareExchange64(const_cast<volatile long long*>(value), 0, 0);
+#else
+    return __sync_fetch_and_add(const_cast<volatile long long*>(value), 0);
+#endif
+}
+
+}
+
+#endif
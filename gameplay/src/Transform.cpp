@@ -824,7 +824,7 @@ void Transform::addListener(Transform::Listener* listener, long cookie)
     GP_ASSERT(listener);
 
     if (_listeners == NULL)
-        _listeners = new std::list<TransformListener>();
+        _listeners = new std::vector<TransformListener>();
 
     TransformListener l;
     l.listener = listener;
@@ -838,7 +838,7 @@ void Transform::removeListener(Transform::Listener* listener)
 
     if (_listeners)
     {
-        for (std::list<TransformListener>::iterator itr = _listeners->begin(); itr != _listeners->end(); ++itr)
+        for (std::vector<TransformListener>::iterator itr = _listeners->begin(); itr != _listeners->end(); ++itr)
         {
             if ((*itr).listener == listener)
             {
@@ -853,9 +853,10 @@ void Transform::transformChanged()
 {
     if (_listeners)
     {
-        for (std::list<TransformListener>::iterator itr = _listeners->begin(); itr != _listeners->end(); ++itr)
+        // Index the listeners, since a listener may add or remove listeners while it is notified.
+        for (size_t i = 0; i < _listeners->size(); ++i)
         {
-            TransformListener& l = *itr;
+            TransformListener& l = (*_listeners)[i];
             GP_ASSERT(l.listener);
             l.listener->transformChanged(this, l.cookie);
         }
@@ -882,4 +883,154 @@ void Transform::applyAnimationValueRotation(AnimationValue* value, unsigned int
     dirty(DIRTY_ROTATION);
 }
 
+static inline void blendScale(Vector3& scale, const float* value, float blendWeight)
+{
+    scale.set(Curve::lerp(blendWeight, scale.x, value[0]), Curve::lerp(blendWeight, scale.y, value[1]), Curve::lerp(blendWeight, scale.z, value[2]));
+}
+
+static inline void blendRotation(Quaternion& rotation, const float* value, float blendWeight)
+{
+    Quaternion::slerp(rotation, Quaternion(value[0], value[1], value[2], value[3]), blendWeight, &rotation);
+}
+
+static inline void blendTranslation(Vector3& translation, const float* value, float blendWeight)
+{
+    translation.set(Curve::lerp(blendWeight, translation.x, value[0]), Curve::lerp(blendWeight, translation.y, value[1]), Curve::lerp(blendWeight, translation.z, value[2]));
+}
+
+void Transform::applyAnimationValues(Transform* const* targets, const int* propertyIds, const float* const* values, const float* blendWeights, size_t count)
+{
+    GP_ASSERT((targets && propertyIds && values && blendWeights) || count == 0);
+
+    // Blend every value into the transform data first.
+    for (size_t i = 0; i < count; i++)
+    {
+        Transform* t = targets[i];
+        const float* value = values[i];
+        float blendWeight = blendWeights[i];
+        GP_ASSERT(t && value);
+        GP_ASSERT(blendWeight >= 0.0f && blendWeight <= 1.0f);
+
+        switch (propertyIds[i])
+        {
+            case ANIMATE_SCALE_UNIT:
+            {
+                float scale = Curve::lerp(blendWeight, t->_scale.x, value[0]);
+                t->_scale.set(scale, scale, scale);
+                break;
+            }
+            case ANIMATE_SCALE:
+            {
+                blendScale(t->_scale, value, blendWeight);
+                break;
+            }
+            case ANIMATE_SCALE_X:
+            {
+                t->_scale.x = Curve::lerp(blendWeight, t->_scale.x, value[0]);
+                break;
+            }
+            case ANIMATE_SCALE_Y:
+            {
+                t->_scale.y = Curve::lerp(blendWeight, t->_scale.y, value[0]);
+                break;
+            }
+            case ANIMATE_SCALE_Z:
+            {
+                t->_scale.z = Curve::lerp(blendWeight, t->_scale.z, value[0]);
+                break;
+            }
+            case ANIMATE_ROTATE:
+            {
+                blendRotation(t->_rotation, value, blendWeight);
+                break;
+            }
+            case ANIMATE_TRANSLATE:
+            {
+                blendTranslation(t->_translation, value, blendWeight);
+                break;
+            }
+            case ANIMATE_TRANSLATE_X:
+            {
+                t->_translation.x = Curve::lerp(blendWeight, t->_translation.x, value[0]);
+                break;
+            }
+            case ANIMATE_TRANSLATE_Y:
+            {
+                t->_translation.y = Curve::lerp(blendWeight, t->_translation.y, value[0]);
+                break;
+            }
+            case ANIMATE_TRANSLATE_Z:
+            {
+                t->_translation.z = Curve::lerp(blendWeight, t->_translation.z, value[0]);
+                break;
+            }
+            case ANIMATE_ROTATE_TRANSLATE:
+            {
+                blendRotation(t->_rotation, value, blendWeight);
+                blendTranslation(t->_translation, value + 4, blendWeight);
+                break;
+            }
+            case ANIMATE_SCALE_ROTATE:
+            {
+                blendScale(t->_scale, value, blendWeight);
+                blendRotation(t->_rotation, value + 3, blendWeight);
+                break;
+            }
+            case ANIMATE_SCALE_TRANSLATE:
+            {
+                blendScale(t->_scale, value, blendWeight);
+                blendTranslation(t->_translation, value + 3, blendWeight);
+                break;
+            }
+            case ANIMATE_SCALE_ROTATE_TRANSLATE:
+            {
+                blendScale(t->_scale, value, blendWeight);
+                blendRotation(t->_rotation, value + 3, blendWeight);
+                blendTranslation(t->_translation, value + 7, blendWeight);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Then mark the targets dirty. A target animated by several channels is only queued for notification once.
+    for (size_t i = 0; i < count; i++)
+    {
+        char dirtyBits = getAnimationPropertyDirtyBits(propertyIds[i]);
+        if (dirtyBits)
+            targets[i]->dirty(dirtyBits);
+    }
+}
+
+char Transform::getAnimationPropertyDirtyBits(int propertyId)
+{
+    switch (propertyId)
+    {
+        case ANIMATE_SCALE_UNIT:
+        case ANIMATE_SCALE:
+        case ANIMATE_SCALE_X:
+        case ANIMATE_SCALE_Y:
+        case ANIMATE_SCALE_Z:
+            return DIRTY_SCALE;
+        case ANIMATE_ROTATE:
+            return DIRTY_ROTATION;
+        case ANIMATE_TRANSLATE:
+        case ANIMATE_TRANSLATE_X:
+        case ANIMATE_TRANSLATE_Y:
+        case ANIMATE_TRANSLATE_Z:
+            return DIRTY_TRANSLATION;
+        case ANIMATE_ROTATE_TRANSLATE:
+            return DIRTY_ROTATION | DIRTY_TRANSLATION;
+        case ANIMATE_SCALE_ROTATE:
+            return DIRTY_SCALE | DIRTY_ROTATION;
+        case ANIMATE_SCALE_TRANSLATE:
+            return DIRTY_SCALE | DIRTY_TRANSLATION;
+        case ANIMATE_SCALE_ROTATE_TRANSLATE:
+            return DIRTY_SCALE | DIRTY_ROTATION | DIRTY_TRANSLATION;
+        default:
+            return 0;
+    }
+}
+
 }
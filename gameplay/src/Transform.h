@@ -31,6 +31,8 @@ class ScriptListener;
  */
 class Transform : public AnimationTarget, public ScriptTarget
 {
+    friend class AnimationController;
+
 public:
 
     /**
@@ -867,12 +869,32 @@ protected:
     /** 
      * List of TransformListener's on the Transform.
      */
-    std::list<TransformListener>* _listeners;
+    std::vector<TransformListener>* _listeners;
 
 private:
-   
+
     void applyAnimationValueRotation(AnimationValue* value, unsigned int index, float blendWeight);
 
+    /**
+     * Blends a batch of animation values into their target transforms.
+     *
+     * The values are blended in order, exactly as setAnimationPropertyValue() would blend them, but are
+     * written straight into the scale, rotation and translation of each transform. The targets are then
+     * marked dirty in a single pass once every value has been written.
+     *
+     * @param targets The transform to blend each value into.
+     * @param propertyIds The animated property of each value.
+     * @param values The values to blend.
+     * @param blendWeights The blend weight of each value.
+     * @param count The number of values.
+     */
+    static void applyAnimationValues(Transform* const* targets, const int* propertyIds, const float* const* values, const float* blendWeights, size_t count);
+
+    /**
+     * Gets the matrix dirty bits for the components changed by the specified animation property.
+     */
+    static char getAnimationPropertyDirtyBits(int propertyId);
+
     static int _suspendTransformChanged;
     static std::vector<Transform*> _transformsChanged;
     
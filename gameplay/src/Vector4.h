@@ -1,6 +1,16 @@
 #ifndef VECTOR4_H_
 #define VECTOR4_H_
 
+// Aligns a type to the given number of bytes. Defined here rather than in Base.h,
+// since the math headers are shared with gameplay-encoder.
+#ifndef GP_ALIGN
+#ifdef _MSC_VER
+    #define GP_ALIGN(alignment) __declspec(align(alignment))
+#else
+    #define GP_ALIGN(alignment) __attribute__((aligned(alignment)))
+#endif
+#endif
+
 namespace gameplay
 {
 
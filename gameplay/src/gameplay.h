@@ -38,6 +38,8 @@
 #include "VertexFormat.h"
 #include "VertexAttributeBinding.h"
 #include "Model.h"
+#include "InstanceBuffer.h"
+#include "RenderQueue.h"
 #include "Camera.h"
 #include "Light.h"
 #include "Scene.h"
@@ -7,18 +7,25 @@ namespace gameplay
 // Lua bindings for Font.
 int lua_Font__gc(lua_State* state);
 int lua_Font_addRef(lua_State* state);
+int lua_Font_clearLayoutCache(lua_State* state);
 int lua_Font_createText(lua_State* state);
 int lua_Font_drawText(lua_State* state);
 int lua_Font_finish(lua_State* state);
+int lua_Font_getFormat(lua_State* state);
 int lua_Font_getIndexAtLocation(lua_State* state);
+int lua_Font_getLayoutCacheCapacity(lua_State* state);
+int lua_Font_getLayoutCacheHits(lua_State* state);
+int lua_Font_getLayoutCacheMisses(lua_State* state);
 int lua_Font_getLocationAtIndex(lua_State* state);
 int lua_Font_getRefCount(lua_State* state);
 int lua_Font_getSize(lua_State* state);
 int lua_Font_getSpriteBatch(lua_State* state);
 int lua_Font_measureText(lua_State* state);
 int lua_Font_release(lua_State* state);
+int lua_Font_setLayoutCacheCapacity(lua_State* state);
 int lua_Font_start(lua_State* state);
 int lua_Font_static_create(lua_State* state);
+int lua_Font_static_createDynamic(lua_State* state);
 int lua_Font_static_getJustify(lua_State* state);
 
 void luaRegister_Font();
@@ -670,6 +670,78 @@ int lua_Frustum_intersects(lua_State* state)
                 }
             } while (0);
 
+            do
+            {
+                if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                    (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL) &&
+                    lua_type(state, 3) == LUA_TNUMBER &&
+                    (lua_type(state, 4) == LUA_TTABLE || lua_type(state, 4) == LUA_TNIL))
+                {
+                    // Get parameter 1 off the stack.
+                    bool param1Valid;
+                    ScriptUtil::LuaArray<BoundingSphere> param1 = ScriptUtil::getObjectPointer<BoundingSphere>(2, "BoundingSphere", false, &param1Valid);
+                    if (!param1Valid)
+                        break;
+
+                    // Get parameter 2 off the stack.
+                    unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 3);
+
+                    // The kernel reads count elements without checking the array.
+                    if (param2 > 0 && (!param1 || param2 > ScriptUtil::getArrayLength(2)))
+                        return luaL_error(state, "lua_Frustum_intersects - The count (%d) is larger than the number of elements in the array.", (int)param2);
+
+                    // Get parameter 3 off the stack (nil when only the number of intersections is needed).
+                    // The results are only written, so the table is filled in rather than read.
+                    bool hasResults = lua_type(state, 4) == LUA_TTABLE;
+                    ScriptUtil::LuaArray<bool> param3(hasResults ? (int)param2 : 0);
+
+                    Frustum* instance = getInstance(state);
+                    unsigned int result = instance->intersects(param1, param2, hasResults ? (bool*)param3 : NULL);
+                    ScriptUtil::setBoolArray(4, param3, param2);
+
+                    // Push the return value onto the stack.
+                    lua_pushunsigned(state, result);
+
+                    return 1;
+                }
+            } while (0);
+
+            do
+            {
+                if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                    (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL) &&
+                    lua_type(state, 3) == LUA_TNUMBER &&
+                    (lua_type(state, 4) == LUA_TTABLE || lua_type(state, 4) == LUA_TNIL))
+                {
+                    // Get parameter 1 off the stack.
+                    bool param1Valid;
+                    ScriptUtil::LuaArray<BoundingBox> param1 = ScriptUtil::getObjectPointer<BoundingBox>(2, "BoundingBox", false, &param1Valid);
+                    if (!param1Valid)
+                        break;
+
+                    // Get parameter 2 off the stack.
+                    unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 3);
+
+                    // The kernel reads count elements without checking the array.
+                    if (param2 > 0 && (!param1 || param2 > ScriptUtil::getArrayLength(2)))
+                        return luaL_error(state, "lua_Frustum_intersects - The count (%d) is larger than the number of elements in the array.", (int)param2);
+
+                    // Get parameter 3 off the stack (nil when only the number of intersections is needed).
+                    // The results are only written, so the table is filled in rather than read.
+                    bool hasResults = lua_type(state, 4) == LUA_TTABLE;
+                    ScriptUtil::LuaArray<bool> param3(hasResults ? (int)param2 : 0);
+
+                    Frustum* instance = getInstance(state);
+                    unsigned int result = instance->intersects(param1, param2, hasResults ? (bool*)param3 : NULL);
+                    ScriptUtil::setBoolArray(4, param3, param2);
+
+                    // Push the return value onto the stack.
+                    lua_pushunsigned(state, result);
+
+                    return 1;
+                }
+            } while (0);
+
             lua_pushstring(state, "lua_Frustum_intersects - Failed to match the given parameters to a valid function signature.");
             lua_error(state);
             break;
@@ -0,0 +1,24 @@
+#ifndef LUA_INSTANCEBUFFER_H_
+#define LUA_INSTANCEBUFFER_H_
+
+namespace gameplay
+{
+
+// Lua bindings for InstanceBuffer.
+int lua_InstanceBuffer__gc(lua_State* state);
+int lua_InstanceBuffer_add(lua_State* state);
+int lua_InstanceBuffer_addRef(lua_State* state);
+int lua_InstanceBuffer_clear(lua_State* state);
+int lua_InstanceBuffer_getCapacity(lua_State* state);
+int lua_InstanceBuffer_getInstanceCount(lua_State* state);
+int lua_InstanceBuffer_getRefCount(lua_State* state);
+int lua_InstanceBuffer_release(lua_State* state);
+int lua_InstanceBuffer_set(lua_State* state);
+int lua_InstanceBuffer_static_create(lua_State* state);
+int lua_InstanceBuffer_static_isHardwareInstancingSupported(lua_State* state);
+
+void luaRegister_InstanceBuffer();
+
+}
+
+#endif
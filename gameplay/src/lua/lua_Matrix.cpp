@@ -41,7 +41,9 @@ void luaRegister_Matrix()
         {"setZero", lua_Matrix_setZero},
         {"subtract", lua_Matrix_subtract},
         {"transformPoint", lua_Matrix_transformPoint},
+        {"transformPoints", lua_Matrix_transformPoints},
         {"transformVector", lua_Matrix_transformVector},
+        {"transformVectors", lua_Matrix_transformVectors},
         {"translate", lua_Matrix_translate},
         {"transpose", lua_Matrix_transpose},
         {NULL, NULL}
@@ -3070,6 +3072,98 @@ int lua_Matrix_transformPoint(lua_State* state)
     return 0;
 }
 
+int lua_Matrix_transformPoints(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 4:
+        {
+            do
+            {
+                if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                    (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL) &&
+                    lua_type(state, 3) == LUA_TNUMBER &&
+                    (lua_type(state, 4) == LUA_TUSERDATA || lua_type(state, 4) == LUA_TTABLE || lua_type(state, 4) == LUA_TNIL))
+                {
+                    // Get parameter 1 off the stack.
+                    bool param1Valid;
+                    ScriptUtil::LuaArray<Vector3> param1 = ScriptUtil::getObjectPointer<Vector3>(2, "Vector3", false, &param1Valid);
+                    if (!param1Valid)
+                        break;
+
+                    // Get parameter 2 off the stack.
+                    unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 3);
+
+                    // Get parameter 3 off the stack.
+                    bool param3Valid;
+                    ScriptUtil::LuaArray<Vector3> param3 = ScriptUtil::getObjectPointer<Vector3>(4, "Vector3", false, &param3Valid);
+                    if (!param3Valid)
+                        break;
+
+                    // The kernel reads and writes count elements without checking the arrays.
+                    if (param2 > 0 && (!param1 || !param3 || param2 > ScriptUtil::getArrayLength(2) || param2 > ScriptUtil::getArrayLength(4)))
+                        return luaL_error(state, "lua_Matrix_transformPoints - The count (%d) is larger than the number of elements in the arrays.", (int)param2);
+
+                    Matrix* instance = getInstance(state);
+                    instance->transformPoints(param1, param2, param3);
+                    ScriptUtil::setObjectArray(4, param3, param2);
+                    
+                    return 0;
+                }
+            } while (0);
+
+            do
+            {
+                if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                    (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL) &&
+                    lua_type(state, 3) == LUA_TNUMBER &&
+                    (lua_type(state, 4) == LUA_TUSERDATA || lua_type(state, 4) == LUA_TTABLE || lua_type(state, 4) == LUA_TNIL))
+                {
+                    // Get parameter 1 off the stack.
+                    bool param1Valid;
+                    ScriptUtil::LuaArray<Vector3> param1 = ScriptUtil::getObjectPointer<Vector3>(2, "Vector3", false, &param1Valid);
+                    if (!param1Valid)
+                        break;
+
+                    // Get parameter 2 off the stack.
+                    unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 3);
+
+                    // Get parameter 3 off the stack.
+                    bool param3Valid;
+                    ScriptUtil::LuaArray<Vector4> param3 = ScriptUtil::getObjectPointer<Vector4>(4, "Vector4", false, &param3Valid);
+                    if (!param3Valid)
+                        break;
+
+                    // The kernel reads and writes count elements without checking the arrays.
+                    if (param2 > 0 && (!param1 || !param3 || param2 > ScriptUtil::getArrayLength(2) || param2 > ScriptUtil::getArrayLength(4)))
+                        return luaL_error(state, "lua_Matrix_transformPoints - The count (%d) is larger than the number of elements in the arrays.", (int)param2);
+
+                    Matrix* instance = getInstance(state);
+                    instance->transformPoints(param1, param2, param3);
+                    ScriptUtil::setObjectArray(4, param3, param2);
+                    
+                    return 0;
+                }
+            } while (0);
+
+            lua_pushstring(state, "lua_Matrix_transformPoints - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 4).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Matrix_transformVector(lua_State* state)
 {
     // Get the number of parameters.
@@ -3226,6 +3320,67 @@ int lua_Matrix_transformVector(lua_State* state)
     return 0;
 }
 
+int lua_Matrix_transformVectors(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 4:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL) &&
+                lua_type(state, 3) == LUA_TNUMBER &&
+                (lua_type(state, 4) == LUA_TUSERDATA || lua_type(state, 4) == LUA_TTABLE || lua_type(state, 4) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                bool param1Valid;
+                ScriptUtil::LuaArray<Vector3> param1 = ScriptUtil::getObjectPointer<Vector3>(2, "Vector3", false, &param1Valid);
+                if (!param1Valid)
+                {
+                    lua_pushstring(state, "Failed to convert parameter 1 to type 'Vector3'.");
+                    lua_error(state);
+                }
+
+                // Get parameter 2 off the stack.
+                unsigned int param2 = (unsigned int)luaL_checkunsigned(state, 3);
+
+                // Get parameter 3 off the stack.
+                bool param3Valid;
+                ScriptUtil::LuaArray<Vector3> param3 = ScriptUtil::getObjectPointer<Vector3>(4, "Vector3", false, &param3Valid);
+                if (!param3Valid)
+                {
+                    lua_pushstring(state, "Failed to convert parameter 3 to type 'Vector3'.");
+                    lua_error(state);
+                }
+
+                // The kernel reads and writes count elements without checking the arrays.
+                if (param2 > 0 && (!param1 || !param3 || param2 > ScriptUtil::getArrayLength(2) || param2 > ScriptUtil::getArrayLength(4)))
+                    return luaL_error(state, "lua_Matrix_transformVectors - The count (%d) is larger than the number of elements in the arrays.", (int)param2);
+
+                Matrix* instance = getInstance(state);
+                instance->transformVectors(param1, param2, param3);
+                ScriptUtil::setObjectArray(4, param3, param2);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_Matrix_transformVectors - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 4).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Matrix_translate(lua_State* state)
 {
     // Get the number of parameters.
@@ -51,7 +51,9 @@ int lua_Matrix_static_subtract(lua_State* state);
 int lua_Matrix_static_zero(lua_State* state);
 int lua_Matrix_subtract(lua_State* state);
 int lua_Matrix_transformPoint(lua_State* state);
+int lua_Matrix_transformPoints(lua_State* state);
 int lua_Matrix_transformVector(lua_State* state);
+int lua_Matrix_transformVectors(lua_State* state);
 int lua_Matrix_translate(lua_State* state);
 int lua_Matrix_transpose(lua_State* state);
 
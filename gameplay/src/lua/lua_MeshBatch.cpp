@@ -16,7 +16,9 @@ void luaRegister_MeshBatch()
         {"finish", lua_MeshBatch_finish},
         {"getCapacity", lua_MeshBatch_getCapacity},
         {"getMaterial", lua_MeshBatch_getMaterial},
+        {"isStreamingEnabled", lua_MeshBatch_isStreamingEnabled},
         {"setCapacity", lua_MeshBatch_setCapacity},
+        {"setStreamingEnabled", lua_MeshBatch_setStreamingEnabled},
         {"start", lua_MeshBatch_start},
         {NULL, NULL}
     };
@@ -218,6 +220,41 @@ int lua_MeshBatch_getMaterial(lua_State* state)
     return 0;
 }
 
+int lua_MeshBatch_isStreamingEnabled(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                MeshBatch* instance = getInstance(state);
+                bool result = instance->isStreamingEnabled();
+
+                // Push the return value onto the stack.
+                lua_pushboolean(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_MeshBatch_isStreamingEnabled - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_MeshBatch_setCapacity(lua_State* state)
 {
     // Get the number of parameters.
@@ -254,6 +291,42 @@ int lua_MeshBatch_setCapacity(lua_State* state)
     return 0;
 }
 
+int lua_MeshBatch_setStreamingEnabled(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TBOOLEAN)
+            {
+                // Get parameter 1 off the stack.
+                bool param1 = ScriptUtil::luaCheckBool(state, 2);
+
+                MeshBatch* instance = getInstance(state);
+                instance->setStreamingEnabled(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_MeshBatch_setStreamingEnabled - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_MeshBatch_start(lua_State* state)
 {
     // Get the number of parameters.
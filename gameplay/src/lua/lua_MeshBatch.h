@@ -10,7 +10,9 @@ int lua_MeshBatch_draw(lua_State* state);
 int lua_MeshBatch_finish(lua_State* state);
 int lua_MeshBatch_getCapacity(lua_State* state);
 int lua_MeshBatch_getMaterial(lua_State* state);
+int lua_MeshBatch_isStreamingEnabled(lua_State* state);
 int lua_MeshBatch_setCapacity(lua_State* state);
+int lua_MeshBatch_setStreamingEnabled(lua_State* state);
 int lua_MeshBatch_start(lua_State* state);
 int lua_MeshBatch_static_create(lua_State* state);
 
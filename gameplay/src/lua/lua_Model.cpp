@@ -20,6 +20,7 @@ void luaRegister_Model()
     {
         {"addRef", lua_Model_addRef},
         {"draw", lua_Model_draw},
+        {"drawInstanced", lua_Model_drawInstanced},
         {"getMaterial", lua_Model_getMaterial},
         {"getMesh", lua_Model_getMesh},
         {"getMeshPartCount", lua_Model_getMeshPartCount},
@@ -169,6 +170,76 @@ int lua_Model_draw(lua_State* state)
     return 0;
 }
 
+int lua_Model_drawInstanced(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                bool param1Valid;
+                ScriptUtil::LuaArray<InstanceBuffer> param1 = ScriptUtil::getObjectPointer<InstanceBuffer>(2, "InstanceBuffer", false, &param1Valid);
+                if (!param1Valid)
+                {
+                    lua_pushstring(state, "Failed to convert parameter 1 to type 'InstanceBuffer'.");
+                    lua_error(state);
+                }
+
+                Model* instance = getInstance(state);
+                instance->drawInstanced(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_Model_drawInstanced - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        case 3:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL) &&
+                lua_type(state, 3) == LUA_TBOOLEAN)
+            {
+                // Get parameter 1 off the stack.
+                bool param1Valid;
+                ScriptUtil::LuaArray<InstanceBuffer> param1 = ScriptUtil::getObjectPointer<InstanceBuffer>(2, "InstanceBuffer", false, &param1Valid);
+                if (!param1Valid)
+                {
+                    lua_pushstring(state, "Failed to convert parameter 1 to type 'InstanceBuffer'.");
+                    lua_error(state);
+                }
+
+                // Get parameter 2 off the stack.
+                bool param2 = ScriptUtil::luaCheckBool(state, 3);
+
+                Model* instance = getInstance(state);
+                instance->drawInstanced(param1, param2);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_Model_drawInstanced - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2 or 3).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Model_getMaterial(lua_State* state)
 {
     // Get the number of parameters.
@@ -8,6 +8,7 @@ namespace gameplay
 int lua_Model__gc(lua_State* state);
 int lua_Model_addRef(lua_State* state);
 int lua_Model_draw(lua_State* state);
+int lua_Model_drawInstanced(lua_State* state);
 int lua_Model_getMaterial(lua_State* state);
 int lua_Model_getMesh(lua_State* state);
 int lua_Model_getMeshPartCount(lua_State* state);
@@ -0,0 +1,25 @@
+#ifndef LUA_PARTICLESYSTEM_H_
+#define LUA_PARTICLESYSTEM_H_
+
+namespace gameplay
+{
+
+// Lua bindings for ParticleSystem.
+int lua_ParticleSystem__gc(lua_State* state);
+int lua_ParticleSystem_addEmitter(lua_State* state);
+int lua_ParticleSystem_addRef(lua_State* state);
+int lua_ParticleSystem_draw(lua_State* state);
+int lua_ParticleSystem_getEmitter(lua_State* state);
+int lua_ParticleSystem_getEmitterCount(lua_State* state);
+int lua_ParticleSystem_getRefCount(lua_State* state);
+int lua_ParticleSystem_release(lua_State* state);
+int lua_ParticleSystem_removeAllEmitters(lua_State* state);
+int lua_ParticleSystem_removeEmitter(lua_State* state);
+int lua_ParticleSystem_static_create(lua_State* state);
+int lua_ParticleSystem_update(lua_State* state);
+
+void luaRegister_ParticleSystem();
+
+}
+
+#endif
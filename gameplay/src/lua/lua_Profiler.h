@@ -0,0 +1,28 @@
+#ifndef LUA_PROFILER_H_
+#define LUA_PROFILER_H_
+
+namespace gameplay
+{
+
+// Lua bindings for Profiler.
+int lua_Profiler_static_beginScope(lua_State* state);
+int lua_Profiler_static_endScope(lua_State* state);
+int lua_Profiler_static_getCapacity(lua_State* state);
+int lua_Profiler_static_getFrameTime(lua_State* state);
+int lua_Profiler_static_getScopeCallCount(lua_State* state);
+int lua_Profiler_static_getScopeCount(lua_State* state);
+int lua_Profiler_static_getScopeDepth(lua_State* state);
+int lua_Profiler_static_getScopeName(lua_State* state);
+int lua_Profiler_static_getScopeThread(lua_State* state);
+int lua_Profiler_static_getScopeTime(lua_State* state);
+int lua_Profiler_static_isEnabled(lua_State* state);
+int lua_Profiler_static_printFrameSummary(lua_State* state);
+int lua_Profiler_static_setCapacity(lua_State* state);
+int lua_Profiler_static_setEnabled(lua_State* state);
+int lua_Profiler_static_writeChromeTrace(lua_State* state);
+
+void luaRegister_Profiler();
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef LUA_RENDERQUEUE_H_
+#define LUA_RENDERQUEUE_H_
+
+namespace gameplay
+{
+
+// Lua bindings for RenderQueue.
+int lua_RenderQueue__gc(lua_State* state);
+int lua_RenderQueue_add(lua_State* state);
+int lua_RenderQueue_addRef(lua_State* state);
+int lua_RenderQueue_clear(lua_State* state);
+int lua_RenderQueue_draw(lua_State* state);
+int lua_RenderQueue_getItemCount(lua_State* state);
+int lua_RenderQueue_getRefCount(lua_State* state);
+int lua_RenderQueue_release(lua_State* state);
+int lua_RenderQueue_sort(lua_State* state);
+int lua_RenderQueue_static_create(lua_State* state);
+
+void luaRegister_RenderQueue();
+
+}
+
+#endif
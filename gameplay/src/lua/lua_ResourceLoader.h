@@ -0,0 +1,21 @@
+#ifndef LUA_RESOURCELOADER_H_
+#define LUA_RESOURCELOADER_H_
+
+namespace gameplay
+{
+
+// Lua bindings for ResourceLoader.
+int lua_ResourceLoader_getPendingCount(lua_State* state);
+int lua_ResourceLoader_getUploadBudget(lua_State* state);
+int lua_ResourceLoader_loadAudioSource(lua_State* state);
+int lua_ResourceLoader_loadBundle(lua_State* state);
+int lua_ResourceLoader_loadImage(lua_State* state);
+int lua_ResourceLoader_loadScene(lua_State* state);
+int lua_ResourceLoader_loadTexture(lua_State* state);
+int lua_ResourceLoader_setUploadBudget(lua_State* state);
+
+void luaRegister_ResourceLoader();
+
+}
+
+#endif
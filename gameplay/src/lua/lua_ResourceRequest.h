@@ -0,0 +1,26 @@
+#ifndef LUA_RESOURCEREQUEST_H_
+#define LUA_RESOURCEREQUEST_H_
+
+namespace gameplay
+{
+
+// Lua bindings for ResourceRequest.
+int lua_ResourceRequest__gc(lua_State* state);
+int lua_ResourceRequest_addListener(lua_State* state);
+int lua_ResourceRequest_addRef(lua_State* state);
+int lua_ResourceRequest_getAudioSource(lua_State* state);
+int lua_ResourceRequest_getBundle(lua_State* state);
+int lua_ResourceRequest_getImage(lua_State* state);
+int lua_ResourceRequest_getPath(lua_State* state);
+int lua_ResourceRequest_getRefCount(lua_State* state);
+int lua_ResourceRequest_getScene(lua_State* state);
+int lua_ResourceRequest_getTexture(lua_State* state);
+int lua_ResourceRequest_isFinished(lua_State* state);
+int lua_ResourceRequest_isLoaded(lua_State* state);
+int lua_ResourceRequest_release(lua_State* state);
+
+void luaRegister_ResourceRequest();
+
+}
+
+#endif
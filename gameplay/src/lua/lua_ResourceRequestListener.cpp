@@ -0,0 +1,121 @@
+#include "Base.h"
+#include "ScriptController.h"
+#include "lua_ResourceRequestListener.h"
+#include "AudioSource.h"
+#include "Base.h"
+#include "Bundle.h"
+#include "Game.h"
+#include "Image.h"
+#include "Ref.h"
+#include "ResourceRequest.h"
+#include "Scene.h"
+#include "ScriptController.h"
+#include "Texture.h"
+
+namespace gameplay
+{
+
+void luaRegister_ResourceRequestListener()
+{
+    const luaL_Reg lua_members[] = 
+    {
+        {"resourceLoaded", lua_ResourceRequestListener_resourceLoaded},
+        {NULL, NULL}
+    };
+    const luaL_Reg lua_statics[] = 
+    {
+        {NULL, NULL}
+    };
+    std::vector<std::string> scopePath;
+
+    ScriptUtil::registerClass("ResourceRequestListener", lua_members, NULL, lua_ResourceRequestListener__gc, lua_statics, scopePath);
+}
+
+static ResourceRequest::Listener* getInstance(lua_State* state)
+{
+    void* userdata = luaL_checkudata(state, 1, "ResourceRequestListener");
+    luaL_argcheck(state, userdata != NULL, 1, "'ResourceRequestListener' expected.");
+    return (ResourceRequest::Listener*)((ScriptUtil::LuaObject*)userdata)->instance;
+}
+
+int lua_ResourceRequestListener__gc(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                void* userdata = luaL_checkudata(state, 1, "ResourceRequestListener");
+                luaL_argcheck(state, userdata != NULL, 1, "'ResourceRequestListener' expected.");
+                ScriptUtil::LuaObject* object = (ScriptUtil::LuaObject*)userdata;
+                if (object->owns)
+                {
+                    ResourceRequest::Listener* instance = (ResourceRequest::Listener*)object->instance;
+                    SAFE_DELETE(instance);
+                }
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_ResourceRequestListener__gc - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+int lua_ResourceRequestListener_resourceLoaded(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                (lua_type(state, 2) == LUA_TUSERDATA || lua_type(state, 2) == LUA_TTABLE || lua_type(state, 2) == LUA_TNIL))
+            {
+                // Get parameter 1 off the stack.
+                bool param1Valid;
+                ScriptUtil::LuaArray<ResourceRequest> param1 = ScriptUtil::getObjectPointer<ResourceRequest>(2, "ResourceRequest", false, &param1Valid);
+                if (!param1Valid)
+                {
+                    lua_pushstring(state, "Failed to convert parameter 1 to type 'ResourceRequest'.");
+                    lua_error(state);
+                }
+
+                ResourceRequest::Listener* instance = getInstance(state);
+                instance->resourceLoaded(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_ResourceRequestListener_resourceLoaded - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
+}
@@ -0,0 +1,15 @@
+#ifndef LUA_RESOURCEREQUESTLISTENER_H_
+#define LUA_RESOURCEREQUESTLISTENER_H_
+
+namespace gameplay
+{
+
+// Lua bindings for ResourceRequestListener.
+int lua_ResourceRequestListener__gc(lua_State* state);
+int lua_ResourceRequestListener_resourceLoaded(lua_State* state);
+
+void luaRegister_ResourceRequestListener();
+
+}
+
+#endif
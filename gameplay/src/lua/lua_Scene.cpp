@@ -31,6 +31,7 @@ void luaRegister_Scene()
         {"getLightDirection", lua_Scene_getLightDirection},
         {"getNodeCount", lua_Scene_getNodeCount},
         {"getRefCount", lua_Scene_getRefCount},
+        {"isSpatialIndexEnabled", lua_Scene_isSpatialIndexEnabled},
         {"release", lua_Scene_release},
         {"removeAllNodes", lua_Scene_removeAllNodes},
         {"removeNode", lua_Scene_removeNode},
@@ -39,6 +40,8 @@ void luaRegister_Scene()
         {"setId", lua_Scene_setId},
         {"setLightColor", lua_Scene_setLightColor},
         {"setLightDirection", lua_Scene_setLightDirection},
+        {"setSpatialIndexEnabled", lua_Scene_setSpatialIndexEnabled},
+        {"updateTransforms", lua_Scene_updateTransforms},
         {"visit", lua_Scene_visit},
         {NULL, NULL}
     };
@@ -746,6 +749,41 @@ int lua_Scene_getRefCount(lua_State* state)
     return 0;
 }
 
+int lua_Scene_isSpatialIndexEnabled(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                Scene* instance = getInstance(state);
+                bool result = instance->isSpatialIndexEnabled();
+
+                // Push the return value onto the stack.
+                lua_pushboolean(state, result);
+
+                return 1;
+            }
+
+            lua_pushstring(state, "lua_Scene_isSpatialIndexEnabled - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Scene_release(lua_State* state)
 {
     // Get the number of parameters.
@@ -1060,6 +1098,42 @@ int lua_Scene_setLightDirection(lua_State* state)
     return 0;
 }
 
+int lua_Scene_setSpatialIndexEnabled(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 2:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA) &&
+                lua_type(state, 2) == LUA_TBOOLEAN)
+            {
+                // Get parameter 1 off the stack.
+                bool param1 = ScriptUtil::luaCheckBool(state, 2);
+
+                Scene* instance = getInstance(state);
+                instance->setSpatialIndexEnabled(param1);
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_Scene_setSpatialIndexEnabled - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 2).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Scene_static_create(lua_State* state)
 {
     // Get the number of parameters.
@@ -1236,6 +1310,38 @@ int lua_Scene_static_load(lua_State* state)
     return 0;
 }
 
+int lua_Scene_updateTransforms(lua_State* state)
+{
+    // Get the number of parameters.
+    int paramCount = lua_gettop(state);
+
+    // Attempt to match the parameters to a valid binding.
+    switch (paramCount)
+    {
+        case 1:
+        {
+            if ((lua_type(state, 1) == LUA_TUSERDATA))
+            {
+                Scene* instance = getInstance(state);
+                instance->updateTransforms();
+                
+                return 0;
+            }
+
+            lua_pushstring(state, "lua_Scene_updateTransforms - Failed to match the given parameters to a valid function signature.");
+            lua_error(state);
+            break;
+        }
+        default:
+        {
+            lua_pushstring(state, "Invalid number of parameters (expected 1).");
+            lua_error(state);
+            break;
+        }
+    }
+    return 0;
+}
+
 int lua_Scene_visit(lua_State* state)
 {
     // Get the number of parameters.
@@ -19,6 +19,7 @@ int lua_Scene_getLightColor(lua_State* state);
 int lua_Scene_getLightDirection(lua_State* state);
 int lua_Scene_getNodeCount(lua_State* state);
 int lua_Scene_getRefCount(lua_State* state);
+int lua_Scene_isSpatialIndexEnabled(lua_State* state);
 int lua_Scene_release(lua_State* state);
 int lua_Scene_removeAllNodes(lua_State* state);
 int lua_Scene_removeNode(lua_State* state);
@@ -27,9 +28,11 @@ int lua_Scene_setAmbientColor(lua_State* state);
 int lua_Scene_setId(lua_State* state);
 int lua_Scene_setLightColor(lua_State* state);
 int lua_Scene_setLightDirection(lua_State* state);
+int lua_Scene_setSpatialIndexEnabled(lua_State* state);
 int lua_Scene_static_create(lua_State* state);
 int lua_Scene_static_getScene(lua_State* state);
 int lua_Scene_static_load(lua_State* state);
+int lua_Scene_updateTransforms(lua_State* state);
 int lua_Scene_visit(lua_State* state);
 
 void luaRegister_Scene();
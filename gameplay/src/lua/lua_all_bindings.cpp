@@ -48,6 +48,7 @@ void lua_RegisterAllBindings()
     luaRegister_Gesture();
     luaRegister_HeightField();
     luaRegister_Image();
+    luaRegister_InstanceBuffer();
     luaRegister_Joint();
     luaRegister_Joystick();
     luaRegister_Keyboard();
@@ -68,6 +69,7 @@ void lua_RegisterAllBindings()
     luaRegister_Node();
     luaRegister_NodeCloneContext();
     luaRegister_ParticleEmitter();
+    luaRegister_ParticleSystem();
     luaRegister_Pass();
     luaRegister_PhysicsCharacter();
     luaRegister_PhysicsCollisionObject();
@@ -92,15 +94,20 @@ void lua_RegisterAllBindings()
     luaRegister_PhysicsVehicleWheel();
     luaRegister_Plane();
     luaRegister_Platform();
+    luaRegister_Profiler();
     luaRegister_Properties();
     luaRegister_Quaternion();
     luaRegister_RadioButton();
     luaRegister_Ray();
     luaRegister_Rectangle();
     luaRegister_Ref();
+    luaRegister_RenderQueue();
     luaRegister_RenderState();
     luaRegister_RenderStateStateBlock();
     luaRegister_RenderTarget();
+    luaRegister_ResourceLoader();
+    luaRegister_ResourceRequest();
+    luaRegister_ResourceRequestListener();
     luaRegister_Scene();
     luaRegister_ScreenDisplayer();
     luaRegister_ScriptController();
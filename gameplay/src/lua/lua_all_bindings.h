@@ -43,6 +43,7 @@
 #include "lua_Gesture.h"
 #include "lua_HeightField.h"
 #include "lua_Image.h"
+#include "lua_InstanceBuffer.h"
 #include "lua_Joint.h"
 #include "lua_Joystick.h"
 #include "lua_Keyboard.h"
@@ -63,6 +64,7 @@
 #include "lua_Node.h"
 #include "lua_NodeCloneContext.h"
 #include "lua_ParticleEmitter.h"
+#include "lua_ParticleSystem.h"
 #include "lua_Pass.h"
 #include "lua_PhysicsCharacter.h"
 #include "lua_PhysicsCollisionObject.h"
@@ -87,15 +89,20 @@
 #include "lua_PhysicsVehicleWheel.h"
 #include "lua_Plane.h"
 #include "lua_Platform.h"
+#include "lua_Profiler.h"
 #include "lua_Properties.h"
 #include "lua_Quaternion.h"
 #include "lua_RadioButton.h"
 #include "lua_Ray.h"
 #include "lua_Rectangle.h"
 #include "lua_Ref.h"
+#include "lua_RenderQueue.h"
 #include "lua_RenderState.h"
 #include "lua_RenderStateStateBlock.h"
 #include "lua_RenderTarget.h"
+#include "lua_ResourceLoader.h"
+#include "lua_ResourceRequest.h"
+#include "lua_ResourceRequestListener.h"
 #include "lua_Scene.h"
 #include "lua_ScreenDisplayer.h"
 #include "lua_ScriptController.h"